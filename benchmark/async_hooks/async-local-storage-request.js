@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common.js');
+const assert = require('assert');
+const { AsyncLocalStorage } = require('async_hooks');
+
+/**
+ * This benchmark models request tracing: every request enters its store once
+ * and reads it back after each asynchronous step.
+ *
+ * To compare both AsyncLocalStorage implementations, run it once as is and
+ * once with NODE_BENCHMARK_FLAGS=--experimental-async-context-frame.
+ */
+const bench = common.createBenchmark(main, {
+  storageCount: [0, 1, 10],
+  step: ['promise', 'tick', 'immediate'],
+  steps: [10],
+  n: [1e4],
+});
+
+function runStores(stores, value, cb, idx = 0) {
+  if (idx === stores.length) {
+    cb();
+  } else {
+    stores[idx].run(value, () => {
+      runStores(stores, value, cb, idx + 1);
+    });
+  }
+}
+
+const schedule = {
+  promise: (cb) => Promise.resolve().then(cb),
+  tick: (cb) => process.nextTick(cb),
+  immediate: (cb) => setImmediate(cb),
+};
+
+function main({ n, storageCount, step, steps }) {
+  const stores = new Array(storageCount).fill(0).map(() => new AsyncLocalStorage());
+  const next = schedule[step];
+  let requests = 0;
+
+  function request() {
+    if (requests === n) {
+      bench.end(n);
+      return;
+    }
+    const id = requests++;
+    let remaining = steps;
+    runStores(stores, id, function onStep() {
+      for (let i = 0; i < stores.length; i++)
+        assert.strictEqual(stores[i].getStore(), id);
+      if (remaining-- > 0)
+        next(onStep);
+      else
+        request();
+    });
+  }
+
+  bench.start();
+  request();
+}
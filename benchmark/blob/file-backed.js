@@ -0,0 +1,59 @@
+// Compares Blobs backed by a file with Blobs holding the file's contents in
+// memory. Creating a file-backed Blob does not read the file, and reading it
+// only holds one chunk of the file in memory at a time.
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const { Blob } = require('buffer');
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+const filename = path.resolve(tmpdir.path,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  source: ['file', 'memory'],
+  operation: ['open', 'stream', 'arrayBuffer', 'slice'],
+  size: [1024 * 1024, 64 * 1024 * 1024],
+  n: [20],
+});
+
+async function open(source) {
+  if (source === 'file')
+    return fs.openAsBlob(filename);
+  return new Blob([await fs.promises.readFile(filename)]);
+}
+
+async function run(source, operation, size, n) {
+  let bytes = 0;
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    let blob = await open(source);
+    switch (operation) {
+      case 'open':
+        break;
+      case 'stream':
+        for await (const chunk of blob.stream())
+          bytes += chunk.byteLength;
+        break;
+      case 'arrayBuffer':
+        bytes += (await blob.arrayBuffer()).byteLength;
+        break;
+      case 'slice':
+        // Reads the last 64 KiB only.
+        blob = blob.slice(size - 64 * 1024);
+        bytes += (await blob.arrayBuffer()).byteLength;
+        break;
+    }
+  }
+  bench.end(n);
+  return bytes;
+}
+
+function main({ source, operation, size, n }) {
+  fs.writeFileSync(filename, Buffer.alloc(size, 'a'));
+  run(source, operation, size, n)
+    .finally(() => fs.unlinkSync(filename))
+    .catch(console.error);
+}
@@ -0,0 +1,54 @@
+// Creates and drops short-lived buffers, with and without
+// --pool-arraybuffer-allocations. `live` buffers are kept alive at any time
+// so that the garbage collector has to free memory while allocation goes on.
+'use strict';
+
+const common = require('../common.js');
+const { fork } = require('child_process');
+
+const kPoolFlag = '--pool-arraybuffer-allocations';
+
+const bench = common.createBenchmark(main, {
+  allocator: ['default', 'pooled'],
+  type: ['alloc', 'allocUnsafeSlow', 'ArrayBuffer'],
+  len: [128, 4096, 65536],
+  live: [16, 1024],
+  n: [1e6],
+});
+
+function main(conf) {
+  const pooled = process.execArgv.includes(kPoolFlag);
+  if ((conf.allocator === 'pooled') !== pooled) {
+    // Allocators are set up at startup, so run this configuration again in a
+    // child process that toggles the flag and report its result.
+    const args = Object.entries(conf).map(([key, value]) => `${key}=${value}`);
+    const execArgv = pooled ?
+      process.execArgv.filter((flag) => flag !== kPoolFlag) :
+      process.execArgv.concat(kPoolFlag);
+    const child = fork(__filename, args, { execArgv });
+    child.on('message', (data) => process.send(data));
+    child.on('exit', (code) => process.exitCode = code);
+    return;
+  }
+
+  const { type, len, live, n } = conf;
+  let fn;
+  switch (type) {
+    case 'alloc':
+      fn = Buffer.alloc;
+      break;
+    case 'allocUnsafeSlow':
+      fn = Buffer.allocUnsafeSlow;
+      break;
+    case 'ArrayBuffer':
+      fn = (size) => new ArrayBuffer(size);
+      break;
+  }
+
+  const buffers = new Array(live);
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    buffers[i % live] = fn(len);
+  }
+  bench.end(n);
+}
@@ -0,0 +1,45 @@
+'use strict';
+// Round trips of small messages over the IPC channel of a forked child.
+if (process.argv[2] === 'child') {
+  process.on('message', (message) => {
+    if (message === 'done')
+      process.disconnect();
+    else
+      process.send(message);
+  });
+} else {
+  const common = require('../common.js');
+  const { fork } = require('child_process');
+  const bench = common.createBenchmark(main, {
+    transport: ['pipe', 'shared-memory'],
+    serialization: ['json', 'advanced'],
+    window: [1, 64],
+    n: [1e5],
+  });
+
+  function main({ transport, serialization, window, n }) {
+    const child = fork(__filename, ['child'], {
+      ipcTransport: transport === 'pipe' ? undefined : transport,
+      serialization,
+    });
+    const message = { id: 0, type: 'request', payload: 'x'.repeat(64) };
+
+    let sent = 0;
+    let received = 0;
+    child.on('message', () => {
+      if (++received === n) {
+        bench.end(n);
+        child.send('done');
+      } else if (sent < n) {
+        message.id = sent++;
+        child.send(message);
+      }
+    });
+
+    bench.start();
+    for (; sent < window; sent++) {
+      message.id = sent;
+      child.send(message);
+    }
+  }
+}
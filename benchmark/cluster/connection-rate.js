@@ -0,0 +1,79 @@
+// Measures how fast a cluster accepts new TCP connections with each of the
+// scheduling policies. A separate client process opens short-lived
+// connections, each of which is answered with a single byte and closed.
+'use strict';
+
+const cluster = require('cluster');
+const net = require('net');
+
+if (cluster.isPrimary) {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    policy: ['none', 'rr', 'reuseport'],
+    workers: [4],
+    concurrency: [50],
+    n: [2e4],
+  });
+
+  function main({ n, workers, concurrency, policy }) {
+    cluster.schedulingPolicy = {
+      none: cluster.SCHED_NONE,
+      rr: cluster.SCHED_RR,
+      reuseport: cluster.SCHED_REUSEPORT,
+    }[policy];
+
+    let listening = 0;
+    for (let i = 0; i < workers; i++) {
+      cluster.fork({ BENCH_ROLE: 'server' }).once('listening', (address) => {
+        if (++listening === workers)
+          startClient(address.port);
+      });
+    }
+
+    function startClient(port) {
+      const client = cluster.fork({
+        BENCH_ROLE: 'client',
+        BENCH_PORT: `${port}`,
+        BENCH_CONCURRENCY: `${concurrency}`,
+        BENCH_N: `${n}`,
+      });
+      client.on('message', (msg) => {
+        if (msg === 'start') {
+          bench.start();
+        } else if (msg === 'done') {
+          bench.end(n);
+          cluster.disconnect();
+        }
+      });
+    }
+  }
+} else if (process.env.BENCH_ROLE === 'server') {
+  net.createServer((socket) => {
+    socket.end('x');
+  }).listen(0, '127.0.0.1');
+} else {
+  const port = +process.env.BENCH_PORT;
+  const concurrency = +process.env.BENCH_CONCURRENCY;
+  const n = +process.env.BENCH_N;
+  let started = 0;
+  let finished = 0;
+
+  function connect() {
+    started++;
+    const socket = net.connect(port, '127.0.0.1');
+    socket.on('data', () => {});
+    socket.on('error', (err) => {
+      throw err;
+    });
+    socket.on('close', () => {
+      if (++finished === n)
+        process.send('done');
+      else if (started < n)
+        connect();
+    });
+  }
+
+  process.send('start');
+  for (let i = 0; i < concurrency; i++)
+    connect();
+}
@@ -0,0 +1,47 @@
+'use strict';
+// Compares hashing many independent chunks with one Hash object per chunk
+// against crypto.hashManySync() and crypto.hashMany().
+
+const common = require('../common.js');
+const { createHash, hashMany, hashManySync, randomBytes } = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['createHash', 'hashManySync', 'hashMany'],
+  size: [4096, 16384, 65536],
+  algo: ['sha256', 'sha1'],
+  concurrency: [1, 4],
+  n: [2e4],
+}, {
+  combinationFilter(p) {
+    return p.api === 'hashMany' || p.concurrency === 1;
+  },
+});
+
+function main({ api, size, algo, concurrency, n }) {
+  // Hash distinct views of a shared pool, as a chunking blob store would.
+  const pool = randomBytes(size * 64);
+  const chunks = new Array(n);
+  for (let i = 0; i < n; i++) {
+    const offset = (i % 64) * size;
+    chunks[i] = pool.subarray(offset, offset + size);
+  }
+
+  bench.start();
+  switch (api) {
+    case 'createHash':
+      for (let i = 0; i < n; i++)
+        createHash(algo).update(chunks[i]).digest();
+      bench.end(n);
+      break;
+    case 'hashManySync':
+      hashManySync(algo, chunks);
+      bench.end(n);
+      break;
+    case 'hashMany':
+      hashMany(algo, chunks, { concurrency }, (err) => {
+        if (err) throw err;
+        bench.end(n);
+      });
+      break;
+  }
+}
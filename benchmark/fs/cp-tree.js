@@ -0,0 +1,48 @@
+'use strict';
+// Copies a tree with fs.promises.cp(): either 10000 small files in 100
+// directories, or a few large files. With `filter` fs.cp() copies one entry
+// at a time from JS, without it the tree is copied natively.
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  tree: ['small', 'large'],
+  filter: ['false', 'true'],
+  n: [3],
+});
+
+function createTree(root, tree) {
+  if (tree === 'large') {
+    fs.mkdirSync(root);
+    const data = Buffer.alloc(64 * 1024 * 1024, 'a');
+    for (let i = 0; i < 4; i++)
+      fs.writeFileSync(path.join(root, `${i}.bin`), data);
+    return;
+  }
+  const data = Buffer.alloc(1024, 'a');
+  for (let i = 0; i < 100; i++) {
+    const dir = path.join(root, `${i}`);
+    fs.mkdirSync(dir, { recursive: true });
+    for (let j = 0; j < 100; j++)
+      fs.writeFileSync(path.join(dir, `${j}.txt`), data);
+  }
+}
+
+async function run(src, filter, n) {
+  const options = { recursive: true };
+  if (filter === 'true')
+    options.filter = () => true;
+  bench.start();
+  for (let i = 0; i < n; i++)
+    await fs.promises.cp(src, path.join(tmpdir.path, `dest-${i}`), options);
+  bench.end(n);
+}
+
+function main({ tree, filter, n }) {
+  tmpdir.refresh();
+  const src = path.join(tmpdir.path, 'src');
+  createTree(src, tree);
+  run(src, filter, n).then(() => tmpdir.refresh());
+}
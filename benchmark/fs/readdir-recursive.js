@@ -0,0 +1,62 @@
+'use strict';
+// Lists trees with fs.readdir({ recursive: true }): either one directory of
+// 10000 files, or 50 directories nested 100 deep with 10 files each.
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  tree: ['wide', 'deep'],
+  method: ['sync', 'callback', 'promise'],
+  withFileTypes: ['false', 'true'],
+  n: [10],
+});
+
+function createTree(root, tree) {
+  if (tree === 'wide') {
+    fs.mkdirSync(root);
+    for (let i = 0; i < 10000; i++)
+      fs.writeFileSync(path.join(root, `${i}.txt`), '');
+    return;
+  }
+  for (let i = 0; i < 50; i++) {
+    let dir = path.join(root, `${i}`);
+    for (let j = 0; j < 100; j++)
+      dir = path.join(dir, 'd');
+    fs.mkdirSync(dir, { recursive: true });
+    for (let j = 0; j < 10; j++)
+      fs.writeFileSync(path.join(dir, `${j}.txt`), '');
+  }
+}
+
+async function run(root, method, options, n) {
+  let entries = 0;
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    switch (method) {
+      case 'sync':
+        entries += fs.readdirSync(root, options).length;
+        break;
+      case 'callback':
+        entries += (await new Promise((resolve, reject) => {
+          fs.readdir(root, options,
+                     (err, files) => (err ? reject(err) : resolve(files)));
+        })).length;
+        break;
+      case 'promise':
+        entries += (await fs.promises.readdir(root, options)).length;
+        break;
+    }
+  }
+  bench.end(n);
+  return entries;
+}
+
+function main({ tree, method, withFileTypes, n }) {
+  tmpdir.refresh();
+  const root = path.join(tmpdir.path, 'tree');
+  createTree(root, tree);
+  const options = { recursive: true, withFileTypes: withFileTypes === 'true' };
+  run(root, method, options, n).then(() => tmpdir.refresh());
+}
@@ -0,0 +1,63 @@
+'use strict';
+// Removes trees with fs.rm({ recursive: true }): either one directory of
+// 10000 files, or 50 directories nested 100 deep with 10 files each.
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  tree: ['wide', 'deep'],
+  method: ['sync', 'callback', 'promise'],
+  n: [3],
+});
+
+function createTree(root, tree) {
+  if (tree === 'wide') {
+    fs.mkdirSync(root);
+    for (let i = 0; i < 10000; i++)
+      fs.writeFileSync(path.join(root, `${i}.txt`), '');
+    return;
+  }
+  for (let i = 0; i < 50; i++) {
+    let dir = path.join(root, `${i}`);
+    for (let j = 0; j < 100; j++)
+      dir = path.join(dir, 'd');
+    fs.mkdirSync(dir, { recursive: true });
+    for (let j = 0; j < 10; j++)
+      fs.writeFileSync(path.join(dir, `${j}.txt`), '');
+  }
+}
+
+async function run(roots, method) {
+  const options = { recursive: true };
+  bench.start();
+  for (const root of roots) {
+    switch (method) {
+      case 'sync':
+        fs.rmSync(root, options);
+        break;
+      case 'callback':
+        await new Promise((resolve, reject) => {
+          fs.rm(root, options, (err) => (err ? reject(err) : resolve()));
+        });
+        break;
+      case 'promise':
+        await fs.promises.rm(root, options);
+        break;
+    }
+  }
+  bench.end(roots.length);
+}
+
+function main({ tree, method, n }) {
+  tmpdir.refresh();
+  // Every iteration removes its own copy of the tree.
+  const roots = [];
+  for (let i = 0; i < n; i++) {
+    const root = path.join(tmpdir.path, `tree-${i}`);
+    createTree(root, tree);
+    roots.push(root);
+  }
+  run(roots, method).then(() => tmpdir.refresh());
+}
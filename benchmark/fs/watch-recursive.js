@@ -0,0 +1,62 @@
+'use strict';
+// Recursive fs.watch() on a large tree: `startup` measures how fast the
+// watcher covers the tree (directories per second), `latency` the round
+// trips of changing a file and being told about it.
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  measure: ['startup', 'latency'],
+  dirs: [100, 1000],
+  filesPerDir: [10],
+  n: [100],
+});
+
+function createTree(root, dirs, filesPerDir) {
+  for (let i = 0; i < dirs; i++) {
+    // Two levels, so that not all directories share a parent.
+    const dir = path.join(root, `${i % 10}`, `${i}`);
+    fs.mkdirSync(dir, { recursive: true });
+    for (let j = 0; j < filesPerDir; j++)
+      fs.writeFileSync(path.join(dir, `${j}.txt`), '');
+  }
+}
+
+function main({ measure, dirs, filesPerDir, n }) {
+  tmpdir.refresh();
+  const root = path.join(tmpdir.path, 'watch-recursive');
+  createTree(root, dirs, filesPerDir);
+
+  if (measure === 'startup') {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      fs.watch(root, { recursive: true }).close();
+    bench.end(n * dirs);
+    return;
+  }
+
+  const watcher = fs.watch(root, { recursive: true });
+  let i = 0;
+  let file;
+  function touch() {
+    const dir = i % dirs;
+    file = path.join(`${dir % 10}`, `${dir}`, `${i % filesPerDir}.txt`);
+    fs.writeFileSync(path.join(root, file), `${i}`);
+  }
+  watcher.on('change', (eventType, filename) => {
+    if (filename !== file)
+      return;
+    file = undefined;
+    if (++i === n) {
+      bench.end(n);
+      watcher.close();
+      return;
+    }
+    // Let the events of the previous write settle.
+    setImmediate(touch);
+  });
+  bench.start();
+  touch();
+}
@@ -0,0 +1,64 @@
+// Small requests over keep-alive connections. metric=rate reports requests
+// per second, metric=allocations reports how many stores were allocated for
+// reads per request, counting both read buffers and the copies of small reads,
+// on both the client and the server side.
+'use strict';
+
+const common = require('../common.js');
+const http = require('http');
+
+const bench = common.createBenchmark(main, {
+  connections: [1, 50],
+  metric: ['rate', 'allocations'],
+  dur: [5],
+}, {
+  flags: ['--expose-internals', '--no-warnings'],
+});
+
+function main({ connections, metric, dur }) {
+  const {
+    getReadBufferAllocations,
+    getReadBufferCopies,
+  } = common.binding('stream_wrap');
+  const readAllocations = () => getReadBufferAllocations() +
+                                getReadBufferCopies();
+  let requests = 0;
+  let running = true;
+
+  const server = http.createServer((req, res) => {
+    res.end('ok');
+  });
+
+  server.listen(0, () => {
+    const agent = new http.Agent({ keepAlive: true, maxSockets: connections });
+    const options = { agent, port: server.address().port, path: '/' };
+
+    function request() {
+      http.get(options, (res) => {
+        res.resume();
+        res.on('end', () => {
+          requests++;
+          if (running)
+            request();
+        });
+      });
+    }
+
+    for (let i = 0; i < connections; i++)
+      request();
+
+    const allocations = readAllocations();
+    const start = process.hrtime.bigint();
+    bench.start();
+    setTimeout(() => {
+      running = false;
+      if (metric === 'rate') {
+        bench.end(requests);
+      } else {
+        bench.report((readAllocations() - allocations) / requests,
+                     process.hrtime.bigint() - start);
+      }
+      process.exit(0);
+    }, dur * 1000);
+  });
+}
@@ -0,0 +1,37 @@
+'use strict';
+
+// Measures the overhead of the `recordTimings` server option, which records
+// the latency of every request in native histograms. The responses are small
+// so that the per-request cost of the server dominates.
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  recordTimings: ['false', 'true'],
+  c: [50],
+  duration: 5,
+});
+
+function main({ recordTimings, c, duration }) {
+  const http = require('http');
+  const body = 'hello world\n';
+  const server = http.createServer({
+    recordTimings: recordTimings === 'true',
+  }, (req, res) => {
+    res.writeHead(200, {
+      'Content-Type': 'text/plain',
+      'Content-Length': body.length,
+    });
+    res.end(body);
+  });
+
+  server.listen(0, () => {
+    bench.http({
+      connections: c,
+      duration,
+      port: server.address().port,
+    }, () => {
+      server.close();
+    });
+  });
+}
@@ -0,0 +1,70 @@
+// Startup time of the embedtest binary from test/embedding, which is built
+// next to the node binary, when bootstrapping from scratch and when
+// deserializing from a snapshot created with
+// CommonEnvironmentSetup::CreateForSnapshotting().
+'use strict';
+const common = require('../common.js');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const bench = common.createBenchmark(main, {
+  mode: ['bootstrap', 'snapshot'],
+  count: [30],
+});
+
+// Stands in for the initialization code of an app. It is limited to the
+// built-in modules that can be included in user snapshots.
+const kInitCode = `
+  for (const id of ['assert', 'buffer', 'crypto', 'events', 'fs', 'path',
+                    'querystring', 'stream', 'string_decoder', 'timers',
+                    'url', 'util', 'zlib']) {
+    require(id);
+  }
+`;
+
+function run(binary, args) {
+  const child = spawnSync(binary, ['--', ...args]);
+  if (child.status !== 0) {
+    console.log('---- STDOUT ----');
+    console.log(child.stdout.toString());
+    console.log('---- STDERR ----');
+    console.log(child.stderr.toString());
+    throw new Error(`Child process stopped with exit code ${child.status}`);
+  }
+}
+
+function main({ mode, count }) {
+  let binary = path.join(path.dirname(process.execPath), 'embedtest');
+  if (process.platform === 'win32') {
+    binary += '.exe';
+  }
+  let args = [kInitCode];
+  let blob;
+  if (mode === 'snapshot') {
+    blob = path.join(os.tmpdir(), `embedder-startup-${process.pid}.blob`);
+    // The app's initialization code runs once here, at build time.
+    run(binary, [
+      `${kInitCode}; require('v8').startupSnapshot.setDeserializeMainFunction(` +
+        '() => {});',
+      '--embedder-snapshot-blob', blob, '--embedder-snapshot-create',
+    ]);
+    args = ['--embedder-snapshot-blob', blob];
+  }
+
+  const warmup = 3;
+  for (let i = 0; i < warmup; i++) {
+    run(binary, args);
+  }
+
+  bench.start();
+  for (let i = 0; i < count; i++) {
+    run(binary, args);
+  }
+  bench.end(count);
+
+  if (blob) {
+    fs.unlinkSync(blob);
+  }
+}
@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <uv.h>
+#define NAPI_EXPERIMENTAL
+#include <node_api.h>
+
+#define NAPI_CALL(env, call)                          \
+  do {                                                \
+    napi_status status = (call);                      \
+    if (status != napi_ok) {                          \
+      napi_throw_error((env), NULL, #call " failed"); \
+      return NULL;                                    \
+    }                                                 \
+  } while (0)
+
+#define MAX_THREADS 16
+
+typedef struct {
+  napi_threadsafe_function ts_fn;
+  napi_ref done;
+  uv_thread_t threads[MAX_THREADS];
+  uint32_t thread_count;
+  uint32_t items_per_thread;
+} bench_state;
+
+static bench_state state;
+
+static void ProducerThread(void* data) {
+  uint32_t index;
+  for (index = 0; index < state.items_per_thread; index++) {
+    napi_call_threadsafe_function(state.ts_fn, NULL, napi_tsfn_blocking);
+  }
+  napi_release_threadsafe_function(state.ts_fn, napi_tsfn_release);
+}
+
+// Calls the JavaScript callback with the number of items it stands for, once
+// per item in the default mode and once per batch in the batched mode.
+static void CallJsCount(napi_env env, napi_value cb, size_t count) {
+  napi_value argv, undefined;
+  if (env == NULL || cb == NULL) return;
+  if (napi_create_uint32(env, count, &argv) != napi_ok) return;
+  if (napi_get_undefined(env, &undefined) != napi_ok) return;
+  napi_call_function(env, undefined, cb, 1, &argv, NULL);
+}
+
+static void CallJs(napi_env env, napi_value cb, void* context, void* data) {
+  CallJsCount(env, cb, 1);
+}
+
+static void CallJsBatch(napi_env env,
+                        napi_value cb,
+                        void* context,
+                        void** data,
+                        size_t count) {
+  CallJsCount(env, cb, count);
+}
+
+static void Finalize(napi_env env, void* data, void* hint) {
+  napi_value done, undefined;
+  uint32_t index;
+
+  for (index = 0; index < state.thread_count; index++) {
+    uv_thread_join(&state.threads[index]);
+  }
+  state.ts_fn = NULL;
+
+  if (napi_get_reference_value(env, state.done, &done) != napi_ok) return;
+  if (napi_get_undefined(env, &undefined) != napi_ok) return;
+  napi_call_function(env, undefined, done, 0, NULL, NULL);
+  napi_delete_reference(env, state.done);
+}
+
+// start(batch, threads, itemsPerThread, maxQueueSize, callback, done)
+static napi_value Start(napi_env env, napi_callback_info info) {
+  size_t argc = 6;
+  napi_value argv[6];
+  napi_value name;
+  bool batch;
+  uint32_t max_queue_size;
+  uint32_t index;
+
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NAPI_CALL(env, napi_get_value_bool(env, argv[0], &batch));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[1], &state.thread_count));
+  NAPI_CALL(env,
+            napi_get_value_uint32(env, argv[2], &state.items_per_thread));
+  NAPI_CALL(env, napi_get_value_uint32(env, argv[3], &max_queue_size));
+  NAPI_CALL(env, napi_create_reference(env, argv[5], 1, &state.done));
+  NAPI_CALL(env, napi_create_string_utf8(env,
+                                         "TSFN Benchmark",
+                                         NAPI_AUTO_LENGTH,
+                                         &name));
+
+  if (state.thread_count == 0 || state.thread_count > MAX_THREADS) {
+    napi_throw_range_error(env, NULL, "invalid thread count");
+    return NULL;
+  }
+
+  if (batch) {
+    NAPI_CALL(env, node_api_create_threadsafe_function_batch(env,
+                                                             argv[4],
+                                                             NULL,
+                                                             name,
+                                                             max_queue_size,
+                                                             state.thread_count,
+                                                             NULL,
+                                                             Finalize,
+                                                             NULL,
+                                                             CallJsBatch,
+                                                             &state.ts_fn));
+  } else {
+    NAPI_CALL(env, napi_create_threadsafe_function(env,
+                                                   argv[4],
+                                                   NULL,
+                                                   name,
+                                                   max_queue_size,
+                                                   state.thread_count,
+                                                   NULL,
+                                                   Finalize,
+                                                   NULL,
+                                                   CallJs,
+                                                   &state.ts_fn));
+  }
+
+  for (index = 0; index < state.thread_count; index++) {
+    if (uv_thread_create(&state.threads[index], ProducerThread, NULL) != 0) {
+      napi_throw_error(env, NULL, "thread creation failed");
+      return NULL;
+    }
+  }
+
+  return NULL;
+}
+
+NAPI_MODULE_INIT() {
+  napi_property_descriptor props[] = {
+    { "start", NULL, Start, NULL, NULL, NULL, napi_enumerable, NULL },
+  };
+
+  NAPI_CALL(env, napi_define_properties(env,
+                                        exports,
+                                        sizeof(props) / sizeof(*props),
+                                        props));
+  return exports;
+}
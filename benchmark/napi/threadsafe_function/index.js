@@ -0,0 +1,31 @@
+'use strict';
+// Measures the throughput of thread-safe functions fed by 1 to 16 producer
+// threads, delivering queued items either one JavaScript call per item or
+// one JavaScript call per batch.
+const common = require('../../common.js');
+
+let binding;
+try {
+  binding = require(`./build/${common.buildType}/binding`);
+} catch {
+  console.error(`${__filename}: Binding failed to load`);
+  process.exit(0);
+}
+
+const bench = common.createBenchmark(main, {
+  mode: ['single', 'batch'],
+  threads: [1, 2, 4, 8, 16],
+  queue: [0, 1024],
+  n: [1e6],
+});
+
+function main({ mode, threads, queue, n }) {
+  const itemsPerThread = Math.ceil(n / threads);
+  let received = 0;
+  bench.start();
+  binding.start(mode === 'batch', threads, itemsPerThread, queue, (count) => {
+    received += count;
+  }, () => {
+    bench.end(received);
+  });
+}
@@ -0,0 +1,64 @@
+// Small request/response round trips over a set of connections, as seen on
+// mostly idle keep-alive connections. metric=rate reports round trips per
+// second, metric=allocations reports how many stores were allocated for reads
+// per round trip, counting both read buffers and the copies of small reads.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  connections: [1, 100],
+  len: [16, 1024],
+  metric: ['rate', 'allocations'],
+  dur: [5],
+}, {
+  flags: ['--expose-internals', '--no-warnings'],
+});
+
+function main({ connections, len, metric, dur }) {
+  const {
+    getReadBufferAllocations,
+    getReadBufferCopies,
+  } = common.binding('stream_wrap');
+  const readAllocations = () => getReadBufferAllocations() +
+                                getReadBufferCopies();
+  const message = Buffer.alloc(len, 'x');
+  let roundTrips = 0;
+  let running = true;
+
+  const server = net.createServer((socket) => {
+    socket.on('data', (data) => socket.write(data));
+  });
+
+  server.listen(0, () => {
+    for (let i = 0; i < connections; i++) {
+      const socket = net.connect(server.address().port);
+      let received = 0;
+      socket.on('data', (data) => {
+        received += data.length;
+        if (received < len)
+          return;
+        received = 0;
+        roundTrips++;
+        if (running)
+          socket.write(message);
+      });
+      socket.write(message);
+    }
+
+    const allocations = readAllocations();
+    const start = process.hrtime.bigint();
+    bench.start();
+    setTimeout(() => {
+      running = false;
+      if (metric === 'rate') {
+        bench.end(roundTrips);
+      } else {
+        bench.report((readAllocations() - allocations) / roundTrips,
+                     process.hrtime.bigint() - start);
+      }
+      process.exit(0);
+    }, dur * 1000);
+  });
+}
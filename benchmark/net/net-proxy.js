@@ -0,0 +1,55 @@
+// A TCP proxy between a client and a server, forwarding with either
+// socket.pipe() or socket.forwardTo(). The client writes as much as it can
+// for the given duration and the throughput arriving at the server is
+// reported in Gbits.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  mode: ['pipe', 'forwardTo'],
+  len: [64 * 1024, 1024 * 1024],
+  dur: [5],
+}, {
+  test: { len: 1024 },
+});
+
+function main({ mode, len, dur }) {
+  const chunk = Buffer.alloc(len, 'x');
+  let received = 0;
+
+  const server = net.createServer((socket) => {
+    socket.on('data', (buf) => {
+      received += buf.length;
+    });
+  });
+
+  const proxy = net.createServer((client) => {
+    const upstream = net.connect(server.address().port);
+    if (mode === 'pipe') {
+      client.pipe(upstream);
+    } else {
+      client.forwardTo(upstream);
+    }
+  });
+
+  server.listen(0, () => {
+    proxy.listen(0, () => {
+      const client = net.connect(proxy.address().port, () => {
+        bench.start();
+        setTimeout(() => {
+          const gbits = (received * 8) / (1024 * 1024 * 1024);
+          bench.end(gbits);
+          process.exit(0);
+        }, dur * 1000);
+        write();
+      });
+      client.on('drain', write);
+
+      function write() {
+        while (client.write(chunk));
+      }
+    });
+  });
+}
@@ -0,0 +1,48 @@
+'use strict';
+
+// Measures the overhead of monitorEventLoopPhases(). Each operation is one
+// turn of the event loop that does a small amount of work, which is the worst
+// case for the monitor since it measures every phase of every turn. With
+// `work=threadpool`, each turn also waits for a small compression job on the
+// threadpool. The monitor should cost less than 1% in both cases.
+
+const common = require('../common.js');
+const { monitorEventLoopPhases } = require('perf_hooks');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  monitor: ['disabled', 'enabled'],
+  work: ['immediate', 'threadpool'],
+  n: [1e5],
+});
+
+function compute() {
+  let sum = 0;
+  for (let i = 0; i < 1e3; i++)
+    sum += Math.sqrt(i);
+  return sum;
+}
+
+function main({ monitor, work, n }) {
+  const phases = monitorEventLoopPhases();
+  if (monitor === 'enabled')
+    phases.enable();
+  const input = Buffer.alloc(256, 'a');
+
+  let i = 0;
+  function next() {
+    compute();
+    if (++i === n) {
+      bench.end(n);
+      phases.disable();
+      return;
+    }
+    if (work === 'threadpool')
+      zlib.deflateRaw(input, next);
+    else
+      setImmediate(next);
+  }
+
+  bench.start();
+  next();
+}
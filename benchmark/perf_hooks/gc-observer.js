@@ -0,0 +1,49 @@
+'use strict';
+
+// Measures the overhead of observing 'gc' entries on an allocation-heavy
+// workload that triggers many scavenges. The work is split in chunks so that
+// the entries are delivered between them.
+
+const common = require('../common.js');
+const { PerformanceObserver } = require('perf_hooks');
+
+const bench = common.createBenchmark(main, {
+  observe: ['none', 'gc', 'gc-read'],
+  n: [2e3],
+});
+
+function work() {
+  let values = [];
+  for (let i = 0; i < 1e4; i++) {
+    values.push({ i, name: `value-${i}` });
+    if (values.length > 1e3)
+      values = [];
+  }
+  return values.length;
+}
+
+function main({ observe, n }) {
+  let entries = 0;
+  let obs;
+  if (observe !== 'none') {
+    obs = new PerformanceObserver((list) => {
+      if (observe === 'gc-read')
+        entries += list.getEntries().length;
+    });
+    obs.observe({ entryTypes: ['gc'] });
+  }
+
+  let i = 0;
+  function chunk() {
+    for (let j = 0; j < 10 && i < n; j++, i++)
+      work();
+    if (i < n)
+      return setImmediate(chunk);
+    bench.end(n);
+    obs?.disconnect();
+    return entries;
+  }
+
+  bench.start();
+  chunk();
+}
@@ -0,0 +1,53 @@
+'use strict';
+// Splitting NDJSON input into records with readline.splitRecords() compared
+// to the 'line' event of readline.createInterface().
+const common = require('../common.js');
+const { Readable } = require('stream');
+const readline = require('readline');
+
+const bench = common.createBenchmark(main, {
+  method: ['splitRecords', 'createInterface'],
+  recordSize: [64, 1024],
+  chunkSize: [64 * 1024],
+  n: [1e6],
+});
+
+function main({ method, recordSize, chunkSize, n }) {
+  const record = JSON.stringify({ id: 0, data: 'x'.repeat(recordSize) })
+    .slice(0, recordSize - 1) + '\n';
+  const data = Buffer.from(record.repeat(Math.ceil(chunkSize / recordSize)));
+  const chunks = [];
+  for (let i = 0; i < Math.ceil(n * recordSize / data.length); i++) {
+    // Start every chunk in a different position of a record.
+    const offset = (i * 7) % recordSize;
+    chunks.push(data.subarray(offset, data.length - recordSize + offset));
+  }
+  // Copies, so that no chunk shares memory with another one.
+  const input = () => Readable.from(chunks.map((chunk) => Buffer.from(chunk)));
+
+  let records = 0;
+  if (method === 'splitRecords') {
+    (async () => {
+      const stream = input();
+      bench.start();
+      for await (const batch of readline.splitRecords(stream)) {
+        for (const record of batch) {
+          if (record.length > 0)
+            records++;
+        }
+      }
+      bench.end(records);
+    })();
+  } else {
+    const stream = input();
+    bench.start();
+    const rl = readline.createInterface({ input: stream, crlfDelay: Infinity });
+    rl.on('line', (line) => {
+      if (line.length > 0)
+        records++;
+    });
+    rl.on('close', () => {
+      bench.end(records);
+    });
+  }
+}
@@ -0,0 +1,29 @@
+'use strict';
+const common = require('../common.js');
+const assert = require('assert');
+
+// Models idle timeouts of many connections: every timer is re-armed over and
+// over again before it gets a chance to fire.
+const bench = common.createBenchmark(main, {
+  timers: [1e3, 1e5, 1e6],
+  durations: [1, 10],
+  n: [1e6],
+});
+
+function main({ timers, durations, n }) {
+  const list = [];
+  for (let i = 0; i < timers; i++)
+    list.push(setTimeout(cb, 60000 + (i % durations) * 1000));
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    list[i % timers].refresh();
+  bench.end(n);
+
+  for (let i = 0; i < timers; i++)
+    clearTimeout(list[i]);
+}
+
+function cb() {
+  assert.fail(`Timer ${this._idleTimeout} should not call callback`);
+}
@@ -0,0 +1,76 @@
+'use strict';
+// A storm of TLS handshakes against one server, with and without
+// offloadPrivateKey. metric=rate reports server handshakes per second,
+// metric=delay reports the server's p99 event loop delay in milliseconds
+// (lower is better). The clients run in a child process so that their half
+// of each handshake does not count against the server's event loop.
+
+const common = require('../common.js');
+const fixtures = require('../../test/common/fixtures');
+const { fork } = require('child_process');
+const { monitorEventLoopDelay } = require('perf_hooks');
+const tls = require('tls');
+
+if (process.argv[2] === 'child') {
+  child(+process.argv[3], +process.argv[4]);
+} else {
+  const bench = common.createBenchmark(main, {
+    offload: [0, 1],
+    key: ['rsa', 'ec'],
+    concurrency: [16, 64],
+    metric: ['rate', 'delay'],
+    dur: [5],
+  });
+
+  function main({ offload, key, concurrency, metric, dur }) {
+    const name = key === 'rsa' ? 'agent1' : 'ec10';
+    const server = tls.createServer({
+      key: fixtures.readKey(`${name}-key.pem`),
+      cert: fixtures.readKey(`${name}-cert.pem`),
+      offloadPrivateKey: offload === 1,
+    });
+
+    let handshakes = 0;
+    server.on('secureConnection', (socket) => {
+      handshakes++;
+      socket.on('error', () => {});
+      socket.end();
+    });
+    server.on('tlsClientError', () => {});
+
+    server.listen(0, () => {
+      const histogram = monitorEventLoopDelay({ resolution: 1 });
+      const clients = fork(__filename,
+                           ['child', server.address().port, concurrency]);
+      clients.on('message', () => {
+        histogram.enable();
+        bench.start();
+        setTimeout(() => {
+          histogram.disable();
+          clients.kill();
+          if (metric === 'rate') {
+            bench.end(handshakes);
+          } else {
+            bench.report(histogram.percentile(99) / 1e6,
+                         BigInt(dur) * 1_000_000_000n);
+          }
+          process.exit(0);
+        }, dur * 1000);
+      });
+    });
+  }
+}
+
+function child(port, concurrency) {
+  function connect() {
+    const socket = tls.connect({ port, rejectUnauthorized: false }, () => {
+      socket.destroy();
+      connect();
+    });
+    socket.on('error', () => setImmediate(connect));
+  }
+
+  for (let i = 0; i < concurrency; i++)
+    connect();
+  process.send('ready');
+}
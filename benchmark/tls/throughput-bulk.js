@@ -0,0 +1,53 @@
+'use strict';
+// Bulk transfer of large payloads over a single TLS connection, client to
+// server. This exercises the encrypted input and output buffers of the TLS
+// layer with many full-size records in flight at once, and reports the
+// received cleartext in megabits per second.
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  sendchunklen: [64 * 1024, 1024 * 1024, 16 * 1024 * 1024],
+  version: ['TLSv1.2', 'TLSv1.3'],
+});
+
+const fixtures = require('../../test/common/fixtures');
+const tls = require('tls');
+
+function main({ dur, sendchunklen, version }) {
+  const chunk = Buffer.alloc(sendchunklen, 'b');
+  const options = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    minVersion: version,
+    maxVersion: version,
+  };
+
+  let received = 0;
+  const server = tls.createServer(options, (socket) => {
+    socket.on('data', (buf) => {
+      received += buf.length;
+    });
+  });
+
+  server.listen(common.PORT, () => {
+    const conn = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false,
+    }, () => {
+      setTimeout(done, dur * 1000);
+      bench.start();
+      conn.on('drain', write);
+      write();
+    });
+
+    function write() {
+      while (false !== conn.write(chunk));
+    }
+  });
+
+  function done() {
+    const mbits = (received * 8) / (1024 * 1024);
+    bench.end(mbits);
+    process.exit(0);
+  }
+}
@@ -0,0 +1,48 @@
+'use strict';
+
+// Measures the overhead of the continuous CPU profiler on a CPU-bound
+// workload. An interval of 0 runs the workload without the profiler. The
+// workload runs in batches of setImmediate() callbacks, so that the profiler
+// rotates its windows every 100 ms while it is measured.
+
+const common = require('../common.js');
+const v8 = require('v8');
+
+const bench = common.createBenchmark(main, {
+  samplingInterval: [0, 1000, 2000, 5000, 10000],
+  n: [1e3],
+});
+
+const kBatchSize = 10;
+
+function fib(n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+function work() {
+  const values = [];
+  for (let i = 0; i < 200; i++)
+    values.push(JSON.stringify({ i, fib: fib(12) }));
+  return values.sort().length;
+}
+
+function main({ samplingInterval, n }) {
+  let profiler;
+  if (samplingInterval > 0) {
+    profiler = new v8.CpuProfiler({ samplingInterval, windowDuration: 100 });
+    profiler.start();
+  }
+
+  let i = 0;
+  bench.start();
+  (function batch() {
+    for (const end = Math.min(i + kBatchSize, n); i < end; i++)
+      work();
+    if (i < n) {
+      setImmediate(batch);
+      return;
+    }
+    bench.end(n);
+    profiler?.stop();
+  })();
+}
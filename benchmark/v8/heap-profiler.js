@@ -0,0 +1,44 @@
+'use strict';
+
+// Measures the overhead of the continuous heap profiler on an allocation-heavy
+// workload that keeps part of what it allocates alive. An interval of 0 runs
+// the workload without the profiler.
+
+const common = require('../common.js');
+const v8 = require('v8');
+
+const bench = common.createBenchmark(main, {
+  samplingInterval: [0, 64 * 1024, 512 * 1024],
+  native: ['true', 'false'],
+  n: [1e3],
+});
+
+let retained = [];
+
+function work(i) {
+  const values = [];
+  for (let j = 0; j < 200; j++)
+    values.push({ i, j, name: `value-${j}` });
+  retained.push(values[i % values.length]);
+  if (retained.length > 1e5) retained = [];
+  return JSON.stringify(values).length;
+}
+
+function main({ samplingInterval, native, n }) {
+  let profiler;
+  if (samplingInterval > 0) {
+    profiler = new v8.HeapProfiler({
+      samplingInterval,
+      aggregateInterval: 100,
+      native: native === 'true',
+    });
+    profiler.start();
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    work(i);
+  bench.end(n);
+
+  profiler?.stop();
+}
@@ -0,0 +1,71 @@
+// HTTP throughput when the main thread only accepts connections and hands
+// them to worker threads, compared to serving everything on the main thread
+// (threads=0).
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+const { Worker, isMainThread, parentPort } = require('worker_threads');
+
+if (!isMainThread) {
+  const server = require('../fixtures/simple-http-server.js');
+  parentPort.on('message', (handle) => {
+    server.emit('connection', new net.Socket({ handle }));
+  });
+  return;
+}
+
+const bench = common.createBenchmark(main, {
+  threads: [0, 2, 4],
+  len: [4, 1024],
+  c: [50, 500],
+  duration: 5,
+});
+
+function main({ threads, len, c, duration }) {
+  const path = `/bytes/${len}`;
+
+  if (threads === 0) {
+    const server = require('../fixtures/simple-http-server.js').listen(0, () => {
+      bench.http({
+        path,
+        connections: c,
+        duration,
+        port: server.address().port,
+      }, () => {
+        server.close();
+      });
+    });
+    return;
+  }
+
+  const workers = [];
+  let online = 0;
+  for (let i = 0; i < threads; i++) {
+    const worker = new Worker(__filename);
+    worker.once('online', () => {
+      if (++online === threads)
+        listen();
+    });
+    workers.push(worker);
+  }
+
+  function listen() {
+    let next = 0;
+    const server = net.createServer({ pauseOnConnect: true }, (socket) => {
+      const handle = socket.detachHandle();
+      workers[next++ % threads].postMessage(handle, [handle]);
+    }).listen(0, () => {
+      bench.http({
+        path,
+        connections: c,
+        duration,
+        port: server.address().port,
+      }, () => {
+        server.close();
+        for (const worker of workers)
+          worker.terminate();
+      });
+    });
+  }
+}
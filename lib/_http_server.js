@@ -48,6 +48,7 @@ const {
   prepareError,
 } = require('_http_common');
 const { ConnectionsList } = internalBinding('http_parser');
+const { internalHistogram } = require('internal/histogram');
 const {
   kUniqueHeaders,
   parseUniqueHeadersOption,
@@ -66,6 +67,7 @@ const {
   getOrSetAsyncId,
 } = require('internal/async_hooks');
 const { IncomingMessage } = require('_http_incoming');
+const { kEmptyObject } = require('internal/util');
 const {
   connResetException,
   codes,
@@ -491,12 +493,20 @@ function storeHTTPOptions(options) {
   } else {
     this.rejectNonStandardBodyWrites = false;
   }
+
+  const recordTimings = options.recordTimings;
+  if (recordTimings !== undefined) {
+    validateBoolean(recordTimings, 'options.recordTimings');
+    this.recordTimings = recordTimings;
+  } else {
+    this.recordTimings = false;
+  }
 }
 
 function setupConnectionsTracking() {
   // Start connection handling
   if (!this[kConnections]) {
-    this[kConnections] = new ConnectionsList();
+    this[kConnections] = new ConnectionsList(this.recordTimings);
   }
 
   // This checker is started without checking whether any headersTimeout or requestTimeout is non zero
@@ -583,6 +593,27 @@ Server.prototype.closeIdleConnections = function() {
   }
 };
 
+Server.prototype.getTimings = function getTimings(options = kEmptyObject) {
+  validateObject(options, 'options');
+  const { reset = false } = options;
+  validateBoolean(reset, 'options.reset');
+
+  if (!this.recordTimings) {
+    return undefined;
+  }
+
+  if (!this[kConnections]) {
+    this[kConnections] = new ConnectionsList(true);
+  }
+
+  const timings = this[kConnections].timings(reset);
+  return {
+    headers: internalHistogram(timings[0]),
+    body: internalHistogram(timings[1]),
+    response: internalHistogram(timings[2]),
+  };
+};
+
 Server.prototype.setTimeout = function setTimeout(msecs, callback) {
   this.timeout = msecs;
   if (callback)
@@ -982,6 +1013,9 @@ function resOnFinish(req, res, socket, state, server) {
 
   state.incoming.shift();
 
+  if (server.recordTimings)
+    socket.parser?.finishResponse();
+
   // If the user never called req.read(), and didn't pipe() or
   // .resume() or .on('data'), then we call req._dump() so that the
   // bytes will be pulled off the wire.
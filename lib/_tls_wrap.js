@@ -1467,6 +1467,7 @@ Server.prototype.setSecureContext = function(options) {
 
   this.privateKeyIdentifier = options.privateKeyIdentifier;
   this.privateKeyEngine = options.privateKeyEngine;
+  this.offloadPrivateKey = options.offloadPrivateKey;
 
   this._sharedCreds = tls.createSecureContext({
     pfx: this.pfx,
@@ -1490,6 +1491,7 @@ Server.prototype.setSecureContext = function(options) {
     sessionTimeout: this.sessionTimeout,
     privateKeyIdentifier: this.privateKeyIdentifier,
     privateKeyEngine: this.privateKeyEngine,
+    offloadPrivateKey: this.offloadPrivateKey,
   });
 };
 
@@ -26,6 +26,7 @@ const {
   validateString,
 } = require('internal/validators');
 const internal_async_hooks = require('internal/async_hooks');
+const AsyncContextFrame = require('internal/async_context_frame');
 
 // Get functions
 // For userland AsyncResources, make sure to emit a destroy event when the
@@ -155,6 +156,7 @@ function createHook(fns) {
 // Embedder API //
 
 const destroyedSymbol = Symbol('destroyed');
+const contextFrameSymbol = Symbol('context_frame');
 
 class AsyncResource {
   constructor(type, opts = kEmptyObject) {
@@ -174,6 +176,8 @@ class AsyncResource {
       throw new ERR_INVALID_ASYNC_ID('triggerAsyncId', triggerAsyncId);
     }
 
+    this[contextFrameSymbol] = AsyncContextFrame.current();
+
     const asyncId = newAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
@@ -198,12 +202,15 @@ class AsyncResource {
     const asyncId = this[async_id_symbol];
     emitBefore(asyncId, this[trigger_async_id_symbol], this);
 
+    const priorContextFrame =
+      AsyncContextFrame.exchange(this[contextFrameSymbol]);
     try {
       const ret =
         ReflectApply(fn, thisArg, args);
 
       return ret;
     } finally {
+      AsyncContextFrame.set(priorContextFrame);
       if (hasAsyncIdStack())
         emitAfter(asyncId);
     }
@@ -365,7 +372,11 @@ class AsyncLocalStorage {
 // otherwise.
 module.exports = {
   // Public API
-  AsyncLocalStorage,
+  get AsyncLocalStorage() {
+    return AsyncContextFrame.enabled ?
+      require('internal/async_local_storage/async_context_frame') :
+      AsyncLocalStorage;
+  },
   createHook,
   executionAsyncId,
   triggerAsyncId,
@@ -110,6 +110,7 @@ let addAbortListener;
  *   execArgv?: string[];
  *   gid?: number;
  *   serialization?: string;
+ *   ipcTransport?: string;
  *   signal?: AbortSignal;
  *   killSignal?: string | number;
  *   silent?: boolean;
@@ -172,12 +173,20 @@ function fork(modulePath, args = [], options) {
   return spawn(options.execPath, args, options);
 }
 
-function _forkChild(fd, serializationMode) {
+function _forkChild(fd, serializationMode, shmFd) {
+  let sharedMemory;
+  if (shmFd !== undefined) {
+    const {
+      openSharedMemory,
+    } = require('internal/child_process/shared_memory');
+    sharedMemory = openSharedMemory(shmFd);
+  }
+
   // set process.send()
   const p = new Pipe(PipeConstants.IPC);
   p.open(fd);
   p.unref();
-  const control = setupChannel(process, p, serializationMode);
+  const control = setupChannel(process, p, serializationMode, sharedMemory);
   process.on('newListener', function onNewListener(name) {
     if (name === 'message' || name === 'disconnect') control.refCounted();
   });
@@ -741,6 +750,7 @@ function abortChildProcess(child, killSignal, reason) {
  *   uid?: number;
  *   gid?: number;
  *   serialization?: string;
+ *   ipcTransport?: string;
  *   shell?: boolean | string;
  *   windowsVerbatimArguments?: boolean;
  *   windowsHide?: boolean;
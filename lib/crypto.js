@@ -106,6 +106,8 @@ const {
 const {
   Hash,
   Hmac,
+  hashMany,
+  hashManySync,
 } = require('internal/crypto/hash');
 const {
   X509Certificate,
@@ -197,6 +199,8 @@ module.exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  hashMany,
+  hashManySync,
   hkdf,
   hkdfSync,
   pbkdf2,
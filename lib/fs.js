@@ -33,6 +33,8 @@ const {
   ObjectDefineProperties,
   ObjectDefineProperty,
   Promise,
+  PromiseReject,
+  PromiseResolve,
   ReflectApply,
   SafeMap,
   SafeSet,
@@ -100,6 +102,7 @@ const {
   getDirent,
   getDirents,
   getOptions,
+  getRecursiveDirents,
   getValidatedFd,
   getValidatedPath,
   getValidMode,
@@ -138,6 +141,7 @@ const {
   validateFunction,
   validateInteger,
   validateObject,
+  validateString,
 } = require('internal/validators');
 
 let truncateWarn = true;
@@ -159,7 +163,6 @@ let FileReadStream;
 let FileWriteStream;
 
 const isWindows = process.platform === 'win32';
-const isOSX = process.platform === 'darwin';
 
 
 const showStringCoercionDeprecation = deprecate(
@@ -597,6 +600,31 @@ function openSync(path, flags, mode) {
   return result;
 }
 
+/**
+ * Returns a `Blob` whose data is read from the file at `path` only
+ * when it is needed.
+ * @param {string | Buffer | URL} path
+ * @param {{
+ *   type?: string;
+ *   }} [options]
+ * @returns {Promise<Blob>}
+ */
+function openAsBlob(path, options = kEmptyObject) {
+  validateObject(options, 'options');
+  const type = options.type || '';
+  validateString(type, 'options.type');
+  path = getValidatedPath(path);
+  // The file is only stat'ed, synchronously for now; returning a Promise
+  // leaves room to do that asynchronously later.
+  try {
+    const { createBlobFromFilePath } = require('internal/blob');
+    return PromiseResolve(
+      createBlobFromFilePath(pathModule.toNamespacedPath(path), { type }));
+  } catch (err) {
+    return PromiseReject(err);
+  }
+}
+
 /**
  * Reads file from the specified `fd` (file descriptor).
  * @param {number} fd
@@ -1397,7 +1425,7 @@ function mkdirSync(path, options) {
 /**
  * An iterative algorithm for reading the entire contents of the `basePath` directory.
  * This function does not validate `basePath` as a directory. It is passed directly to
- * `binding.readdir`.
+ * `binding.readdirRecursive`, or to `binding.readdir` on Windows.
  * @param {string} basePath
  * @param {{ encoding: string, withFileTypes: boolean }} options
  * @returns {string[] | Dirent[]}
@@ -1406,6 +1434,19 @@ function readdirSyncRecursive(basePath, options) {
   const withFileTypes = Boolean(options.withFileTypes);
   const encoding = options.encoding;
 
+  if (!isWindows) {
+    const ctx = { path: basePath };
+    const result = binding.readdirRecursive(
+      pathModule.toNamespacedPath(basePath),
+      encoding,
+      withFileTypes,
+      undefined,
+      ctx,
+    );
+    handleErrorFromBinding(ctx);
+    return withFileTypes ? getRecursiveDirents(basePath, result) : result;
+  }
+
   const readdirResults = [];
   const pathsQueue = [basePath];
 
@@ -1455,6 +1496,34 @@ function readdirSyncRecursive(basePath, options) {
   return readdirResults;
 }
 
+function readdirRecursive(basePath, options, callback) {
+  if (isWindows) {
+    callback(null, readdirSyncRecursive(basePath, options));
+    return;
+  }
+
+  const req = new FSReqCallback();
+  if (!options.withFileTypes) {
+    req.oncomplete = callback;
+  } else {
+    req.oncomplete = (err, result) => {
+      if (err) {
+        callback(err);
+        return;
+      }
+      try {
+        result = getRecursiveDirents(basePath, result);
+      } catch (err) {
+        callback(err);
+        return;
+      }
+      callback(null, result);
+    };
+  }
+  binding.readdirRecursive(pathModule.toNamespacedPath(basePath),
+                           options.encoding, !!options.withFileTypes, req);
+}
+
 /**
  * Reads the contents of a directory.
  * @param {string | Buffer | URL} path
@@ -1477,7 +1546,7 @@ function readdir(path, options, callback) {
   }
 
   if (options.recursive) {
-    callback(null, readdirSyncRecursive(path, options));
+    readdirRecursive(path, options, callback);
     return;
   }
 
@@ -2410,11 +2479,12 @@ function watch(filename, options, listener) {
 
   if (options.persistent === undefined) options.persistent = true;
   if (options.recursive === undefined) options.recursive = false;
-  if (options.recursive && !(isOSX || isWindows))
-    throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('watch recursively');
 
   const watchers = require('internal/fs/watchers');
-  const watcher = new watchers.FSWatcher();
+  if (options.recursive && !watchers.kCanWatchRecursively)
+    throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('watch recursively');
+
+  const watcher = new watchers.FSWatcher(options.recursive);
   watcher[watchers.kFSWatchStart](filename,
                                   options.persistent,
                                   options.recursive,
@@ -3119,6 +3189,7 @@ module.exports = fs = {
   mkdtemp,
   mkdtempSync,
   open,
+  openAsBlob,
   openSync,
   readdir,
   readdirSync,
@@ -98,6 +98,8 @@ Server.prototype.closeAllConnections = HttpServer.prototype.closeAllConnections;
 
 Server.prototype.closeIdleConnections = HttpServer.prototype.closeIdleConnections;
 
+Server.prototype.getTimings = HttpServer.prototype.getTimings;
+
 Server.prototype.setTimeout = HttpServer.prototype.setTimeout;
 
 Server.prototype.close = function() {
@@ -0,0 +1,76 @@
+'use strict';
+
+const {
+  ObjectSetPrototypeOf,
+  SafeMap,
+} = primordials;
+
+const {
+  getContinuationPreservedEmbedderData,
+  setContinuationPreservedEmbedderData,
+} = internalBinding('async_context_frame');
+
+let enabled_;
+
+// An async context frame maps every AsyncLocalStorage instance to its store.
+// Frames are immutable once they became current: entering a store creates a
+// copy of the current frame. The current frame is stored as the context's
+// continuation-preserved embedder data, which V8 captures for every promise
+// reaction and restores when the reaction runs, so promises need no
+// PromiseHook. Other async resources capture the frame when they are created
+// and restore it around their callbacks.
+class ActiveAsyncContextFrame extends SafeMap {
+  static current() {
+    return getContinuationPreservedEmbedderData();
+  }
+
+  static set(frame) {
+    setContinuationPreservedEmbedderData(frame);
+  }
+
+  static exchange(frame) {
+    const prior = this.current();
+    this.set(frame);
+    return prior;
+  }
+
+  static disable(store) {
+    const frame = this.current();
+    frame?.delete(store);
+  }
+}
+
+// Used until --experimental-async-context-frame turns out to be set, so that
+// timers and other resources do not call into C++ for a frame that can only
+// ever be undefined.
+class InactiveAsyncContextFrame extends SafeMap {
+  static current() {}
+  static set(frame) {}
+  static exchange(frame) {}
+  static disable(store) {}
+}
+
+class AsyncContextFrame extends InactiveAsyncContextFrame {
+  constructor(store, data) {
+    super(AsyncContextFrame.current());
+    this.set(store, data);
+  }
+
+  static get enabled() {
+    if (enabled_ === undefined)
+      enabled_ = checkEnabled();
+    return enabled_;
+  }
+}
+
+function checkEnabled() {
+  const { getOptionValue } = require('internal/options');
+  const enabled = getOptionValue('--experimental-async-context-frame');
+  if (enabled) {
+    // Swap the static methods instead of checking the option on every call.
+    ObjectSetPrototypeOf(AsyncContextFrame, ActiveAsyncContextFrame);
+  }
+  return enabled;
+}
+
+module.exports = AsyncContextFrame;
@@ -0,0 +1,48 @@
+'use strict';
+
+const {
+  ReflectApply,
+} = primordials;
+
+const { AsyncResource } = require('async_hooks');
+const AsyncContextFrame = require('internal/async_context_frame');
+
+// AsyncLocalStorage implementation used with --experimental-async-context-frame.
+class AsyncLocalStorage {
+  static bind(fn) {
+    return AsyncResource.bind(fn);
+  }
+
+  static snapshot() {
+    return AsyncLocalStorage.bind((cb, ...args) => cb(...args));
+  }
+
+  disable() {
+    AsyncContextFrame.disable(this);
+  }
+
+  enterWith(store) {
+    const frame = new AsyncContextFrame(this, store);
+    AsyncContextFrame.set(frame);
+  }
+
+  run(store, callback, ...args) {
+    const prior = AsyncContextFrame.current();
+    this.enterWith(store);
+    try {
+      return ReflectApply(callback, null, args);
+    } finally {
+      AsyncContextFrame.set(prior);
+    }
+  }
+
+  exit(callback, ...args) {
+    return ReflectApply(this.run, this, [undefined, callback, ...args]);
+  }
+
+  getStore() {
+    return AsyncContextFrame.current()?.get(this);
+  }
+}
+
+module.exports = AsyncLocalStorage;
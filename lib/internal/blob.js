@@ -1,12 +1,13 @@
 'use strict';
 
 const {
+  ArrayBuffer,
   ArrayFrom,
   MathMax,
   MathMin,
+  MathTrunc,
   ObjectDefineProperties,
   ObjectDefineProperty,
-  PromiseResolve,
   PromiseReject,
   SafePromisePrototypeFinally,
   ReflectConstruct,
@@ -17,12 +18,13 @@ const {
   Symbol,
   SymbolIterator,
   SymbolToStringTag,
+  TypedArrayPrototypeSet,
   Uint8Array,
 } = primordials;
 
 const {
   createBlob: _createBlob,
-  FixedSizeBlobCopyJob,
+  createBlobFromFilePath: _createBlobFromFilePath,
   getDataObject,
 } = internalBinding('blob');
 
@@ -47,11 +49,11 @@ const {
   customInspectSymbol: kInspect,
   kEmptyObject,
   kEnumerableProperty,
+  lazyDOMException,
 } = require('internal/util');
 const { inspect } = require('internal/util/inspect');
 
 const {
-  AbortError,
   codes: {
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
@@ -66,14 +68,15 @@ const {
 } = require('internal/validators');
 
 const kHandle = Symbol('kHandle');
-const kState = Symbol('kState');
-const kIndex = Symbol('kIndex');
 const kType = Symbol('kType');
 const kLength = Symbol('kLength');
 const kArrayBufferPromise = Symbol('kArrayBufferPromise');
 
 const kMaxChunkSize = 65536;
 
+// Status codes passed to the callback of a Blob reader's pull().
+const kStatusEnd = 0;
+
 const disallowedTypeCharacters = /[^\u{0020}-\u{007E}]/u;
 
 let ReadableStream;
@@ -125,6 +128,22 @@ function getSource(source, endings) {
   return [byteLength, new Uint8Array(slice)];
 }
 
+function normalizeType(type) {
+  type = `${type}`;
+  return RegExpPrototypeExec(disallowedTypeCharacters, type) !== null ?
+    '' : StringPrototypeToLowerCase(type);
+}
+
+// Converts a slice() position the way WebIDL converts a `long long`.
+function toPosition(value, length) {
+  value = MathTrunc(value) || 0;
+  return value < 0 ? MathMax(length + value, 0) : MathMin(value, length);
+}
+
+function notReadable() {
+  return lazyDOMException('The blob could not be read', 'NotReadableError');
+}
+
 class Blob {
   /**
    * @typedef {string|ArrayBuffer|ArrayBufferView|Blob} SourcePart
@@ -145,12 +164,12 @@ class Blob {
       throw new ERR_INVALID_ARG_TYPE('sources', 'a sequence', sources);
     }
     validateDictionary(options, 'options');
-    let {
+    const {
       type = '',
-      endings = 'transparent',
+      endings: endingsOption = 'transparent',
     } = options ?? kEmptyObject;
 
-    endings = `${endings}`;
+    const endings = `${endingsOption}`;
     if (endings !== 'transparent' && endings !== 'native')
       throw new ERR_INVALID_ARG_VALUE('options.endings', endings);
 
@@ -166,10 +185,7 @@ class Blob {
 
     this[kHandle] = _createBlob(sources_, length);
     this[kLength] = length;
-
-    type = `${type}`;
-    this[kType] = RegExpPrototypeExec(disallowedTypeCharacters, type) !== null ?
-      '' : StringPrototypeToLowerCase(type);
+    this[kType] = normalizeType(type);
 
     // eslint-disable-next-line no-constructor-return
     return makeTransferable(this);
@@ -235,26 +251,9 @@ class Blob {
   slice(start = 0, end = this[kLength], contentType = '') {
     if (!isBlob(this))
       throw new ERR_INVALID_THIS('Blob');
-    if (start < 0) {
-      start = MathMax(this[kLength] + start, 0);
-    } else {
-      start = MathMin(start, this[kLength]);
-    }
-    start |= 0;
-
-    if (end < 0) {
-      end = MathMax(this[kLength] + end, 0);
-    } else {
-      end = MathMin(end, this[kLength]);
-    }
-    end |= 0;
-
-    contentType = `${contentType}`;
-    if (RegExpPrototypeExec(disallowedTypeCharacters, contentType) !== null) {
-      contentType = '';
-    } else {
-      contentType = StringPrototypeToLowerCase(contentType);
-    }
+    start = toPosition(start, this[kLength]);
+    end = toPosition(end, this[kLength]);
+    contentType = normalizeType(contentType);
 
     const span = MathMax(end - start, 0);
 
@@ -278,27 +277,42 @@ class Blob {
     if (this[kArrayBufferPromise])
       return this[kArrayBufferPromise];
 
-    const job = new FixedSizeBlobCopyJob(this[kHandle]);
-
-    const ret = job.run();
-
-    // If the job returns a value immediately, the ArrayBuffer
-    // was generated synchronously and should just be returned
-    // directly.
-    if (ret !== undefined)
-      return PromiseResolve(ret);
-
     const {
       promise,
       resolve,
       reject,
     } = createDeferredPromise();
 
-    job.ondone = (err, ab) => {
-      if (err !== undefined)
-        return reject(new AbortError(undefined, { cause: err }));
-      resolve(ab);
+    // In-memory data is available synchronously and arrives in one piece,
+    // file-backed data is read in chunks that are copied into place.
+    const length = this[kLength];
+    const reader = this[kHandle].getReader();
+    let buffer;
+    let offset = 0;
+    const readNext = () => {
+      reader.pull((status, chunk) => {
+        if (status < 0) {
+          reject(notReadable());
+          return;
+        }
+        if (chunk !== undefined) {
+          if (buffer === undefined && chunk.byteLength === length) {
+            buffer = chunk;
+          } else {
+            buffer ??= new ArrayBuffer(length);
+            TypedArrayPrototypeSet(
+              new Uint8Array(buffer), new Uint8Array(chunk), offset);
+          }
+          offset += chunk.byteLength;
+        }
+        if (status === kStatusEnd)
+          resolve(buffer ?? new ArrayBuffer(0));
+        else
+          readNext();
+      });
     };
+    readNext();
+
     this[kArrayBufferPromise] =
     SafePromisePrototypeFinally(
       promise,
@@ -326,22 +340,30 @@ class Blob {
     if (!isBlob(this))
       throw new ERR_INVALID_THIS('Blob');
 
-    const self = this;
+    const reader = this[kHandle].getReader();
     return new lazyReadableStream({
-      async start() {
-        this[kState] = await self.arrayBuffer();
-        this[kIndex] = 0;
-      },
-
       pull(controller) {
-        if (this[kState].byteLength - this[kIndex] <= kMaxChunkSize) {
-          controller.enqueue(new Uint8Array(this[kState], this[kIndex]));
-          controller.close();
-          this[kState] = undefined;
-        } else {
-          controller.enqueue(new Uint8Array(this[kState], this[kIndex], kMaxChunkSize));
-          this[kIndex] += kMaxChunkSize;
-        }
+        const {
+          promise,
+          resolve,
+          reject,
+        } = createDeferredPromise();
+        reader.pull((status, buffer) => {
+          if (status < 0) {
+            reject(notReadable());
+            return;
+          }
+          if (buffer !== undefined) {
+            for (let n = 0; n < buffer.byteLength; n += kMaxChunkSize) {
+              controller.enqueue(new Uint8Array(
+                buffer, n, MathMin(kMaxChunkSize, buffer.byteLength - n)));
+            }
+          }
+          if (status === kStatusEnd)
+            controller.close();
+          resolve();
+        }, kMaxChunkSize);
+        return promise;
       },
     });
   }
@@ -360,6 +382,14 @@ function createBlob(handle, length, type = '') {
   }, [], Blob));
 }
 
+// Returns a Blob whose data is read from the file at `path` when it is
+// needed. The file is only stat'ed here; the reads of the Blob fail with a
+// NotReadableError if the file has been modified in the meantime.
+function createBlobFromFilePath(path, options) {
+  const { 0: handle, 1: length } = _createBlobFromFilePath(path);
+  return createBlob(handle, length, normalizeType(options?.type ?? ''));
+}
+
 ObjectDefineProperty(Blob.prototype, SymbolToStringTag, {
   __proto__: null,
   configurable: true,
@@ -415,6 +445,7 @@ module.exports = {
   Blob,
   ClonedBlob,
   createBlob,
+  createBlobFromFilePath,
   isBlob,
   kHandle,
   resolveObjectURL,
@@ -2,6 +2,7 @@
 
 const {
   ArrayIsArray,
+  ArrayPrototypePop,
   ArrayPrototypePush,
   ArrayPrototypeReduce,
   ArrayPrototypeSlice,
@@ -19,6 +20,7 @@ const {
 const {
   errnoException,
   codes: {
+    ERR_FEATURE_UNAVAILABLE_ON_PLATFORM,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
     ERR_INVALID_HANDLE_TYPE,
@@ -60,6 +62,10 @@ const { convertToValidSignal, deprecate } = require('internal/util');
 const { isArrayBufferView } = require('internal/util/types');
 const spawn_sync = internalBinding('spawn_sync');
 const { kStateSymbol } = require('internal/dgram');
+const { closeSync } = require('fs');
+const {
+  createSharedMemory,
+} = require('internal/child_process/shared_memory');
 
 const {
   UV_EACCES,
@@ -364,6 +370,10 @@ ChildProcess.prototype.spawn = function(options) {
                 [undefined, 'json', 'advanced']);
   const serialization = options.serialization || 'json';
 
+  validateOneOf(options.ipcTransport, 'options.ipcTransport',
+                [undefined, 'pipe', 'shared-memory']);
+  let sharedMemory;
+
   if (ipc !== undefined) {
     // Let child process know about opened IPC channel
     if (options.envPairs === undefined)
@@ -374,6 +384,19 @@ ChildProcess.prototype.spawn = function(options) {
     ArrayPrototypePush(options.envPairs, `NODE_CHANNEL_FD=${ipcFd}`);
     ArrayPrototypePush(options.envPairs,
                        `NODE_CHANNEL_SERIALIZATION_MODE=${serialization}`);
+
+    if (options.ipcTransport === 'shared-memory') {
+      if (process.platform === 'win32') {
+        throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM(
+          'options.ipcTransport \'shared-memory\'');
+      }
+      // The descriptor of the shared memory object is only passed down to the
+      // child and closed again right after spawning it.
+      sharedMemory = createSharedMemory();
+      ArrayPrototypePush(options.envPairs,
+                         `NODE_CHANNEL_SHM_FD=${stdio.length}`);
+      ArrayPrototypePush(stdio, { type: 'fd', fd: sharedMemory.fd });
+    }
   }
 
   validateString(options.file, 'options.file');
@@ -386,7 +409,15 @@ ChildProcess.prototype.spawn = function(options) {
     this.spawnargs = options.args;
   }
 
-  const err = this._handle.spawn(options);
+  let err;
+  try {
+    err = this._handle.spawn(options);
+  } finally {
+    if (sharedMemory !== undefined) {
+      ArrayPrototypePop(stdio);
+      closeSync(sharedMemory.fd);
+    }
+  }
 
   // Run-time errors should emit an error, not throw an exception.
   if (err === UV_EACCES ||
@@ -467,7 +498,8 @@ ChildProcess.prototype.spawn = function(options) {
                        stdio[i].socket === undefined ? null : stdio[i].socket);
 
   // Add .send() method and start listening for IPC data
-  if (ipc !== undefined) setupChannel(this, ipc, serialization);
+  if (ipc !== undefined)
+    setupChannel(this, ipc, serialization, sharedMemory?.rings);
 
   return err;
 };
@@ -573,7 +605,7 @@ const channelDeprecationMsg = '_channel is deprecated. ' +
                               'Use ChildProcess.channel instead.';
 
 let serialization;
-function setupChannel(target, channel, serializationMode) {
+function setupChannel(target, channel, serializationMode, sharedMemory) {
   const control = new Control(channel);
   target.channel = control;
   target[kChannelHandle] = channel;
@@ -599,8 +631,49 @@ function setupChannel(target, channel, serializationMode) {
     initMessageChannel,
     parseChannelMessages,
     writeChannelMessage,
+    serializeMessage,
+    deserializeMessage,
   } = serialization[serializationMode];
 
+  // With `ipcTransport: 'shared-memory'` messages without a handle are passed
+  // through ring buffers in shared memory, see
+  // internal/child_process/shared_memory. The pipe still carries everything
+  // else, wrapped in NODE_SHM_SYNC messages, and the NODE_SHM_DRAIN wake-ups.
+  let sendRing;
+  let receiveRing;
+  let pipeMessagesReceived = 0;
+  if (sharedMemory !== undefined) {
+    sendRing = sharedMemory[0];
+    receiveRing = sharedMemory[1];
+  }
+
+  function readSharedMemory(until) {
+    for (const bytes of receiveRing.read(until)) {
+      const message = deserializeMessage(bytes);
+      handleMessage(message, undefined, isInternal(message));
+    }
+  }
+
+  // Reads the receive ring until it is empty. Stops early at the position of
+  // a message sent over the pipe that has not been received yet, receiving it
+  // resumes reading.
+  function drainSharedMemory() {
+    do {
+      const head = receiveRing.loadHead();
+      if (receiveRing.pipeMessagesSent() !== pipeMessagesReceived)
+        return;
+      readSharedMemory(head);
+    } while (!receiveRing.wait());
+  }
+
+  function writeSharedMemory(message) {
+    if (!sendRing.write(serializeMessage(message)))
+      return false;
+    if (sendRing.takeWaiting())
+      writeChannelMessage(channel, new WriteWrap(), { cmd: 'NODE_SHM_DRAIN' });
+    return true;
+  }
+
   let pendingHandle = null;
   initMessageChannel(channel);
   channel.pendingHandle = null;
@@ -614,7 +687,20 @@ function setupChannel(target, channel, serializationMode) {
       if (recvHandle)
         pendingHandle = recvHandle;
 
-      for (const message of parseChannelMessages(channel, pool)) {
+      for (let message of parseChannelMessages(channel, pool)) {
+        let synced = false;
+        if (receiveRing !== undefined && isInternal(message)) {
+          if (message.cmd === 'NODE_SHM_DRAIN') {
+            drainSharedMemory();
+            continue;
+          }
+          if (message.cmd === 'NODE_SHM_SYNC') {
+            readSharedMemory(message.until);
+            message = message.msg;
+            synced = true;
+          }
+        }
+
         // There will be at most one NODE_HANDLE message in every chunk we
         // read because SCM_RIGHTS messages don't get coalesced. Make sure
         // that we deliver the handle with the right message however.
@@ -628,8 +714,16 @@ function setupChannel(target, channel, serializationMode) {
         } else {
           handleMessage(message, undefined, false);
         }
+
+        if (synced) {
+          pipeMessagesReceived++;
+          drainSharedMemory();
+        }
       }
     } else {
+      // The other end is gone, everything it has written is there to read.
+      if (receiveRing !== undefined)
+        readSharedMemory(receiveRing.loadHead());
       this.buffering = false;
       target.disconnect();
       channel.onread = nop;
@@ -841,9 +935,25 @@ function setupChannel(target, channel, serializationMode) {
     }
 
     const req = new WriteWrap();
-
-    const err = writeChannelMessage(channel, req, message, handle);
-    const wasAsyncWrite = streamBaseState[kLastWriteWasAsync];
+    let err = 0;
+    let wasAsyncWrite = false;
+
+    if (sendRing === undefined) {
+      err = writeChannelMessage(channel, req, message, handle);
+      wasAsyncWrite = streamBaseState[kLastWriteWasAsync];
+    } else if (handle || !writeSharedMemory(message)) {
+      // Messages with a handle and the ones the ring has no room for take
+      // the pipe. The receiver reads the ring up to `until` first.
+      const sync = {
+        cmd: 'NODE_SHM_SYNC',
+        until: sendRing.beginPipeSend(),
+        msg: message,
+      };
+      err = writeChannelMessage(channel, req, sync, handle);
+      wasAsyncWrite = streamBaseState[kLastWriteWasAsync];
+      if (err !== 0)
+        sendRing.cancelPipeSend();
+    }
 
     if (err === 0) {
       if (handle) {
@@ -126,6 +126,22 @@ const advanced = {
 
     return result;
   },
+
+  // Used by the shared memory transport, which frames messages itself.
+  serializeMessage(message) {
+    const ser = new ChildProcessSerializer();
+    ser.writeHeader();
+    ser.writeValue(message);
+    return ser.releaseBuffer();
+  },
+
+  deserializeMessage(bytes) {
+    // Typed arrays in the message are views of the buffer they are read from,
+    // which must not be the shared memory.
+    const deserializer = new ChildProcessDeserializer(Buffer.from(bytes));
+    deserializer.readHeader();
+    return deserializer.readValue();
+  },
 };
 
 const json = {
@@ -159,6 +175,14 @@ const json = {
     const string = JSONStringify(message) + '\n';
     return channel.writeUtf8String(req, string, handle);
   },
+
+  serializeMessage(message) {
+    return Buffer.from(JSONStringify(message));
+  },
+
+  deserializeMessage(bytes) {
+    return JSONParse(bytes.utf8Slice(0, bytes.length));
+  },
 };
 
 module.exports = { advanced, json };
@@ -0,0 +1,195 @@
+'use strict';
+
+const {
+  AtomicsAdd,
+  AtomicsExchange,
+  AtomicsLoad,
+  AtomicsStore,
+  Int32Array,
+  TypedArrayPrototypeSet,
+} = primordials;
+
+const { FastBuffer } = require('internal/buffer');
+const { errnoException } = require('internal/errors');
+const { closeSync } = require('fs');
+const binding = internalBinding('process_wrap');
+
+// Layout of an IPC channel with `ipcTransport: 'shared-memory'`: the shared
+// memory object holds two single-producer single-consumer ring buffers, the
+// first one carries messages from the parent to the child, the second one
+// the other way around. Each ring starts with a header of int32 fields,
+// followed by the message records. A record is the int32 byte length of the
+// message followed by the message itself, padded to a multiple of 4 bytes.
+// A record never wraps around the end of the ring; kWrapMarker in place of
+// the length means that the next record starts at the beginning.
+//
+// Positions are byte counts that only ever grow (modulo 2 ** 32). The
+// producer owns kHead, the consumer owns kTail. The consumer sets kWaiting
+// before it goes idle; a producer that resets it has to ring the doorbell,
+// i.e. send a NODE_SHM_DRAIN message over the pipe.
+//
+// Messages that cannot go through the ring (the ones with a handle, or the
+// ones that do not fit) are sent over the pipe. The producer counts them in
+// kPipeSent before writing them, and the consumer does not read past the
+// position where such a message was sent before it has received it, see
+// setupChannel() in internal/child_process.
+const kHead = 0;
+const kTail = 1;
+const kWaiting = 2;
+const kPipeSent = 3;
+const kHeaderSize = 16;
+const kWrapMarker = -1;
+
+const kRingSize = 1024 * 1024;
+
+class SharedMemoryRing {
+  constructor(buffer, byteOffset, byteLength) {
+    const capacity = byteLength - kHeaderSize;
+    this.state = new Int32Array(buffer, byteOffset, kHeaderSize / 4);
+    this.data = new FastBuffer(buffer, byteOffset + kHeaderSize, capacity);
+    this.lengths = new Int32Array(buffer, byteOffset + kHeaderSize,
+                                  capacity / 4);
+    this.capacity = capacity;
+    this.mask = capacity - 1;
+    // Local copies of the position owned by this end.
+    this.head = AtomicsLoad(this.state, kHead);
+    this.tail = AtomicsLoad(this.state, kTail);
+  }
+
+  // Producer side. Returns false if `bytes` does not fit at the moment.
+  write(bytes) {
+    const length = bytes.length;
+    const size = 4 + ((length + 3) & ~3);
+    if (size > this.capacity / 2)
+      return false;
+
+    const head = this.head;
+    const used = (head - AtomicsLoad(this.state, kTail)) | 0;
+    let offset = head & this.mask;
+    const skip = offset + size > this.capacity ? this.capacity - offset : 0;
+    if (used + skip + size > this.capacity)
+      return false;
+
+    if (skip !== 0) {
+      this.lengths[offset >> 2] = kWrapMarker;
+      offset = 0;
+    }
+    this.lengths[offset >> 2] = length;
+    TypedArrayPrototypeSet(this.data, bytes, offset + 4);
+
+    this.head = (head + skip + size) | 0;
+    AtomicsStore(this.state, kHead, this.head);
+    return true;
+  }
+
+  // Producer side. Whether the consumer has to be woken up.
+  takeWaiting() {
+    return AtomicsExchange(this.state, kWaiting, 0) === 1;
+  }
+
+  // Producer side. Called before a message is sent over the pipe instead,
+  // returns the position the consumer has to read up to before handling it.
+  beginPipeSend() {
+    AtomicsAdd(this.state, kPipeSent, 1);
+    return this.head;
+  }
+
+  // Producer side. Called if sending the message over the pipe failed.
+  cancelPipeSend() {
+    AtomicsAdd(this.state, kPipeSent, -1);
+  }
+
+  // Consumer side.
+  loadHead() {
+    return AtomicsLoad(this.state, kHead);
+  }
+
+  // Consumer side. The number of messages the producer sent over the pipe.
+  // Has to be checked after loadHead() to cover the messages up to its result.
+  pipeMessagesSent() {
+    return AtomicsLoad(this.state, kPipeSent);
+  }
+
+  // Consumer side. Yields the messages written before position `until`.
+  // Every yielded view is only valid until the iteration continues.
+  *read(until) {
+    let tail = this.tail;
+    while (((until - tail) | 0) > 0) {
+      let offset = tail & this.mask;
+      let length = this.lengths[offset >> 2];
+      if (length === kWrapMarker) {
+        tail = (tail + this.capacity - offset) | 0;
+        offset = 0;
+        length = this.lengths[0];
+      }
+      yield this.data.subarray(offset + 4, offset + 4 + length);
+      tail = (tail + 4 + ((length + 3) & ~3)) | 0;
+      this.tail = tail;
+      AtomicsStore(this.state, kTail, tail);
+    }
+  }
+
+  // Consumer side. Marks the consumer as idle. Returns false if messages
+  // arrived in the meantime that no doorbell is going to be sent for, in which
+  // case the caller has to keep reading.
+  wait() {
+    AtomicsStore(this.state, kWaiting, 1);
+    if (AtomicsLoad(this.state, kHead) === this.tail)
+      return true;
+    return AtomicsExchange(this.state, kWaiting, 0) === 0;
+  }
+}
+
+function initRingState(buffer, byteOffset) {
+  const state = new Int32Array(buffer, byteOffset, kHeaderSize / 4);
+  AtomicsStore(state, kWaiting, 1);
+}
+
+// Returns the [sendRing, receiveRing] pair for one end of the channel.
+function openRings(buffer, isParent) {
+  const ringSize = buffer.byteLength / 2;
+  const first = new SharedMemoryRing(buffer, 0, ringSize);
+  const second = new SharedMemoryRing(buffer, ringSize, ringSize);
+  return isParent ? [first, second] : [second, first];
+}
+
+function mapSharedMemory(fd) {
+  const buffer = binding.mapSharedMemory(fd);
+  if (typeof buffer === 'number')
+    throw errnoException(buffer, 'mmap');
+  return buffer;
+}
+
+// Parent side. Returns the file descriptor to pass to the child and the rings
+// of the parent's end of the channel.
+function createSharedMemory() {
+  const size = 2 * (kHeaderSize + kRingSize);
+  const fd = binding.createSharedMemory(size);
+  if (fd < 0)
+    throw errnoException(fd, 'createSharedMemory');
+  let buffer;
+  try {
+    buffer = mapSharedMemory(fd);
+  } catch (err) {
+    closeSync(fd);
+    throw err;
+  }
+  initRingState(buffer, 0);
+  initRingState(buffer, size / 2);
+  return { fd, rings: openRings(buffer, true) };
+}
+
+// Child side. Returns the rings of the child's end of the channel. The file
+// descriptor is closed, the mapping stays valid.
+function openSharedMemory(fd) {
+  try {
+    return openRings(mapSharedMemory(fd), false);
+  } finally {
+    closeSync(fd);
+  }
+}
+
+module.exports = {
+  createSharedMemory,
+  openSharedMemory,
+};
@@ -16,6 +16,7 @@ const { owner_symbol } = require('internal/async_hooks').symbols;
 const Worker = require('internal/cluster/worker');
 const { internal, sendHelper } = require('internal/cluster/utils');
 const { TIMEOUT_MAX } = require('internal/timers');
+const { constants: TCPConstants } = internalBinding('tcp_wrap');
 const { setInterval, clearInterval } = require('timers');
 
 const cluster = new EventEmitter();
@@ -107,6 +108,9 @@ cluster._getServer = function(obj, options, cb) {
     if (handle) {
       // Shared listen socket
       shared(reply, { handle, indexesKey, index }, cb);
+    } else if (reply.reusePort) {
+      // Listen socket of our own, balanced by the kernel.
+      reusePort(reply, message, { indexesKey, index }, cb);
     } else {
       // Round-robin.
       rr(reply, { indexesKey, index }, cb);
@@ -156,6 +160,28 @@ function shared(message, { handle, indexesKey, index }, cb) {
   cb(message.errno, handle);
 }
 
+// SO_REUSEPORT. The worker binds a listen socket of its own to the port that
+// the primary reserved.
+function reusePort(reply, { address, addressType, fd, flags },
+                   { indexesKey, index }, cb) {
+  if (reply.errno)
+    return cb(reply.errno, null);
+
+  const key = reply.key;
+  const net = require('net');
+  const handle = net._createServerHandle(address, reply.sockname.port,
+                                         addressType, fd,
+                                         flags | TCPConstants.REUSEPORT);
+
+  if (typeof handle === 'number') {
+    send({ act: 'close', key });
+    removeIndexesKey(indexesKey, index);
+    return cb(handle, null);
+  }
+
+  shared(reply, { handle, indexesKey, index }, cb);
+}
+
 // Round-robin. Master distributes handles across workers.
 function rr(message, { indexesKey, index }, cb) {
   if (message.errno)
@@ -19,6 +19,7 @@ const assert = require('internal/assert');
 const { fork } = require('child_process');
 const path = require('path');
 const EventEmitter = require('events');
+const ReusePortHandle = require('internal/cluster/reuseport_handle');
 const RoundRobinHandle = require('internal/cluster/round_robin_handle');
 const SharedHandle = require('internal/cluster/shared_handle');
 const Worker = require('internal/cluster/worker');
@@ -28,6 +29,7 @@ const cluster = new EventEmitter();
 const intercom = new EventEmitter();
 const SCHED_NONE = 1;
 const SCHED_RR = 2;
+const SCHED_REUSEPORT = 3;
 
 module.exports = cluster;
 
@@ -40,6 +42,7 @@ cluster.workers = {};
 cluster.settings = {};
 cluster.SCHED_NONE = SCHED_NONE;  // Leave it to the operating system.
 cluster.SCHED_RR = SCHED_RR;      // Primary distributes connections.
+cluster.SCHED_REUSEPORT = SCHED_REUSEPORT;  // Workers listen with SO_REUSEPORT.
 
 let ids = 0;
 let initialized = false;
@@ -50,6 +53,8 @@ if (schedulingPolicy === 'rr')
   schedulingPolicy = SCHED_RR;
 else if (schedulingPolicy === 'none')
   schedulingPolicy = SCHED_NONE;
+else if (schedulingPolicy === 'reuseport')
+  schedulingPolicy = SCHED_REUSEPORT;
 else if (process.platform === 'win32') {
   // Round-robin doesn't perform well on
   // Windows due to the way IOCP is wired up.
@@ -87,7 +92,8 @@ cluster.setupPrimary = function(options) {
 
   initialized = true;
   schedulingPolicy = cluster.schedulingPolicy;  // Freeze policy.
-  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR,
+  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR ||
+         schedulingPolicy === SCHED_REUSEPORT,
          `Bad cluster.schedulingPolicy: ${schedulingPolicy}`);
 
   process.nextTick(setupSettingsNT, settings);
@@ -130,6 +136,7 @@ function createWorkerProcess(id, env) {
     cwd: cluster.settings.cwd,
     env: workerEnv,
     serialization: cluster.settings.serialization,
+    ipcTransport: cluster.settings.ipcTransport,
     silent: cluster.settings.silent,
     windowsHide: cluster.settings.windowsHide,
     execArgv: execArgv,
@@ -290,12 +297,17 @@ function queryServer(worker, message) {
     // UDP is exempt from round-robin connection balancing for what should
     // be obvious reasons: it's connectionless. There is nothing to send to
     // the workers except raw datagrams and that's pointless.
-    if (schedulingPolicy !== SCHED_RR ||
-        message.addressType === 'udp4' ||
-        message.addressType === 'udp6') {
-      handle = new SharedHandle(key, address, message);
-    } else {
+    // SO_REUSEPORT is only used for TCP ports, pipes and file descriptors
+    // are shared instead.
+    const isUDP = message.addressType === 'udp4' ||
+                  message.addressType === 'udp6';
+    if (schedulingPolicy === SCHED_RR && !isUDP) {
       handle = new RoundRobinHandle(key, address, message);
+    } else if (schedulingPolicy === SCHED_REUSEPORT && !isUDP &&
+               message.port >= 0 && !(message.fd >= 0)) {
+      handle = new ReusePortHandle(key, address, message);
+    } else {
+      handle = new SharedHandle(key, address, message);
     }
 
     handles.set(key, handle);
@@ -0,0 +1,53 @@
+'use strict';
+const { SafeMap } = primordials;
+const assert = require('internal/assert');
+const net = require('net');
+const { constants } = internalBinding('tcp_wrap');
+
+module.exports = ReusePortHandle;
+
+// Each worker binds and listens on a socket of its own with SO_REUSEPORT set,
+// and the kernel balances incoming connections across their accept queues.
+// The primary only binds (but does not listen on) a socket of its own, which
+// resolves the port for `listen(0)` and keeps it reserved for the workers.
+// Bound sockets that do not listen are never handed connections.
+function ReusePortHandle(key, address, { port, addressType, fd, flags }) {
+  this.key = key;
+  this.workers = new SafeMap();
+  this.handle = null;
+  this.errno = 0;
+  this.sockname = null;
+
+  const rval = net._createServerHandle(address, port, addressType, fd,
+                                       flags | constants.REUSEPORT);
+
+  if (typeof rval === 'number') {
+    this.errno = rval;
+  } else {
+    this.handle = rval;
+    this.sockname = {};
+    this.errno = this.handle.getsockname(this.sockname);
+  }
+}
+
+ReusePortHandle.prototype.add = function(worker, send) {
+  assert(!this.workers.has(worker.id));
+  this.workers.set(worker.id, worker);
+  send(this.errno, { reusePort: true, sockname: this.sockname }, null);
+};
+
+ReusePortHandle.prototype.remove = function(worker) {
+  if (!this.workers.has(worker.id))
+    return false;
+
+  this.workers.delete(worker.id);
+
+  if (this.workers.size !== 0)
+    return false;
+
+  if (this.handle !== null) {
+    this.handle.close();
+    this.handle = null;
+  }
+  return true;
+};
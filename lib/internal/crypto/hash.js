@@ -1,6 +1,11 @@
 'use strict';
 
 const {
+  Array,
+  ArrayPrototypePush,
+  ArrayPrototypeSlice,
+  MathCeil,
+  MathMin,
   ObjectSetPrototypeOf,
   ReflectApply,
   Symbol,
@@ -9,8 +14,10 @@ const {
 const {
   Hash: _Hash,
   HashJob,
+  HashManyJob,
   Hmac: _Hmac,
   kCryptoJobAsync,
+  kCryptoJobSync,
 } = internalBinding('crypto');
 
 const {
@@ -27,6 +34,7 @@ const {
 } = require('internal/crypto/keys');
 
 const {
+  kEmptyObject,
   lazyDOMException,
 } = require('internal/util');
 
@@ -43,12 +51,17 @@ const {
 } = require('internal/errors');
 
 const {
+  validateArray,
   validateEncoding,
+  validateFunction,
+  validateInteger,
+  validateObject,
   validateString,
   validateUint32,
 } = require('internal/validators');
 
 const {
+  isAnyArrayBuffer,
   isArrayBufferView,
 } = require('internal/util/types');
 
@@ -163,6 +176,117 @@ Hmac.prototype.digest = function digest(outputEncoding) {
 Hmac.prototype._flush = Hash.prototype._flush;
 Hmac.prototype._transform = Hash.prototype._transform;
 
+// Implementation of crypto.hashMany() and crypto.hashManySync(). Each
+// HashManyJob digests a list of inputs with a single EVP_MD_CTX and returns
+// the concatenated digests, which are exposed as views of one Buffer.
+
+function checkHashMany(algorithm, data, options) {
+  validateString(algorithm, 'algorithm');
+  validateArray(data, 'data');
+  for (let i = 0; i < data.length; i++) {
+    if (!isArrayBufferView(data[i]) && !isAnyArrayBuffer(data[i])) {
+      throw new ERR_INVALID_ARG_TYPE(
+        `data[${i}]`,
+        ['ArrayBuffer', 'Buffer', 'TypedArray', 'DataView'],
+        data[i]);
+    }
+  }
+
+  validateObject(options, 'options');
+  const {
+    outputLength,
+    outputEncoding = 'buffer',
+    concurrency = 1,
+  } = options;
+  if (outputLength !== undefined)
+    validateUint32(outputLength, 'options.outputLength');
+  validateString(outputEncoding, 'options.outputEncoding');
+  validateInteger(concurrency, 'options.concurrency', 1, 128);
+
+  return {
+    // The job expects the XOF output length in bits.
+    length: outputLength !== undefined ? outputLength * 8 : undefined,
+    outputEncoding,
+    concurrency,
+  };
+}
+
+function splitDigests(result, count, digests, outputEncoding) {
+  if (count === 0)
+    return;
+  const buf = Buffer.from(result);
+  const length = buf.length / count;
+  for (let i = 0; i < count; i++) {
+    const digest = buf.subarray(i * length, (i + 1) * length);
+    ArrayPrototypePush(
+      digests,
+      outputEncoding === 'buffer' ? digest : digest.toString(outputEncoding));
+  }
+}
+
+function hashManySync(algorithm, data, options = kEmptyObject) {
+  const {
+    length,
+    outputEncoding,
+  } = checkHashMany(algorithm, data, options);
+
+  const job = new HashManyJob(kCryptoJobSync, algorithm, data, length);
+  const { 0: err, 1: result } = job.run();
+  if (err !== undefined)
+    throw err;
+
+  const digests = [];
+  splitDigests(result, data.length, digests, outputEncoding);
+  return digests;
+}
+
+function hashMany(algorithm, data, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = kEmptyObject;
+  }
+
+  const {
+    length,
+    outputEncoding,
+    concurrency,
+  } = checkHashMany(algorithm, data, options);
+  validateFunction(callback, 'callback');
+
+  // Split the inputs into up to `concurrency` contiguous slices so that the
+  // jobs can run in parallel on the threadpool.
+  const jobs = MathMin(concurrency, data.length) || 1;
+  const sliceLength = MathCeil(data.length / jobs);
+  const results = new Array(jobs);
+  let pending = jobs;
+  let failed = false;
+
+  for (let i = 0; i < jobs; i++) {
+    const slice = jobs === 1 ?
+      data :
+      ArrayPrototypeSlice(data, i * sliceLength, (i + 1) * sliceLength);
+    const job = new HashManyJob(kCryptoJobAsync, algorithm, slice, length);
+    job.ondone = (err, result) => {
+      if (failed)
+        return;
+      if (err !== undefined) {
+        failed = true;
+        return callback(err);
+      }
+      results[i] = { result, count: slice.length };
+      if (--pending !== 0)
+        return;
+      const digests = [];
+      for (let j = 0; j < jobs; j++) {
+        splitDigests(results[j].result, results[j].count, digests,
+                     outputEncoding);
+      }
+      callback(null, digests);
+    };
+    job.run();
+  }
+}
+
 // Implementation for WebCrypto subtle.digest()
 
 async function asyncDigest(algorithm, data) {
@@ -189,4 +313,6 @@ module.exports = {
   Hash,
   Hmac,
   asyncDigest,
+  hashMany,
+  hashManySync,
 };
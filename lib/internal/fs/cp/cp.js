@@ -10,6 +10,7 @@ const {
   PromiseReject,
   SafePromiseAll,
   StringPrototypeSplit,
+  Symbol,
 } = primordials;
 const {
   codes: {
@@ -23,8 +24,12 @@ const {
     ERR_FS_CP_UNKNOWN,
     ERR_FS_EISDIR,
   },
+  uvException,
 } = require('internal/errors');
 const {
+  fs: {
+    COPYFILE_FICLONE,
+  },
   os: {
     errno: {
       EEXIST,
@@ -34,6 +39,8 @@ const {
     },
   },
 } = internalBinding('constants');
+const { CopyTree } = internalBinding('fs');
+const { createDeferredPromise } = require('internal/util');
 const {
   chmod,
   copyFile,
@@ -55,6 +62,29 @@ const {
   sep,
 } = require('path');
 
+// Keep in sync with CopyTree::Flags in src/node_copy_tree.h.
+const kCopyTreeDereference = 1 << 0;
+const kCopyTreeErrorOnExist = 1 << 1;
+const kCopyTreeForce = 1 << 2;
+const kCopyTreePreserveTimestamps = 1 << 3;
+const kCopyTreeReportProgress = 1 << 4;
+
+// Keep in sync with CopyTree::Error in src/node_copy_tree.h.
+const kCopyTreeSame = 1;
+const kCopyTreeDirToNonDir = 2;
+const kCopyTreeNonDirToDir = 3;
+const kCopyTreeExists = 4;
+const kCopyTreeSocket = 5;
+const kCopyTreeFifoPipe = 6;
+const kCopyTreeUnknownType = 7;
+const kCopyTreeLinkFailed = 8;
+
+// The number of requests a tree copy keeps on the threadpool, which is the
+// default size of the libuv threadpool.
+const kCopyTreeConcurrency = 4;
+
+const kProgress = Symbol('kProgress');
+
 async function cpFn(src, dest, opts) {
   // Warn about using preserveTimestamps on 32-bit node
   if (opts.preserveTimestamps && process.arch === 'ia32') {
@@ -209,7 +239,8 @@ async function getStatsForCopy(destStat, src, dest, opts) {
             srcStat.isBlockDevice()) {
     return onFile(srcStat, destStat, src, dest, opts);
   } else if (srcStat.isSymbolicLink()) {
-    return onLink(destStat, src, dest, opts);
+    await onLink(destStat, src, dest, opts);
+    return reportProgress(opts, 0);
   } else if (srcStat.isSocket()) {
     throw new ERR_FS_CP_SOCKET({
       message: `cannot copy a socket file: ${dest}`,
@@ -257,11 +288,13 @@ async function mayCopyFile(srcStat, src, dest, opts) {
 }
 
 async function _copyFile(srcStat, src, dest, opts) {
-  await copyFile(src, dest, opts.mode);
+  await copyFile(src, dest, opts.mode | COPYFILE_FICLONE);
   if (opts.preserveTimestamps) {
-    return handleTimestampsAndMode(srcStat.mode, src, dest);
+    await handleTimestampsAndMode(srcStat.mode, src, dest);
+  } else {
+    await setDestMode(dest, srcStat.mode);
   }
-  return setDestMode(dest, srcStat.mode);
+  reportProgress(opts, srcStat.size);
 }
 
 async function handleTimestampsAndMode(srcMode, src, dest) {
@@ -300,9 +333,15 @@ async function setDestTimestamps(src, dest) {
   return utimes(dest, updatedSrcStat.atime, updatedSrcStat.mtime);
 }
 
-function onDir(srcStat, destStat, src, dest, opts) {
-  if (!destStat) return mkDirAndCopy(srcStat.mode, src, dest, opts);
-  return copyDir(src, dest, opts);
+async function onDir(srcStat, destStat, src, dest, opts) {
+  // Without a filter the whole tree is copied natively.
+  if (opts.filter === undefined) return copyTree(src, dest, opts);
+  if (!destStat) {
+    await mkDirAndCopy(srcStat.mode, src, dest, opts);
+  } else {
+    await copyDir(src, dest, opts);
+  }
+  reportProgress(opts, 0);
 }
 
 async function mkDirAndCopy(srcMode, src, dest, opts) {
@@ -376,6 +415,127 @@ async function copyLink(resolvedSrc, dest) {
   return symlink(resolvedSrc, dest);
 }
 
+function reportProgress(opts, bytes) {
+  const { onProgress } = opts;
+  if (onProgress === undefined) return;
+  const progress = opts[kProgress] ??= { entries: 0, bytes: 0 };
+  progress.entries++;
+  progress.bytes += bytes;
+  onProgress({ entries: progress.entries, bytes: progress.bytes });
+}
+
+function copyTreeError(status, src, dest) {
+  switch (status) {
+    case kCopyTreeSame:
+      return new ERR_FS_CP_EINVAL({
+        message: 'src and dest cannot be the same',
+        path: dest,
+        syscall: 'cp',
+        errno: EINVAL,
+        code: 'EINVAL',
+      });
+    case kCopyTreeDirToNonDir:
+      return new ERR_FS_CP_DIR_TO_NON_DIR({
+        message: `cannot overwrite directory ${src} ` +
+            `with non-directory ${dest}`,
+        path: dest,
+        syscall: 'cp',
+        errno: EISDIR,
+        code: 'EISDIR',
+      });
+    case kCopyTreeNonDirToDir:
+      return new ERR_FS_CP_NON_DIR_TO_DIR({
+        message: `cannot overwrite non-directory ${src} ` +
+            `with directory ${dest}`,
+        path: dest,
+        syscall: 'cp',
+        errno: ENOTDIR,
+        code: 'ENOTDIR',
+      });
+    case kCopyTreeExists:
+      return new ERR_FS_CP_EEXIST({
+        message: `${dest} already exists`,
+        path: dest,
+        syscall: 'cp',
+        errno: EEXIST,
+        code: 'EEXIST',
+      });
+    case kCopyTreeSocket:
+      return new ERR_FS_CP_SOCKET({
+        message: `cannot copy a socket file: ${dest}`,
+        path: dest,
+        syscall: 'cp',
+        errno: EINVAL,
+        code: 'EINVAL',
+      });
+    case kCopyTreeFifoPipe:
+      return new ERR_FS_CP_FIFO_PIPE({
+        message: `cannot copy a FIFO pipe: ${dest}`,
+        path: dest,
+        syscall: 'cp',
+        errno: EINVAL,
+        code: 'EINVAL',
+      });
+    case kCopyTreeUnknownType:
+    default:
+      return new ERR_FS_CP_UNKNOWN({
+        message: `cannot copy an unknown file type: ${dest}`,
+        path: dest,
+        syscall: 'cp',
+        errno: EINVAL,
+        code: 'EINVAL',
+      });
+  }
+}
+
+// Copies the directory `src` to `dest` natively. The directories are walked
+// and the files copied with several requests on the threadpool at a time,
+// only symbolic links are copied by onLink().
+function copyTree(src, dest, opts) {
+  const { promise, resolve: resolvePromise, reject } = createDeferredPromise();
+  let flags = 0;
+  if (opts.dereference) flags |= kCopyTreeDereference;
+  if (opts.errorOnExist) flags |= kCopyTreeErrorOnExist;
+  if (opts.force) flags |= kCopyTreeForce;
+  if (opts.preserveTimestamps) flags |= kCopyTreePreserveTimestamps;
+  if (opts.onProgress !== undefined) flags |= kCopyTreeReportProgress;
+
+  // Files are cloned where the filesystem supports it.
+  const job = new CopyTree(src, dest, flags, opts.mode | COPYFILE_FICLONE,
+                           kCopyTreeConcurrency);
+  let linkError;
+  job.onlink = (id, linkSrc, linkDest, destExists) => {
+    PromisePrototypeThen(
+      onLink(destExists || null, linkSrc, linkDest, opts),
+      () => job.linkDone(id, true),
+      (err) => {
+        linkError ??= err;
+        job.linkDone(id, false);
+      });
+  };
+  job.onprogress = (entries, bytes) => {
+    opts.onProgress({ entries, bytes });
+  };
+  job.ondone = (status, syscall, errorPath, errorDest) => {
+    if (status === 0) {
+      resolvePromise();
+    } else if (status === kCopyTreeLinkFailed) {
+      reject(linkError);
+    } else if (status < 0) {
+      reject(uvException({
+        errno: status,
+        syscall,
+        path: errorPath,
+        dest: errorDest,
+      }));
+    } else {
+      reject(copyTreeError(status, errorPath, errorDest));
+    }
+  };
+  job.start();
+  return promise;
+}
+
 module.exports = {
   areIdentical,
   cpFn,
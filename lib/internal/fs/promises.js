@@ -55,6 +55,7 @@ const {
   emitRecursiveRmdirWarning,
   getDirents,
   getOptions,
+  getRecursiveDirents,
   getStatFsFromBinding,
   getStatsFromBinding,
   getValidatedPath,
@@ -94,6 +95,8 @@ const { watch } = require('internal/fs/watchers');
 const { isIterable } = require('internal/streams/utils');
 const assert = require('internal/assert');
 
+const isWindows = process.platform === 'win32';
+
 const kHandle = Symbol('kHandle');
 const kFd = Symbol('kFd');
 const kRefs = Symbol('kRefs');
@@ -764,6 +767,18 @@ async function mkdir(path, options) {
 }
 
 async function readdirRecursive(originalPath, options) {
+  if (!isWindows) {
+    const result = await binding.readdirRecursive(
+      pathModule.toNamespacedPath(originalPath),
+      options.encoding,
+      !!options.withFileTypes,
+      kUsePromises,
+    );
+    return options.withFileTypes ?
+      getRecursiveDirents(originalPath, result) :
+      result;
+  }
+
   const result = [];
   const queue = [
     [
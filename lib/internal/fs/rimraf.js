@@ -13,6 +13,8 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
+const binding = internalBinding('fs');
+const { FSReqCallback } = binding;
 const fs = require('fs');
 const {
   chmod,
@@ -28,6 +30,7 @@ const {
   unlink,
   unlinkSync,
 } = fs;
+const { handleErrorFromBinding } = require('internal/fs/utils');
 const { sep } = require('path');
 const { setTimeout } = require('timers');
 const { sleep } = require('internal/util');
@@ -43,13 +46,14 @@ const separator = Buffer.from(sep);
 
 function rimraf(path, options, callback) {
   let retries = 0;
+  const remove = isWindows ? _rimraf : _rmTree;
 
-  _rimraf(path, options, function CB(err) {
+  remove(path, options, function CB(err) {
     if (err) {
       if (retryErrorCodes.has(err.code) && retries < options.maxRetries) {
         retries++;
         const delay = retries * options.retryDelay;
-        return setTimeout(_rimraf, delay, path, options, CB);
+        return setTimeout(remove, delay, path, options, CB);
       }
 
       // The file is already gone.
@@ -62,6 +66,16 @@ function rimraf(path, options, callback) {
 }
 
 
+// Removes the whole tree with a single request, the traversal runs on one
+// threadpool thread. Windows keeps the per-entry implementation below for its
+// EPERM workarounds.
+function _rmTree(path, options, callback) {
+  const req = new FSReqCallback();
+  req.oncomplete = callback;
+  binding.rmTree(path, req);
+}
+
+
 function _rimraf(path, options, callback) {
   // SunOS lets the root user unlink directories. Use lstat here to make sure
   // it's not a directory.
@@ -174,6 +188,9 @@ function rimrafPromises(path, options) {
 
 
 function rimrafSync(path, options) {
+  if (!isWindows)
+    return _rmTreeSync(path, options);
+
   let stats;
 
   try {
@@ -206,6 +223,24 @@ function rimrafSync(path, options) {
 }
 
 
+function _rmTreeSync(path, options) {
+  const tries = options.maxRetries + 1;
+
+  for (let i = 1; i <= tries; i++) {
+    try {
+      const ctx = { path };
+      binding.rmTree(path, undefined, ctx);
+      return handleErrorFromBinding(ctx);
+    } catch (err) {
+      if (!retryErrorCodes.has(err.code) || i === tries)
+        throw err;
+      if (options.retryDelay > 0)
+        sleep(i * options.retryDelay);
+    }
+  }
+}
+
+
 function _unlinkSync(path, options) {
   const tries = options.maxRetries + 1;
 
@@ -290,6 +290,21 @@ function getDirents(path, { 0: names, 1: types }, callback) {
   }
 }
 
+// Turns the [names, types, parents, dirs] result of
+// binding.readdirRecursive() into Dirents. `dirs` holds the directories
+// relative to `path`, and `parents[i]` indexes the directory of entry `i`.
+function getRecursiveDirents(path, { 0: names, 1: types, 2: parents, 3: dirs }) {
+  const dirPaths = [path];
+  for (let i = 1; i < dirs.length; i++) {
+    dirPaths[i] = join(path, dirs[i]);
+  }
+  const len = names.length;
+  for (let i = 0; i < len; i++) {
+    names[i] = getDirent(dirPaths[parents[i]], names[i], types[i]);
+  }
+  return names;
+}
+
 function getDirent(path, name, type, callback) {
   if (typeof callback === 'function') {
     if (type === UV_DIRENT_UNKNOWN) {
@@ -792,6 +807,9 @@ const validateCpOptions = hideStackFrames((options) => {
   if (options.filter !== undefined) {
     validateFunction(options.filter, 'options.filter');
   }
+  if (options.onProgress !== undefined) {
+    validateFunction(options.onProgress, 'options.onProgress');
+  }
   return options;
 });
 
@@ -957,6 +975,7 @@ module.exports = {
   getDirent,
   getDirents,
   getOptions,
+  getRecursiveDirents,
   getValidatedFd,
   getValidatedPath,
   getValidMode,
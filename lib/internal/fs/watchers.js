@@ -1,6 +1,8 @@
 'use strict';
 
 const {
+  ArrayPrototypePush,
+  ArrayPrototypeShift,
   FunctionPrototypeCall,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
@@ -24,7 +26,12 @@ const {
   StatWatcher: _StatWatcher,
 } = internalBinding('fs');
 
-const { FSEvent } = internalBinding('fs_event_wrap');
+// RecursiveFSEvent is only available on Linux, where FSEvent cannot watch
+// recursively.
+const { FSEvent, RecursiveFSEvent } = internalBinding('fs_event_wrap');
+const kCanWatchRecursively = process.platform === 'darwin' ||
+                             process.platform === 'win32' ||
+                             RecursiveFSEvent !== undefined;
 const { UV_ENOSPC } = internalBinding('uv');
 const { EventEmitter } = require('events');
 
@@ -187,13 +194,11 @@ StatWatcher.prototype.unref = function() {
 };
 
 
-function FSWatcher() {
+// On Linux, recursive watchers use a RecursiveFSEvent instead of an FSEvent.
+function FSWatcher(recursive = false) {
   FunctionPrototypeCall(EventEmitter, this);
 
-  this._handle = new FSEvent();
-  this._handle[owner_symbol] = this;
-
-  this._handle.onchange = (status, eventType, filename) => {
+  const onchange = (status, eventType, filename) => {
     // TODO(joyeecheung): we may check self._handle.initialized here
     // and return if that is false. This allows us to avoid firing the event
     // after the handle is closed, and to fire both UV_RENAME and UV_CHANGE
@@ -215,6 +220,17 @@ function FSWatcher() {
       this.emit('change', eventType, filename);
     }
   };
+
+  if (recursive && RecursiveFSEvent !== undefined) {
+    this._handle = new RecursiveFSEvent();
+    this._handle.onchange = recursiveOnChange(onchange, () => {
+      return this._handle !== null;
+    });
+  } else {
+    this._handle = new FSEvent();
+    this._handle.onchange = onchange;
+  }
+  this._handle[owner_symbol] = this;
 }
 ObjectSetPrototypeOf(FSWatcher.prototype, EventEmitter.prototype);
 ObjectSetPrototypeOf(FSWatcher, EventEmitter);
@@ -232,17 +248,22 @@ FSWatcher.prototype[kFSWatchStart] = function(filename,
   if (this._handle === null) {  // closed
     return;
   }
-  assert(this._handle instanceof FSEvent, 'handle must be a FSEvent');
+  assert(isFSEventHandle(this._handle), 'handle must be a FSEvent');
   if (this._handle.initialized) {  // already started
     return;
   }
 
   filename = getValidatedPath(filename, 'filename');
 
-  const err = this._handle.start(toNamespacedPath(filename),
-                                 persistent,
-                                 recursive,
-                                 encoding);
+  let err;
+  if (isRecursiveFSEventHandle(this._handle)) {
+    err = this._handle.start(toNamespacedPath(filename), persistent, encoding);
+  } else {
+    err = this._handle.start(toNamespacedPath(filename),
+                             persistent,
+                             recursive,
+                             encoding);
+  }
   if (err) {
     const error = uvException({
       errno: err,
@@ -256,6 +277,31 @@ FSWatcher.prototype[kFSWatchStart] = function(filename,
   }
 };
 
+function isRecursiveFSEventHandle(handle) {
+  return RecursiveFSEvent !== undefined && handle instanceof RecursiveFSEvent;
+}
+
+function isFSEventHandle(handle) {
+  return handle instanceof FSEvent || isRecursiveFSEventHandle(handle);
+}
+
+// RecursiveFSEvent reports all events of one wake-up at once, as a flat
+// [eventType, filename, ...] array. If the kernel dropped events, a 'rename'
+// event without a filename is reported first. Passes them on to the
+// FSEvent-style `onchange` one by one, as long as `isActive()`.
+function recursiveOnChange(onchange, isActive) {
+  return (status, events, overflow) => {
+    if (status < 0) {
+      onchange(status, '', null);
+      return;
+    }
+    if (overflow)
+      onchange(0, 'rename', null);
+    for (let i = 0; i < events.length && isActive(); i += 2)
+      onchange(0, events[i], events[i + 1]);
+  };
+}
+
 // To maximize backward-compatibility for the end user,
 // a no-op stub method has been added instead of
 // totally removing FSWatcher.prototype.start.
@@ -268,7 +314,7 @@ FSWatcher.prototype.close = function() {
   if (this._handle === null) {  // closed
     return;
   }
-  assert(this._handle instanceof FSEvent, 'handle must be a FSEvent');
+  assert(isFSEventHandle(this._handle), 'handle must be a FSEvent');
   if (!this._handle.initialized) {  // not started
     return;
   }
@@ -324,7 +370,8 @@ async function* watch(filename, options = kEmptyObject) {
   if (signal?.aborted)
     throw new AbortError(undefined, { cause: signal?.reason });
 
-  const handle = new FSEvent();
+  const useRecursiveFSEvent = recursive && RecursiveFSEvent !== undefined;
+  const handle = useRecursiveFSEvent ? new RecursiveFSEvent() : new FSEvent();
   let { promise, resolve, reject } = createDeferredPromise();
   const oncancel = () => {
     handle.close();
@@ -336,6 +383,10 @@ async function* watch(filename, options = kEmptyObject) {
       kResistStopPropagation ??= require('internal/event_target').kResistStopPropagation;
       signal.addEventListener('abort', oncancel, { __proto__: null, once: true, [kResistStopPropagation]: true });
     }
+    // Events that arrive while the consumer is busy. RecursiveFSEvent reports
+    // several at once.
+    const queued = [];
+    let failed;
     handle.onchange = (status, eventType, filename) => {
       if (status < 0) {
         const error = uvException({
@@ -345,14 +396,20 @@ async function* watch(filename, options = kEmptyObject) {
         });
         error.filename = filename;
         handle.close();
+        failed = error;
         reject(error);
         return;
       }
 
-      resolve({ eventType, filename });
+      ArrayPrototypePush(queued, { eventType, filename });
+      resolve();
     };
+    if (useRecursiveFSEvent)
+      handle.onchange = recursiveOnChange(handle.onchange, () => true);
 
-    const err = handle.start(path, persistent, recursive, encoding);
+    const err = useRecursiveFSEvent ?
+      handle.start(path, persistent, encoding) :
+      handle.start(path, persistent, recursive, encoding);
     if (err) {
       const error = uvException({
         errno: err,
@@ -367,8 +424,12 @@ async function* watch(filename, options = kEmptyObject) {
     }
 
     while (!signal?.aborted) {
-      yield await promise;
+      await promise;
+      while (queued.length > 0 && !signal?.aborted)
+        yield ArrayPrototypeShift(queued);
       ({ promise, resolve, reject } = createDeferredPromise());
+      if (failed !== undefined)
+        throw failed;
     }
     throw new AbortError(undefined, { cause: signal?.reason });
   } finally {
@@ -380,6 +441,7 @@ async function* watch(filename, options = kEmptyObject) {
 module.exports = {
   FSWatcher,
   StatWatcher,
+  kCanWatchRecursively,
   kFSWatchStart,
   kFSStatWatcherStart,
   kFSStatWatcherAddOrCleanRef,
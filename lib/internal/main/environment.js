@@ -10,4 +10,6 @@ const {
 } = require('internal/process/pre_execution');
 
 prepareMainThreadExecution();
+// Embedders creating a snapshot can register serialization callbacks.
+require('internal/v8/startup_snapshot').initializeCallbacks();
 markBootstrapComplete();
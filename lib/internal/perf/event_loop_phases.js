@@ -0,0 +1,141 @@
+'use strict';
+const {
+  ObjectFreeze,
+  ReflectConstruct,
+  Symbol,
+} = primordials;
+
+const {
+  codes: {
+    ERR_ILLEGAL_CONSTRUCTOR,
+    ERR_INVALID_THIS,
+  },
+} = require('internal/errors');
+
+const {
+  EventLoopPhaseMonitor: EventLoopPhaseMonitorHandle,
+  constants: {
+    NODE_PERFORMANCE_LOOP_PHASE_TIMERS,
+    NODE_PERFORMANCE_LOOP_PHASE_POLL,
+    NODE_PERFORMANCE_LOOP_PHASE_CHECK,
+    NODE_PERFORMANCE_LOOP_PHASE_CLOSE,
+  },
+} = internalBinding('performance');
+
+const {
+  internalHistogram,
+} = require('internal/histogram');
+
+const kHandle = Symbol('kHandle');
+const kEnabled = Symbol('kEnabled');
+const kPhases = Symbol('kPhases');
+const kThreadpool = Symbol('kThreadpool');
+
+const phaseNames = [];
+phaseNames[NODE_PERFORMANCE_LOOP_PHASE_TIMERS] = 'timers';
+phaseNames[NODE_PERFORMANCE_LOOP_PHASE_POLL] = 'poll';
+phaseNames[NODE_PERFORMANCE_LOOP_PHASE_CHECK] = 'check';
+phaseNames[NODE_PERFORMANCE_LOOP_PHASE_CLOSE] = 'close';
+
+class EventLoopPhaseMonitor {
+  constructor() {
+    throw new ERR_ILLEGAL_CONSTRUCTOR();
+  }
+
+  /**
+   * @returns {boolean}
+   */
+  enable() {
+    if (this[kEnabled] === undefined)
+      throw new ERR_INVALID_THIS('EventLoopPhaseMonitor');
+    if (this[kEnabled]) return false;
+    this[kEnabled] = true;
+    this[kHandle].start();
+    return true;
+  }
+
+  /**
+   * @returns {boolean}
+   */
+  disable() {
+    if (this[kEnabled] === undefined)
+      throw new ERR_INVALID_THIS('EventLoopPhaseMonitor');
+    if (!this[kEnabled]) return false;
+    this[kEnabled] = false;
+    this[kHandle].stop();
+    return true;
+  }
+
+  /**
+   * @readonly
+   * @type {{
+   *   timers: Histogram,
+   *   poll: Histogram,
+   *   check: Histogram,
+   *   close: Histogram,
+   * }}
+   */
+  get phases() {
+    if (this[kEnabled] === undefined)
+      throw new ERR_INVALID_THIS('EventLoopPhaseMonitor');
+    return this[kPhases];
+  }
+
+  /**
+   * @readonly
+   * @type {{ wait: Histogram, run: Histogram }}
+   */
+  get threadpool() {
+    if (this[kEnabled] === undefined)
+      throw new ERR_INVALID_THIS('EventLoopPhaseMonitor');
+    return this[kThreadpool];
+  }
+
+  /**
+   * @readonly
+   * @type {{ timers: number, poll: number, check: number, close: number }}
+   */
+  get callbacks() {
+    if (this[kEnabled] === undefined)
+      throw new ERR_INVALID_THIS('EventLoopPhaseMonitor');
+    const counts = this[kHandle].getCallbackCounts();
+    const callbacks = {};
+    for (let n = 0; n < phaseNames.length; n++)
+      callbacks[phaseNames[n]] = counts[n];
+    return callbacks;
+  }
+
+  reset() {
+    if (this[kEnabled] === undefined)
+      throw new ERR_INVALID_THIS('EventLoopPhaseMonitor');
+    for (let n = 0; n < phaseNames.length; n++)
+      this[kPhases][phaseNames[n]].reset();
+    this[kThreadpool].wait.reset();
+    this[kThreadpool].run.reset();
+    this[kHandle].resetCallbackCounts();
+  }
+}
+
+/**
+ * @returns {EventLoopPhaseMonitor}
+ */
+function monitorEventLoopPhases() {
+  return ReflectConstruct(
+    function() {
+      this[kEnabled] = false;
+      this[kHandle] = new EventLoopPhaseMonitorHandle();
+      // The histograms of the phases come first, followed by the ones of the
+      // threadpool.
+      const histograms = this[kHandle].getHistograms();
+      const phases = {};
+      for (let n = 0; n < phaseNames.length; n++)
+        phases[phaseNames[n]] = internalHistogram(histograms[n]);
+      this[kPhases] = ObjectFreeze(phases);
+      this[kThreadpool] = ObjectFreeze({
+        wait: internalHistogram(histograms[phaseNames.length]),
+        run: internalHistogram(histograms[phaseNames.length + 1]),
+      });
+    }, [], EventLoopPhaseMonitor);
+}
+
+module.exports = monitorEventLoopPhases;
@@ -10,6 +10,7 @@ const {
   ArrayPrototypeSlice,
   ArrayPrototypeSort,
   Error,
+  Float64Array,
   MathMax,
   MathMin,
   ObjectDefineProperties,
@@ -27,6 +28,11 @@ const {
     NODE_PERFORMANCE_ENTRY_TYPE_HTTP,
     NODE_PERFORMANCE_ENTRY_TYPE_NET,
     NODE_PERFORMANCE_ENTRY_TYPE_DNS,
+    NODE_PERFORMANCE_ENTRY_FIELD_TYPE,
+    NODE_PERFORMANCE_ENTRY_FIELD_START_TIME,
+    NODE_PERFORMANCE_ENTRY_FIELD_DURATION,
+    NODE_PERFORMANCE_ENTRY_FIELD_DETAILS,
+    NODE_PERFORMANCE_ENTRY_FIELD_COUNT,
   },
   installGarbageCollectionTracking,
   observerCounts,
@@ -71,6 +77,8 @@ const { convertToInt } = require('internal/webidl');
 const kDispatch = Symbol('kDispatch');
 const kMaybeBuffer = Symbol('kMaybeBuffer');
 const kDeprecatedFields = Symbol('kDeprecatedFields');
+const kMaybeBufferBatch = Symbol('kMaybeBufferBatch');
+const kBatchEntries = Symbol('kBatchEntries');
 
 const kDeprecationMessage =
   'Custom PerformanceEntry accessors are deprecated. ' +
@@ -79,6 +87,8 @@ const kDeprecationMessage =
 const kTypeSingle = 0;
 const kTypeMultiple = 1;
 
+const kPackedEntrySize = NODE_PERFORMANCE_ENTRY_FIELD_COUNT;
+
 let gcTrackingInstalled = false;
 
 const kSupportedEntryTypes = ObjectFreeze([
@@ -137,6 +147,16 @@ function getObserverType(type) {
   }
 }
 
+function getEntryTypeName(observerType) {
+  switch (observerType) {
+    case NODE_PERFORMANCE_ENTRY_TYPE_GC: return 'gc';
+    case NODE_PERFORMANCE_ENTRY_TYPE_HTTP2: return 'http2';
+    case NODE_PERFORMANCE_ENTRY_TYPE_HTTP: return 'http';
+    case NODE_PERFORMANCE_ENTRY_TYPE_NET: return 'net';
+    case NODE_PERFORMANCE_ENTRY_TYPE_DNS: return 'dns';
+  }
+}
+
 function maybeDecrementObserverCounts(entryTypes) {
   for (const type of entryTypes) {
     const observerType = getObserverType(type);
@@ -166,23 +186,41 @@ function maybeIncrementObserverCount(type) {
   }
 }
 
+function sortEntries(entries) {
+  return ArrayPrototypeSort(entries, (first, second) => {
+    return first.startTime - second.startTime;
+  });
+}
+
 class PerformanceObserverEntryList {
   #buffer = [];
+  #batches;
 
-  constructor(entries) {
-    this.#buffer = ArrayPrototypeSort(entries, (first, second) => {
-      return first.startTime - second.startTime;
-    });
+  constructor(entries, batches = []) {
+    this.#buffer = entries;
+    this.#batches = batches;
+    if (batches.length === 0)
+      sortEntries(entries);
+  }
+
+  // The entries of batches are only created when the list is used.
+  #entries() {
+    if (this.#batches.length > 0) {
+      materializeBatches(this.#buffer, this.#batches);
+      this.#batches = [];
+      sortEntries(this.#buffer);
+    }
+    return this.#buffer;
   }
 
   getEntries() {
-    return ArrayPrototypeSlice(this.#buffer);
+    return ArrayPrototypeSlice(this.#entries());
   }
 
   getEntriesByType(type) {
     type = `${type}`;
     return ArrayPrototypeFilter(
-      this.#buffer,
+      this.#entries(),
       (entry) => entry.entryType === type);
   }
 
@@ -190,11 +228,11 @@ class PerformanceObserverEntryList {
     name = `${name}`;
     if (type != null /** not nullish */) {
       return ArrayPrototypeFilter(
-        this.#buffer,
+        this.#entries(),
         (entry) => entry.name === name && entry.entryType === type);
     }
     return ArrayPrototypeFilter(
-      this.#buffer,
+      this.#entries(),
       (entry) => entry.name === name);
   }
 
@@ -206,12 +244,13 @@ class PerformanceObserverEntryList {
       depth: options.depth == null ? null : options.depth - 1,
     };
 
-    return `PerformanceObserverEntryList ${inspect(this.#buffer, opts)}`;
+    return `PerformanceObserverEntryList ${inspect(this.#entries(), opts)}`;
   }
 }
 
 class PerformanceObserver {
   #buffer = [];
+  #batches = [];
   #entryTypes = new SafeSet();
   #type;
   #callback;
@@ -295,13 +334,16 @@ class PerformanceObserver {
     kObservers.delete(this);
     kPending.delete(this);
     this.#buffer = [];
+    this.#batches = [];
     this.#entryTypes.clear();
     this.#type = undefined;
   }
 
   takeRecords() {
     const list = this.#buffer;
+    materializeBatches(list, this.#batches);
     this.#buffer = [];
+    this.#batches = [];
     return list;
   }
 
@@ -318,9 +360,31 @@ class PerformanceObserver {
       queuePending();
   }
 
+  // Buffers the entries of a batch delivered by the native layer that this
+  // observer is interested in.
+  [kMaybeBufferBatch](batch) {
+    let observed = 0;
+    for (let i = 0; i < batch.length; i += kPackedEntrySize) {
+      const type = batch[i + NODE_PERFORMANCE_ENTRY_FIELD_TYPE];
+      if (this.#entryTypes.has(getEntryTypeName(type)))
+        observed++;
+    }
+    if (observed === 0)
+      return;
+    if (observed * kPackedEntrySize !== batch.length)
+      batch = filterBatch(batch, this.#entryTypes);
+    ArrayPrototypePush(this.#batches, batch);
+    kPending.add(this);
+    if (kPending.size)
+      queuePending();
+  }
+
   [kDispatch]() {
-    this.#callback(new PerformanceObserverEntryList(this.takeRecords()),
-                   this);
+    const entries = this.#buffer;
+    const batches = this.#batches;
+    this.#buffer = [];
+    this.#batches = [];
+    this.#callback(new PerformanceObserverEntryList(entries, batches), this);
   }
 
   [kInspect](depth, options) {
@@ -488,7 +552,28 @@ function filterBufferMapByNameAndType(name, type) {
   });
 }
 
-function observerCallback(name, type, startTime, duration, details) {
+// The accessors are shared by all entries.
+const kDeprecatedAccessors = new SafeMap();
+function getDeprecatedAccessor(key) {
+  let accessor = kDeprecatedAccessors.get(key);
+  if (accessor === undefined) {
+    accessor = {
+      __proto__: null,
+      configurable: true,
+      enumerable: true,
+      get: deprecate(function() {
+        return this[kDeprecatedFields].get(key);
+      }, kDeprecationMessage, 'DEP0152'),
+      set: deprecate(function(value) {
+        this[kDeprecatedFields].set(key, value);
+      }, kDeprecationMessage, 'DEP0152'),
+    };
+    kDeprecatedAccessors.set(key, accessor);
+  }
+  return accessor;
+}
+
+function createPerformanceEntry(name, type, startTime, duration, details) {
   const entry =
     new InternalPerformanceEntry(
       name,
@@ -509,24 +594,78 @@ function observerCallback(name, type, startTime, duration, details) {
     for (let n = 0; n < detailKeys.length; n++) {
       const key = detailKeys[n];
       entry[kDeprecatedFields].set(key, details[key]);
-      props[key] = {
-        configurable: true,
-        enumerable: true,
-        get: deprecate(() => {
-          return entry[kDeprecatedFields].get(key);
-        }, kDeprecationMessage, 'DEP0152'),
-        set: deprecate((value) => {
-          entry[kDeprecatedFields].set(key, value);
-        }, kDeprecationMessage, 'DEP0152'),
-      };
+      props[key] = getDeprecatedAccessor(key);
     }
     ObjectDefineProperties(entry, props);
   }
 
-  enqueue(entry);
+  return entry;
+}
+
+function observerCallback(name, type, startTime, duration, details) {
+  enqueue(createPerformanceEntry(name, type, startTime, duration, details));
+}
+
+function getPackedDetails(type, batch, offset) {
+  switch (type) {
+    case 'gc':
+      return { kind: batch[offset], flags: batch[offset + 1] };
+  }
+}
+
+/**
+ * Creates the entries of batches of packed entries and appends them to
+ * `buffer`. The entries of a batch are created once and shared by all the
+ * observers that receive it.
+ */
+function materializeBatches(buffer, batches) {
+  for (let n = 0; n < batches.length; n++) {
+    const batch = batches[n];
+    if (batch[kBatchEntries] === undefined) {
+      const entries = [];
+      for (let i = 0; i < batch.length; i += kPackedEntrySize) {
+        const type =
+          getEntryTypeName(batch[i + NODE_PERFORMANCE_ENTRY_FIELD_TYPE]);
+        ArrayPrototypePush(entries, createPerformanceEntry(
+          type,
+          type,
+          batch[i + NODE_PERFORMANCE_ENTRY_FIELD_START_TIME],
+          batch[i + NODE_PERFORMANCE_ENTRY_FIELD_DURATION],
+          getPackedDetails(type,
+                           batch,
+                           i + NODE_PERFORMANCE_ENTRY_FIELD_DETAILS)));
+      }
+      batch[kBatchEntries] = entries;
+    }
+    ArrayPrototypePushApply(buffer, batch[kBatchEntries]);
+  }
+}
+
+// Returns a batch with only the entries of the given types.
+function filterBatch(batch, entryTypes) {
+  const fields = [];
+  for (let i = 0; i < batch.length; i += kPackedEntrySize) {
+    const type = batch[i + NODE_PERFORMANCE_ENTRY_FIELD_TYPE];
+    if (entryTypes.has(getEntryTypeName(type))) {
+      for (let n = 0; n < kPackedEntrySize; n++)
+        ArrayPrototypePush(fields, batch[i + n]);
+    }
+  }
+  return new Float64Array(fields);
+}
+
+/**
+ * Receives the entries created by the native layer since the last call, as a
+ * Float64Array of packed entries. Creating the entry objects is left to the
+ * observers, so it only happens for the entries that are actually read.
+ */
+function observerBatchCallback(batch) {
+  for (const obs of kObservers) {
+    obs[kMaybeBufferBatch](batch);
+  }
 }
 
-setupObservers(observerCallback);
+setupObservers(observerCallback, observerBatchCallback);
 
 function hasObserver(type) {
   const observerType = getObserverType(type);
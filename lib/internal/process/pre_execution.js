@@ -91,6 +91,7 @@ function prepareExecution(options) {
     setupStacktracePrinterOnSigint();
     initializeReportSignalHandlers();  // Main-thread-only.
     initializeHeapSnapshotSignalHandlers();
+    initializeCpuProfileSignalHandlers();
     // If the process is spawned with env NODE_CHANNEL_FD, it's probably
     // spawned by our child_process module, then initialize IPC.
     // This attaches some internal event listeners and creates:
@@ -398,8 +399,10 @@ function initializeHeapSnapshotSignalHandlers() {
   require('internal/validators').validateSignalName(signal);
   const { writeHeapSnapshot } = require('v8');
 
+  const compress = getOptionValue('--heapsnapshot-compress');
+
   function doWriteHeapSnapshot() {
-    writeHeapSnapshot();
+    writeHeapSnapshot(undefined, { compress });
   }
   process.on(signal, doWriteHeapSnapshot);
 
@@ -412,6 +415,32 @@ function initializeHeapSnapshotSignalHandlers() {
   }
 }
 
+function initializeCpuProfileSignalHandlers() {
+  const signal = getOptionValue('--cpu-prof-signal');
+
+  if (!signal)
+    return;
+
+  require('internal/validators').validateSignalName(signal);
+  const { CpuProfiler } = require('v8');
+  const profiler = new CpuProfiler();
+  profiler.start();
+
+  function doWriteCpuProfile() {
+    profiler.writeProfile().catch((err) => process.emitWarning(err));
+  }
+  process.on(signal, doWriteCpuProfile);
+
+  // The code above would add the listener back during deserialization,
+  // if applicable.
+  if (isBuildingSnapshot()) {
+    addSerializeCallback(() => {
+      profiler.stop();
+      process.removeListener(signal, doWriteCpuProfile);
+    });
+  }
+}
+
 function setupTraceCategoryState() {
   const { isTraceCategoryEnabled } = internalBinding('trace_events');
   const { toggleTraceCategoryState } = require('internal/process/per_thread');
@@ -515,7 +544,14 @@ function setupChildProcessIpcChannel() {
       process.env.NODE_CHANNEL_SERIALIZATION_MODE || 'json';
     delete process.env.NODE_CHANNEL_SERIALIZATION_MODE;
 
-    require('child_process')._forkChild(fd, serializationMode);
+    let shmFd;
+    if (process.env.NODE_CHANNEL_SHM_FD) {
+      shmFd = NumberParseInt(process.env.NODE_CHANNEL_SHM_FD, 10);
+      assert(shmFd >= 0);
+      delete process.env.NODE_CHANNEL_SHM_FD;
+    }
+
+    require('child_process')._forkChild(fd, serializationMode, shmFd);
     assert(process.send);
   }
 }
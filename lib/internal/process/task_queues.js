@@ -3,6 +3,7 @@
 const {
   Array,
   FunctionPrototypeBind,
+  Symbol,
 } = primordials;
 
 const {
@@ -34,6 +35,7 @@ const {
   symbols: { async_id_symbol, trigger_async_id_symbol },
 } = require('internal/async_hooks');
 const FixedQueue = require('internal/fixed_queue');
+const AsyncContextFrame = require('internal/async_context_frame');
 
 const {
   validateFunction,
@@ -41,6 +43,8 @@ const {
 
 const { AsyncResource } = require('async_hooks');
 
+const context_frame_symbol = Symbol('contextFrame');
+
 // *Must* match Environment::TickInfo::Fields in src/env.h.
 const kHasTickScheduled = 0;
 
@@ -71,6 +75,9 @@ function processTicksAndRejections() {
       const asyncId = tock[async_id_symbol];
       emitBefore(asyncId, tock[trigger_async_id_symbol], tock);
 
+      const priorContextFrame =
+        AsyncContextFrame.exchange(tock[context_frame_symbol]);
+
       try {
         const callback = tock.callback;
         if (tock.args === undefined) {
@@ -86,6 +93,7 @@ function processTicksAndRejections() {
           }
         }
       } finally {
+        AsyncContextFrame.set(priorContextFrame);
         if (destroyHooksExist())
           emitDestroy(asyncId);
       }
@@ -125,6 +133,7 @@ function nextTick(callback) {
   const tickObject = {
     [async_id_symbol]: asyncId,
     [trigger_async_id_symbol]: triggerAsyncId,
+    [context_frame_symbol]: AsyncContextFrame.current(),
     callback,
     args,
   };
@@ -0,0 +1,131 @@
+'use strict';
+
+const {
+  ArrayPrototypePush,
+  MathMin,
+  Uint32Array,
+} = primordials;
+
+const { Buffer } = require('buffer');
+const { FastBuffer } = require('internal/buffer');
+const { findRecordBoundaries } = internalBinding('buffer');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+  },
+} = require('internal/errors');
+const { isUint8Array } = require('internal/util/types');
+const { kEmptyObject } = require('internal/util');
+const { validateObject } = require('internal/validators');
+
+// Number of delimiter positions looked up per call into C++.
+const kBatchSize = 1024;
+
+function view(chunk, start, end) {
+  return new FastBuffer(chunk.buffer, chunk.byteOffset + start, end - start);
+}
+
+/**
+ * Splits the byte stream `input` into the records separated by `delimiter`.
+ * The records are Buffers without the delimiter, yielded in one array per
+ * chunk of `input` that completes any. Records that are contained in a single
+ * chunk are views of that chunk, only the ones that span chunks are copied.
+ * @param {AsyncIterable<Buffer | Uint8Array | string>} input
+ * @param {{ delimiter?: string | Buffer | Uint8Array }} [options]
+ * @yields {Buffer[]}
+ */
+async function* splitRecords(input, options = kEmptyObject) {
+  validateObject(options, 'options');
+  let { delimiter = '\n' } = options;
+  if (typeof delimiter === 'string') {
+    delimiter = Buffer.from(delimiter);
+  } else if (!isUint8Array(delimiter)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.delimiter', ['string', 'Buffer', 'Uint8Array'], delimiter);
+  }
+  if (delimiter.length === 0) {
+    throw new ERR_INVALID_ARG_VALUE('options.delimiter', delimiter,
+                                    'must not be empty');
+  }
+  const delimiterLength = delimiter.length;
+
+  const positions = new Uint32Array(kBatchSize);
+  // The chunks of the record that is still incomplete.
+  let pending = [];
+  let pendingLength = 0;
+
+  for await (let chunk of input) {
+    if (typeof chunk === 'string') {
+      chunk = Buffer.from(chunk);
+    } else if (!isUint8Array(chunk)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'chunk', ['string', 'Buffer', 'Uint8Array'], chunk);
+    }
+
+    const records = [];
+    let start = 0;
+    if (pendingLength > 0) {
+      // Look for the end of the pending record first.
+      let end = -1;
+      let excess = 0;
+      if (delimiterLength > 1) {
+        // The delimiter might start in the pending bytes.
+        if (pending.length > 1)
+          pending = [Buffer.concat(pending, pendingLength)];
+        const carry = pending[0];
+        const tail = MathMin(carry.length, delimiterLength - 1);
+        const edge = Buffer.concat([
+          view(carry, carry.length - tail, carry.length),
+          view(chunk, 0, MathMin(chunk.length, delimiterLength - 1)),
+        ]);
+        const index = edge.indexOf(delimiter);
+        if (index !== -1 && index < tail) {
+          excess = tail - index;
+          end = index + delimiterLength - tail;
+        }
+      }
+      if (end === -1 &&
+          findRecordBoundaries(chunk, delimiter, 0, positions) > 0) {
+        ArrayPrototypePush(pending, view(chunk, 0, positions[0]));
+        pendingLength += positions[0];
+        end = positions[0] + delimiterLength;
+      }
+      if (end === -1) {
+        ArrayPrototypePush(pending, chunk);
+        pendingLength += chunk.length;
+        continue;
+      }
+      ArrayPrototypePush(records,
+                         Buffer.concat(pending, pendingLength - excess));
+      pending = [];
+      pendingLength = 0;
+      start = end;
+    }
+
+    let count;
+    do {
+      count = findRecordBoundaries(chunk, delimiter, start, positions);
+      for (let i = 0; i < count; i++) {
+        const position = positions[i];
+        ArrayPrototypePush(records, view(chunk, start, position));
+        start = position + delimiterLength;
+      }
+    } while (count === kBatchSize);
+
+    if (start < chunk.length) {
+      pending = [view(chunk, start, chunk.length)];
+      pendingLength = chunk.length - start;
+    }
+
+    if (records.length > 0)
+      yield records;
+  }
+
+  if (pendingLength > 0)
+    yield [Buffer.concat(pending, pendingLength)];
+}
+
+module.exports = {
+  splitRecords,
+};
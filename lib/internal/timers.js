@@ -82,14 +82,14 @@ const {
   Symbol,
 } = primordials;
 
+const binding = internalBinding('timers');
 const {
   scheduleTimer,
   toggleTimerRef,
-  getLibuvNow,
   immediateInfo,
   timeoutInfo,
   toggleImmediateRef,
-} = internalBinding('timers');
+} = binding;
 
 const {
   getDefaultTriggerAsyncId,
@@ -102,10 +102,12 @@ const {
   emitAfter,
   emitDestroy,
 } = require('internal/async_hooks');
+const AsyncContextFrame = require('internal/async_context_frame');
 
 // Symbols for storing async id state.
 const async_id_symbol = Symbol('asyncId');
 const trigger_async_id_symbol = Symbol('triggerId');
+const kContextFrame = Symbol('kContextFrame');
 
 const kHasPrimitive = Symbol('kHasPrimitive');
 
@@ -160,6 +162,7 @@ function initAsyncResource(resource, type) {
   const asyncId = resource[async_id_symbol] = newAsyncId();
   const triggerAsyncId =
     resource[trigger_async_id_symbol] = getDefaultTriggerAsyncId();
+  resource[kContextFrame] = AsyncContextFrame.current();
   if (initHooksExist())
     emitInit(asyncId, type, triggerAsyncId, resource);
 }
@@ -357,13 +360,21 @@ function insertGuarded(item, refed, start) {
   item[kRefed] = refed;
 }
 
-function insert(item, msecs, start = getLibuvNow()) {
+function insert(item, msecs, start = binding.getLibuvNow()) {
   // Truncate so that accuracy of sub-millisecond timers is not assumed.
   msecs = MathTrunc(msecs);
-  item._idleStart = start;
 
   // Use an existing list if there is one, otherwise we need to make a new one.
   let list = timerListMap[msecs];
+  if (list !== undefined && isLinkedInPlace(list, item, msecs, start)) {
+    // Re-arming a timer that does not have to move, e.g. a socket timeout
+    // that is refreshed by several reads and writes within the same
+    // millisecond, or the most recently armed timer of its list.
+    item._idleStart = start;
+    return;
+  }
+  item._idleStart = start;
+
   if (list === undefined) {
     debug('no %d list was found in insert, creating a new one', msecs);
     const expiry = start + msecs;
@@ -379,6 +390,19 @@ function insert(item, msecs, start = getLibuvNow()) {
   L.append(list, item);
 }
 
+// Whether `item` is linked into `list` at a position that stays sorted by
+// start time once its start time becomes `start`, so that re-arming it does not
+// have to move it. Timers are linked from oldest to newest through _idlePrev,
+// so it is enough to look at the next newer timer.
+function isLinkedInPlace(list, item, msecs, start) {
+  const newer = item._idlePrev;
+  if (newer === item || newer === null || newer === undefined ||
+      MathTrunc(item._idleTimeout) !== msecs) {
+    return false;
+  }
+  return newer === list || newer._idleStart >= start;
+}
+
 function setUnrefTimeout(callback, after) {
   // Type checking identical to setTimeout()
   validateFunction(callback, 'callback');
@@ -470,6 +494,9 @@ function getTimerCallbacks(runNextTicks) {
       const asyncId = immediate[async_id_symbol];
       emitBefore(asyncId, immediate[trigger_async_id_symbol], immediate);
 
+      const priorContextFrame =
+        AsyncContextFrame.exchange(immediate[kContextFrame]);
+
       try {
         const argv = immediate._argv;
         if (!argv)
@@ -477,6 +504,7 @@ function getTimerCallbacks(runNextTicks) {
         else
           immediate._onImmediate(...argv);
       } finally {
+        AsyncContextFrame.set(priorContextFrame);
         immediate._onImmediate = null;
 
         if (destroyHooksExist())
@@ -561,7 +589,10 @@ function getTimerCallbacks(runNextTicks) {
 
       let start;
       if (timer._repeat)
-        start = getLibuvNow();
+        start = binding.getLibuvNow();
+
+      const priorContextFrame =
+        AsyncContextFrame.exchange(timer[kContextFrame]);
 
       try {
         const args = timer._timerArgs;
@@ -570,6 +601,7 @@ function getTimerCallbacks(runNextTicks) {
         else
           ReflectApply(timer._onTimeout, timer, args);
       } finally {
+        AsyncContextFrame.set(priorContextFrame);
         if (timer._repeat && timer._idleTimeout !== -1) {
           timer._idleTimeout = timer._repeat;
           insert(timer, timer._idleTimeout, start);
@@ -26,6 +26,7 @@ const {
 } = require('internal/util/types');
 
 const {
+  validateBoolean,
   validateBuffer,
   validateInt32,
   validateObject,
@@ -134,6 +135,7 @@ function configSecureContext(context, options = kEmptyObject, name = 'options')
     dhparam,
     ecdhCurve = getDefaultEcdhCurve(),
     key,
+    offloadPrivateKey,
     passphrase,
     pfx,
     privateKeyIdentifier,
@@ -310,6 +312,13 @@ function configSecureContext(context, options = kEmptyObject, name = 'options')
     validateInt32(sessionTimeout, `${name}.sessionTimeout`);
     context.setSessionTimeout(sessionTimeout);
   }
+
+  // Done last, once every private key has been loaded into the context.
+  if (offloadPrivateKey !== undefined && offloadPrivateKey !== null) {
+    validateBoolean(offloadPrivateKey, `${name}.offloadPrivateKey`);
+    if (offloadPrivateKey)
+      context.enablePrivateKeyOffload();
+  }
 }
 
 module.exports = {
@@ -63,6 +63,7 @@ const {
 const { Buffer } = require('buffer');
 const { guessHandleType } = internalBinding('util');
 const { ShutdownWrap } = internalBinding('stream_wrap');
+const { StreamPipe } = internalBinding('stream_pipe');
 const {
   TCP,
   TCPConnectWrap,
@@ -98,6 +99,7 @@ const {
     ERR_INVALID_FD_TYPE,
     ERR_INVALID_IP_ADDRESS,
     ERR_INVALID_HANDLE_TYPE,
+    ERR_INVALID_STATE,
     ERR_SERVER_ALREADY_LISTEN,
     ERR_SERVER_NOT_RUNNING,
     ERR_SOCKET_CLOSED,
@@ -750,6 +752,32 @@ Socket.prototype.resetAndDestroy = function() {
   return this;
 };
 
+Socket.prototype.detachHandle = function() {
+  const handle = this._handle;
+  if (!handle)
+    throw new ERR_SOCKET_CLOSED();
+  if (!(handle instanceof TCP) && !(handle instanceof Pipe))
+    throw new ERR_INVALID_HANDLE_TYPE();
+  if (this.connecting || this.writableLength !== 0 ||
+      handle.writeQueueSize !== 0) {
+    throw new ERR_INVALID_STATE('Socket is connecting or has pending writes');
+  }
+
+  if (handle.reading) {
+    handle.reading = false;
+    handle.readStop();
+  }
+  // `bytesRead` and `kBytesWritten` should be accessible after detaching.
+  this[kBytesRead] = handle.bytesRead;
+  this[kBytesWritten] = handle.bytesWritten;
+  handle.onread = noop;
+  handle[owner_symbol] = null;
+  this._handle = null;
+  this._sockname = null;
+  this.destroy();
+  return handle;
+};
+
 Socket.prototype.pause = function() {
   if (this[kBuffer] && !this.connecting && this._handle &&
       this._handle.reading) {
@@ -782,6 +810,79 @@ Socket.prototype.read = function(n) {
 };
 
 
+Socket.prototype.forwardTo = function(destination, callback) {
+  if (!(destination instanceof Socket))
+    throw new ERR_INVALID_ARG_TYPE('destination', 'net.Socket', destination);
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+
+  if (this.connecting || destination.connecting) {
+    const pending = this.connecting ? this : destination;
+    pending.once('connect', () => this.forwardTo(destination, callback));
+    return this;
+  }
+
+  if (!this._handle || !destination._handle)
+    throw new ERR_SOCKET_CLOSED();
+
+  // Take reading over from the JS side. Marking the handle as reading keeps
+  // _read() and resume() from starting reads of their own.
+  this.pause();
+  if (this._handle.reading)
+    this._handle.readStop();
+  this._handle.reading = true;
+
+  // Data that has already been read goes first.
+  let chunk;
+  while ((chunk = this.read()) !== null)
+    destination.write(chunk);
+
+  // So does everything written to the destination from JS, including what is
+  // corked, since the native pipe writes past it. The empty write completes
+  // once all of the writes before it have.
+  while (destination.writableCorked)
+    destination.uncork();
+  if (destination.writableLength > 0) {
+    debug('forwardTo: waiting for queued writes');
+    destination.write('', (err) => {
+      if (!err && (!this._handle || !destination._handle))
+        err = new ERR_SOCKET_CLOSED();
+      if (err) {
+        if (callback !== undefined)
+          callback(err);
+        return;
+      }
+      startForwarding(this, destination, callback);
+    });
+    return this;
+  }
+
+  startForwarding(this, destination, callback);
+  return this;
+};
+
+function startForwarding(source, destination, callback) {
+  debug('forwardTo: starting native pipe');
+  const pipe = new StreamPipe(source._handle, destination._handle, true);
+  pipe.onunpipe = (err) => {
+    let error = null;
+    if (err !== undefined) {
+      error = errnoException(err, 'splice');
+      destination.destroy(error);
+    } else if (source._readableState.ended) {
+      // The native side has already shut down the destination's write side,
+      // this only brings the JS side up to date.
+      destination.end();
+    } else {
+      error = source.errored || destination.errored || null;
+    }
+    if (callback !== undefined)
+      callback(error);
+  };
+  pipe.start();
+}
+
+
 // Called when the 'end' event is emitted.
 function onReadableStreamEnd() {
   if (!this.allowHalfOpen) {
@@ -1750,12 +1851,13 @@ function createServerHandle(address, port, addressType, fd, flags) {
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle(DEFAULT_IPV4_ADDR, port);
+        return createServerHandle(DEFAULT_IPV4_ADDR, port, 4, undefined,
+                                  flags & ~TCPConstants.UV_TCP_IPV6ONLY);
       }
     } else if (addressType === 6) {
       err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, flags & ~TCPConstants.UV_TCP_IPV6ONLY);
     }
   }
 
@@ -1915,7 +2017,7 @@ Server.prototype.listen = function(...args) {
   options = options._handle || options.handle || options;
   const flags = getFlags(options.ipv6Only);
   // (handle[, backlog][, cb]) where handle is an object with a handle
-  if (options instanceof TCP) {
+  if (options instanceof TCP || options instanceof Pipe) {
     this._handle = options;
     this[async_id_symbol] = this._handle.getAsyncId();
     listenInCluster(this, null, -1, -1, backlogFromArgs);
@@ -2154,6 +2256,20 @@ Server.prototype.getConnections = function(cb) {
 };
 
 
+Server.prototype.detachHandle = function() {
+  const handle = this._handle;
+  if (!handle)
+    throw new ERR_SERVER_NOT_RUNNING();
+  if (!(handle instanceof TCP) && !(handle instanceof Pipe))
+    throw new ERR_INVALID_HANDLE_TYPE();
+
+  handle.onconnection = noop;
+  handle[owner_symbol] = null;
+  this._handle = null;
+  this.close();
+  return handle;
+};
+
 Server.prototype.close = function(cb) {
   if (typeof cb === 'function') {
     if (!this._handle) {
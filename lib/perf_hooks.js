@@ -28,6 +28,7 @@ const {
 } = require('internal/histogram');
 
 const monitorEventLoopDelay = require('internal/perf/event_loop_delay');
+const monitorEventLoopPhases = require('internal/perf/event_loop_phases');
 
 module.exports = {
   Performance,
@@ -38,6 +39,7 @@ module.exports = {
   PerformanceObserverEntryList,
   PerformanceResourceTiming,
   monitorEventLoopDelay,
+  monitorEventLoopPhases,
   createHistogram,
   performance,
 };
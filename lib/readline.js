@@ -40,6 +40,7 @@ const {
   moveCursor,
 } = require('internal/readline/callbacks');
 const emitKeypressEvents = require('internal/readline/emitKeypressEvents');
+const { splitRecords } = require('internal/readline/records');
 const promises = require('readline/promises');
 
 const {
@@ -522,4 +523,5 @@ module.exports = {
   emitKeypressEvents,
   moveCursor,
   promises,
+  splitRecords,
 };
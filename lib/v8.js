@@ -26,6 +26,7 @@ const {
   Int32Array,
   Int8Array,
   ObjectPrototypeToString,
+  Promise,
   Uint16Array,
   Uint32Array,
   Uint8Array,
@@ -33,7 +34,22 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
-const { validateString, validateUint32 } = require('internal/validators');
+const {
+  validateBoolean,
+  validateInteger,
+  validateObject,
+  validateOneOf,
+  validateString,
+  validateUint32,
+} = require('internal/validators');
+const {
+  codes: {
+    ERR_OPERATION_FAILED,
+  },
+  uvException,
+} = require('internal/errors');
+const { kEmptyObject } = require('internal/util');
+const { clearInterval, setInterval } = require('timers');
 const {
   Serializer,
   Deserializer,
@@ -56,6 +72,8 @@ const { toNamespacedPath } = require('path');
 const {
   createHeapSnapshotStream,
   triggerHeapSnapshot,
+  kHeapSnapshotBinary,
+  kHeapSnapshotCompress,
 } = internalBinding('heap_utils');
 const { HeapSnapshotStream } = require('internal/heap_utils');
 const promiseHooks = require('internal/promise_hooks');
@@ -63,16 +81,29 @@ const { getOptionValue } = require('internal/options');
 const { JSONParse } = primordials;
 /**
  * Generates a snapshot of the current V8 heap
- * and writes it to a JSON file.
+ * and writes it to a file.
  * @param {string} [filename]
+ * @param {{
+ *   compress?: boolean;
+ *   format?: 'json' | 'binary';
+ *   }} [options]
  * @returns {string}
  */
-function writeHeapSnapshot(filename) {
+function writeHeapSnapshot(filename, options = kEmptyObject) {
   if (filename !== undefined) {
     filename = getValidatedPath(filename);
     filename = toNamespacedPath(filename);
   }
-  return triggerHeapSnapshot(filename);
+  validateObject(options, 'options');
+  const { compress = false, format = 'json' } = options;
+  validateBoolean(compress, 'options.compress');
+  validateOneOf(format, 'options.format', ['json', 'binary']);
+  let flags = 0;
+  if (compress)
+    flags |= kHeapSnapshotCompress;
+  if (format === 'binary')
+    flags |= kHeapSnapshotBinary;
+  return triggerHeapSnapshot(filename, flags);
 }
 
 /**
@@ -403,6 +434,108 @@ class GCProfiler {
   }
 }
 
+// The parts that CpuProfiler and HeapProfiler share. While the profiler is
+// running, `update` is called every `interval` milliseconds.
+class ContinuousProfiler {
+  #kind;
+  #profiler;
+  #update;
+  #interval;
+  #timer = null;
+
+  constructor(kind, profiler, update, interval) {
+    this.#kind = kind;
+    this.#profiler = profiler;
+    this.#update = update;
+    this.#interval = interval;
+  }
+
+  start() {
+    if (this.#timer !== null)
+      return;
+    if (!this.#profiler.start()) {
+      throw new ERR_OPERATION_FAILED(
+        `${this.#kind} profiler could not be started`);
+    }
+    this.#timer = setInterval(this.#update, this.#interval);
+    this.#timer.unref();
+  }
+
+  stop() {
+    if (this.#timer === null)
+      return;
+    clearInterval(this.#timer);
+    this.#timer = null;
+    this.#profiler.stop();
+  }
+
+  takeProfile(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const { compress = true } = options;
+    validateBoolean(compress, 'options.compress');
+    return new Promise((resolve) => {
+      this.#profiler.takeProfile(compress, undefined, (err, buffer) => {
+        resolve(buffer);
+      });
+    });
+  }
+
+  writeProfile(filename) {
+    if (filename !== undefined) {
+      filename = getValidatedPath(filename);
+      filename = toNamespacedPath(filename);
+    }
+    return new Promise((resolve, reject) => {
+      this.#profiler.takeProfile(true, filename ?? true, (err, path) => {
+        if (err !== undefined)
+          reject(uvException({ errno: err, syscall: 'open', path }));
+        else
+          resolve(path);
+      });
+    });
+  }
+}
+
+class CpuProfiler extends ContinuousProfiler {
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const {
+      samplingInterval = 1000,
+      windowDuration = 10000,
+      windowCount = 6,
+    } = options;
+    validateInteger(samplingInterval, 'options.samplingInterval', 1, 1e6);
+    validateInteger(windowDuration, 'options.windowDuration', 1);
+    validateInteger(windowCount, 'options.windowCount', 1, 1000);
+    const profiler = new binding.ContinuousCpuProfiler(samplingInterval,
+                                                       windowCount);
+    super('CPU', profiler, () => profiler.rotate(), windowDuration);
+  }
+}
+
+class HeapProfiler extends ContinuousProfiler {
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const {
+      samplingInterval = 512 * 1024,
+      stackDepth = 16,
+      maxStacks = 4096,
+      aggregateInterval = 10000,
+      native = true,
+    } = options;
+    validateInteger(samplingInterval, 'options.samplingInterval', 1);
+    validateInteger(stackDepth, 'options.stackDepth', 1, 1024);
+    validateInteger(maxStacks, 'options.maxStacks', 1, 1e6);
+    validateInteger(aggregateInterval, 'options.aggregateInterval', 1);
+    validateBoolean(native, 'options.native');
+    const profiler = new binding.ContinuousHeapProfiler(samplingInterval,
+                                                        stackDepth,
+                                                        maxStacks,
+                                                        native);
+    super('Heap', profiler, () => profiler.aggregate(), aggregateInterval);
+  }
+}
+
 module.exports = {
   cachedDataVersionTag,
   getHeapSnapshot,
@@ -423,4 +556,6 @@ module.exports = {
   startupSnapshot,
   setHeapSnapshotNearHeapLimit,
   GCProfiler,
+  CpuProfiler,
+  HeapProfiler,
 };
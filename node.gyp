@@ -493,16 +493,20 @@
         'src/api/exceptions.cc',
         'src/api/hooks.cc',
         'src/api/utils.cc',
+        'src/array_buffer_pool.cc',
+        'src/async_context_frame.cc',
         'src/async_wrap.cc',
         'src/base_object.cc',
         'src/cares_wrap.cc',
         'src/cleanup_queue.cc',
         'src/connect_wrap.cc',
         'src/connection_wrap.cc',
+        'src/dataqueue/queue.cc',
         'src/debug_utils.cc',
         'src/env.cc',
         'src/fs_event_wrap.cc',
         'src/handle_wrap.cc',
+        'src/heap_snapshot_writer.cc',
         'src/heap_utils.cc',
         'src/histogram.cc',
         'src/js_native_api.h',
@@ -523,12 +527,16 @@
         'src/node_config.cc',
         'src/node_constants.cc',
         'src/node_contextify.cc',
+        'src/node_cpu_profiler.cc',
+        'src/node_copy_tree.cc',
         'src/node_credentials.cc',
         'src/node_dir.cc',
         'src/node_env_var.cc',
         'src/node_errors.cc',
         'src/node_external_reference.cc',
         'src/node_file.cc',
+        'src/node_file_tree.cc',
+        'src/node_heap_profiler.cc',
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
@@ -539,6 +547,7 @@
         'src/node_os.cc',
         'src/node_perf.cc',
         'src/node_platform.cc',
+        'src/node_pprof.cc',
         'src/node_postmortem_metadata.cc',
         'src/node_process_events.cc',
         'src/node_process_methods.cc',
@@ -591,6 +600,8 @@
         'src/aliased_buffer-inl.h',
         'src/aliased_struct.h',
         'src/aliased_struct-inl.h',
+        'src/array_buffer_pool.h',
+        'src/async_context_frame.h',
         'src/async_wrap.h',
         'src/async_wrap-inl.h',
         'src/base_object.h',
@@ -604,12 +615,14 @@
         'src/cleanup_queue-inl.h',
         'src/connect_wrap.h',
         'src/connection_wrap.h',
+        'src/dataqueue/queue.h',
         'src/debug_utils.h',
         'src/debug_utils-inl.h',
         'src/env_properties.h',
         'src/env.h',
         'src/env-inl.h',
         'src/handle_wrap.h',
+        'src/heap_snapshot_writer.h',
         'src/histogram.h',
         'src/histogram-inl.h',
         'src/js_stream.h',
@@ -629,11 +642,15 @@
         'src/node_constants.h',
         'src/node_context_data.h',
         'src/node_contextify.h',
+        'src/node_cpu_profiler.h',
+        'src/node_copy_tree.h',
         'src/node_dir.h',
         'src/node_errors.h',
         'src/node_external_reference.h',
         'src/node_file.h',
         'src/node_file-inl.h',
+        'src/node_file_tree.h',
+        'src/node_heap_profiler.h',
         'src/node_http_common.h',
         'src/node_http_common-inl.h',
         'src/node_http2.h',
@@ -653,6 +670,7 @@
         'src/node_perf.h',
         'src/node_perf_common.h',
         'src/node_platform.h',
+        'src/node_pprof.h',
         'src/node_process.h',
         'src/node_process-inl.h',
         'src/node_realm.h',
@@ -697,6 +715,7 @@
         'src/tracing/traced_value.h',
         'src/timer_wrap.h',
         'src/timer_wrap-inl.h',
+        'src/timers.h',
         'src/tty_wrap.h',
         'src/udp_wrap.h',
         'src/util.h',
@@ -1280,6 +1299,7 @@
         'test/cctest/test_aliased_buffer.cc',
         'test/cctest/test_base64.cc',
         'test/cctest/test_base_object_ptr.cc',
+        'test/cctest/test_dataqueue.cc',
         'test/cctest/test_node_postmortem_metadata.cc',
         'test/cctest/test_environment.cc',
         'test/cctest/test_linked_binding.cc',
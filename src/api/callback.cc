@@ -1,4 +1,5 @@
 #include "node.h"
+#include "async_context_frame.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "v8.h"
@@ -42,12 +43,14 @@ InternalCallbackScope::InternalCallbackScope(AsyncWrap* async_wrap, int flags)
                             async_wrap->object(),
                             { async_wrap->get_async_id(),
                               async_wrap->get_trigger_async_id() },
-                            flags) {}
+                            flags,
+                            async_wrap->context_frame()) {}
 
 InternalCallbackScope::InternalCallbackScope(Environment* env,
                                              Local<Object> object,
                                              const async_context& asyncContext,
-                                             int flags)
+                                             int flags,
+                                             Local<Value> context_frame)
   : env_(env),
     async_context_(asyncContext),
     object_(object),
@@ -61,6 +64,13 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
     return;
   }
 
+  performance::LoopPhaseTracker* loop_phases =
+      &env->performance_state()->loop_phases;
+  if (UNLIKELY(loop_phases->enabled()) &&
+      env->async_callback_scope_depth() == 1) {
+    loop_phases->CountCallback();
+  }
+
   Isolate* isolate = env->isolate();
 
   HandleScope handle_scope(isolate);
@@ -76,6 +86,11 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
 
   isolate->SetIdle(false);
 
+  if (!context_frame.IsEmpty()) {
+    prior_context_frame_.Reset(
+        isolate, async_context_frame::exchange(env->context(), context_frame));
+  }
+
   env->async_hooks()->push_async_context(
     async_context_.async_id, async_context_.trigger_async_id, object);
 
@@ -120,6 +135,13 @@ void InternalCallbackScope::Close() {
   if (pushed_ids_)
     env_->async_hooks()->pop_async_context(async_context_.async_id);
 
+  if (!prior_context_frame_.IsEmpty()) {
+    HandleScope handle_scope(isolate);
+    async_context_frame::set(env_->context(),
+                             prior_context_frame_.Get(isolate));
+    prior_context_frame_.Reset();
+  }
+
   if (failed_) return;
 
   if (env_->async_callback_scope_depth() > 1 || skip_task_queues_) {
@@ -173,7 +195,8 @@ MaybeLocal<Value> InternalMakeCallback(Environment* env,
                                        const Local<Function> callback,
                                        int argc,
                                        Local<Value> argv[],
-                                       async_context asyncContext) {
+                                       async_context asyncContext,
+                                       Local<Value> context_frame) {
   CHECK(!recv.IsEmpty());
 #ifdef DEBUG
   for (int i = 0; i < argc; i++)
@@ -194,7 +217,8 @@ MaybeLocal<Value> InternalMakeCallback(Environment* env,
         async_hooks->fields()[AsyncHooks::kUsesExecutionAsyncResource] > 0;
   }
 
-  InternalCallbackScope scope(env, resource, asyncContext, flags);
+  InternalCallbackScope scope(
+      env, resource, asyncContext, flags, context_frame);
   if (scope.Failed()) {
     return MaybeLocal<Value>();
   }
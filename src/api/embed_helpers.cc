@@ -1,6 +1,9 @@
 #include "node.h"
 #include "env-inl.h"
 #include "debug_utils-inl.h"
+#include "node_snapshot_builder.h"
+
+#include <optional>
 
 using v8::Context;
 using v8::Function;
@@ -12,6 +15,7 @@ using v8::Locker;
 using v8::Maybe;
 using v8::Nothing;
 using v8::SealHandleScope;
+using v8::SnapshotCreator;
 using v8::TryCatch;
 
 namespace node {
@@ -77,6 +81,7 @@ struct CommonEnvironmentSetup::Impl {
   MultiIsolatePlatform* platform = nullptr;
   uv_loop_t loop;
   std::shared_ptr<ArrayBufferAllocator> allocator;
+  std::optional<SnapshotCreator> snapshot_creator;
   Isolate* isolate = nullptr;
   DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data;
   DeleteFnPtr<Environment, FreeEnvironment> env;
@@ -87,6 +92,14 @@ CommonEnvironmentSetup::CommonEnvironmentSetup(
     MultiIsolatePlatform* platform,
     std::vector<std::string>* errors,
     std::function<Environment*(const CommonEnvironmentSetup*)> make_env)
+    : CommonEnvironmentSetup(platform, errors, nullptr, kNoFlags, make_env) {}
+
+CommonEnvironmentSetup::CommonEnvironmentSetup(
+    MultiIsolatePlatform* platform,
+    std::vector<std::string>* errors,
+    const EmbedderSnapshotData* snapshot_data,
+    uint32_t flags,
+    std::function<Environment*(const CommonEnvironmentSetup*)> make_env)
   : impl_(new Impl()) {
   CHECK_NOT_NULL(platform);
   CHECK_NOT_NULL(errors);
@@ -103,9 +116,25 @@ CommonEnvironmentSetup::CommonEnvironmentSetup(
   }
   loop->data = this;
 
-  impl_->allocator = ArrayBufferAllocator::Create();
-  impl_->isolate = NewIsolate(impl_->allocator, &impl_->loop, platform);
-  Isolate* isolate = impl_->isolate;
+  Isolate* isolate;
+  if (flags & kIsForSnapshotting) {
+    // The SnapshotCreator owns the isolate, and uses its own ArrayBuffer
+    // allocator, so there is no NodeArrayBufferAllocator to hand to the
+    // IsolateData either.
+    isolate = impl_->isolate = Isolate::Allocate();
+    // Must be done before the SnapshotCreator creation so that the
+    // memory reducer can be initialized.
+    platform->RegisterIsolate(isolate, loop);
+    impl_->snapshot_creator.emplace(
+        isolate, SnapshotBuilder::CollectExternalReferences().data());
+    isolate->SetCaptureStackTraceForUncaughtExceptions(
+        true, 10, v8::StackTrace::StackTraceOptions::kDetailed);
+    SetIsolateMiscHandlers(isolate, {});
+  } else {
+    impl_->allocator = ArrayBufferAllocator::Create();
+    isolate = impl_->isolate =
+        NewIsolate(impl_->allocator, &impl_->loop, platform, snapshot_data);
+  }
 
   {
     Locker locker(isolate);
@@ -121,7 +150,19 @@ CommonEnvironmentSetup::CommonEnvironmentSetup(
     });
 
     impl_->isolate_data.reset(CreateIsolateData(
-        isolate, loop, platform, impl_->allocator.get()));
+        isolate, loop, platform, impl_->allocator.get(), snapshot_data));
+    if (flags & kIsForSnapshotting)
+      impl_->isolate_data->options()->build_snapshot = true;
+
+    if (snapshot_data != nullptr) {
+      // The context is deserialized as part of creating the Environment.
+      impl_->env.reset(make_env(this));
+      if (impl_->env)
+        impl_->context.Reset(isolate, impl_->env->context());
+      else
+        errors->push_back("Failed to deserialize the Environment");
+      return;
+    }
 
     Local<Context> context = NewContext(isolate);
     impl_->context.Reset(isolate, context);
@@ -152,7 +193,10 @@ CommonEnvironmentSetup::~CommonEnvironmentSetup() {
       *static_cast<bool*>(data) = true;
     }, &platform_finished);
     impl_->platform->UnregisterIsolate(isolate);
-    isolate->Dispose();
+    if (impl_->snapshot_creator.has_value())
+      impl_->snapshot_creator.reset();  // Disposes of the isolate.
+    else
+      isolate->Dispose();
 
     // Wait until the platform has cleaned up all relevant resources.
     while (!platform_finished)
@@ -165,6 +209,55 @@ CommonEnvironmentSetup::~CommonEnvironmentSetup() {
   delete impl_;
 }
 
+std::unique_ptr<CommonEnvironmentSetup>
+CommonEnvironmentSetup::CreateForSnapshotting(
+    MultiIsolatePlatform* platform,
+    std::vector<std::string>* errors,
+    const std::vector<std::string>& args,
+    const std::vector<std::string>& exec_args) {
+  // It's not guaranteed that a context that goes through
+  // v8_inspector::V8Inspector::contextCreated() is runtime-independent,
+  // so do not start the inspector on the main context when building
+  // a snapshot.
+  uint64_t env_flags =
+      EnvironmentFlags::kDefaultFlags | EnvironmentFlags::kNoCreateInspector;
+
+  auto ret = std::unique_ptr<CommonEnvironmentSetup>(new CommonEnvironmentSetup(
+      platform,
+      errors,
+      nullptr,
+      kIsForSnapshotting,
+      [&](const CommonEnvironmentSetup* setup) -> Environment* {
+        return CreateEnvironment(
+            setup->isolate_data(),
+            setup->context(),
+            args,
+            exec_args,
+            static_cast<EnvironmentFlags::Flags>(env_flags));
+      }));
+  if (!errors->empty()) ret.reset();
+  return ret;
+}
+
+EmbedderSnapshotData::Pointer CommonEnvironmentSetup::CreateSnapshot() {
+  CHECK(impl_->snapshot_creator.has_value());
+  Isolate* isolate = impl_->isolate;
+  SnapshotData* snapshot_data = new SnapshotData();
+  EmbedderSnapshotData::Pointer result{
+      new EmbedderSnapshotData(snapshot_data, true)};
+
+  Locker locker(isolate);
+  Isolate::Scope isolate_scope(isolate);
+  int exit_code = SnapshotBuilder::CreateSnapshot(
+      snapshot_data,
+      &impl_->snapshot_creator.value(),
+      isolate_data(),
+      env(),
+      static_cast<uint8_t>(SnapshotMetadata::Type::kFullyCustomized));
+  if (exit_code != 0) return {};
+
+  return result;
+}
 
 uv_loop_t* CommonEnvironmentSetup::event_loop() const {
   return &impl_->loop;
@@ -191,4 +284,42 @@ v8::Local<v8::Context> CommonEnvironmentSetup::context() const {
   return impl_->context.Get(impl_->isolate);
 }
 
+EmbedderSnapshotData::EmbedderSnapshotData(const SnapshotData* impl,
+                                           bool owns_impl)
+    : impl_(impl), owns_impl_(owns_impl) {}
+
+void EmbedderSnapshotData::DeleteSnapshotData::operator()(
+    const EmbedderSnapshotData* data) const {
+  if (data->owns_impl_) delete data->impl_;
+  delete data;
+}
+
+EmbedderSnapshotData::Pointer EmbedderSnapshotData::BuiltinSnapshotData() {
+  const SnapshotData* impl = SnapshotBuilder::GetEmbeddedSnapshotData();
+  if (impl == nullptr) return {};
+  return EmbedderSnapshotData::Pointer{new EmbedderSnapshotData(impl, false)};
+}
+
+EmbedderSnapshotData::Pointer EmbedderSnapshotData::FromFile(FILE* in) {
+  SnapshotData* snapshot_data = new SnapshotData();
+  EmbedderSnapshotData::Pointer result{
+      new EmbedderSnapshotData(snapshot_data, true)};
+  if (!SnapshotData::FromBlob(snapshot_data, in)) {
+    return {};
+  }
+  return result;
+}
+
+void EmbedderSnapshotData::ToFile(FILE* out) const {
+  impl_->ToBlob(out);
+}
+
+bool EmbedderSnapshotData::CanUseCustomSnapshotPerIsolate() {
+#ifdef NODE_V8_SHARED_RO_HEAP
+  return false;
+#else
+  return true;
+#endif
+}
+
 }  // namespace node
@@ -1,3 +1,4 @@
+#include "array_buffer_pool.h"
 #include "node.h"
 #include "node_builtins.h"
 #include "node_context_data.h"
@@ -7,9 +8,14 @@
 #include "node_platform.h"
 #include "node_realm-inl.h"
 #include "node_shadow_realm.h"
+#include "node_snapshot_builder.h"
+#include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
 #include "node_wasm_web_api.h"
 #include "uv.h"
+#if HAVE_OPENSSL
+#include "crypto/crypto_util.h"
+#endif  // HAVE_OPENSSL
 #ifdef NODE_ENABLE_VTUNE_PROFILING
 #include "../deps/v8/src/third_party/vtune/v8-vtune.h"
 #endif
@@ -98,9 +104,13 @@ MaybeLocal<Value> PrepareStackTraceCallback(Local<Context> context,
   return result;
 }
 
+bool NodeArrayBufferAllocator::should_zero_fill() const {
+  return zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers;
+}
+
 void* NodeArrayBufferAllocator::Allocate(size_t size) {
   void* ret;
-  if (zero_fill_field_ || per_process::cli_options->zero_fill_all_buffers)
+  if (should_zero_fill())
     ret = allocator_->Allocate(size);
   else
     ret = allocator_->AllocateUninitialized(size);
@@ -210,9 +220,72 @@ void DebuggingArrayBufferAllocator::RegisterPointerInternal(void* data,
   allocations_[data] = size;
 }
 
+void* PoolingArrayBufferAllocator::Allocate(size_t size) {
+  ArrayBufferPool* pool = ArrayBufferPool::Get();
+  void* ret;
+  if (ArrayBufferPool::IsPooledSize(size)) {
+    // Slots are recycled, so unlike fresh memory from the system they have
+    // to be cleared explicitly.
+    ret = pool->Take(size);
+    if (LIKELY(ret != nullptr) && should_zero_fill())
+      memset(ret, 0, size);
+  } else {
+    ret = pool->AllocateLarge(size, should_zero_fill());
+  }
+  if (LIKELY(ret != nullptr))
+    total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
+  return ret;
+}
+
+void* PoolingArrayBufferAllocator::AllocateUninitialized(size_t size) {
+  ArrayBufferPool* pool = ArrayBufferPool::Get();
+  void* ret = ArrayBufferPool::IsPooledSize(size) ?
+      pool->Take(size) : pool->AllocateLarge(size, false);
+  if (LIKELY(ret != nullptr))
+    total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
+  return ret;
+}
+
+void* PoolingArrayBufferAllocator::Reallocate(
+    void* data, size_t old_size, size_t size) {
+  // Stay in place when both sizes map to the same slot.
+  if (ArrayBufferPool::IsPooledSize(old_size) &&
+      ArrayBufferPool::IsPooledSize(size) &&
+      ArrayBufferPool::SizeClassOf(old_size) ==
+          ArrayBufferPool::SizeClassOf(size)) {
+    if (size > old_size)
+      memset(static_cast<char*>(data) + old_size, 0, size - old_size);
+    total_mem_usage_.fetch_add(size - old_size, std::memory_order_relaxed);
+    return data;
+  }
+
+  void* ret = nullptr;
+  if (size > 0) {
+    ret = AllocateUninitialized(size);
+    if (UNLIKELY(ret == nullptr)) return nullptr;
+    const size_t copied = std::min(old_size, size);
+    if (copied > 0) memcpy(ret, data, copied);
+    if (size > copied)
+      memset(static_cast<char*>(ret) + copied, 0, size - copied);
+  }
+  Free(data, old_size);
+  return ret;
+}
+
+void PoolingArrayBufferAllocator::Free(void* data, size_t size) {
+  if (data == nullptr) return;
+  total_mem_usage_.fetch_sub(size, std::memory_order_relaxed);
+  if (ArrayBufferPool::IsPooledSize(size))
+    ArrayBufferPool::Get()->Give(data, size);
+  else
+    ArrayBufferPool::Get()->FreeLarge(data, size);
+}
+
 std::unique_ptr<ArrayBufferAllocator> ArrayBufferAllocator::Create(bool debug) {
   if (debug || per_process::cli_options->debug_arraybuffer_allocations)
     return std::make_unique<DebuggingArrayBufferAllocator>();
+  else if (per_process::cli_options->pool_arraybuffer_allocations)
+    return std::make_unique<PoolingArrayBufferAllocator>();
   else
     return std::make_unique<NodeArrayBufferAllocator>();
 }
@@ -359,25 +432,40 @@ Isolate* NewIsolate(Isolate::CreateParams* params,
 
 Isolate* NewIsolate(ArrayBufferAllocator* allocator,
                     uv_loop_t* event_loop,
-                    MultiIsolatePlatform* platform) {
+                    MultiIsolatePlatform* platform,
+                    const EmbedderSnapshotData* snapshot_data) {
   Isolate::CreateParams params;
   if (allocator != nullptr) params.array_buffer_allocator = allocator;
-  return NewIsolate(&params, event_loop, platform);
+  if (snapshot_data != nullptr) {
+    SnapshotBuilder::InitializeIsolateParams(
+        SnapshotData::FromEmbedderWrapper(snapshot_data), &params);
+  }
+  return NewIsolate(&params, event_loop, platform, snapshot_data != nullptr);
 }
 
 Isolate* NewIsolate(std::shared_ptr<ArrayBufferAllocator> allocator,
                     uv_loop_t* event_loop,
-                    MultiIsolatePlatform* platform) {
+                    MultiIsolatePlatform* platform,
+                    const EmbedderSnapshotData* snapshot_data) {
   Isolate::CreateParams params;
   if (allocator) params.array_buffer_allocator_shared = allocator;
-  return NewIsolate(&params, event_loop, platform);
+  if (snapshot_data != nullptr) {
+    SnapshotBuilder::InitializeIsolateParams(
+        SnapshotData::FromEmbedderWrapper(snapshot_data), &params);
+  }
+  return NewIsolate(&params, event_loop, platform, snapshot_data != nullptr);
 }
 
 IsolateData* CreateIsolateData(Isolate* isolate,
                                uv_loop_t* loop,
                                MultiIsolatePlatform* platform,
-                               ArrayBufferAllocator* allocator) {
-  return new IsolateData(isolate, loop, platform, allocator);
+                               ArrayBufferAllocator* allocator,
+                               const EmbedderSnapshotData* snapshot_data) {
+  return new IsolateData(isolate,
+                         loop,
+                         platform,
+                         allocator,
+                         SnapshotData::FromEmbedderWrapper(snapshot_data));
 }
 
 void FreeIsolateData(IsolateData* isolate_data) {
@@ -405,13 +493,51 @@ Environment* CreateEnvironment(
     EnvironmentFlags::Flags flags,
     ThreadId thread_id,
     std::unique_ptr<InspectorParentHandle> inspector_parent_handle) {
-  Isolate* isolate = context->GetIsolate();
+  Isolate* isolate = isolate_data->isolate();
   HandleScope handle_scope(isolate);
-  Context::Scope context_scope(context);
+
+  const bool use_snapshot = context.IsEmpty();
+  const EnvSerializeInfo* env_snapshot_info = nullptr;
+  if (use_snapshot) {
+    CHECK_NOT_NULL(isolate_data->snapshot_data());
+    env_snapshot_info = &isolate_data->snapshot_data()->env_info;
+  }
+
   // TODO(addaleax): This is a much better place for parsing per-Environment
   // options than the global parse call.
-  Environment* env = new Environment(
-      isolate_data, context, args, exec_args, nullptr, flags, thread_id);
+  Environment* env = new Environment(isolate_data,
+                                     isolate,
+                                     args,
+                                     exec_args,
+                                     env_snapshot_info,
+                                     flags,
+                                     thread_id);
+
+  if (use_snapshot) {
+#ifdef NODE_V8_SHARED_RO_HEAP
+    // TODO(addaleax): Do this as part of creating the Environment
+    // once we store the SnapshotData* itself on IsolateData.
+    env->builtin_loader()->RefreshCodeCache(
+        isolate_data->snapshot_data()->code_cache);
+#endif
+    context = Context::FromSnapshot(isolate,
+                                    SnapshotData::kNodeMainContextIndex,
+                                    {DeserializeNodeInternalFields, env})
+                  .ToLocalChecked();
+
+    CHECK(!context.IsEmpty());
+    Context::Scope context_scope(context);
+
+    if (InitializeContextRuntime(context).IsNothing()) {
+      env->InitializeMainContext(context, env_snapshot_info);
+      FreeEnvironment(env);
+      return nullptr;
+    }
+    SetIsolateErrorHandlers(isolate, {});
+  }
+
+  Context::Scope context_scope(context);
+  env->InitializeMainContext(context, env_snapshot_info);
 
 #if HAVE_INSPECTOR
   if (env->should_create_inspector()) {
@@ -425,7 +551,12 @@ Environment* CreateEnvironment(
   }
 #endif
 
-  if (env->principal_realm()->RunBootstrapping().IsEmpty()) {
+  if (use_snapshot) {
+    // Bootstrapping has already happened before the snapshot was taken.
+#if HAVE_OPENSSL
+    crypto::InitCryptoOnce(isolate);
+#endif  // HAVE_OPENSSL
+  } else if (env->principal_realm()->RunBootstrapping().IsEmpty()) {
     FreeEnvironment(env);
     return nullptr;
   }
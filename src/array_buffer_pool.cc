@@ -0,0 +1,169 @@
+#include "array_buffer_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace node {
+
+namespace {
+
+// Marks the page-aligned interior of [data, data + size) as eligible for
+// transparent huge pages. The memory comes from V8's allocator, so it is not
+// necessarily aligned; only the huge pages fully inside of it can be backed
+// by one, which is why arenas are a few huge pages large.
+void AdviseHugePages(void* data, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (size < ArrayBufferPool::kHugePageSize) return;
+  const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t start =
+      (reinterpret_cast<uintptr_t>(data) + page - 1) & ~(page - 1);
+  const uintptr_t end =
+      (reinterpret_cast<uintptr_t>(data) + size) & ~(page - 1);
+  if (end > start) {
+    // This is only a hint, failure is harmless.
+    madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+// Set once the calling thread's cache has been destroyed, so that memory freed
+// during thread teardown goes straight to the shared free lists.
+thread_local bool thread_cache_destroyed = false;
+
+}  // anonymous namespace
+
+struct ArrayBufferPool::ThreadCache {
+  std::array<std::vector<void*>, kClassCount> slots;
+
+  ~ThreadCache() {
+    thread_cache_destroyed = true;
+    ArrayBufferPool* pool = ArrayBufferPool::Get();
+    for (size_t i = 0; i < kClassCount; i++)
+      pool->Release(i, slots[i].size(), &slots[i]);
+  }
+};
+
+ArrayBufferPool::ArrayBufferPool() = default;
+
+ArrayBufferPool* ArrayBufferPool::Get() {
+  // Intentionally leaked: backing stores may still be freed by threads that
+  // outlive static destructors.
+  static ArrayBufferPool* pool = new ArrayBufferPool();
+  return pool;
+}
+
+ArrayBufferPool::ThreadCache* ArrayBufferPool::GetThreadCache() {
+  if (UNLIKELY(thread_cache_destroyed)) return nullptr;
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+void* ArrayBufferPool::Take(size_t size) {
+  DCHECK(IsPooledSize(size));
+  const size_t index = SizeClassOf(size);
+  ThreadCache* cache = GetThreadCache();
+  if (UNLIKELY(cache == nullptr)) {
+    std::vector<void*> slot;
+    Refill(index, 1, &slot);
+    return slot.empty() ? nullptr : slot.back();
+  }
+
+  std::vector<void*>& slots = cache->slots[index];
+  if (slots.empty()) {
+    Refill(index, std::max<size_t>(kRefillBytes / ClassSize(index), 1),
+           &slots);
+    if (slots.empty()) return nullptr;
+  }
+  void* data = slots.back();
+  slots.pop_back();
+  return data;
+}
+
+void ArrayBufferPool::Give(void* data, size_t size) {
+  DCHECK(IsPooledSize(size));
+  const size_t index = SizeClassOf(size);
+  ThreadCache* cache = GetThreadCache();
+  if (UNLIKELY(cache == nullptr)) {
+    Mutex::ScopedLock lock(mutex_);
+    free_lists_[index].push_back(data);
+    return;
+  }
+
+  std::vector<void*>& slots = cache->slots[index];
+  slots.push_back(data);
+  const size_t limit = std::max<size_t>(kThreadCacheBytes / ClassSize(index),
+                                        1);
+  if (slots.size() > limit) Release(index, slots.size() / 2, &slots);
+}
+
+void ArrayBufferPool::Refill(size_t index,
+                             size_t count,
+                             std::vector<void*>* out) {
+  const size_t class_size = ClassSize(index);
+  Mutex::ScopedLock lock(mutex_);
+  std::vector<void*>& free_list = free_lists_[index];
+  const size_t reused = std::min(count, free_list.size());
+  out->insert(out->end(), free_list.end() - reused, free_list.end());
+  free_list.resize(free_list.size() - reused);
+  count -= reused;
+
+  while (count > 0) {
+    if (static_cast<size_t>(arena_end_ - arena_pos_) < class_size &&
+        !NewArena()) {
+      return;
+    }
+    out->push_back(arena_pos_);
+    arena_pos_ += class_size;
+    count--;
+  }
+}
+
+void ArrayBufferPool::Release(size_t index,
+                              size_t count,
+                              std::vector<void*>* slots) {
+  if (count == 0) return;
+  Mutex::ScopedLock lock(mutex_);
+  free_lists_[index].insert(free_lists_[index].end(),
+                            slots->end() - count,
+                            slots->end());
+  slots->resize(slots->size() - count);
+}
+
+bool ArrayBufferPool::NewArena() {
+  // The remainder of the current arena is too small for the requested class.
+  // Hand it out to the smaller classes instead of wasting it.
+  for (size_t i = kClassCount; i-- > 0;) {
+    const size_t class_size = ClassSize(i);
+    while (static_cast<size_t>(arena_end_ - arena_pos_) >= class_size) {
+      free_lists_[i].push_back(arena_pos_);
+      arena_pos_ += class_size;
+    }
+  }
+
+  char* arena =
+      static_cast<char*>(allocator_->AllocateUninitialized(kArenaSize));
+  if (arena == nullptr) return false;
+  AdviseHugePages(arena, kArenaSize);
+  arenas_.push_back(arena);
+  arena_pos_ = arena;
+  arena_end_ = arena + kArenaSize;
+  return true;
+}
+
+void* ArrayBufferPool::AllocateLarge(size_t size, bool zero_fill) {
+  void* data = zero_fill ? allocator_->Allocate(size)
+                         : allocator_->AllocateUninitialized(size);
+  if (data != nullptr) AdviseHugePages(data, size);
+  return data;
+}
+
+void ArrayBufferPool::FreeLarge(void* data, size_t size) {
+  allocator_->Free(data, size);
+}
+
+}  // namespace node
@@ -0,0 +1,110 @@
+#ifndef SRC_ARRAY_BUFFER_POOL_H_
+#define SRC_ARRAY_BUFFER_POOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "node_mutex.h"
+#include "util.h"
+#include "v8-array-buffer.h"
+
+namespace node {
+
+// A process-wide pool of ArrayBuffer backing memory, used by
+// PoolingArrayBufferAllocator when --pool-arraybuffer-allocations is set.
+//
+// Small allocations are rounded up to a power-of-two size class and served
+// from per-thread free lists, which are refilled from (and overflow into)
+// shared per-class free lists. Fresh slots are carved out of large arenas
+// that are never returned to the system. The pool is shared by all isolates
+// because V8 may free a backing store on any thread, including background
+// GC threads and threads other than the one that allocated it.
+//
+// Allocations larger than the biggest size class are not pooled. Both the
+// arenas and those large allocations are obtained from V8's default
+// allocator so that they stay inside the V8 memory cage; on Linux they are
+// additionally marked as eligible for transparent huge pages.
+//
+// The pool never initializes memory. Callers that need zero-filled memory
+// have to clear slots handed out by Take() themselves.
+class ArrayBufferPool {
+ public:
+  static constexpr size_t kMinClassSize = 64;
+  static constexpr size_t kMaxClassSize = 64 * 1024;
+  static constexpr size_t kClassCount = 11;  // 64 bytes ... 64 KB.
+  static constexpr size_t kArenaSize = 8 * 1024 * 1024;
+  static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+  // Upper bound on the number of bytes a thread caches per size class before
+  // half of that class's cache is handed back to the shared free list.
+  static constexpr size_t kThreadCacheBytes = 256 * 1024;
+  // Maximum number of bytes moved between a thread cache and the shared free
+  // lists (or carved from an arena) in one go.
+  static constexpr size_t kRefillBytes = 64 * 1024;
+
+  static ArrayBufferPool* Get();
+
+  static inline bool IsPooledSize(size_t size) {
+    return size > 0 && size <= kMaxClassSize;
+  }
+
+  static inline size_t SizeClassOf(size_t size) {
+    size_t index = 0;
+    size_t class_size = kMinClassSize;
+    while (class_size < size) {
+      class_size <<= 1;
+      index++;
+    }
+    return index;
+  }
+
+  static inline size_t ClassSize(size_t index) {
+    return kMinClassSize << index;
+  }
+
+  // Returns an uninitialized slot of at least |size| bytes, where
+  // IsPooledSize(size) must hold, or nullptr if the system is out of memory.
+  void* Take(size_t size);
+  // Returns a slot previously handed out by Take() for an allocation of the
+  // same size class as |size|.
+  void Give(void* data, size_t size);
+
+  // Allocates or frees memory that is too large to be pooled.
+  void* AllocateLarge(size_t size, bool zero_fill);
+  void FreeLarge(void* data, size_t size);
+
+  ArrayBufferPool(const ArrayBufferPool&) = delete;
+  ArrayBufferPool& operator=(const ArrayBufferPool&) = delete;
+
+ private:
+  struct ThreadCache;
+
+  ArrayBufferPool();
+
+  // Moves up to |count| slots of size class |index| into |out|, carving new
+  // ones from the current arena if the shared free list runs dry.
+  void Refill(size_t index, size_t count, std::vector<void*>* out);
+  // Moves the last |count| entries of |slots| to the shared free list.
+  void Release(size_t index, size_t count, std::vector<void*>* slots);
+  bool NewArena();
+
+  static ThreadCache* GetThreadCache();
+
+  Mutex mutex_;
+  std::array<std::vector<void*>, kClassCount> free_lists_;
+  std::vector<char*> arenas_;
+  char* arena_pos_ = nullptr;
+  char* arena_end_ = nullptr;
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator_{
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator()};
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_ARRAY_BUFFER_POOL_H_
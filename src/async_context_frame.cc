@@ -0,0 +1,78 @@
+#include "async_context_frame.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8.h"
+
+namespace node {
+
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Null;
+using v8::Object;
+using v8::Value;
+
+namespace async_context_frame {
+
+Local<Value> current(Local<Context> context) {
+  return context->GetContinuationPreservedEmbedderData();
+}
+
+void set(Local<Context> context, Local<Value> frame) {
+  // V8 leaves the current value in place while running a promise reaction
+  // that captured undefined, so use null when there is no frame. Otherwise
+  // such reactions would run in whatever frame happens to be current.
+  if (frame->IsUndefined()) frame = Null(context->GetIsolate());
+  context->SetContinuationPreservedEmbedderData(frame);
+}
+
+Local<Value> exchange(Local<Context> context, Local<Value> frame) {
+  Local<Value> prior = current(context);
+  set(context, frame);
+  return prior;
+}
+
+namespace {
+
+void GetContinuationPreservedEmbedderData(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(current(env->context()));
+}
+
+void SetContinuationPreservedEmbedderData(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  set(env->context(), args[0]);
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  SetMethodNoSideEffect(context,
+                        target,
+                        "getContinuationPreservedEmbedderData",
+                        GetContinuationPreservedEmbedderData);
+  SetMethod(context,
+            target,
+            "setContinuationPreservedEmbedderData",
+            SetContinuationPreservedEmbedderData);
+}
+
+}  // anonymous namespace
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(GetContinuationPreservedEmbedderData);
+  registry->Register(SetContinuationPreservedEmbedderData);
+}
+
+}  // namespace async_context_frame
+}  // namespace node
+
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(async_context_frame,
+                                    node::async_context_frame::Initialize)
+NODE_BINDING_EXTERNAL_REFERENCE(
+    async_context_frame,
+    node::async_context_frame::RegisterExternalReferences)
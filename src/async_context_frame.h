@@ -0,0 +1,33 @@
+#ifndef SRC_ASYNC_CONTEXT_FRAME_H_
+#define SRC_ASYNC_CONTEXT_FRAME_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "v8.h"
+
+namespace node {
+
+class ExternalReferenceRegistry;
+
+// The async context frame is the value that backs AsyncLocalStorage when
+// --experimental-async-context-frame is set. It is stored as the
+// continuation-preserved embedder data of a context, which V8 captures when a
+// promise reaction is created and restores while that reaction runs. Native
+// callbacks restore the frame that was current when their AsyncWrap was
+// (re)initialized, see InternalCallbackScope.
+namespace async_context_frame {
+
+v8::Local<v8::Value> current(v8::Local<v8::Context> context);
+void set(v8::Local<v8::Context> context, v8::Local<v8::Value> frame);
+// Sets |frame| as the current frame and returns the previous one.
+v8::Local<v8::Value> exchange(v8::Local<v8::Context> context,
+                              v8::Local<v8::Value> frame);
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+}  // namespace async_context_frame
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_ASYNC_CONTEXT_FRAME_H_
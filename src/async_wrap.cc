@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "async_wrap.h"  // NOLINT(build/include_inline)
+#include "async_context_frame.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "node_errors.h"
@@ -593,6 +594,10 @@ void AsyncWrap::AsyncReset(Local<Object> resource, double execution_async_id,
     if (resource != obj) {
       USE(obj->Set(env()->context(), env()->resource_symbol(), resource));
     }
+    if (env()->options()->experimental_async_context_frame) {
+      context_frame_.Reset(env()->isolate(),
+                           async_context_frame::current(env()->context()));
+    }
   }
 
   switch (provider_type()) {
@@ -662,7 +667,7 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
   ProviderType provider = provider_type();
   async_context context { get_async_id(), get_trigger_async_id() };
   MaybeLocal<Value> ret = InternalMakeCallback(
-      env(), object(), object(), cb, argc, argv, context);
+      env(), object(), object(), cb, argc, argv, context, context_frame());
 
   // This is a static call with cached values because the `this` object may
   // no longer be alive at this point.
@@ -33,17 +33,20 @@ namespace node {
 
 #define NODE_ASYNC_NON_CRYPTO_PROVIDER_TYPES(V)                               \
   V(NONE)                                                                     \
+  V(CPUPROFILER)                                                              \
   V(DIRHANDLE)                                                                \
   V(DNSCHANNEL)                                                               \
   V(ELDHISTOGRAM)                                                             \
   V(FILEHANDLE)                                                               \
   V(FILEHANDLECLOSEREQ)                                                       \
-  V(FIXEDSIZEBLOBCOPY)                                                        \
+  V(BLOBREADER)                                                               \
+  V(FSCOPYTREE)                                                               \
   V(FSEVENTWRAP)                                                              \
   V(FSREQCALLBACK)                                                            \
   V(FSREQPROMISE)                                                             \
   V(GETADDRINFOREQWRAP)                                                       \
   V(GETNAMEINFOREQWRAP)                                                       \
+  V(HEAPPROFILER)                                                             \
   V(HEAPSNAPSHOT)                                                             \
   V(HTTP2SESSION)                                                             \
   V(HTTP2STREAM)                                                              \
@@ -186,6 +189,9 @@ class AsyncWrap : public BaseObject {
 
   inline double get_async_id() const;
   inline double get_trigger_async_id() const;
+  // The async context frame that was current when this instance was last
+  // reset. Empty unless --experimental-async-context-frame is set.
+  inline v8::Local<v8::Value> context_frame() const;
 
   void AsyncReset(v8::Local<v8::Object> resource,
                   double execution_async_id = kInvalidAsyncId,
@@ -239,6 +245,7 @@ class AsyncWrap : public BaseObject {
   // Because the values may be Reset(), cannot be made const.
   double async_id_ = kInvalidAsyncId;
   double trigger_async_id_ = kInvalidAsyncId;
+  v8::Global<v8::Value> context_frame_;
 };
 
 }  // namespace node
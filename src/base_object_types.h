@@ -14,6 +14,7 @@ namespace node {
   V(v8_binding_data, v8_utils::BindingData)                                    \
   V(blob_binding_data, BlobBindingData)                                        \
   V(process_binding_data, process::BindingData)                                \
+  V(timers_binding_data, timers::BindingData)                                  \
   V(url_binding_data, url::BindingData)
 
 #define UNSERIALIZABLE_BINDING_TYPES(V)                                        \
@@ -8,14 +8,24 @@
 #include "tcp_wrap.h"
 #include "util-inl.h"
 
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 
 using v8::Boolean;
 using v8::Context;
+using v8::Function;
+using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Local;
 using v8::Object;
+using v8::String;
 using v8::Value;
 
 
@@ -116,6 +126,112 @@ void ConnectionWrap<WrapType, UVType>::AfterConnect(uv_connect_t* req,
   req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
 }
 
+template <typename WrapType, typename UVType>
+BaseObject::TransferMode
+ConnectionWrap<WrapType, UVType>::GetTransferMode() const {
+#ifdef _WIN32
+  return TransferMode::kUntransferable;
+#else
+  // Pending writes would be lost, and IPC pipes carry state of their own.
+  if (IsHandleClosing() || is_named_pipe_ipc() ||
+      stream()->write_queue_size != 0) {
+    return TransferMode::kUntransferable;
+  }
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<const uv_handle_t*>(&handle_), &fd) != 0)
+    return TransferMode::kUntransferable;
+  return TransferMode::kTransferable;
+#endif
+}
+
+template <typename WrapType, typename UVType>
+std::unique_ptr<worker::TransferData>
+ConnectionWrap<WrapType, UVType>::TransferForMessaging() {
+  CHECK_NE(GetTransferMode(), TransferMode::kUntransferable);
+#ifdef _WIN32
+  UNREACHABLE();
+#else
+  uv_os_fd_t fd;
+  CHECK_EQ(uv_fileno(reinterpret_cast<const uv_handle_t*>(&handle_), &fd), 0);
+  // The original descriptor is owned by this handle's event loop, which may
+  // still have it registered with epoll/kqueue, so hand over a duplicate.
+  const int dup_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup_fd == -1) {
+    env()->ThrowErrnoException(errno, "fcntl");
+    return {};
+  }
+  const bool server = provider_type() == PROVIDER_TCPSERVERWRAP ||
+                      provider_type() == PROVIDER_PIPESERVERWRAP;
+  Close();
+  return std::make_unique<TransferData>(dup_fd, server);
+#endif
+}
+
+template <typename WrapType, typename UVType>
+ConnectionWrap<WrapType, UVType>::TransferData::TransferData(int fd,
+                                                             bool server)
+    : fd_(fd), server_(server) {}
+
+template <typename WrapType, typename UVType>
+ConnectionWrap<WrapType, UVType>::TransferData::~TransferData() {
+#ifndef _WIN32
+  // The message was never received.
+  if (fd_ != -1) ::close(fd_);
+#endif
+}
+
+template <typename WrapType, typename UVType>
+BaseObjectPtr<BaseObject>
+ConnectionWrap<WrapType, UVType>::TransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  constexpr bool is_tcp = std::is_same_v<UVType, uv_tcp_t>;
+  auto constructor_template = [&]() {
+    return is_tcp ? env->tcp_constructor_template()
+                  : env->pipe_constructor_template();
+  };
+
+  // The constructor template is created when the binding is first loaded,
+  // which may not have happened on the receiving thread yet. Load it through
+  // internalBinding() so that the handle is an instance of the same class
+  // that lib/net.js sees.
+  if (constructor_template().IsEmpty()) {
+    Local<Value> name =
+        is_tcp ? FIXED_ONE_BYTE_STRING(env->isolate(), "tcp_wrap")
+               : FIXED_ONE_BYTE_STRING(env->isolate(), "pipe_wrap");
+    if (env->internal_binding_loader()
+            ->Call(context, Undefined(env->isolate()), 1, &name)
+            .IsEmpty()) {
+      return {};
+    }
+    CHECK(!constructor_template().IsEmpty());
+  }
+
+  Local<Function> constructor;
+  Local<Object> obj;
+  Local<Value> type = Integer::New(
+      env->isolate(), server_ ? WrapType::SERVER : WrapType::SOCKET);
+  if (!constructor_template()->GetFunction(context).ToLocal(&constructor) ||
+      !constructor->NewInstance(context, 1, &type).ToLocal(&obj)) {
+    return {};
+  }
+
+  WrapType* wrap = Unwrap<WrapType>(obj);
+  CHECK_NOT_NULL(wrap);
+  int err;
+  if constexpr (is_tcp)
+    err = uv_tcp_open(&wrap->handle_, fd_);
+  else
+    err = uv_pipe_open(&wrap->handle_, fd_);
+  if (err != 0) {
+    env->ThrowUVException(err, is_tcp ? "uv_tcp_open" : "uv_pipe_open");
+    return {};
+  }
+  fd_ = -1;
+  return BaseObjectPtr<BaseObject>(wrap);
+}
+
 template ConnectionWrap<PipeWrap, uv_pipe_t>::ConnectionWrap(
     Environment* env,
     Local<Object> object,
@@ -138,5 +254,17 @@ template void ConnectionWrap<PipeWrap, uv_pipe_t>::AfterConnect(
 template void ConnectionWrap<TCPWrap, uv_tcp_t>::AfterConnect(
     uv_connect_t* handle, int status);
 
+template BaseObject::TransferMode
+ConnectionWrap<PipeWrap, uv_pipe_t>::GetTransferMode() const;
+
+template BaseObject::TransferMode
+ConnectionWrap<TCPWrap, uv_tcp_t>::GetTransferMode() const;
+
+template std::unique_ptr<worker::TransferData>
+ConnectionWrap<PipeWrap, uv_pipe_t>::TransferForMessaging();
+
+template std::unique_ptr<worker::TransferData>
+ConnectionWrap<TCPWrap, uv_tcp_t>::TransferForMessaging();
+
 
 }  // namespace node
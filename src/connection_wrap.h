@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "node_messaging.h"
 #include "stream_wrap.h"
 
 namespace node {
@@ -15,12 +16,38 @@ class ConnectionWrap : public LibuvStreamWrap {
   static void OnConnection(uv_stream_t* handle, int status);
   static void AfterConnect(uv_connect_t* req, int status);
 
+  // Open sockets and servers can be moved to another thread's event loop.
+  // The file descriptor is duplicated and this handle is closed; the
+  // receiving side opens a new handle of the same type on the duplicate.
+  TransferMode GetTransferMode() const override;
+  std::unique_ptr<worker::TransferData> TransferForMessaging() override;
+
  protected:
   ConnectionWrap(Environment* env,
                  v8::Local<v8::Object> object,
                  ProviderType provider);
 
   UVType handle_;
+
+ private:
+  class TransferData : public worker::TransferData {
+   public:
+    TransferData(int fd, bool server);
+    ~TransferData();
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(ConnectionWrapTransferData)
+    SET_SELF_SIZE(TransferData)
+
+   private:
+    int fd_;
+    bool server_;
+  };
 };
 
 }  // namespace node
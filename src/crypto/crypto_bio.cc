@@ -26,6 +26,7 @@
 
 #include <openssl/bio.h>
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
 
@@ -95,35 +96,31 @@ int NodeBIO::Read(BIO* bio, char* out, int len) {
 
 
 char* NodeBIO::Peek(size_t* size) {
-  *size = read_head_->write_pos_ - read_head_->read_pos_;
-  return read_head_->data_ + read_head_->read_pos_;
+  if (length_ == 0) {
+    *size = 0;
+    return data_ == nullptr ? nullptr : data_ + read_pos_;
+  }
+
+  *size = std::min(length_, capacity_ - read_pos_);
+  return data_ + read_pos_;
 }
 
 
 size_t NodeBIO::PeekMultiple(char** out, size_t* size, size_t* count) {
-  Buffer* pos = read_head_;
-  size_t max = *count;
-  size_t total = 0;
-
-  size_t i;
-  for (i = 0; i < max; i++) {
-    size[i] = pos->write_pos_ - pos->read_pos_;
-    total += size[i];
-    out[i] = pos->data_ + pos->read_pos_;
-
-    /* Don't get past write head */
-    if (pos == write_head_)
-      break;
-    else
-      pos = pos->next_;
+  CHECK_GT(*count, 0);
+
+  // The readable data is at most two segments: from the read position to the
+  // end of the buffer, and, if it wraps around, from the start of the buffer.
+  out[0] = Peek(&size[0]);
+  if (size[0] == length_ || *count == 1) {
+    *count = 1;
+    return size[0];
   }
 
-  if (i == max)
-    *count = i;
-  else
-    *count = i + 1;
-
-  return total;
+  out[1] = data_;
+  size[1] = length_ - size[0];
+  *count = 2;
+  return length_;
 }
 
 
@@ -237,256 +234,198 @@ const BIO_METHOD* NodeBIO::GetMethod() {
 }
 
 
-void NodeBIO::TryMoveReadHead() {
-  // `read_pos_` and `write_pos_` means the position of the reader and writer
-  // inside the buffer, respectively. When they're equal - its safe to reset
-  // them, because both reader and writer will continue doing their stuff
-  // from new (zero) positions.
-  while (read_head_->read_pos_ != 0 &&
-         read_head_->read_pos_ == read_head_->write_pos_) {
-    // Reset positions
-    read_head_->read_pos_ = 0;
-    read_head_->write_pos_ = 0;
-
-    // Move read_head_ forward, just in case if there're still some data to
-    // read in the next buffer.
-    if (read_head_ != write_head_)
-      read_head_ = read_head_->next_;
-  }
-}
-
-
 size_t NodeBIO::Read(char* out, size_t size) {
-  size_t bytes_read = 0;
-  size_t expected = Length() > size ? size : Length();
-  size_t offset = 0;
-  size_t left = size;
-
-  while (bytes_read < expected) {
-    CHECK_LE(read_head_->read_pos_, read_head_->write_pos_);
-    size_t avail = read_head_->write_pos_ - read_head_->read_pos_;
-    if (avail > left)
-      avail = left;
-
-    // Copy data
-    if (out != nullptr)
-      memcpy(out + offset, read_head_->data_ + read_head_->read_pos_, avail);
-    read_head_->read_pos_ += avail;
-
-    // Move pointers
-    bytes_read += avail;
-    offset += avail;
-    left -= avail;
-
-    TryMoveReadHead();
+  size_t bytes_read = std::min(length_, size);
+  if (bytes_read == 0)
+    return 0;
+
+  // Copy data, wrapping around the end of the buffer if needed
+  size_t first = std::min(bytes_read, capacity_ - read_pos_);
+  if (out != nullptr) {
+    memcpy(out, data_ + read_pos_, first);
+    memcpy(out + first, data_, bytes_read - first);
   }
-  CHECK_EQ(expected, bytes_read);
+
+  // Move pointers
+  read_pos_ += bytes_read;
+  if (read_pos_ >= capacity_)
+    read_pos_ -= capacity_;
   length_ -= bytes_read;
 
-  // Free all empty buffers, but write_head's child
-  FreeEmpty();
+  // Everything that was peeked before this call has been consumed now, so
+  // the storage it pointed to may go away.
+  FreeRetired();
+
+  if (length_ == 0)
+    OnDrained();
 
   return bytes_read;
 }
 
 
-void NodeBIO::FreeEmpty() {
-  if (write_head_ == nullptr)
-    return;
-  Buffer* child = write_head_->next_;
-  if (child == write_head_ || child == read_head_)
-    return;
-  Buffer* cur = child->next_;
-  if (cur == write_head_ || cur == read_head_)
-    return;
-
-  Buffer* prev = child;
-  while (cur != read_head_) {
-    CHECK_NE(cur, write_head_);
-    CHECK_EQ(cur->write_pos_, cur->read_pos_);
+void NodeBIO::OnDrained() {
+  // Start over from the beginning so that the whole buffer is contiguous.
+  read_pos_ = 0;
 
-    Buffer* next = cur->next_;
-    delete cur;
-    cur = next;
+  // A burst of traffic can leave a large buffer behind. Shrink it once the
+  // data that passes through has stayed well below its size for a while.
+  if (capacity_ > 4 * kThroughputBufferLength &&
+      peak_length_ * 4 <= capacity_) {
+    if (++small_drains_ >= kShrinkAfterDrains) {
+      Resize(std::max(2 * peak_length_, kThroughputBufferLength));
+      small_drains_ = 0;
+    }
+  } else {
+    small_drains_ = 0;
   }
-  prev->next_ = cur;
+  peak_length_ = 0;
 }
 
 
 size_t NodeBIO::IndexOf(char delim, size_t limit) {
-  size_t bytes_read = 0;
   size_t max = Length() > limit ? limit : Length();
-  size_t left = limit;
-  Buffer* current = read_head_;
-
-  while (bytes_read < max) {
-    CHECK_LE(current->read_pos_, current->write_pos_);
-    size_t avail = current->write_pos_ - current->read_pos_;
-    if (avail > left)
-      avail = left;
-
-    // Walk through data
-    char* tmp = current->data_ + current->read_pos_;
-    size_t off = 0;
-    while (off < avail && *tmp != delim) {
-      off++;
-      tmp++;
-    }
+  if (max == 0)
+    return 0;
 
-    // Move pointers
-    bytes_read += off;
-    left -= off;
+  // Walk through the first segment, then the wrapped-around one
+  size_t first = std::min(max, capacity_ - read_pos_);
+  const char* found = static_cast<const char*>(
+      memchr(data_ + read_pos_, delim, first));
+  if (found != nullptr)
+    return found - (data_ + read_pos_);
 
-    // Found `delim`
-    if (off != avail) {
-      return bytes_read;
-    }
-
-    // Move to next buffer
-    if (current->read_pos_ + avail == current->len_) {
-      current = current->next_;
-    }
-  }
-  CHECK_EQ(max, bytes_read);
+  found = static_cast<const char*>(memchr(data_, delim, max - first));
+  if (found != nullptr)
+    return first + (found - data_);
 
   return max;
 }
 
 
 void NodeBIO::Write(const char* data, size_t size) {
-  size_t offset = 0;
-  size_t left = size;
-
-  // Allocate initial buffer if the ring is empty
-  TryAllocateForWrite(left);
-
-  while (left > 0) {
-    size_t to_write = left;
-    CHECK_LE(write_head_->write_pos_, write_head_->len_);
-    size_t avail = write_head_->len_ - write_head_->write_pos_;
-
-    if (to_write > avail)
-      to_write = avail;
-
-    // Copy data
-    memcpy(write_head_->data_ + write_head_->write_pos_,
-           data + offset,
-           to_write);
-
-    // Move pointers
-    left -= to_write;
-    offset += to_write;
-    length_ += to_write;
-    write_head_->write_pos_ += to_write;
-    CHECK_LE(write_head_->write_pos_, write_head_->len_);
-
-    // Go to next buffer if there still are some bytes to write
-    if (left != 0) {
-      CHECK_EQ(write_head_->write_pos_, write_head_->len_);
-      TryAllocateForWrite(left);
-      write_head_ = write_head_->next_;
-
-      // Additionally, since we're moved to the next buffer, read head
-      // may be moved as well.
-      TryMoveReadHead();
-    }
-  }
-  CHECK_EQ(left, 0);
+  if (size == 0)
+    return;
+
+  Reserve(size, 0);
+
+  // Copy data, wrapping around the end of the buffer if needed
+  size_t pos = write_pos();
+  size_t first = std::min(size, capacity_ - pos);
+  memcpy(data_ + pos, data, first);
+  memcpy(data_, data + first, size - first);
+
+  length_ += size;
+  peak_length_ = std::max(peak_length_, length_);
 }
 
 
 char* NodeBIO::PeekWritable(size_t* size) {
-  TryAllocateForWrite(*size);
-
-  size_t available = write_head_->len_ - write_head_->write_pos_;
-  if (*size == 0 || available <= *size)
+  // The first allocation is sized after the request, later ones make sure
+  // that at least a full TLS record fits in a single block.
+  size_t wanted = *size;
+  size_t contiguous = capacity_ == 0 ?
+      wanted : std::min(wanted, kThroughputBufferLength);
+  if (contiguous == 0)
+    contiguous = 1;
+  Reserve(contiguous, contiguous);
+
+  size_t available = contiguous_free();
+  if (wanted == 0 || available <= wanted)
     *size = available;
 
-  return write_head_->data_ + write_head_->write_pos_;
+  return data_ + write_pos();
 }
 
 
 void NodeBIO::Commit(size_t size) {
-  write_head_->write_pos_ += size;
+  CHECK_LE(size, contiguous_free());
   length_ += size;
-  CHECK_LE(write_head_->write_pos_, write_head_->len_);
+  peak_length_ = std::max(peak_length_, length_);
+}
+
 
-  // Allocate new buffer if write head is full,
-  // and there're no other place to go
-  TryAllocateForWrite(0);
-  if (write_head_->write_pos_ == write_head_->len_) {
-    write_head_ = write_head_->next_;
+void NodeBIO::Reserve(size_t size, size_t contiguous) {
+  if (length_ == 0)
+    read_pos_ = 0;
 
-    // Additionally, since we're moved to the next buffer, read head
-    // may be moved as well.
-    TryMoveReadHead();
+  if (capacity_ - length_ >= size && contiguous_free() >= contiguous)
+    return;
+
+  size_t capacity;
+  if (capacity_ == 0) {
+    capacity = std::max(initial_, size);
+  } else if (capacity_ - length_ >= size) {
+    // There is enough room, it is just split around the data.
+    capacity = capacity_;
+  } else {
+    capacity = std::max(2 * capacity_, length_ + size);
   }
+
+  // If there is a one time allocation size hint, use it.
+  if (length_ + allocate_hint_ > capacity)
+    capacity = length_ + allocate_hint_;
+  allocate_hint_ = 0;
+
+  Resize(capacity);
 }
 
 
-void NodeBIO::TryAllocateForWrite(size_t hint) {
-  Buffer* w = write_head_;
-  Buffer* r = read_head_;
-  // If write head is full, next buffer is either read head or not empty.
-  if (w == nullptr ||
-      (w->write_pos_ == w->len_ &&
-       (w->next_ == r || w->next_->write_pos_ != 0))) {
-    size_t len = w == nullptr ? initial_ :
-                             kThroughputBufferLength;
-    if (len < hint)
-      len = hint;
-
-    // If there is a one time allocation size hint, use it.
-    if (allocate_hint_ > len) {
-      len = allocate_hint_;
-      allocate_hint_ = 0;
-    }
+void NodeBIO::Resize(size_t capacity) {
+  CHECK_GE(capacity, length_);
 
-    Buffer* next = new Buffer(env_, len);
+  char* data = new char[capacity];
+  size_t first = std::min(length_, capacity_ - read_pos_);
+  if (length_ > 0) {
+    memcpy(data, data_ + read_pos_, first);
+    memcpy(data + first, data_, length_ - first);
+  }
 
-    if (w == nullptr) {
-      next->next_ = next;
-      write_head_ = next;
-      read_head_ = next;
+  // Data that was handed out through Peek() or PeekMultiple() may still be
+  // in use (e.g. by a pending write), so keep the old storage around until
+  // the next Read().
+  if (data_ != nullptr) {
+    if (length_ > 0) {
+      retired_.emplace_back(data_, capacity_);
     } else {
-      next->next_ = w->next_;
-      w->next_ = next;
+      delete[] data_;
+      AdjustExternalMemory(-static_cast<int64_t>(capacity_));
     }
   }
-}
+  AdjustExternalMemory(capacity);
 
+  data_ = data;
+  capacity_ = capacity;
+  read_pos_ = 0;
+}
 
-void NodeBIO::Reset() {
-  if (read_head_ == nullptr)
-    return;
 
-  while (read_head_->read_pos_ != read_head_->write_pos_) {
-    CHECK(read_head_->write_pos_ > read_head_->read_pos_);
+void NodeBIO::FreeRetired() {
+  for (const auto& buffer : retired_) {
+    delete[] buffer.first;
+    AdjustExternalMemory(-static_cast<int64_t>(buffer.second));
+  }
+  retired_.clear();
+}
 
-    length_ -= read_head_->write_pos_ - read_head_->read_pos_;
-    read_head_->write_pos_ = 0;
-    read_head_->read_pos_ = 0;
 
-    read_head_ = read_head_->next_;
-  }
-  write_head_ = read_head_;
-  CHECK_EQ(length_, 0);
+void NodeBIO::AdjustExternalMemory(int64_t change) {
+  if (env_ != nullptr)
+    env_->isolate()->AdjustAmountOfExternalAllocatedMemory(change);
 }
 
 
-NodeBIO::~NodeBIO() {
-  if (read_head_ == nullptr)
-    return;
+void NodeBIO::Reset() {
+  read_pos_ = 0;
+  length_ = 0;
+}
 
-  Buffer* current = read_head_;
-  do {
-    Buffer* next = current->next_;
-    delete current;
-    current = next;
-  } while (current != read_head_);
 
-  read_head_ = nullptr;
-  write_head_ = nullptr;
+NodeBIO::~NodeBIO() {
+  FreeRetired();
+  delete[] data_;
+  AdjustExternalMemory(-static_cast<int64_t>(capacity_));
+  data_ = nullptr;
+  capacity_ = 0;
 }
 
 
@@ -29,13 +29,17 @@
 #include "util.h"
 #include "v8.h"
 
+#include <utility>
+#include <vector>
+
 namespace node {
 
 class Environment;
 
 namespace crypto {
-// This class represents buffers for OpenSSL I/O, implemented as a singly-linked
-// list of chunks. It can be used either for writing data from Node to OpenSSL,
+// This class represents buffers for OpenSSL I/O, implemented as a contiguous
+// ring buffer that grows to fit the data passing through it and shrinks back
+// after bursts. It can be used either for writing data from Node to OpenSSL,
 // or for reading data back, but not both.
 // The structure is only accessed, and owned by, the OpenSSL BIOPointer
 // (a.k.a. std::unique_ptr<BIO>).
@@ -50,25 +54,17 @@ class NodeBIO : public MemoryRetainer {
   static BIOPointer NewFixed(const char* data, size_t len,
                              Environment* env = nullptr);
 
-  // Move read head to next buffer if needed
-  void TryMoveReadHead();
-
-  // Allocate new buffer for write if needed
-  void TryAllocateForWrite(size_t hint);
-
   // Read `len` bytes maximum into `out`, return actual number of read bytes
   size_t Read(char* out, size_t size);
 
-  // Memory optimization:
-  // Deallocate children of write head's child if they're empty
-  void FreeEmpty();
-
   // Return pointer to internal data and amount of
-  // contiguous data available to read
+  // contiguous data available to read. The pointer stays valid until the
+  // next call to Read().
   char* Peek(size_t* size);
 
-  // Return pointers and sizes of multiple internal data chunks available for
-  // reading
+  // Return pointers and sizes of the (at most two) internal data segments
+  // available for reading. Like Peek(), the pointers stay valid until the
+  // next call to Read().
   size_t PeekMultiple(char** out, size_t* size, size_t* count);
 
   // Find first appearance of `delim` in buffer or `limit` if `delim`
@@ -95,14 +91,18 @@ class NodeBIO : public MemoryRetainer {
     return length_;
   }
 
+  // Return the number of bytes currently allocated for the buffer
+  inline size_t Capacity() const {
+    return capacity_;
+  }
+
   // Provide a hint about the size of the next pending set of writes. TLS
   // writes records of a maximum length of 16k of data plus a 5-byte header,
   // a MAC (up to 20 bytes for SSLv3, TLS 1.0, TLS 1.1, and up to 32 bytes
   // for TLS 1.2), and padding if a block cipher is used.  If there is a
-  // large write this will result in potentially many buffers being
-  // allocated and gc'ed which can cause long pauses. By providing a
-  // guess about the amount of buffer space that will be needed in the
-  // next allocation this overhead is removed.
+  // large write this would otherwise make the buffer grow several times in
+  // a row. By providing a guess about the amount of buffer space that will
+  // be needed, the buffer grows to the right size at once.
   inline void set_allocate_tls_hint(size_t size) {
     constexpr size_t kThreshold = 16 * 1024;
     if (size >= kThreshold) {
@@ -125,7 +125,7 @@ class NodeBIO : public MemoryRetainer {
   static NodeBIO* FromBIO(BIO* bio);
 
   void MemoryInfo(MemoryTracker* tracker) const override {
-    tracker->TrackFieldWithSize("buffer", length_, "NodeBIO::Buffer");
+    tracker->TrackFieldWithSize("buffer", capacity_, "NodeBIO::Buffer");
   }
 
   SET_MEMORY_INFO_NAME(NodeBIO)
@@ -144,44 +144,54 @@ class NodeBIO : public MemoryRetainer {
   static const BIO_METHOD* GetMethod();
 
   // Enough to handle the most of the client hellos
-  static const size_t kInitialBufferLength = 1024;
-  static const size_t kThroughputBufferLength = 16384;
-
-  class Buffer {
-   public:
-    Buffer(Environment* env, size_t len) : env_(env),
-                                           read_pos_(0),
-                                           write_pos_(0),
-                                           len_(len),
-                                           next_(nullptr) {
-      data_ = new char[len];
-      if (env_ != nullptr)
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len);
-    }
+  static constexpr size_t kInitialBufferLength = 1024;
+  static constexpr size_t kThroughputBufferLength = 16384;
+  // The buffer shrinks back once it has drained this many times in a row
+  // while holding no more than a quarter of its capacity.
+  static constexpr size_t kShrinkAfterDrains = 16;
+
+  // Offset at which the next byte will be written.
+  inline size_t write_pos() const {
+    size_t pos = read_pos_ + length_;
+    return pos >= capacity_ ? pos - capacity_ : pos;
+  }
 
-    ~Buffer() {
-      delete[] data_;
-      if (env_ != nullptr) {
-        const int64_t len = static_cast<int64_t>(len_);
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
-      }
-    }
+  // Amount of free space available in a single block at write_pos().
+  inline size_t contiguous_free() const {
+    size_t end = read_pos_ + length_;
+    return end < capacity_ ? capacity_ - end : capacity_ - length_;
+  }
+
+  // Make sure that at least `size` more bytes fit, and that `contiguous` of
+  // them are available in a single block at write_pos().
+  void Reserve(size_t size, size_t contiguous);
+
+  // Reallocate the buffer with `capacity` bytes, moving the readable data to
+  // the front.
+  void Resize(size_t capacity);
 
-    Environment* env_;
-    size_t read_pos_;
-    size_t write_pos_;
-    size_t len_;
-    Buffer* next_;
-    char* data_;
-  };
+  // Release storage that was replaced by Resize().
+  void FreeRetired();
+
+  // Called when the last readable byte has been consumed.
+  void OnDrained();
+
+  void AdjustExternalMemory(int64_t change);
 
   Environment* env_ = nullptr;
   size_t initial_ = kInitialBufferLength;
-  size_t length_ = 0;
   size_t allocate_hint_ = 0;
   int eof_return_ = -1;
-  Buffer* read_head_ = nullptr;
-  Buffer* write_head_ = nullptr;
+  char* data_ = nullptr;
+  size_t capacity_ = 0;
+  size_t read_pos_ = 0;
+  size_t length_ = 0;
+  // Most data held at once since the buffer last drained, and the number of
+  // consecutive drains after which the buffer could have been much smaller.
+  size_t peak_length_ = 0;
+  size_t small_drains_ = 0;
+  // Storage replaced by Resize() while Peek()ed data may still point into it.
+  std::vector<std::pair<char*, size_t>> retired_;
 };
 
 }  // namespace crypto
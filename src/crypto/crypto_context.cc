@@ -1,6 +1,7 @@
 #include "crypto/crypto_context.h"
 #include "crypto/crypto_bio.h"
 #include "crypto/crypto_common.h"
+#include "crypto/crypto_tls.h"
 #include "crypto/crypto_util.h"
 #include "base_object-inl.h"
 #include "env-inl.h"
@@ -11,6 +12,7 @@
 #include "util.h"
 #include "v8.h"
 
+#include <openssl/async.h>
 #include <openssl/x509.h>
 #include <openssl/pkcs12.h>
 #include <openssl/rand.h>
@@ -279,6 +281,8 @@ Local<FunctionTemplate> SecureContext::GetConstructorTemplate(
     SetProtoMethod(isolate, tmpl, "setCipherSuites", SetCipherSuites);
     SetProtoMethod(isolate, tmpl, "setCiphers", SetCiphers);
     SetProtoMethod(isolate, tmpl, "setSigalgs", SetSigalgs);
+    SetProtoMethod(
+        isolate, tmpl, "enablePrivateKeyOffload", EnablePrivateKeyOffload);
     SetProtoMethod(isolate, tmpl, "setECDHCurve", SetECDHCurve);
     SetProtoMethod(isolate, tmpl, "setDHParam", SetDHParam);
     SetProtoMethod(isolate, tmpl, "setMaxProto", SetMaxProto);
@@ -358,6 +362,7 @@ void SecureContext::RegisterExternalReferences(
   registry->Register(SetCipherSuites);
   registry->Register(SetCiphers);
   registry->Register(SetSigalgs);
+  registry->Register(EnablePrivateKeyOffload);
   registry->Register(SetECDHCurve);
   registry->Register(SetDHParam);
   registry->Register(SetMaxProto);
@@ -625,6 +630,152 @@ void SecureContext::SetKey(const FunctionCallbackInfo<Value>& args) {
     return ThrowCryptoError(env, ERR_get_error(), "SSL_CTX_use_PrivateKey");
 }
 
+namespace {
+// RSA and EC key methods that behave like OpenSSL's defaults, except that the
+// private key operations are handed to TLSWrap::OffloadPrivateKeyOperation().
+// A key with a non-default method is "foreign" to OpenSSL 3, so libssl keeps
+// using these methods instead of the provider implementation.
+int OffloadedRSAPrivateEncrypt(int flen,
+                               const unsigned char* from,
+                               unsigned char* to,
+                               RSA* rsa,
+                               int padding) {
+  return TLSWrap::OffloadPrivateKeyOperation([=]() {
+    return RSA_meth_get_priv_enc(RSA_PKCS1_OpenSSL())(
+        flen, from, to, rsa, padding);
+  }, -1);
+}
+
+int OffloadedRSAPrivateDecrypt(int flen,
+                               const unsigned char* from,
+                               unsigned char* to,
+                               RSA* rsa,
+                               int padding) {
+  return TLSWrap::OffloadPrivateKeyOperation([=]() {
+    return RSA_meth_get_priv_dec(RSA_PKCS1_OpenSSL())(
+        flen, from, to, rsa, padding);
+  }, -1);
+}
+
+using ECDSASignFn = int (*)(int type,
+                            const unsigned char* dgst,
+                            int dlen,
+                            unsigned char* sig,
+                            unsigned int* siglen,
+                            const BIGNUM* kinv,
+                            const BIGNUM* r,
+                            EC_KEY* eckey);
+
+ECDSASignFn DefaultECDSASign() {
+  ECDSASignFn sign = nullptr;
+  EC_KEY_METHOD_get_sign(EC_KEY_OpenSSL(), &sign, nullptr, nullptr);
+  return sign;
+}
+
+int OffloadedECDSASign(int type,
+                       const unsigned char* dgst,
+                       int dlen,
+                       unsigned char* sig,
+                       unsigned int* siglen,
+                       const BIGNUM* kinv,
+                       const BIGNUM* r,
+                       EC_KEY* eckey) {
+  return TLSWrap::OffloadPrivateKeyOperation([=]() {
+    return DefaultECDSASign()(type, dgst, dlen, sig, siglen, kinv, r, eckey);
+  }, 0);
+}
+
+const RSA_METHOD* OffloadedRSAMethod() {
+  // Guaranteed thread-safe by standard, just don't use -fno-threadsafe-statics.
+  static RSA_METHOD* method = []() {
+    RSA_METHOD* method = RSA_meth_dup(RSA_PKCS1_OpenSSL());
+    CHECK_NOT_NULL(method);
+    CHECK_EQ(RSA_meth_set_priv_enc(method, OffloadedRSAPrivateEncrypt), 1);
+    CHECK_EQ(RSA_meth_set_priv_dec(method, OffloadedRSAPrivateDecrypt), 1);
+    return method;
+  }();
+  return method;
+}
+
+const EC_KEY_METHOD* OffloadedECKeyMethod() {
+  static EC_KEY_METHOD* method = []() {
+    EC_KEY_METHOD* method = EC_KEY_METHOD_new(EC_KEY_OpenSSL());
+    CHECK_NOT_NULL(method);
+    int (*sign_setup)(EC_KEY*, BN_CTX*, BIGNUM**, BIGNUM**) = nullptr;
+    ECDSA_SIG* (*sign_sig)(const unsigned char*, int, const BIGNUM*,
+                           const BIGNUM*, EC_KEY*) = nullptr;
+    EC_KEY_METHOD_get_sign(EC_KEY_OpenSSL(), nullptr, &sign_setup, &sign_sig);
+    EC_KEY_METHOD_set_sign(method, OffloadedECDSASign, sign_setup, sign_sig);
+    return method;
+  }();
+  return method;
+}
+
+// Returns a copy of |pkey| that uses the offloading key methods, or nullptr
+// if keys of its type are not offloaded.
+EVPKeyPointer NewOffloadedPrivateKey(EVP_PKEY* pkey) {
+  EVPKeyPointer offloaded(EVP_PKEY_new());
+  if (!offloaded)
+    return EVPKeyPointer();
+
+  switch (EVP_PKEY_id(pkey)) {
+    case EVP_PKEY_RSA: {
+      RSAPointer rsa(EVP_PKEY_get1_RSA(pkey));
+      RSAPointer copy(rsa ? RSAPrivateKey_dup(rsa.get()) : nullptr);
+      if (!copy ||
+          !RSA_set_method(copy.get(), OffloadedRSAMethod()) ||
+          !EVP_PKEY_assign_RSA(offloaded.get(), copy.get())) {
+        return EVPKeyPointer();
+      }
+      copy.release();
+      return offloaded;
+    }
+    case EVP_PKEY_EC: {
+      const EC_KEY* ec = EVP_PKEY_get0_EC_KEY(pkey);
+      ECKeyPointer copy(ec != nullptr ? EC_KEY_dup(ec) : nullptr);
+      if (!copy ||
+          !EC_KEY_set_method(copy.get(), OffloadedECKeyMethod()) ||
+          !EVP_PKEY_assign_EC_KEY(offloaded.get(), copy.get())) {
+        return EVPKeyPointer();
+      }
+      copy.release();
+      return offloaded;
+    }
+    default:
+      return EVPKeyPointer();
+  }
+}
+}  // namespace
+
+// Switches the RSA and ECDSA private keys already loaded into the context to
+// key methods that run their operations on the threadpool during handshakes.
+// Returns false, leaving the keys alone, if OpenSSL cannot run async jobs on
+// this platform.
+void SecureContext::EnablePrivateKeyOffload(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+  Environment* env = sc->env();
+  ClearErrorOnReturn clear_error_on_return;
+
+  if (!ASYNC_is_capable())
+    return args.GetReturnValue().Set(false);
+
+  SSL_CTX* ctx = sc->ctx_.get();
+  for (int rv = SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_FIRST); rv == 1;
+       rv = SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_NEXT)) {
+    EVP_PKEY* pkey = SSL_CTX_get0_privatekey(ctx);
+    if (pkey == nullptr)
+      continue;
+    EVPKeyPointer offloaded = NewOffloadedPrivateKey(pkey);
+    if (offloaded && !SSL_CTX_use_PrivateKey(ctx, offloaded.get()))
+      return ThrowCryptoError(env, ERR_get_error(), "SSL_CTX_use_PrivateKey");
+  }
+
+  sc->private_key_offload_ = true;
+  args.GetReturnValue().Set(true);
+}
+
 void SecureContext::SetSigalgs(const FunctionCallbackInfo<Value>& args) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
@@ -1170,6 +1321,12 @@ int SecureContext::TicketKeyCallback(SSL* ssl,
                                      int enc) {
   static const int kTicketPartSize = 16;
 
+  if (TLSWrap::IsInAsyncJob()) {
+    return TLSWrap::RunOnLoopStack([=]() {
+      return TicketKeyCallback(ssl, name, iv, ectx, hctx, enc);
+    });
+  }
+
   SecureContext* sc = static_cast<SecureContext*>(
       SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
 
@@ -55,6 +55,10 @@ class SecureContext final : public BaseObject {
   void SetNewSessionCallback(NewSessionCb cb);
   void SetSelectSNIContextCallback(SelectSNIContextCb cb);
 
+  // Whether private keys were switched to threadpool-backed methods by
+  // EnablePrivateKeyOffload(); see TLSWrap::OffloadPrivateKeyOperation().
+  bool private_key_offload() const { return private_key_offload_; }
+
   inline const X509Pointer& issuer() const { return issuer_; }
   inline const X509Pointer& cert() const { return cert_; }
 
@@ -96,6 +100,8 @@ class SecureContext final : public BaseObject {
   static void SetCipherSuites(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetCiphers(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetSigalgs(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnablePrivateKeyOffload(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetECDHCurve(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetDHParam(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetOptions(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -147,6 +153,7 @@ class SecureContext final : public BaseObject {
   bool client_cert_engine_provided_ = false;
   EnginePointer private_key_engine_;
 #endif  // !OPENSSL_NO_ENGINE
+  bool private_key_offload_ = false;
 
   unsigned char ticket_key_name_[16];
   unsigned char ticket_key_aes_[16];
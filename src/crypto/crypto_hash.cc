@@ -11,6 +11,7 @@
 
 namespace node {
 
+using v8::Array;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -69,6 +70,7 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
   SetMethodNoSideEffect(context, target, "getHashes", GetHashes);
 
   HashJob::Initialize(env, target);
+  HashManyJob::Initialize(env, target);
 
   SetMethodNoSideEffect(
       context, target, "internalVerifyIntegrity", InternalVerifyIntegrity);
@@ -81,6 +83,7 @@ void Hash::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GetHashes);
 
   HashJob::RegisterExternalReferences(registry);
+  HashManyJob::RegisterExternalReferences(registry);
 
   registry->Register(InternalVerifyIntegrity);
 }
@@ -315,6 +318,160 @@ bool HashTraits::DeriveBits(
   return true;
 }
 
+HashManyConfig::HashManyConfig(HashManyConfig&& other) noexcept
+    : mode(other.mode),
+      storage(std::move(other.storage)),
+      in(std::move(other.in)),
+      digest(other.digest),
+      length(other.length) {}
+
+HashManyConfig& HashManyConfig::operator=(HashManyConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~HashManyConfig();
+  return *new (this) HashManyConfig(std::move(other));
+}
+
+void HashManyConfig::MemoryInfo(MemoryTracker* tracker) const {
+  // If the Job is sync, then the HashManyConfig does not own the data.
+  if (mode == kCryptoJobAsync)
+    tracker->TrackFieldWithSize("storage", storage.size());
+  tracker->TrackFieldWithSize("in", in.capacity() * sizeof(ByteSource));
+}
+
+Maybe<bool> HashManyTraits::EncodeOutput(
+    Environment* env,
+    const HashManyConfig& params,
+    ByteSource* out,
+    v8::Local<v8::Value>* result) {
+  *result = out->ToArrayBuffer(env);
+  return Just(!result->IsEmpty());
+}
+
+Maybe<bool> HashManyTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    HashManyConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  params->mode = mode;
+
+  CHECK(args[offset]->IsString());  // Hash algorithm
+  Utf8Value digest(env->isolate(), args[offset]);
+  params->digest = EVP_get_digestbyname(*digest);
+  if (UNLIKELY(params->digest == nullptr)) {
+    THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Invalid digest: %s", *digest);
+    return Nothing<bool>();
+  }
+
+  CHECK(args[offset + 1]->IsArray());  // Inputs
+  Local<Array> inputs = args[offset + 1].As<Array>();
+  uint32_t count = inputs->Length();
+
+  std::vector<std::pair<const char*, size_t>> contents;
+  contents.reserve(count);
+  size_t total = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> input;
+    if (!inputs->Get(env->context(), i).ToLocal(&input))
+      return Nothing<bool>();
+    CHECK(IsAnyByteSource(input));
+    ArrayBufferOrViewContents<char> data(input);
+    if (UNLIKELY(!data.CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+      return Nothing<bool>();
+    }
+    contents.emplace_back(data.size() > 0 ? data.data() : nullptr,
+                          data.size());
+    total += data.size();
+  }
+
+  // Async jobs copy all inputs into a single allocation rather than one
+  // allocation per input.
+  char* copy = nullptr;
+  if (mode == kCryptoJobAsync && total > 0) {
+    ByteSource::Builder storage(total);
+    copy = storage.data<char>();
+    params->storage = std::move(storage).release();
+  }
+
+  params->in.reserve(count);
+  for (const auto& [data, size] : contents) {
+    if (copy != nullptr && size > 0) {
+      memcpy(copy, data, size);
+      params->in.push_back(ByteSource::Foreign(copy, size));
+      copy += size;
+    } else {
+      params->in.push_back(ByteSource::Foreign(data, size));
+    }
+  }
+
+  unsigned int expected = EVP_MD_size(params->digest);
+  params->length = expected;
+  if (UNLIKELY(args[offset + 2]->IsUint32())) {
+    // length is expressed in terms of bits
+    params->length =
+        static_cast<uint32_t>(args[offset + 2]
+            .As<Uint32>()->Value()) / CHAR_BIT;
+    if (params->length != expected) {
+      if ((EVP_MD_flags(params->digest) & EVP_MD_FLAG_XOF) == 0) {
+        THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Digest method not supported");
+        return Nothing<bool>();
+      }
+    }
+  }
+
+  return Just(true);
+}
+
+bool HashManyTraits::DeriveBits(
+    Environment* env,
+    const HashManyConfig& params,
+    ByteSource* out) {
+  const size_t count = params.in.size();
+  const unsigned int length = params.length;
+  if (count == 0 || length == 0)
+    return true;
+
+#if OPENSSL_VERSION_MAJOR >= 3
+  // Fetch the implementation once, EVP_DigestInit_ex() would otherwise
+  // look it up again for every input.
+  DeleteFnPtr<EVP_MD, EVP_MD_free> fetched(
+      EVP_MD_fetch(nullptr, EVP_MD_get0_name(params.digest), nullptr));
+  const EVP_MD* md = fetched ? fetched.get() : params.digest;
+#else
+  const EVP_MD* md = params.digest;
+#endif
+
+  EVPMDPointer ctx(EVP_MD_CTX_new());
+  if (UNLIKELY(!ctx))
+    return false;
+
+  const bool xof = length != static_cast<unsigned int>(EVP_MD_size(md));
+  ByteSource::Builder buf(count * length);
+  unsigned char* digest = buf.data<unsigned char>();
+
+  for (const ByteSource& in : params.in) {
+    if (UNLIKELY(EVP_DigestInit_ex(ctx.get(), md, nullptr) <= 0 ||
+                 (in.size() > 0 &&
+                  EVP_DigestUpdate(ctx.get(), in.data<char>(), in.size()) <=
+                      0))) {
+      return false;
+    }
+
+    unsigned int digest_length = length;
+    int ret = xof ? EVP_DigestFinalXOF(ctx.get(), digest, length)
+                  : EVP_DigestFinal_ex(ctx.get(), digest, &digest_length);
+    if (UNLIKELY(ret != 1))
+      return false;
+
+    digest += length;
+  }
+
+  *out = std::move(buf).release();
+  return true;
+}
+
 void InternalVerifyIntegrity(const v8::FunctionCallbackInfo<v8::Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -10,6 +10,8 @@
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 class Hash final : public BaseObject {
@@ -82,6 +84,53 @@ struct HashTraits final {
 
 using HashJob = DeriveBitsJob<HashTraits>;
 
+// Computes the digests of many independent inputs in one job, reusing a
+// single EVP_MD_CTX. The output is the concatenation of all digests.
+struct HashManyConfig final : public MemoryRetainer {
+  CryptoJobMode mode;
+  // In async mode, a copy of all inputs that the entries of `in` point into.
+  ByteSource storage;
+  std::vector<ByteSource> in;
+  const EVP_MD* digest;
+  unsigned int length;
+
+  HashManyConfig() = default;
+
+  explicit HashManyConfig(HashManyConfig&& other) noexcept;
+
+  HashManyConfig& operator=(HashManyConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(HashManyConfig)
+  SET_SELF_SIZE(HashManyConfig)
+};
+
+struct HashManyTraits final {
+  using AdditionalParameters = HashManyConfig;
+  static constexpr const char* JobName = "HashManyJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+
+  static v8::Maybe<bool> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      HashManyConfig* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const HashManyConfig& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const HashManyConfig& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using HashManyJob = DeriveBitsJob<HashManyTraits>;
+
 void InternalVerifyIntegrity(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 }  // namespace crypto
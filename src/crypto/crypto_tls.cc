@@ -31,8 +31,14 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "stream_base-inl.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#include <openssl/async.h>
+
+#include <algorithm>
+#include <climits>
+
 namespace node {
 
 using v8::Array;
@@ -64,6 +70,38 @@ using v8::Value;
 namespace crypto {
 
 namespace {
+// The TLSWrap whose SSL_read() is currently running with SSL_MODE_ASYNC, if
+// any. Async jobs only ever start or resume inside such a call.
+thread_local TLSWrap* current_async_job_wrap = nullptr;
+
+// Enables SSL_MODE_ASYNC for the duration of one SSL_read() on |ssl| if the
+// handshake is still in progress and private key offload is in use, and
+// publishes |wrap| to the key methods and callbacks that run inside the job.
+class AsyncJobScope {
+ public:
+  AsyncJobScope(TLSWrap* wrap, SSL* ssl, bool enable)
+      : previous_(current_async_job_wrap),
+        ssl_(enable && (SSL_waiting_for_async(ssl) ||
+                        !SSL_is_init_finished(ssl)) ? ssl : nullptr) {
+    if (ssl_ == nullptr) return;
+    current_async_job_wrap = wrap;
+    SSL_set_mode(ssl_, SSL_MODE_ASYNC);
+  }
+
+  ~AsyncJobScope() {
+    if (ssl_ == nullptr) return;
+    SSL_clear_mode(ssl_, SSL_MODE_ASYNC);
+    current_async_job_wrap = previous_;
+  }
+
+  AsyncJobScope(const AsyncJobScope&) = delete;
+  AsyncJobScope& operator=(const AsyncJobScope&) = delete;
+
+ private:
+  TLSWrap* previous_;
+  SSL* ssl_;
+};
+
 SSL_SESSION* GetSessionCallback(
     SSL* s,
     const unsigned char* key,
@@ -112,6 +150,14 @@ void OnClientHello(
 }
 
 void KeylogCallback(const SSL* s, const char* line) {
+  if (TLSWrap::IsInAsyncJob()) {
+    TLSWrap::RunOnLoopStack([=]() {
+      KeylogCallback(s, line);
+      return 0;
+    });
+    return;
+  }
+
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   Environment* env = w->env();
   HandleScope handle_scope(env->isolate());
@@ -129,6 +175,11 @@ void KeylogCallback(const SSL* s, const char* line) {
 }
 
 int NewSessionCallback(SSL* s, SSL_SESSION* sess) {
+  if (TLSWrap::IsInAsyncJob()) {
+    return TLSWrap::RunOnLoopStack(
+        [=]() { return NewSessionCallback(s, sess); });
+  }
+
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   Environment* env = w->env();
   HandleScope handle_scope(env->isolate());
@@ -189,6 +240,10 @@ int SSLCertCallback(SSL* s, void* arg) {
     // handshake will continue after certcb is done.
     return -1;
 
+  if (TLSWrap::IsInAsyncJob()) {
+    return TLSWrap::RunOnLoopStack([=]() { return SSLCertCallback(s, arg); });
+  }
+
   Environment* env = w->env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -225,6 +280,12 @@ int SelectALPNCallback(
     void* arg) {
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   if (w->alpn_callback_enabled_) {
+    if (TLSWrap::IsInAsyncJob()) {
+      return TLSWrap::RunOnLoopStack([=]() {
+        return SelectALPNCallback(s, out, outlen, in, inlen, arg);
+      });
+    }
+
     Environment* env = w->env();
     HandleScope handle_scope(env->isolate());
 
@@ -283,6 +344,11 @@ int SelectALPNCallback(
 }
 
 int TLSExtStatusCallback(SSL* s, void* arg) {
+  if (TLSWrap::IsInAsyncJob()) {
+    return TLSWrap::RunOnLoopStack(
+        [=]() { return TLSExtStatusCallback(s, arg); });
+  }
+
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   Environment* env = w->env();
   HandleScope handle_scope(env->isolate());
@@ -546,6 +612,14 @@ void TLSWrap::SSLInfoCallback(const SSL* ssl_, int where, int ret) {
   if (!(where & (SSL_CB_HANDSHAKE_START | SSL_CB_HANDSHAKE_DONE)))
     return;
 
+  if (IsInAsyncJob()) {
+    RunOnLoopStack([=]() {
+      SSLInfoCallback(ssl_, where, ret);
+      return 0;
+    });
+    return;
+  }
+
   // SSL_renegotiate_pending() should take `const SSL*`, but it does not.
   SSL* ssl = const_cast<SSL*>(ssl_);
   TLSWrap* c = static_cast<TLSWrap*>(SSL_get_app_data(ssl_));
@@ -748,14 +822,78 @@ void TLSWrap::ClearOut() {
     return;
   }
 
+  // The paused async job can only be resumed once it has what it waits for.
+  if (private_key_op_pending_ || in_loop_stack_callback_) {
+    Debug(this, "Returning from ClearOut(), async job is waiting");
+    return;
+  }
+
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
   char out[kClearOutChunkSize];
   int read;
+  int err = SSL_ERROR_NONE;
   for (;;) {
-    read = SSL_read(ssl_.get(), out, sizeof(out));
+    // Decrypt the next record, if there is one, without consuming it. Only
+    // then is a buffer obtained from the stream listener, sized to the
+    // cleartext that is available, so that attempts which produce no
+    // cleartext do not allocate. For JS streams, that buffer is the memory
+    // that ends up in the ArrayBuffer passed to onread.
+    int pending = SSL_pending(ssl_.get());
+    if (pending <= 0) {
+      char probe;
+      {
+        AsyncJobScope async_job_scope(this, ssl_.get(), UsePrivateKeyOffload());
+        read = SSL_peek(ssl_.get(), &probe, 1);
+      }
+      if (read <= 0) {
+        // SSL_get_error must be called immediately after SSL_peek.
+        err = SSL_get_error(ssl_.get(), read);
+        Debug(this, "No cleartext output available");
+
+        // The job paused to have a callback run on this stack. Run it and
+        // resume the job, unless the callback destroyed the connection.
+        if (RunLoopStackCallback()) {
+          if (ssl_ == nullptr)
+            return;
+          continue;
+        }
+        break;
+      }
+      pending = std::max(SSL_pending(ssl_.get()), read);
+    }
+
+    uv_buf_t buf = EmitAlloc(std::min(pending, kClearOutChunkSize));
+    bool direct = buf.base != nullptr && buf.len > 0;
+    if (!direct) {
+      EmitRead(0, buf);
+      if (ssl_ == nullptr)
+        return;
+      buf = uv_buf_init(out, sizeof(out));
+    }
+
+    // The cleartext has already been decrypted, so this does not block.
+    read = SSL_read(ssl_.get(), buf.base, std::min<size_t>(buf.len, INT_MAX));
     Debug(this, "Read %d bytes of cleartext output", read);
 
+    // SSL_get_error must be called immediately after SSL_read, before
+    // handing the buffer back may call into JS.
+    if (read <= 0)
+      err = SSL_get_error(ssl_.get(), read);
+
+    if (direct) {
+      EmitRead(read > 0 ? read : 0, buf);
+
+      // Caveat emptor: see below.
+      if (ssl_ == nullptr) {
+        Debug(this, "Returning from read loop, ssl_ == nullptr");
+        return;
+      }
+
+      if (read > 0)
+        continue;
+    }
+
     if (read <= 0)
       break;
 
@@ -787,11 +925,10 @@ void TLSWrap::ClearOut() {
   // See node#1642 and SSL_read(3SSL) for details. SSL_get_error must be
   // called immediately after SSL_read, without calling into JS, which may
   // change OpenSSL's error queue, modify ssl_, or even destroy ssl_
-  // altogether.
+  // altogether, which is why `err` was recorded in the loop above.
   if (read <= 0) {
     HandleScope handle_scope(env()->isolate());
     Local<Value> error;
-    int err = SSL_get_error(ssl_.get(), read);
     switch (err) {
       case SSL_ERROR_ZERO_RETURN:
         if (!eof_) {
@@ -868,6 +1005,12 @@ void TLSWrap::ClearIn() {
     return;
   }
 
+  // SSL_write() would resume the async job paused in SSL_read().
+  if (SSL_waiting_for_async(ssl_.get())) {
+    Debug(this, "Returning from ClearIn(), async job is waiting");
+    return;
+  }
+
   std::unique_ptr<BackingStore> bs = std::move(pending_cleartext_input_);
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
@@ -1019,6 +1162,10 @@ int TLSWrap::DoWrite(WriteWrap* w,
 
   int written = 0;
 
+  // SSL_write() would resume the async job paused in SSL_read(), so hold the
+  // data for ClearIn() as if SSL_write() had asked to be retried.
+  const bool async_job_waiting = SSL_waiting_for_async(ssl_.get());
+
   // It is common for zero length buffers to be written,
   // don't copy data if there there is one buffer with data
   // and one or more zero length buffers.
@@ -1040,12 +1187,18 @@ int TLSWrap::DoWrite(WriteWrap* w,
     }
 
     NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(length);
-    written = SSL_write(ssl_.get(), bs->Data(), length);
+    if (!async_job_waiting)
+      written = SSL_write(ssl_.get(), bs->Data(), length);
+    else
+      written = -1;
   } else {
     // Only one buffer: try to write directly, only store if it fails
     uv_buf_t* buf = &bufs[nonempty_i];
     NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(buf->len);
-    written = SSL_write(ssl_.get(), buf->base, buf->len);
+    if (!async_job_waiting)
+      written = SSL_write(ssl_.get(), buf->base, buf->len);
+    else
+      written = -1;
 
     if (written == -1) {
       NoArrayBufferZeroFillScope no_zero_fill_scope(env()->isolate_data());
@@ -1059,7 +1212,8 @@ int TLSWrap::DoWrite(WriteWrap* w,
 
   if (written == -1) {
     // If we stopped writing because of an error, it's fatal, discard the data.
-    int err = SSL_get_error(ssl_.get(), written);
+    int err = async_job_waiting ? SSL_ERROR_WANT_ASYNC
+                                : SSL_get_error(ssl_.get(), written);
     if (err == SSL_ERROR_SSL || err == SSL_ERROR_SYSCALL) {
       // TODO(@jasnell): What are we doing with the error?
       Debug(this, "Got SSL error (%d), returning UV_EPROTO", err);
@@ -1145,8 +1299,12 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
   Debug(this, "DoShutdown()");
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
+  // SSL_shutdown() would resume the async job paused in SSL_read(). The
+  // handshake is still in progress then, so there is no close_notify to send.
+  if (ssl_ && !SSL_waiting_for_async(ssl_.get()) &&
+      SSL_shutdown(ssl_.get()) == 0) {
     SSL_shutdown(ssl_.get());
+  }
 
   shutdown_ = true;
   EncOut();
@@ -1258,6 +1416,12 @@ void TLSWrap::Destroy() {
   // And destroy
   InvokeQueued(UV_ECANCELED, "Canceled because of SSL destruction");
 
+  // A job paused for a private key operation is finished off when the
+  // operation completes, which holds its own reference to the SSL. Anything
+  // else can be finished off now, or the job would leak with the SSL.
+  if (SSL_waiting_for_async(ssl_.get()) && !private_key_op_pending_)
+    AbortAsyncJob(ssl_.get());
+
   env()->isolate()->AdjustAmountOfExternalAllocatedMemory(-kExternalSize);
   ssl_.reset();
 
@@ -1331,6 +1495,11 @@ void TLSWrap::SetServername(const FunctionCallbackInfo<Value>& args) {
 }
 
 int TLSWrap::SelectSNIContextCallback(SSL* s, int* ad, void* arg) {
+  if (IsInAsyncJob()) {
+    return RunOnLoopStack(
+        [=]() { return SelectSNIContextCallback(s, ad, arg); });
+  }
+
   TLSWrap* p = static_cast<TLSWrap*>(SSL_get_app_data(s));
   Environment* env = p->env();
   HandleScope handle_scope(env->isolate());
@@ -1411,6 +1580,12 @@ unsigned int TLSWrap::PskServerCallback(
     const char* identity,
     unsigned char* psk,
     unsigned int max_psk_len) {
+  if (IsInAsyncJob()) {
+    return RunOnLoopStack([=]() {
+      return PskServerCallback(s, identity, psk, max_psk_len);
+    });
+  }
+
   TLSWrap* p = static_cast<TLSWrap*>(SSL_get_app_data(s));
 
   Environment* env = p->env();
@@ -1452,6 +1627,13 @@ unsigned int TLSWrap::PskClientCallback(
     unsigned int max_identity_len,
     unsigned char* psk,
     unsigned int max_psk_len) {
+  if (IsInAsyncJob()) {
+    return RunOnLoopStack([=]() {
+      return PskClientCallback(
+          s, hint, identity, max_identity_len, psk, max_psk_len);
+    });
+  }
+
   TLSWrap* p = static_cast<TLSWrap*>(SSL_get_app_data(s));
 
   Environment* env = p->env();
@@ -1761,6 +1943,16 @@ void TLSWrap::IsSessionReused(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(yes);
 }
 
+// Only used by tests, to check that private key operations actually ran on
+// the threadpool. It is not installed on the TLSWrap prototype.
+void TLSWrap::GetOffloadedPrivateKeyOperations(
+    const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsObject());
+  TLSWrap* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args[0].As<Object>());
+  args.GetReturnValue().Set(w->offloaded_private_key_ops_);
+}
+
 void TLSWrap::VerifyError(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   TLSWrap* w;
@@ -2071,6 +2263,147 @@ void TLSWrap::Cycle() {
   }
 }
 
+// Runs a private key operation on the threadpool on behalf of the async job
+// that is paused waiting for it. The SSL is referenced separately from the
+// TLSWrap because the operation writes into buffers the SSL owns, and the
+// TLSWrap may drop its SSL in Destroy() while the operation is running.
+class TLSWrap::PrivateKeyOperation final : public ThreadPoolWork {
+ public:
+  PrivateKeyOperation(TLSWrap* wrap,
+                      std::function<int()> operation,
+                      int failure)
+      : ThreadPoolWork(wrap->env(), "crypto"),
+        wrap_(wrap),
+        operation_(std::move(operation)),
+        result_(failure) {
+    CHECK_EQ(SSL_up_ref(wrap->ssl_.get()), 1);
+    ssl_.reset(wrap->ssl_.get());
+  }
+
+  void DoThreadPoolWork() override { result_ = operation_(); }
+
+  void AfterThreadPoolWork(int status) override {
+    CHECK(status == 0 || status == UV_ECANCELED);
+    std::unique_ptr<PrivateKeyOperation> ptr(this);
+    if (status == 0)
+      wrap_->offloaded_private_key_ops_++;
+    // If the work was canceled, result_ still holds the failure value.
+    wrap_->OnPrivateKeyOperationDone(std::move(ssl_), result_);
+  }
+
+ private:
+  BaseObjectPtr<TLSWrap> wrap_;
+  SSLPointer ssl_;
+  std::function<int()> operation_;
+  int result_;
+};
+
+bool TLSWrap::IsInAsyncJob() {
+  return current_async_job_wrap != nullptr &&
+         ASYNC_get_current_job() != nullptr;
+}
+
+int TLSWrap::RunOnLoopStack(std::function<int()> callback) {
+  if (!IsInAsyncJob())
+    return callback();
+
+  // Once the job has been aborted the connection is gone, and there is
+  // nothing left to call back into.
+  TLSWrap* wrap = current_async_job_wrap;
+  if (wrap->async_job_aborted_)
+    return 0;
+
+  // Pause the job. ClearOut() runs the callback and then resumes us.
+  CHECK(!wrap->loop_stack_callback_);
+  wrap->loop_stack_callback_ = std::move(callback);
+  while (wrap->loop_stack_callback_ && !wrap->async_job_aborted_)
+    ASYNC_pause_job();
+
+  if (wrap->async_job_aborted_) {
+    wrap->loop_stack_callback_ = nullptr;
+    return 0;
+  }
+  return wrap->loop_stack_result_;
+}
+
+int TLSWrap::OffloadPrivateKeyOperation(std::function<int()> operation,
+                                        int failure) {
+  if (!IsInAsyncJob())
+    return operation();
+
+  TLSWrap* wrap = current_async_job_wrap;
+  if (wrap->async_job_aborted_)
+    return failure;
+
+  // Scheduling the work touches the Environment, so it is done from the
+  // loop's stack. The job then stays paused until the operation completes.
+  RunOnLoopStack([&]() {
+    wrap->StartPrivateKeyOperation(std::move(operation), failure);
+    return 0;
+  });
+  while (wrap->private_key_op_pending_ && !wrap->async_job_aborted_)
+    ASYNC_pause_job();
+
+  return wrap->async_job_aborted_ ? failure : wrap->private_key_op_result_;
+}
+
+bool TLSWrap::UsePrivateKeyOffload() const {
+  const BaseObjectPtr<SecureContext>& sc = sni_context_ ? sni_context_ : sc_;
+  return sc && sc->private_key_offload();
+}
+
+bool TLSWrap::RunLoopStackCallback() {
+  if (!loop_stack_callback_)
+    return false;
+
+  std::function<int()> callback = std::move(loop_stack_callback_);
+  loop_stack_callback_ = nullptr;
+  in_loop_stack_callback_ = true;
+  loop_stack_result_ = callback();
+  in_loop_stack_callback_ = false;
+  return true;
+}
+
+void TLSWrap::StartPrivateKeyOperation(std::function<int()> operation,
+                                       int failure) {
+  CHECK(!private_key_op_pending_);
+  Debug(this, "Offloading private key operation");
+  private_key_op_pending_ = true;
+  auto* work = new PrivateKeyOperation(this, std::move(operation), failure);
+  work->ScheduleWork();
+}
+
+void TLSWrap::OnPrivateKeyOperationDone(SSLPointer ssl, int result) {
+  Debug(this, "Private key operation done, result = %d", result);
+  private_key_op_pending_ = false;
+  private_key_op_result_ = result;
+
+  if (!ssl_) {
+    // Destroyed while the operation was running. Let the job fail the
+    // handshake and finish before the last reference to the SSL goes away.
+    AbortAsyncJob(ssl.get());
+    return;
+  }
+
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  // Resume the job first, ClearIn() does not write while it is paused.
+  ClearOut();
+  Cycle();
+}
+
+void TLSWrap::AbortAsyncJob(SSL* ssl) {
+  Debug(this, "Aborting paused async job");
+  async_job_aborted_ = true;
+
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+  AsyncJobScope async_job_scope(this, ssl, true);
+  char byte;
+  while (SSL_waiting_for_async(ssl))
+    SSL_read(ssl, &byte, sizeof(byte));
+}
+
 #ifdef SSL_set_max_send_fragment
 void TLSWrap::SetMaxSendFragment(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.Length() >= 1 && args[0]->IsNumber());
@@ -2093,6 +2426,10 @@ void TLSWrap::Initialize(
   Isolate* isolate = env->isolate();
 
   SetMethod(context, target, "wrap", TLSWrap::Wrap);
+  SetMethodNoSideEffect(context,
+                        target,
+                        "getOffloadedPrivateKeyOperations",
+                        GetOffloadedPrivateKeyOperations);
 
   NODE_DEFINE_CONSTANT(target, HAVE_SSL_TRACE);
 
@@ -2213,6 +2550,7 @@ void TLSWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GetCipher);
   registry->Register(GetEphemeralKeyInfo);
   registry->Register(GetFinished);
+  registry->Register(GetOffloadedPrivateKeyOperations);
   registry->Register(GetPeerCertificate);
   registry->Register(GetPeerX509Certificate);
   registry->Register(GetPeerFinished);
@@ -33,6 +33,7 @@
 
 #include <openssl/ssl.h>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -105,7 +106,20 @@ class TLSWrap : public AsyncWrap,
 
   std::string diagnostic_name() const override;
 
+  // When a SecureContext has private key offload enabled, the handshake
+  // SSL_read() in ClearOut() runs as an OpenSSL async job on a small private
+  // stack. Code that runs inside such a job uses these to get back to the
+  // event loop: RunOnLoopStack() for anything that enters V8, and
+  // OffloadPrivateKeyOperation() to move a signature or decryption to the
+  // threadpool. Outside of a job, both simply call the function.
+  static bool IsInAsyncJob();
+  static int RunOnLoopStack(std::function<int()> callback);
+  static int OffloadPrivateKeyOperation(std::function<int()> operation,
+                                        int failure);
+
  private:
+  class PrivateKeyOperation;
+
   // OpenSSL structures are opaque. Estimate SSL memory size for OpenSSL 1.1.1b:
   //   SSL: 6224
   //   SSL->SSL3_STATE: 1040
@@ -154,6 +168,13 @@ class TLSWrap : public AsyncWrap,
   void ClearOut();  // SSL_read() clear text "out" from SSL.
   void Destroy();
 
+  // Async job support, see IsInAsyncJob().
+  bool UsePrivateKeyOffload() const;
+  bool RunLoopStackCallback();
+  void StartPrivateKeyOperation(std::function<int()> operation, int failure);
+  void OnPrivateKeyOperationDone(SSLPointer ssl, int result);
+  void AbortAsyncJob(SSL* ssl);
+
   // Call Done() on outstanding WriteWrap request.
   void InvokeQueued(int status, const char* error_str = nullptr);
 
@@ -193,6 +214,8 @@ class TLSWrap : public AsyncWrap,
   static void GetEphemeralKeyInfo(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetFinished(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetOffloadedPrivateKeyOperations(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetPeerCertificate(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetPeerX509Certificate(
@@ -289,6 +312,18 @@ class TLSWrap : public AsyncWrap,
 
   BIOPointer bio_trace_;
 
+  // A paused async job is waiting for either a callback to run on the loop
+  // stack or a private key operation to finish on the threadpool. No other
+  // SSL call may be made until it is resumed by SSL_read() in ClearOut().
+  std::function<int()> loop_stack_callback_;
+  int loop_stack_result_ = 0;
+  bool in_loop_stack_callback_ = false;
+  bool private_key_op_pending_ = false;
+  int private_key_op_result_ = 0;
+  bool async_job_aborted_ = false;
+  // The number of private key operations that ran on the threadpool.
+  uint32_t offloaded_private_key_ops_ = 0;
+
   bool has_active_write_issued_by_prev_listener_ = false;
 
  public:
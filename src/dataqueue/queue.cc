@@ -0,0 +1,736 @@
+#include "queue.h"
+#include <base_object-inl.h>
+#include <env-inl.h>
+#include <memory_tracker-inl.h>
+#include <node.h>
+#include <node_bob-inl.h>
+#include <node_errors.h>
+#include <util-inl.h>
+#include <uv.h>
+#include <v8.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace node {
+
+using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::BackingStore;
+using v8::Isolate;
+using v8::Local;
+using v8::Value;
+
+namespace {
+
+// Returns the [start, end) range of a slice of something of the given
+// size, clamped to it.
+std::pair<uint64_t, uint64_t> ClampRange(uint64_t size,
+                                         uint64_t start,
+                                         std::optional<uint64_t> end) {
+  start = std::min(start, size);
+  return {start, std::max(start, std::min(end.value_or(size), size))};
+}
+
+void DoneNothing(size_t) {}
+
+class IdempotentDataQueueReader;
+class NonIdempotentDataQueueReader;
+
+class DataQueueImpl final : public DataQueue,
+                            public std::enable_shared_from_this<DataQueueImpl> {
+ public:
+  // An idempotent DataQueue of a fixed set of entries of a known size.
+  DataQueueImpl(std::deque<std::unique_ptr<Entry>> entries, uint64_t size)
+      : entries_(std::move(entries)), idempotent_(true), size_(size) {}
+
+  // A non-idempotent DataQueue that entries can be appended to. The size
+  // stays known until an entry of an unknown size is appended.
+  explicit DataQueueImpl(std::optional<uint64_t> cap)
+      : idempotent_(false), size_(0), capped_size_(cap) {}
+
+  DataQueueImpl(const DataQueueImpl&) = delete;
+  DataQueueImpl& operator=(const DataQueueImpl&) = delete;
+
+  std::shared_ptr<DataQueue> slice(
+      uint64_t start, std::optional<uint64_t> maybe_end) override {
+    if (!idempotent_ || !size_.has_value()) return nullptr;
+
+    auto [first, last] = ClampRange(size_.value(), start, maybe_end);
+    uint64_t begin = first;
+    uint64_t remaining = last - first;
+    std::deque<std::unique_ptr<Entry>> slices;
+
+    for (const auto& entry : entries_) {
+      if (remaining == 0) break;
+      // Every entry of an idempotent queue has a known size.
+      uint64_t entry_size = entry->size().value();
+      if (begin >= entry_size) {
+        begin -= entry_size;
+        continue;
+      }
+      uint64_t length = std::min(entry_size - begin, remaining);
+      std::unique_ptr<Entry> slice = entry->slice(begin, begin + length);
+      if (!slice) return nullptr;
+      slices.push_back(std::move(slice));
+      remaining -= length;
+      begin = 0;
+    }
+
+    return std::make_shared<DataQueueImpl>(std::move(slices), last - first);
+  }
+
+  std::optional<uint64_t> size() const override { return size_; }
+
+  bool is_idempotent() const override { return idempotent_; }
+
+  bool is_capped() const override { return capped_size_.has_value(); }
+
+  std::optional<uint64_t> maybeCapRemaining() const override {
+    if (!capped_size_.has_value() || !size_.has_value()) return std::nullopt;
+    return capped_size_.value() - size_.value();
+  }
+
+  std::optional<bool> append(std::unique_ptr<Entry> entry) override {
+    if (idempotent_) return std::nullopt;
+    if (!entry) return false;
+
+    std::optional<uint64_t> entry_size = entry->size();
+    if (capped_size_.has_value()) {
+      // Entries of an unknown size could exceed the cap.
+      if (!size_.has_value() || !entry_size.has_value() ||
+          entry_size.value() > capped_size_.value() - size_.value()) {
+        return false;
+      }
+    }
+
+    if (size_.has_value()) {
+      if (entry_size.has_value())
+        size_ = size_.value() + entry_size.value();
+      else
+        size_ = std::nullopt;
+    }
+    entries_.push_back(std::move(entry));
+    return true;
+  }
+
+  void cap(uint64_t limit) override {
+    if (idempotent_) return;
+    // Without a known size, nothing can be checked against the limit.
+    if (!size_.has_value()) {
+      capped_size_ = 0;
+      return;
+    }
+    limit = std::max(limit, size_.value());
+    if (capped_size_.has_value())
+      limit = std::min(limit, capped_size_.value());
+    capped_size_ = limit;
+  }
+
+  std::shared_ptr<Reader> get_reader() override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("entries", entries_);
+  }
+  SET_MEMORY_INFO_NAME(DataQueue)
+  SET_SELF_SIZE(DataQueueImpl)
+
+ private:
+  // Whether nothing can be appended anymore.
+  bool is_closed() const {
+    return capped_size_.has_value() && maybeCapRemaining().value_or(0) == 0;
+  }
+
+  std::deque<std::unique_ptr<Entry>> entries_;
+  bool idempotent_;
+  std::optional<uint64_t> size_;
+  std::optional<uint64_t> capped_size_;
+  bool locked_ = false;
+
+  friend class IdempotentDataQueueReader;
+  friend class NonIdempotentDataQueueReader;
+};
+
+// Maps the status of an entry's reader to the one of the queue's reader:
+// the end of an entry is not the end of the queue, the next Pull() moves
+// on to the following entry.
+int ContinueAfterEntry(int status) {
+  if (status == bob::Status::STATUS_END || status == bob::Status::STATUS_EOS)
+    return bob::Status::STATUS_CONTINUE;
+  return status;
+}
+
+// Reads the entries of an idempotent DataQueue one after another, without
+// changing the queue, so any number of these can read it concurrently.
+class IdempotentDataQueueReader final
+    : public DataQueue::Reader,
+      public std::enable_shared_from_this<IdempotentDataQueueReader> {
+ public:
+  explicit IdempotentDataQueueReader(std::shared_ptr<DataQueueImpl> data_queue)
+      : data_queue_(std::move(data_queue)) {
+    CHECK(data_queue_->is_idempotent());
+  }
+
+  int Pull(Next next,
+           int options,
+           DataQueue::Vec* data,
+           size_t count,
+           size_t max_count_hint = bob::kMaxCountHint) override {
+    if (ended_) {
+      std::move(next)(bob::Status::STATUS_EOS, nullptr, 0, DoneNothing);
+      return bob::Status::STATUS_EOS;
+    }
+
+    // The reader of the previous entry is released here rather than from
+    // within its own callback.
+    if (current_done_) {
+      current_reader_.reset();
+      current_index_++;
+      current_done_ = false;
+    }
+
+    if (!current_reader_) {
+      if (current_index_ == data_queue_->entries_.size()) {
+        ended_ = true;
+        std::move(next)(bob::Status::STATUS_END, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_END;
+      }
+      current_reader_ = data_queue_->entries_[current_index_]->get_reader();
+      if (!current_reader_) {
+        ended_ = true;
+        std::move(next)(UV_EINVAL, nullptr, 0, DoneNothing);
+        return UV_EINVAL;
+      }
+    }
+
+    std::shared_ptr<IdempotentDataQueueReader> self = shared_from_this();
+    int status = current_reader_->Pull(
+        [self, next = std::move(next)](int status,
+                                       const DataQueue::Vec* vecs,
+                                       size_t count,
+                                       Done done) {
+          if (status == bob::Status::STATUS_END ||
+              status == bob::Status::STATUS_EOS) {
+            self->current_done_ = true;
+          } else if (status < 0) {
+            self->ended_ = true;
+          }
+          next(ContinueAfterEntry(status), vecs, count, std::move(done));
+        },
+        options,
+        data,
+        count,
+        max_count_hint);
+    return ContinueAfterEntry(status);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(IdempotentDataQueueReader)
+  SET_SELF_SIZE(IdempotentDataQueueReader)
+
+ private:
+  std::shared_ptr<DataQueueImpl> data_queue_;
+  std::shared_ptr<DataQueue::Reader> current_reader_;
+  size_t current_index_ = 0;
+  bool current_done_ = false;
+  bool ended_ = false;
+};
+
+// Reads a non-idempotent DataQueue, removing every entry from it once it
+// has been read. It ends once the queue is capped and all of the entries
+// have been read; until then, it reports STATUS_BLOCK when it runs out of
+// entries.
+class NonIdempotentDataQueueReader final
+    : public DataQueue::Reader,
+      public std::enable_shared_from_this<NonIdempotentDataQueueReader> {
+ public:
+  explicit NonIdempotentDataQueueReader(
+      std::shared_ptr<DataQueueImpl> data_queue)
+      : data_queue_(std::move(data_queue)) {
+    CHECK(!data_queue_->is_idempotent());
+  }
+
+  int Pull(Next next,
+           int options,
+           DataQueue::Vec* data,
+           size_t count,
+           size_t max_count_hint = bob::kMaxCountHint) override {
+    if (ended_) {
+      std::move(next)(bob::Status::STATUS_EOS, nullptr, 0, DoneNothing);
+      return bob::Status::STATUS_EOS;
+    }
+
+    if (current_done_) {
+      current_reader_.reset();
+      data_queue_->entries_.pop_front();
+      current_done_ = false;
+    }
+
+    if (!current_reader_) {
+      if (data_queue_->entries_.empty()) {
+        if (data_queue_->is_closed()) {
+          ended_ = true;
+          std::move(next)(bob::Status::STATUS_END, nullptr, 0, DoneNothing);
+          return bob::Status::STATUS_END;
+        }
+        std::move(next)(bob::Status::STATUS_BLOCK, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_BLOCK;
+      }
+      current_reader_ = data_queue_->entries_.front()->get_reader();
+      if (!current_reader_) {
+        ended_ = true;
+        std::move(next)(UV_EINVAL, nullptr, 0, DoneNothing);
+        return UV_EINVAL;
+      }
+    }
+
+    std::shared_ptr<NonIdempotentDataQueueReader> self = shared_from_this();
+    int status = current_reader_->Pull(
+        [self, next = std::move(next)](int status,
+                                       const DataQueue::Vec* vecs,
+                                       size_t count,
+                                       Done done) {
+          if (status == bob::Status::STATUS_END ||
+              status == bob::Status::STATUS_EOS) {
+            self->current_done_ = true;
+          } else if (status < 0) {
+            self->ended_ = true;
+          }
+          next(ContinueAfterEntry(status), vecs, count, std::move(done));
+        },
+        options,
+        data,
+        count,
+        max_count_hint);
+    return ContinueAfterEntry(status);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(NonIdempotentDataQueueReader)
+  SET_SELF_SIZE(NonIdempotentDataQueueReader)
+
+ private:
+  std::shared_ptr<DataQueueImpl> data_queue_;
+  std::shared_ptr<DataQueue::Reader> current_reader_;
+  bool current_done_ = false;
+  bool ended_ = false;
+};
+
+std::shared_ptr<DataQueue::Reader> DataQueueImpl::get_reader() {
+  if (idempotent_) {
+    return std::make_shared<IdempotentDataQueueReader>(shared_from_this());
+  }
+  if (locked_) return nullptr;
+  locked_ = true;
+  return std::make_shared<NonIdempotentDataQueueReader>(shared_from_this());
+}
+
+// ============================================================================
+
+// An entry for a range of a BackingStore. It is read in one piece, without
+// copying the data.
+class InMemoryEntry final : public DataQueue::Entry {
+ public:
+  InMemoryEntry(std::shared_ptr<BackingStore> backing_store,
+                uint64_t offset,
+                uint64_t byte_length)
+      : backing_store_(std::move(backing_store)),
+        offset_(offset),
+        byte_length_(byte_length) {
+    CHECK_LE(offset_ + byte_length_, backing_store_->ByteLength());
+  }
+
+  std::unique_ptr<Entry> slice(uint64_t start,
+                               std::optional<uint64_t> end) override {
+    auto [begin, finish] = ClampRange(byte_length_, start, end);
+    return std::make_unique<InMemoryEntry>(
+        backing_store_, offset_ + begin, finish - begin);
+  }
+
+  std::optional<uint64_t> size() const override { return byte_length_; }
+
+  bool is_idempotent() const override { return true; }
+
+  std::shared_ptr<DataQueue::Reader> get_reader() override {
+    return std::make_shared<Reader>(backing_store_, offset_, byte_length_);
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("store", backing_store_);
+  }
+  SET_MEMORY_INFO_NAME(InMemoryEntry)
+  SET_SELF_SIZE(InMemoryEntry)
+
+ private:
+  class Reader final : public DataQueue::Reader {
+   public:
+    Reader(std::shared_ptr<BackingStore> backing_store,
+           uint64_t offset,
+           uint64_t byte_length)
+        : backing_store_(std::move(backing_store)),
+          offset_(offset),
+          byte_length_(byte_length) {}
+
+    int Pull(Next next,
+             int options,
+             DataQueue::Vec* data,
+             size_t count,
+             size_t max_count_hint = bob::kMaxCountHint) override {
+      if (ended_) {
+        std::move(next)(bob::Status::STATUS_EOS, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_EOS;
+      }
+      if (delivered_ || byte_length_ == 0) {
+        ended_ = true;
+        std::move(next)(bob::Status::STATUS_END, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_END;
+      }
+      delivered_ = true;
+      DataQueue::Vec vec{
+          static_cast<uint8_t*>(backing_store_->Data()) + offset_,
+          byte_length_,
+      };
+      // The Done callback keeps the data alive for as long as the consumer
+      // holds on to it.
+      std::move(next)(bob::Status::STATUS_CONTINUE,
+                      &vec,
+                      1,
+                      [store = backing_store_](size_t) {});
+      return bob::Status::STATUS_CONTINUE;
+    }
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(InMemoryEntry::Reader)
+    SET_SELF_SIZE(Reader)
+
+   private:
+    std::shared_ptr<BackingStore> backing_store_;
+    uint64_t offset_;
+    uint64_t byte_length_;
+    bool delivered_ = false;
+    bool ended_ = false;
+  };
+
+  std::shared_ptr<BackingStore> backing_store_;
+  uint64_t offset_;
+  uint64_t byte_length_;
+};
+
+// ============================================================================
+
+// An entry that reads another DataQueue.
+class DataQueueEntry final : public DataQueue::Entry {
+ public:
+  explicit DataQueueEntry(std::shared_ptr<DataQueue> data_queue)
+      : data_queue_(std::move(data_queue)) {
+    CHECK(data_queue_);
+  }
+
+  std::unique_ptr<Entry> slice(uint64_t start,
+                               std::optional<uint64_t> end) override {
+    std::shared_ptr<DataQueue> slice = data_queue_->slice(start, end);
+    if (!slice) return nullptr;
+    return std::make_unique<DataQueueEntry>(std::move(slice));
+  }
+
+  std::optional<uint64_t> size() const override {
+    return data_queue_->size();
+  }
+
+  bool is_idempotent() const override { return data_queue_->is_idempotent(); }
+
+  std::shared_ptr<DataQueue::Reader> get_reader() override {
+    return data_queue_->get_reader();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("data_queue", data_queue_);
+  }
+  SET_MEMORY_INFO_NAME(DataQueueEntry)
+  SET_SELF_SIZE(DataQueueEntry)
+
+ private:
+  std::shared_ptr<DataQueue> data_queue_;
+};
+
+// ============================================================================
+
+// An entry for a range of a file. The file is opened by each reader when it
+// is first pulled and read in chunks of kReadSize bytes on the threadpool,
+// one chunk per pull.
+class FdEntry final : public DataQueue::Entry {
+ public:
+  static constexpr size_t kReadSize = 64 * 1024;
+
+  FdEntry(std::string path, const uv_stat_t& stat, uint64_t start, uint64_t end)
+      : path_(std::move(path)), stat_(stat), start_(start), end_(end) {
+    CHECK_LE(start_, end_);
+  }
+
+  std::unique_ptr<Entry> slice(uint64_t start,
+                               std::optional<uint64_t> end) override {
+    auto [begin, finish] = ClampRange(end_ - start_, start, end);
+    return std::make_unique<FdEntry>(
+        path_, stat_, start_ + begin, start_ + finish);
+  }
+
+  std::optional<uint64_t> size() const override { return end_ - start_; }
+
+  bool is_idempotent() const override { return true; }
+
+  std::shared_ptr<DataQueue::Reader> get_reader() override {
+    return std::make_shared<Reader>(path_, stat_, start_, end_);
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("path", path_);
+  }
+  SET_MEMORY_INFO_NAME(FdEntry)
+  SET_SELF_SIZE(FdEntry)
+
+ private:
+  class Reader final : public DataQueue::Reader,
+                       public std::enable_shared_from_this<Reader> {
+   public:
+    Reader(const std::string& path,
+           const uv_stat_t& stat,
+           uint64_t start,
+           uint64_t end)
+        : path_(path), stat_(stat), position_(start), end_(end) {}
+
+    ~Reader() override {
+      CHECK(!reading_);
+      if (fd_ >= 0) {
+        uv_fs_t req;
+        uv_fs_close(nullptr, &req, fd_, nullptr);
+        uv_fs_req_cleanup(&req);
+      }
+    }
+
+    int Pull(Next next,
+             int options,
+             DataQueue::Vec* data,
+             size_t count,
+             size_t max_count_hint = bob::kMaxCountHint) override {
+      if (ended_) {
+        std::move(next)(bob::Status::STATUS_EOS, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_EOS;
+      }
+      // A read is in flight already, or the consumer cannot wait for one.
+      if (reading_ || (options & bob::Options::OPTIONS_SYNC)) {
+        std::move(next)(bob::Status::STATUS_BLOCK, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_BLOCK;
+      }
+      if (position_ == end_) {
+        ended_ = true;
+        std::move(next)(bob::Status::STATUS_END, nullptr, 0, DoneNothing);
+        return bob::Status::STATUS_END;
+      }
+
+      int err;
+      if (env_ == nullptr) {
+        // The first pull opens the file, and checks that it has not been
+        // modified since the entry was created, before reading from it.
+        env_ = Environment::GetCurrent(Isolate::GetCurrent());
+        CHECK_NOT_NULL(env_);
+        req_.data = this;
+        err = uv_fs_open(
+            env_->event_loop(), &req_, path_.c_str(), O_RDONLY, 0, OnOpen);
+        if (err < 0) uv_fs_req_cleanup(&req_);
+      } else {
+        err = Read();
+      }
+      if (err < 0) return Fail(std::move(next), err);
+
+      reading_ = true;
+      next_ = std::move(next);
+      // The reader stays alive until the read is done.
+      self_ = shared_from_this();
+      env_->IncreaseWaitingRequestCounter();
+      return bob::Status::STATUS_WAIT;
+    }
+
+    SET_NO_MEMORY_INFO()
+    SET_MEMORY_INFO_NAME(FdEntry::Reader)
+    SET_SELF_SIZE(Reader)
+
+   private:
+    // Starts reading the next chunk of the file.
+    int Read() {
+      size_t length = std::min<uint64_t>(kReadSize, end_ - position_);
+      store_ = ArrayBuffer::NewBackingStore(env_->isolate(), length);
+      uv_buf_t buf = uv_buf_init(static_cast<char*>(store_->Data()), length);
+      req_.data = this;
+      int err = uv_fs_read(
+          env_->event_loop(), &req_, fd_, &buf, 1, position_, OnRead);
+      if (err < 0) {
+        uv_fs_req_cleanup(&req_);
+        store_.reset();
+      }
+      return err;
+    }
+
+    int Fail(Next next, int err) {
+      ended_ = true;
+      std::move(next)(err, nullptr, 0, DoneNothing);
+      return err;
+    }
+
+    // Ends the request that is in flight. The returned reference keeps the
+    // reader alive until the caller is done with it.
+    std::shared_ptr<Reader> Settle() {
+      env_->DecreaseWaitingRequestCounter();
+      reading_ = false;
+      return std::move(self_);
+    }
+
+    void Abort(int err) {
+      std::shared_ptr<Reader> self = Settle();
+      Fail(std::move(next_), err);
+    }
+
+    static void OnOpen(uv_fs_t* req) {
+      Reader* reader = static_cast<Reader*>(req->data);
+      int err = req->result;
+      uv_fs_req_cleanup(req);
+      if (err >= 0) {
+        reader->fd_ = err;
+        req->data = reader;
+        err = uv_fs_fstat(
+            reader->env_->event_loop(), req, reader->fd_, OnStat);
+        if (err < 0) uv_fs_req_cleanup(req);
+      }
+      if (err < 0) reader->Abort(err);
+    }
+
+    static void OnStat(uv_fs_t* req) {
+      Reader* reader = static_cast<Reader*>(req->data);
+      int err = req->result;
+      const uv_stat_t& stat = req->statbuf;
+      const uv_stat_t& expected = reader->stat_;
+      if (err == 0 &&
+          (stat.st_size != expected.st_size ||
+           stat.st_mtim.tv_sec != expected.st_mtim.tv_sec ||
+           stat.st_mtim.tv_nsec != expected.st_mtim.tv_nsec)) {
+        err = UV_EINVAL;
+      }
+      uv_fs_req_cleanup(req);
+      if (err == 0) err = reader->Read();
+      if (err < 0) reader->Abort(err);
+    }
+
+    static void OnRead(uv_fs_t* req) {
+      Reader* reader = static_cast<Reader*>(req->data);
+      std::shared_ptr<Reader> self = reader->Settle();
+
+      ssize_t result = req->result;
+      uv_fs_req_cleanup(req);
+      Next next = std::move(reader->next_);
+      std::shared_ptr<BackingStore> store = std::move(reader->store_);
+
+      // Reaching the end of the file early means that it was truncated.
+      if (result == 0) result = UV_EINVAL;
+      if (result < 0) {
+        reader->Fail(std::move(next), result);
+        return;
+      }
+
+      reader->position_ += result;
+      DataQueue::Vec vec{static_cast<uint8_t*>(store->Data()),
+                         static_cast<uint64_t>(result)};
+      std::move(next)(bob::Status::STATUS_CONTINUE,
+                      &vec,
+                      1,
+                      [store = std::move(store)](size_t) {});
+    }
+
+    std::string path_;
+    uv_stat_t stat_;
+    uint64_t position_;
+    uint64_t end_;
+    Environment* env_ = nullptr;
+    uv_file fd_ = -1;
+    uv_fs_t req_;
+    std::shared_ptr<BackingStore> store_;
+    Next next_;
+    std::shared_ptr<Reader> self_;
+    bool reading_ = false;
+    bool ended_ = false;
+  };
+
+  std::string path_;
+  uv_stat_t stat_;
+  uint64_t start_;
+  uint64_t end_;
+};
+
+}  // namespace
+
+// ============================================================================
+
+std::shared_ptr<DataQueue> DataQueue::CreateIdempotent(
+    std::vector<std::unique_ptr<Entry>> list) {
+  uint64_t size = 0;
+  for (const auto& entry : list) {
+    if (!entry || !entry->is_idempotent() || !entry->size().has_value())
+      return nullptr;
+    size += entry->size().value();
+  }
+  return std::make_shared<DataQueueImpl>(
+      std::deque<std::unique_ptr<Entry>>(std::make_move_iterator(list.begin()),
+                                         std::make_move_iterator(list.end())),
+      size);
+}
+
+std::shared_ptr<DataQueue> DataQueue::Create(std::optional<uint64_t> capped) {
+  return std::make_shared<DataQueueImpl>(capped);
+}
+
+std::unique_ptr<DataQueue::Entry> DataQueue::CreateInMemoryEntryFromView(
+    Local<ArrayBufferView> view) {
+  Local<ArrayBuffer> buffer = view->Buffer();
+  if (!buffer->IsDetachable()) return nullptr;
+  std::shared_ptr<BackingStore> store = buffer->GetBackingStore();
+  size_t offset = view->ByteOffset();
+  size_t length = view->ByteLength();
+  buffer->Detach();
+  return CreateInMemoryEntryFromBackingStore(std::move(store), offset, length);
+}
+
+std::unique_ptr<DataQueue::Entry>
+DataQueue::CreateInMemoryEntryFromBackingStore(
+    std::shared_ptr<BackingStore> store, uint64_t offset, uint64_t length) {
+  CHECK(store);
+  if (offset + length > store->ByteLength()) return nullptr;
+  return std::make_unique<InMemoryEntry>(std::move(store), offset, length);
+}
+
+std::unique_ptr<DataQueue::Entry> DataQueue::CreateDataQueueEntry(
+    std::shared_ptr<DataQueue> data_queue) {
+  return std::make_unique<DataQueueEntry>(std::move(data_queue));
+}
+
+std::unique_ptr<DataQueue::Entry> DataQueue::CreateFdEntry(
+    Environment* env, Local<Value> path) {
+  BufferValue file(env->isolate(), path);
+  CHECK_NOT_NULL(*file);
+
+  uv_fs_t req;
+  int err = uv_fs_stat(nullptr, &req, *file, nullptr);
+  uv_stat_t stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  if (err == 0 && (stat.st_mode & S_IFMT) == S_IFDIR) err = UV_EISDIR;
+  if (err < 0) {
+    env->ThrowUVException(err, "stat", nullptr, *file);
+    return nullptr;
+  }
+
+  return std::make_unique<FdEntry>(file.ToString(), stat, 0, stat.st_size);
+}
+
+}  // namespace node
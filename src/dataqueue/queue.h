@@ -171,6 +171,12 @@ class DataQueue : public MemoryRetainer {
     // If the entry is idempotent, a size should always be available.
     virtual std::optional<uint64_t> size() const = 0;
 
+    // Returns a new Reader for the data of this entry. An idempotent
+    // entry can be read any number of times, a non-idempotent entry
+    // at most once; nullptr is returned if the entry cannot be read
+    // (anymore).
+    virtual std::shared_ptr<Reader> get_reader() = 0;
+
     // When true, multiple reads on the object must produce the exact
     // same data or the reads will fail. Some sources of entry data,
     // such as streams, may not be capable of preserving idempotency
@@ -210,9 +216,20 @@ class DataQueue : public MemoryRetainer {
       uint64_t offset,
       uint64_t length);
 
+  // Creates an Entry that reads the data of another DataQueue. The
+  // entry is idempotent if the DataQueue is.
   static std::unique_ptr<Entry> CreateDataQueueEntry(
       std::shared_ptr<DataQueue> data_queue);
 
+  // Creates an idempotent Entry for the contents of the file at path.
+  // The file is not read until the entry is, and only the part that
+  // the reader pulls is held in memory. The size and modification
+  // time of the file are recorded here; reads fail if the file is
+  // modified afterwards. If the file cannot be stat'ed, or is a
+  // directory, an exception is thrown and nullptr returned.
+  //
+  // Readers of the entry issue the reads on the threadpool of the
+  // Environment that is current when they are first pulled.
   static std::unique_ptr<Entry> CreateFdEntry(Environment* env,
                                               v8::Local<v8::Value> path);
 
@@ -284,9 +301,6 @@ class DataQueue : public MemoryRetainer {
   // If the size of the queue cannot be known, or the cap has not
   // been set, maybeCapRemaining() will return std::nullopt.
   virtual std::optional<uint64_t> maybeCapRemaining() const = 0;
-
-  static void Initialize(Environment* env, v8::Local<v8::Object> target);
-  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 };
 
 }  // namespace node
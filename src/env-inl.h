@@ -65,6 +65,10 @@ inline NodeArrayBufferAllocator* IsolateData::node_allocator() const {
   return node_allocator_;
 }
 
+inline const SnapshotData* IsolateData::snapshot_data() const {
+  return snapshot_data_;
+}
+
 inline MultiIsolatePlatform* IsolateData::platform() const {
   return platform_;
 }
@@ -646,6 +650,14 @@ bool Environment::source_maps_enabled() const {
   return source_maps_enabled_;
 }
 
+inline uint64_t Environment::read_buffer_allocations() const {
+  return read_buffer_allocations_;
+}
+
+inline uint64_t Environment::read_buffer_copies() const {
+  return read_buffer_copies_;
+}
+
 inline uint64_t Environment::thread_id() const {
   return thread_id_;
 }
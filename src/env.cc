@@ -3,6 +3,7 @@
 #include "base_object-inl.h"
 #include "debug_utils-inl.h"
 #include "diagnosticfilename-inl.h"
+#include "heap_snapshot_writer.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_context_data.h"
@@ -24,6 +25,7 @@
 #include <atomic>
 #include <cinttypes>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -32,6 +34,8 @@ namespace node {
 
 using errors::TryCatchScope;
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::Boolean;
 using v8::Context;
 using v8::EmbedderGraph;
@@ -474,19 +478,20 @@ IsolateData::IsolateData(Isolate* isolate,
                          uv_loop_t* event_loop,
                          MultiIsolatePlatform* platform,
                          ArrayBufferAllocator* node_allocator,
-                         const IsolateDataSerializeInfo* isolate_data_info)
+                         const SnapshotData* snapshot_data)
     : isolate_(isolate),
       event_loop_(event_loop),
       node_allocator_(node_allocator == nullptr ? nullptr
                                                 : node_allocator->GetImpl()),
-      platform_(platform) {
+      platform_(platform),
+      snapshot_data_(snapshot_data) {
   options_.reset(
       new PerIsolateOptions(*(per_process::cli_options->per_isolate)));
 
-  if (isolate_data_info == nullptr) {
+  if (snapshot_data == nullptr) {
     CreateProperties();
   } else {
-    DeserializeProperties(isolate_data_info);
+    DeserializeProperties(&snapshot_data->isolate_data_info);
   }
 }
 
@@ -620,6 +625,56 @@ std::unique_ptr<v8::BackingStore> Environment::release_managed_buffer(
   return bs;
 }
 
+uv_buf_t Environment::allocate_read_buffer(size_t suggested_size) {
+  // Only one read can use the read buffer at a time. Anything that does not
+  // fit that pattern gets a buffer of its own.
+  if (read_buffer_pending_ || suggested_size > kReadBufferSize) {
+    read_buffer_allocations_++;
+    return allocate_managed_buffer(suggested_size);
+  }
+
+  if (!read_buffer_) {
+    NoArrayBufferZeroFillScope no_zero_fill_scope(isolate_data());
+    read_buffer_ = ArrayBuffer::NewBackingStore(isolate(), kReadBufferSize);
+    read_buffer_allocations_++;
+  }
+
+  read_buffer_pending_ = true;
+  return uv_buf_init(static_cast<char*>(read_buffer_->Data()),
+                     suggested_size);
+}
+
+Local<ArrayBuffer> Environment::release_read_buffer(const uv_buf_t& buf,
+                                                   size_t nread) {
+  std::unique_ptr<BackingStore> bs;
+  if (read_buffer_pending_ && buf.base == read_buffer_->Data()) {
+    read_buffer_pending_ = false;
+    if (nread == 0)
+      return Local<ArrayBuffer>();
+    CHECK_LE(nread, buf.len);
+
+    // Small reads are copied out, so that the read buffer can be reused.
+    // Larger ones take it over, and a new one is allocated for the next read.
+    if (nread < kReadCopyThreshold) {
+      NoArrayBufferZeroFillScope no_zero_fill_scope(isolate_data());
+      bs = ArrayBuffer::NewBackingStore(isolate(), nread);
+      memcpy(bs->Data(), buf.base, nread);
+      read_buffer_copies_++;
+      return ArrayBuffer::New(isolate(), std::move(bs));
+    }
+    bs = std::move(read_buffer_);
+  } else {
+    bs = release_managed_buffer(buf);
+    if (nread == 0 || !bs)
+      return Local<ArrayBuffer>();
+  }
+
+  // Only the data of this read is visible to JS.
+  CHECK_LE(nread, bs->ByteLength());
+  bs = BackingStore::Reallocate(isolate(), std::move(bs), nread);
+  return ArrayBuffer::New(isolate(), std::move(bs));
+}
+
 std::string GetExecPath(const std::vector<std::string>& argv) {
   char exec_path_buf[2 * PATH_MAX];
   size_t exec_path_len = sizeof(exec_path_buf);
@@ -985,10 +1040,19 @@ void Environment::StartProfilerIdleNotifier() {
   uv_prepare_start(&idle_prepare_handle_, [](uv_prepare_t* handle) {
     Environment* env = ContainerOf(&Environment::idle_prepare_handle_, handle);
     env->isolate()->SetIdle(true);
+    // These handles run right before and right after libuv polls for I/O.
+    performance::LoopPhaseTracker* loop_phases =
+        &env->performance_state()->loop_phases;
+    if (UNLIKELY(loop_phases->enabled()))
+      loop_phases->BeforePoll(env->event_loop());
   });
   uv_check_start(&idle_check_handle_, [](uv_check_t* handle) {
     Environment* env = ContainerOf(&Environment::idle_check_handle_, handle);
     env->isolate()->SetIdle(false);
+    performance::LoopPhaseTracker* loop_phases =
+        &env->performance_state()->loop_phases;
+    if (UNLIKELY(loop_phases->enabled()))
+      loop_phases->AfterPoll(env->event_loop());
   });
 }
 
@@ -1191,6 +1255,10 @@ void Environment::RunTimers(uv_timer_t* handle) {
   if (!env->can_call_into_js())
     return;
 
+  performance::LoopPhaseScope phase_scope(
+      &env->performance_state()->loop_phases,
+      performance::NODE_PERFORMANCE_LOOP_PHASE_TIMERS);
+
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
@@ -1248,6 +1316,9 @@ void Environment::RunTimers(uv_timer_t* handle) {
 void Environment::CheckImmediate(uv_check_t* handle) {
   Environment* env = Environment::from_immediate_check_handle(handle);
   TRACE_EVENT0(TRACING_CATEGORY_NODE1(environment), "CheckImmediate");
+  performance::LoopPhaseScope phase_scope(
+      &env->performance_state()->loop_phases,
+      performance::NODE_PERFORMANCE_LOOP_PHASE_CHECK);
 
   HandleScope scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -1282,11 +1353,15 @@ void Environment::ToggleImmediateRef(bool ref) {
 }
 
 
-Local<Value> Environment::GetNow() {
+uint64_t Environment::GetNowUint64() {
   uv_update_time(event_loop());
   uint64_t now = uv_now(event_loop());
   CHECK_GE(now, timer_base());
-  now -= timer_base();
+  return now - timer_base();
+}
+
+Local<Value> Environment::GetNow() {
+  uint64_t now = GetNowUint64();
   if (now <= 0xffffffff)
     return Integer::NewFromUnsigned(isolate(), static_cast<uint32_t>(now));
   else
@@ -1788,12 +1863,16 @@ size_t Environment::NearHeapLimitCallback(void* data,
   if (dir.empty()) {
     dir = env->GetCwd();
   }
-  DiagnosticFilename name(env, "Heap", "heapsnapshot");
+  const int flags = env->options()->heap_snapshot_compress
+                        ? heap::HeapSnapshotWriter::kCompress
+                        : 0;
+  DiagnosticFilename name(
+      env, "Heap", heap::HeapSnapshotWriter::Extension(flags));
   std::string filename = dir + kPathSeparator + (*name);
 
   Debug(env, DebugCategory::DIAGNOSTICS, "Start generating %s...\n", *name);
 
-  heap::WriteSnapshot(env, filename.c_str());
+  heap::WriteSnapshot(env, filename.c_str(), flags);
   env->heap_limit_snapshot_taken_ += 1;
 
   Debug(env,
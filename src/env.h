@@ -125,7 +125,7 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
               uv_loop_t* event_loop,
               MultiIsolatePlatform* platform = nullptr,
               ArrayBufferAllocator* node_allocator = nullptr,
-              const IsolateDataSerializeInfo* isolate_data_info = nullptr);
+              const SnapshotData* snapshot_data = nullptr);
   SET_MEMORY_INFO_NAME(IsolateData)
   SET_SELF_SIZE(IsolateData)
   void MemoryInfo(MemoryTracker* tracker) const override;
@@ -137,6 +137,8 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
   inline void set_options(std::shared_ptr<PerIsolateOptions> options);
 
   inline NodeArrayBufferAllocator* node_allocator() const;
+  // The snapshot that the isolate was deserialized from, if any.
+  inline const SnapshotData* snapshot_data() const;
 
   inline worker::Worker* worker_context() const;
   inline void set_worker_context(worker::Worker* context);
@@ -204,6 +206,7 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
   uv_loop_t* const event_loop_;
   NodeArrayBufferAllocator* const node_allocator_;
   MultiIsolatePlatform* platform_;
+  const SnapshotData* snapshot_data_;
   std::shared_ptr<PerIsolateOptions> options_;
   worker::Worker* worker_context_ = nullptr;
 };
@@ -519,6 +522,10 @@ struct SnapshotData {
   // and the caller should not consume the snapshot data.
   bool Check() const;
   static bool FromBlob(SnapshotData* out, FILE* in);
+  static inline const SnapshotData* FromEmbedderWrapper(
+      const EmbedderSnapshotData* data) {
+    return data != nullptr ? data->impl_ : nullptr;
+  }
 
   ~SnapshotData();
 };
@@ -868,6 +875,7 @@ class Environment : public MemoryRetainer {
   static inline Environment* ForAsyncHooks(AsyncHooks* hooks);
 
   v8::Local<v8::Value> GetNow();
+  uint64_t GetNowUint64();
   void ScheduleTimer(int64_t duration);
   void ToggleTimerRef(bool ref);
 
@@ -932,6 +940,18 @@ class Environment : public MemoryRetainer {
   uv_buf_t allocate_managed_buffer(const size_t suggested_size);
   std::unique_ptr<v8::BackingStore> release_managed_buffer(const uv_buf_t& buf);
 
+  // Buffers for stream reads that are passed to JS. Reads go into a buffer
+  // that is reused for as long as the reads are small, and
+  // release_read_buffer() returns an ArrayBuffer that holds exactly the data
+  // of the read.
+  uv_buf_t allocate_read_buffer(size_t suggested_size);
+  v8::Local<v8::ArrayBuffer> release_read_buffer(const uv_buf_t& buf,
+                                                 size_t nread);
+  // Number of full-size buffers that have been allocated for stream reads.
+  inline uint64_t read_buffer_allocations() const;
+  // Number of small reads that have been copied out of the read buffer.
+  inline uint64_t read_buffer_copies() const;
+
   void AddUnmanagedFd(int fd);
   void RemoveUnmanagedFd(int fd);
 
@@ -1099,6 +1119,14 @@ class Environment : public MemoryRetainer {
   // track of the BackingStore for a given pointer.
   std::unordered_map<char*, std::unique_ptr<v8::BackingStore>>
       released_allocated_buffers_;
+
+  // Used by allocate_read_buffer() and release_read_buffer().
+  static constexpr size_t kReadBufferSize = 64 * 1024;
+  static constexpr size_t kReadCopyThreshold = 16 * 1024;
+  std::unique_ptr<v8::BackingStore> read_buffer_;
+  bool read_buffer_pending_ = false;
+  uint64_t read_buffer_allocations_ = 0;
+  uint64_t read_buffer_copies_ = 0;
 };
 
 }  // namespace node
@@ -26,8 +26,25 @@
 #include "node_external_reference.h"
 #include "string_bytes.h"
 
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#endif
+
 namespace node {
 
+using v8::Array;
+using v8::Boolean;
 using v8::Context;
 using v8::DontDelete;
 using v8::DontEnum;
@@ -47,6 +64,380 @@ using v8::Value;
 
 namespace {
 
+#ifdef __linux__
+// Recursive watcher for Linux, where libuv can only watch single directories.
+// Every directory of the tree gets a watch on one inotify instance. Watches
+// are added as directories appear, including the ones that are moved into the
+// tree, and dropped as they go away. The events of one wake-up are
+// deduplicated and passed to JS in a single call. If the kernel's event queue
+// overflowed, the tree is scanned again to pick up directories that were
+// missed, and JS is told that events have been lost.
+class RecursiveFSEventWrap : public HandleWrap {
+ public:
+  static void Initialize(Environment* env,
+                         Local<Object> target,
+                         Local<Context> context);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Start(const FunctionCallbackInfo<Value>& args);
+  static void GetInitialized(const FunctionCallbackInfo<Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(RecursiveFSEventWrap)
+  SET_SELF_SIZE(RecursiveFSEventWrap)
+
+ private:
+  static const encoding kDefaultEncoding = UTF8;
+  static const uint32_t kEventMask = IN_ATTRIB | IN_CREATE | IN_MODIFY |
+                                     IN_DELETE | IN_DELETE_SELF |
+                                     IN_MOVE_SELF | IN_MOVED_FROM |
+                                     IN_MOVED_TO | IN_EXCL_UNLINK;
+
+  RecursiveFSEventWrap(Environment* env, Local<Object> object);
+  ~RecursiveFSEventWrap() override = default;
+
+  void OnClose() override;
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+
+  std::string FullPath(const std::string& path) const;
+  // Adds watches for `path`, a directory relative to the root, and all
+  // directories below it. If `report` is set, the entries found are reported
+  // as 'rename' events, they may have been created before the watch was.
+  // Returns a libuv error code if a directory could not be watched, other
+  // than because it went away or cannot be read.
+  int WatchTree(const std::string& path, bool report);
+  int ScanDirectory(const std::string& path,
+                    bool report,
+                    std::vector<std::string>* directories);
+  void UnwatchTree(const std::string& path);
+  void HandleEvent(const struct inotify_event* event);
+  void AddEvent(bool change, const std::string& path);
+  void Flush(int status);
+
+  uv_poll_t handle_;
+  int fd_ = -1;
+  std::string root_;
+  enum encoding encoding_ = kDefaultEncoding;
+  // Watch descriptor -> path of the directory relative to the root.
+  std::unordered_map<int, std::string> paths_;
+  // Events of the current wake-up, as (is change event, path) pairs.
+  std::vector<std::pair<bool, std::string>> events_;
+  std::unordered_set<std::string> seen_events_;
+  bool overflow_ = false;
+  // The first error of watching a directory that appeared after Start().
+  int watch_error_ = 0;
+};
+
+// Directories that are removed or replaced while the tree is being watched,
+// and ones that cannot be read, are left out.
+bool IsSkippedWatchError(int error) {
+  return error == ENOENT || error == ENOTDIR || error == EACCES;
+}
+
+RecursiveFSEventWrap::RecursiveFSEventWrap(Environment* env,
+                                           Local<Object> object)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&handle_),
+                 AsyncWrap::PROVIDER_FSEVENTWRAP) {
+  MarkAsUninitialized();
+}
+
+void RecursiveFSEventWrap::Initialize(Environment* env,
+                                      Local<Object> target,
+                                      Local<Context> context) {
+  Isolate* isolate = env->isolate();
+
+  Local<FunctionTemplate> t = NewFunctionTemplate(isolate, New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      RecursiveFSEventWrap::kInternalFieldCount);
+
+  t->Inherit(HandleWrap::GetConstructorTemplate(env));
+  SetProtoMethod(isolate, t, "start", Start);
+
+  Local<FunctionTemplate> get_initialized_templ =
+      FunctionTemplate::New(isolate,
+                            GetInitialized,
+                            Local<Value>(),
+                            Signature::New(isolate, t));
+
+  t->PrototypeTemplate()->SetAccessorProperty(
+      FIXED_ONE_BYTE_STRING(isolate, "initialized"),
+      get_initialized_templ,
+      Local<FunctionTemplate>(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
+
+  SetConstructorFunction(context, target, "RecursiveFSEvent", t);
+}
+
+void RecursiveFSEventWrap::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Start);
+  registry->Register(GetInitialized);
+}
+
+void RecursiveFSEventWrap::GetInitialized(
+    const FunctionCallbackInfo<Value>& args) {
+  RecursiveFSEventWrap* wrap = Unwrap<RecursiveFSEventWrap>(args.This());
+  CHECK_NOT_NULL(wrap);
+  args.GetReturnValue().Set(!wrap->IsHandleClosing());
+}
+
+void RecursiveFSEventWrap::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new RecursiveFSEventWrap(env, args.This());
+}
+
+// wrap.start(filename, persistent, encoding)
+void RecursiveFSEventWrap::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  RecursiveFSEventWrap* wrap = Unwrap<RecursiveFSEventWrap>(args.This());
+  CHECK_NOT_NULL(wrap);
+  CHECK(wrap->IsHandleClosing());  // Check that Start() has not been called.
+  CHECK_GE(args.Length(), 3);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+  wrap->root_ = *path;
+  wrap->encoding_ = ParseEncoding(env->isolate(), args[2], kDefaultEncoding);
+
+  wrap->fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (wrap->fd_ == -1)
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+
+  int err = uv_poll_init(env->event_loop(), &wrap->handle_, wrap->fd_);
+  if (err != 0) {
+    close(wrap->fd_);
+    wrap->fd_ = -1;
+    return args.GetReturnValue().Set(err);
+  }
+  wrap->MarkAsInitialized();
+
+  // The root itself may be a symbolic link, or a file.
+  const int wd = inotify_add_watch(wrap->fd_, wrap->root_.c_str(), kEventMask);
+  struct stat st;
+  if (wd == -1) {
+    err = uv_translate_sys_error(errno);
+  } else if (stat(wrap->root_.c_str(), &st) != 0) {
+    err = uv_translate_sys_error(errno);
+  } else {
+    wrap->paths_[wd] = std::string();
+    if (S_ISDIR(st.st_mode))
+      err = wrap->WatchTree(std::string(), false);
+    if (err == 0)
+      err = uv_poll_start(&wrap->handle_, UV_READABLE, OnPoll);
+  }
+
+  if (err != 0) {
+    RecursiveFSEventWrap::Close(args);
+    return args.GetReturnValue().Set(err);
+  }
+
+  if (!args[1]->IsTrue())
+    uv_unref(reinterpret_cast<uv_handle_t*>(&wrap->handle_));
+
+  args.GetReturnValue().Set(0);
+}
+
+void RecursiveFSEventWrap::OnClose() {
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+std::string RecursiveFSEventWrap::FullPath(const std::string& path) const {
+  return path.empty() ? root_ : root_ + "/" + path;
+}
+
+int RecursiveFSEventWrap::WatchTree(const std::string& path, bool report) {
+  std::vector<std::string> directories;
+  int err = 0;
+  if (path.empty())
+    err = ScanDirectory(path, report, &directories);
+  else
+    directories.push_back(path);
+
+  while (err == 0 && !directories.empty()) {
+    std::string directory = std::move(directories.back());
+    directories.pop_back();
+    const int wd = inotify_add_watch(fd_,
+                                     FullPath(directory).c_str(),
+                                     kEventMask | IN_ONLYDIR | IN_DONT_FOLLOW);
+    if (wd == -1) {
+      // ENOSPC means that the fs.inotify.max_user_watches limit was hit.
+      if (!IsSkippedWatchError(errno))
+        err = uv_translate_sys_error(errno);
+      continue;
+    }
+    paths_[wd] = directory;
+    err = ScanDirectory(directory, report, &directories);
+  }
+  return err;
+}
+
+int RecursiveFSEventWrap::ScanDirectory(
+    const std::string& path,
+    bool report,
+    std::vector<std::string>* directories) {
+  const std::string full_path = FullPath(path);
+  DIR* dir = opendir(full_path.c_str());
+  if (dir == nullptr)
+    return IsSkippedWatchError(errno) ? 0 : uv_translate_sys_error(errno);
+
+  while (const struct dirent* entry = readdir(dir)) {
+    const char* name = entry->d_name;
+    if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+    std::string child = path.empty() ? name : path + "/" + name;
+    if (report) AddEvent(false, child);
+
+    // Symbolic links are not followed.
+    bool is_directory = entry->d_type == DT_DIR;
+    if (entry->d_type == DT_UNKNOWN) {
+      struct stat st;
+      is_directory = lstat((full_path + "/" + name).c_str(), &st) == 0 &&
+                     S_ISDIR(st.st_mode);
+    }
+    if (is_directory) directories->push_back(std::move(child));
+  }
+  closedir(dir);
+  return 0;
+}
+
+void RecursiveFSEventWrap::UnwatchTree(const std::string& path) {
+  const std::string prefix = path + "/";
+  for (auto it = paths_.begin(); it != paths_.end();) {
+    if (it->second == path ||
+        it->second.compare(0, prefix.size(), prefix) == 0) {
+      inotify_rm_watch(fd_, it->first);
+      it = paths_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void RecursiveFSEventWrap::HandleEvent(const struct inotify_event* event) {
+  if (event->mask & IN_Q_OVERFLOW) {
+    overflow_ = true;
+    return;
+  }
+
+  auto it = paths_.find(event->wd);
+  if (it == paths_.end()) return;
+
+  if (event->mask & IN_IGNORED) {
+    paths_.erase(it);
+    return;
+  }
+
+  std::string path = it->second;
+  if (event->len > 0) {
+    if (!path.empty()) path += "/";
+    path += event->name;
+  } else if (!path.empty()) {
+    // IN_DELETE_SELF and friends of subdirectories, the event in the parent
+    // directory has been reported already.
+    return;
+  } else {
+    // The root itself, reported by its name like libuv does.
+    const size_t slash = root_.find_last_of('/');
+    path = slash == std::string::npos ? root_ : root_.substr(slash + 1);
+  }
+
+  const uint32_t mask = event->mask & ~IN_ISDIR;
+  AddEvent((mask & ~(IN_ATTRIB | IN_MODIFY)) == 0, path);
+
+  if ((event->mask & IN_ISDIR) && event->len > 0) {
+    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+      int err = WatchTree(path, true);
+      if (watch_error_ == 0)
+        watch_error_ = err;
+    } else if (event->mask & IN_MOVED_FROM) {
+      UnwatchTree(path);
+    }
+  }
+}
+
+void RecursiveFSEventWrap::AddEvent(bool change, const std::string& path) {
+  if (seen_events_.emplace((change ? "c" : "r") + path).second)
+    events_.emplace_back(change, path);
+}
+
+void RecursiveFSEventWrap::OnPoll(uv_poll_t* handle, int status, int events) {
+  RecursiveFSEventWrap* wrap = static_cast<RecursiveFSEventWrap*>(handle->data);
+
+  alignas(struct inotify_event) char buf[16 * 1024];
+  while (status == 0) {
+    ssize_t size;
+    do {
+      size = read(wrap->fd_, buf, sizeof(buf));
+    } while (size == -1 && errno == EINTR);
+    if (size <= 0) {
+      if (size == -1 && errno != EAGAIN)
+        status = uv_translate_sys_error(errno);
+      break;
+    }
+
+    for (const char* p = buf; p < buf + size;) {
+      const struct inotify_event* event =
+          reinterpret_cast<const struct inotify_event*>(p);
+      wrap->HandleEvent(event);
+      p += sizeof(*event) + event->len;
+    }
+  }
+
+  if (status == 0 && wrap->overflow_)
+    status = wrap->WatchTree(std::string(), false);
+  // A directory of the tree could not be watched, so events would be missed
+  // from now on. Report it as an error of the watcher, which closes it.
+  if (status == 0)
+    status = wrap->watch_error_;
+
+  wrap->Flush(status);
+}
+
+void RecursiveFSEventWrap::Flush(int status) {
+  if (status == 0 && events_.empty() && !overflow_) return;
+
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  // [eventType, filename, eventType, filename, ...]
+  std::vector<Local<Value>> values;
+  values.reserve(events_.size() * 2);
+  for (const auto& event : events_) {
+    values.push_back(event.first ? env->change_string() : env->rename_string());
+    Local<Value> error;
+    MaybeLocal<Value> filename = StringBytes::Encode(
+        isolate, event.second.data(), event.second.size(), encoding_, &error);
+    if (filename.IsEmpty()) {
+      filename = StringBytes::Encode(
+          isolate, event.second.data(), event.second.size(), BUFFER, &error);
+    }
+    values.push_back(filename.ToLocalChecked());
+  }
+
+  Local<Value> argv[] = {
+    Integer::New(isolate, status),
+    Array::New(isolate, values.data(), values.size()),
+    Boolean::New(isolate, overflow_),
+  };
+
+  events_.clear();
+  seen_events_.clear();
+  overflow_ = false;
+
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+#endif  // __linux__
+
+
 class FSEventWrap: public HandleWrap {
  public:
   static void Initialize(Local<Object> target,
@@ -118,6 +509,10 @@ void FSEventWrap::Initialize(Local<Object> target,
       static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
 
   SetConstructorFunction(context, target, "FSEvent", t);
+
+#ifdef __linux__
+  RecursiveFSEventWrap::Initialize(env, target, context);
+#endif
 }
 
 void FSEventWrap::RegisterExternalReferences(
@@ -125,6 +520,9 @@ void FSEventWrap::RegisterExternalReferences(
   registry->Register(New);
   registry->Register(Start);
   registry->Register(GetInitialized);
+#ifdef __linux__
+  RecursiveFSEventWrap::RegisterExternalReferences(registry);
+#endif
 }
 
 void FSEventWrap::New(const FunctionCallbackInfo<Value>& args) {
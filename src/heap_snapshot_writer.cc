@@ -0,0 +1,489 @@
+#include "heap_snapshot_writer.h"
+#include "util-inl.h"
+
+#include <cstring>
+
+namespace node {
+namespace heap {
+
+namespace {
+
+constexpr char kBinaryMagic[] = {'N', 'O', 'D', 'E', 'H', 'E', 'A', 'P'};
+constexpr uint8_t kBinaryVersion = 1;
+
+// Kinds of the top-level values of the snapshot in the binary format.
+enum SectionKind : uint8_t {
+  kRawJson = 0,
+  kIntegers = 1,
+  kStrings = 2,
+};
+
+// The top-level arrays of the JSON snapshot that only contain integers.
+bool IsIntegerSection(const std::string& name) {
+  return name == "nodes" || name == "edges" ||
+         name == "trace_function_infos" || name == "samples" ||
+         name == "locations";
+}
+
+void AppendVarint(std::string* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendUtf8(std::string* out, uint32_t c) {
+  if (c < 0x80) {
+    out->push_back(static_cast<char>(c));
+  } else if (c < 0x800) {
+    out->push_back(static_cast<char>(0xc0 | (c >> 6)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  } else if (c < 0x10000) {
+    out->push_back(static_cast<char>(0xe0 | (c >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  } else {
+    out->push_back(static_cast<char>(0xf0 | (c >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+  }
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+}  // namespace
+
+// Transcodes the JSON serialization of a heap snapshot, as produced by V8,
+// into the binary format. The input may be split at any byte, so this is a
+// small state machine over the characters of the top-level object.
+class HeapSnapshotWriter::Transcoder {
+ public:
+  explicit Transcoder(HeapSnapshotWriter* writer) : writer_(writer) {
+    out_.append(kBinaryMagic, sizeof(kBinaryMagic));
+    out_.push_back(static_cast<char>(kBinaryVersion));
+  }
+
+  // Returns false if the input is not a heap snapshot.
+  bool Feed(const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      if (!Next(data[i])) return false;
+    }
+    if (out_.size() >= kChunkSize) Flush(false);
+    return true;
+  }
+
+  bool End() {
+    if (state_ != kDone) return false;
+    Flush(true);
+    return true;
+  }
+
+ private:
+  enum State {
+    kStart,
+    kObject,
+    kKey,
+    kColon,
+    kValue,
+    kRaw,
+    kIntegerArray,
+    kStringArray,
+    kString,
+    kEscape,
+    kUnicode,
+    kDone,
+  };
+
+  void Flush(bool end) {
+    writer_->Output(out_.data(), out_.size(), end);
+    out_.clear();
+  }
+
+  void BeginSection(SectionKind kind) {
+    AppendVarint(&out_, key_.size());
+    out_.append(key_);
+    out_.push_back(static_cast<char>(kind));
+  }
+
+  void EndInteger() {
+    if (!has_digits_) return;
+    // Zigzag encoded and shifted by one, 0 ends the section.
+    uint64_t zigzag = negative_ ? value_ * 2 - 1 : value_ * 2;
+    AppendVarint(&out_, zigzag + 1);
+    value_ = 0;
+    negative_ = false;
+    has_digits_ = false;
+  }
+
+  void AppendCodeUnit(uint32_t unit) {
+    if (high_surrogate_ != 0) {
+      if (unit >= 0xdc00 && unit <= 0xdfff) {
+        AppendUtf8(&string_,
+                   0x10000 + ((high_surrogate_ - 0xd800) << 10) +
+                       (unit - 0xdc00));
+        high_surrogate_ = 0;
+        return;
+      }
+      FlushSurrogate();
+    }
+    if (unit >= 0xd800 && unit <= 0xdbff) {
+      high_surrogate_ = unit;
+    } else {
+      AppendUtf8(&string_, unit);
+    }
+  }
+
+  void FlushSurrogate() {
+    if (high_surrogate_ == 0) return;
+    AppendUtf8(&string_, high_surrogate_);
+    high_surrogate_ = 0;
+  }
+
+  bool Next(char c) {
+    switch (state_) {
+      case kStart:
+        if (IsWhitespace(c)) return true;
+        if (c != '{') return false;
+        state_ = kObject;
+        return true;
+
+      case kObject:
+        if (IsWhitespace(c) || c == ',') return true;
+        if (c == '}') {
+          AppendVarint(&out_, 0);
+          state_ = kDone;
+          return true;
+        }
+        if (c != '"') return false;
+        key_.clear();
+        state_ = kKey;
+        return true;
+
+      case kKey:
+        if (c == '"') {
+          if (key_.empty()) return false;
+          state_ = kColon;
+        } else {
+          key_.push_back(c);
+        }
+        return true;
+
+      case kColon:
+        if (IsWhitespace(c)) return true;
+        if (c != ':') return false;
+        state_ = kValue;
+        return true;
+
+      case kValue:
+        if (IsWhitespace(c)) return true;
+        if (c == '[' && key_ == "strings") {
+          BeginSection(kStrings);
+          state_ = kStringArray;
+          return true;
+        }
+        if (c == '[' && IsIntegerSection(key_)) {
+          BeginSection(kIntegers);
+          state_ = kIntegerArray;
+          return true;
+        }
+        if (c != '[' && c != '{') return false;
+        raw_.clear();
+        raw_depth_ = 0;
+        raw_in_string_ = false;
+        raw_escape_ = false;
+        state_ = kRaw;
+        return Next(c);
+
+      case kRaw:
+        raw_.push_back(c);
+        if (raw_in_string_) {
+          if (raw_escape_) {
+            raw_escape_ = false;
+          } else if (c == '\\') {
+            raw_escape_ = true;
+          } else if (c == '"') {
+            raw_in_string_ = false;
+          }
+        } else if (c == '"') {
+          raw_in_string_ = true;
+        } else if (c == '[' || c == '{') {
+          raw_depth_++;
+        } else if (c == ']' || c == '}') {
+          if (--raw_depth_ == 0) {
+            BeginSection(kRawJson);
+            AppendVarint(&out_, raw_.size());
+            out_.append(raw_);
+            raw_.clear();
+            state_ = kObject;
+          }
+        }
+        return true;
+
+      case kIntegerArray:
+        if (c >= '0' && c <= '9') {
+          value_ = value_ * 10 + (c - '0');
+          has_digits_ = true;
+        } else if (c == '-' && !has_digits_ && !negative_) {
+          negative_ = true;
+        } else if (IsWhitespace(c) || c == ',') {
+          EndInteger();
+        } else if (c == ']') {
+          EndInteger();
+          AppendVarint(&out_, 0);
+          state_ = kObject;
+        } else {
+          return false;
+        }
+        return true;
+
+      case kStringArray:
+        if (IsWhitespace(c) || c == ',') return true;
+        if (c == ']') {
+          AppendVarint(&out_, 0);
+          state_ = kObject;
+          return true;
+        }
+        if (c != '"') return false;
+        string_.clear();
+        state_ = kString;
+        return true;
+
+      case kString:
+        if (c == '\\') {
+          state_ = kEscape;
+          return true;
+        }
+        FlushSurrogate();
+        if (c == '"') {
+          AppendVarint(&out_, string_.size() + 1);
+          out_.append(string_);
+          state_ = kStringArray;
+        } else {
+          string_.push_back(c);
+        }
+        return true;
+
+      case kEscape:
+        state_ = kString;
+        if (c == 'u') {
+          unit_ = 0;
+          unit_digits_ = 0;
+          state_ = kUnicode;
+          return true;
+        }
+        FlushSurrogate();
+        switch (c) {
+          case 'b': string_.push_back('\b'); return true;
+          case 'f': string_.push_back('\f'); return true;
+          case 'n': string_.push_back('\n'); return true;
+          case 'r': string_.push_back('\r'); return true;
+          case 't': string_.push_back('\t'); return true;
+          case '"':
+          case '\\':
+          case '/':
+            string_.push_back(c);
+            return true;
+          default:
+            return false;
+        }
+
+      case kUnicode: {
+        int digit = HexValue(c);
+        if (digit < 0) return false;
+        unit_ = unit_ * 16 + digit;
+        if (++unit_digits_ == 4) {
+          AppendCodeUnit(unit_);
+          state_ = kString;
+        }
+        return true;
+      }
+
+      case kDone:
+        return IsWhitespace(c);
+    }
+    UNREACHABLE();
+  }
+
+  HeapSnapshotWriter* const writer_;
+  State state_ = kStart;
+  std::string out_;
+  std::string key_;
+
+  std::string raw_;
+  int raw_depth_ = 0;
+  bool raw_in_string_ = false;
+  bool raw_escape_ = false;
+
+  uint64_t value_ = 0;
+  bool negative_ = false;
+  bool has_digits_ = false;
+
+  std::string string_;
+  uint32_t unit_ = 0;
+  int unit_digits_ = 0;
+  uint32_t high_surrogate_ = 0;
+};
+
+const char* HeapSnapshotWriter::Extension(int flags) {
+  switch (flags & (kBinary | kCompress)) {
+    case kBinary | kCompress:
+      return "heapsnapshot.bin.gz";
+    case kBinary:
+      return "heapsnapshot.bin";
+    case kCompress:
+      return "heapsnapshot.gz";
+    default:
+      return "heapsnapshot";
+  }
+}
+
+HeapSnapshotWriter::HeapSnapshotWriter(uv_file fd, int flags)
+    : fd_(fd), flags_(flags) {
+  if (flags_ & kBinary) transcoder_ = std::make_unique<Transcoder>(this);
+  if (flags_ & kCompress) {
+    memset(&stream_, 0, sizeof(stream_));
+    // Snapshots are large and compress well even at the fastest level.
+    int err = deflateInit2(&stream_,
+                           Z_BEST_SPEED,
+                           Z_DEFLATED,
+                           16 + MAX_WBITS,  // gzip
+                           8,
+                           Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+      status_ = UV_ENOMEM;
+      return;
+    }
+    deflating_ = true;
+    out_.resize(kChunkSize);
+  }
+  // Without a thread the chunks are written as they are produced.
+  threaded_ = uv_thread_create(&thread_, ThreadMain, this) == 0;
+}
+
+HeapSnapshotWriter::~HeapSnapshotWriter() {
+  if (!finished_) Finish();
+  if (deflating_) deflateEnd(&stream_);
+}
+
+void HeapSnapshotWriter::ThreadMain(void* data) {
+  HeapSnapshotWriter* writer = static_cast<HeapSnapshotWriter*>(data);
+  for (;;) {
+    std::string chunk;
+    {
+      Mutex::ScopedLock lock(writer->mutex_);
+      while (writer->queue_.empty() && !writer->ended_)
+        writer->cond_.Wait(lock);
+      if (writer->queue_.empty()) break;
+      chunk = std::move(writer->queue_.front());
+      writer->queue_.pop_front();
+      writer->cond_.Broadcast(lock);
+    }
+    writer->Process(chunk.data(), chunk.size());
+  }
+  writer->ProcessEnd();
+}
+
+int HeapSnapshotWriter::Finish() {
+  CHECK(!finished_);
+  finished_ = true;
+  if (threaded_) {
+    {
+      Mutex::ScopedLock lock(mutex_);
+      ended_ = true;
+      cond_.Broadcast(lock);
+    }
+    CHECK_EQ(uv_thread_join(&thread_), 0);
+  } else {
+    ProcessEnd();
+  }
+  Mutex::ScopedLock lock(mutex_);
+  return status_;
+}
+
+void HeapSnapshotWriter::EndOfStream() {
+  if (!threaded_) return;
+  Mutex::ScopedLock lock(mutex_);
+  ended_ = true;
+  cond_.Broadcast(lock);
+}
+
+v8::OutputStream::WriteResult HeapSnapshotWriter::WriteAsciiChunk(char* data,
+                                                                  int size) {
+  if (!threaded_) {
+    Process(data, size);
+    return status_ == 0 ? kContinue : kAbort;
+  }
+  Mutex::ScopedLock lock(mutex_);
+  while (queue_.size() >= kMaxQueuedChunks && status_ == 0)
+    cond_.Wait(lock);
+  if (status_ != 0) return kAbort;
+  queue_.emplace_back(data, size);
+  cond_.Broadcast(lock);
+  return kContinue;
+}
+
+void HeapSnapshotWriter::Process(const char* data, size_t size) {
+  if (status_ != 0) return;
+  if (transcoder_) {
+    if (!transcoder_->Feed(data, size)) Fail(UV_EINVAL);
+  } else {
+    Output(data, size);
+  }
+}
+
+void HeapSnapshotWriter::ProcessEnd() {
+  if (status_ != 0) return;
+  if (transcoder_) {
+    if (!transcoder_->End()) Fail(UV_EINVAL);
+  } else {
+    Output(nullptr, 0, true);
+  }
+}
+
+void HeapSnapshotWriter::Output(const char* data, size_t size, bool end) {
+  if (status_ != 0) return;
+  if (!deflating_) return Write(data, size);
+
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream_.avail_in = size;
+  int err;
+  do {
+    stream_.next_out = reinterpret_cast<Bytef*>(&out_[0]);
+    stream_.avail_out = out_.size();
+    err = deflate(&stream_, end ? Z_FINISH : Z_NO_FLUSH);
+    CHECK_NE(err, Z_STREAM_ERROR);
+    Write(out_.data(), out_.size() - stream_.avail_out);
+  } while (status_ == 0 && stream_.avail_out == 0 && err != Z_STREAM_END);
+}
+
+void HeapSnapshotWriter::Write(const char* data, size_t size) {
+  while (size > 0) {
+    uv_fs_t req;
+    uv_buf_t buf = uv_buf_init(const_cast<char*>(data), size);
+    int written = uv_fs_write(nullptr, &req, fd_, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (written < 0) return Fail(written);
+    data += written;
+    size -= written;
+  }
+}
+
+void HeapSnapshotWriter::Fail(int err) {
+  Mutex::ScopedLock lock(mutex_);
+  status_ = err;
+  cond_.Broadcast(lock);
+}
+
+}  // namespace heap
+}  // namespace node
@@ -0,0 +1,88 @@
+#ifndef SRC_HEAP_SNAPSHOT_WRITER_H_
+#define SRC_HEAP_SNAPSHOT_WRITER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "node_mutex.h"
+#include "uv.h"
+#include "v8-profiler.h"
+#include "zlib.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace node {
+namespace heap {
+
+// A v8::OutputStream that writes a heap snapshot to a file descriptor from a
+// background thread. V8 serializes the snapshot on the calling thread in
+// chunks; the chunks are handed to the writer thread through a queue that
+// holds at most kMaxQueuedChunks of them, so the serializer waits for the
+// disk instead of buffering the snapshot in memory.
+//
+// With kBinary the JSON produced by V8 is transcoded on the writer thread
+// into the compact format described in doc/api/v8.md, with kCompress the
+// output is gzip-compressed.
+class HeapSnapshotWriter final : public v8::OutputStream {
+ public:
+  enum Flags : int {
+    kCompress = 1 << 0,
+    kBinary = 1 << 1,
+  };
+
+  static constexpr size_t kChunkSize = 65536;
+  static constexpr size_t kMaxQueuedChunks = 16;
+
+  // Returns the file extension of snapshots written with `flags`.
+  static const char* Extension(int flags);
+
+  HeapSnapshotWriter(uv_file fd, int flags);
+  ~HeapSnapshotWriter() override;
+
+  HeapSnapshotWriter(const HeapSnapshotWriter&) = delete;
+  HeapSnapshotWriter& operator=(const HeapSnapshotWriter&) = delete;
+
+  // Waits until everything is written and returns 0 or the first error.
+  int Finish();
+
+  int GetChunkSize() override { return kChunkSize; }
+  void EndOfStream() override;
+  WriteResult WriteAsciiChunk(char* data, int size) override;
+
+ private:
+  class Transcoder;
+
+  static void ThreadMain(void* data);
+  void Process(const char* data, size_t size);
+  void ProcessEnd();
+  void Output(const char* data, size_t size, bool end = false);
+  void Write(const char* data, size_t size);
+  void Fail(int err);
+
+  const uv_file fd_;
+  const int flags_;
+  bool threaded_ = false;
+  bool finished_ = false;
+  uv_thread_t thread_;
+
+  Mutex mutex_;
+  ConditionVariable cond_;
+  std::deque<std::string> queue_;
+  bool ended_ = false;
+  int status_ = 0;
+
+  // Only used by the writer thread.
+  std::unique_ptr<Transcoder> transcoder_;
+  bool deflating_ = false;
+  z_stream stream_;
+  std::string out_;
+};
+
+}  // namespace heap
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HEAP_SNAPSHOT_WRITER_H_
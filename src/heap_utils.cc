@@ -1,5 +1,6 @@
 #include "diagnosticfilename-inl.h"
 #include "env-inl.h"
+#include "heap_snapshot_writer.h"
 #include "memory_tracker-inl.h"
 #include "node_external_reference.h"
 #include "stream_base-inl.h"
@@ -26,6 +27,7 @@ using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
 using v8::HeapSnapshot;
+using v8::Int32;
 using v8::Isolate;
 using v8::JustVoid;
 using v8::Local;
@@ -218,48 +220,6 @@ void BuildEmbedderGraph(const FunctionCallbackInfo<Value>& args) {
 }
 
 namespace {
-class FileOutputStream : public v8::OutputStream {
- public:
-  FileOutputStream(const int fd, uv_fs_t* req) : fd_(fd), req_(req) {}
-
-  int GetChunkSize() override {
-    return 65536;  // big chunks == faster
-  }
-
-  void EndOfStream() override {}
-
-  WriteResult WriteAsciiChunk(char* data, const int size) override {
-    DCHECK_EQ(status_, 0);
-    int offset = 0;
-    while (offset < size) {
-      const uv_buf_t buf = uv_buf_init(data + offset, size - offset);
-      const int num_bytes_written = uv_fs_write(nullptr,
-                                                req_,
-                                                fd_,
-                                                &buf,
-                                                1,
-                                                -1,
-                                                nullptr);
-      uv_fs_req_cleanup(req_);
-      if (num_bytes_written < 0) {
-        status_ = num_bytes_written;
-        return kAbort;
-      }
-      DCHECK_LE(static_cast<size_t>(num_bytes_written), buf.len);
-      offset += num_bytes_written;
-    }
-    DCHECK_EQ(offset, size);
-    return kContinue;
-  }
-
-  int status() const { return status_; }
-
- private:
-  const int fd_;
-  uv_fs_t* req_;
-  int status_ = 0;
-};
-
 class HeapSnapshotStream : public AsyncWrap,
                            public StreamBase,
                            public v8::OutputStream {
@@ -348,7 +308,7 @@ inline void TakeSnapshot(Environment* env, v8::OutputStream* out) {
 
 }  // namespace
 
-Maybe<void> WriteSnapshot(Environment* env, const char* filename) {
+Maybe<void> WriteSnapshot(Environment* env, const char* filename, int flags) {
   uv_fs_t req;
   int err;
 
@@ -364,9 +324,16 @@ Maybe<void> WriteSnapshot(Environment* env, const char* filename) {
     return Nothing<void>();
   }
 
-  FileOutputStream stream(fd, &req);
-  TakeSnapshot(env, &stream);
-  if ((err = stream.status()) < 0) {
+  {
+    // The snapshot is released as soon as it has been serialized, before
+    // waiting for the writer thread to catch up.
+    HeapSnapshotWriter writer(fd, flags);
+    TakeSnapshot(env, &writer);
+    err = writer.Finish();
+  }
+  if (err < 0) {
+    uv_fs_close(nullptr, &req, fd, nullptr);
+    uv_fs_req_cleanup(&req);
     env->ThrowUVException(err, "write", nullptr, filename);
     return Nothing<void>();
   }
@@ -421,15 +388,18 @@ void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(stream->object());
 }
 
+// triggerHeapSnapshot(filename | undefined, flags)
 void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = args.GetIsolate();
 
   Local<Value> filename_v = args[0];
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
 
   if (filename_v->IsUndefined()) {
-    DiagnosticFilename name(env, "Heap", "heapsnapshot");
-    if (WriteSnapshot(env, *name).IsNothing())
+    DiagnosticFilename name(env, "Heap", HeapSnapshotWriter::Extension(flags));
+    if (WriteSnapshot(env, *name, flags).IsNothing())
       return;
     if (String::NewFromUtf8(isolate, *name).ToLocal(&filename_v)) {
       args.GetReturnValue().Set(filename_v);
@@ -439,7 +409,7 @@ void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
 
   BufferValue path(isolate, filename_v);
   CHECK_NOT_NULL(*path);
-  if (WriteSnapshot(env, *path).IsNothing())
+  if (WriteSnapshot(env, *path, flags).IsNothing())
     return;
   return args.GetReturnValue().Set(filename_v);
 }
@@ -452,6 +422,11 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "triggerHeapSnapshot", TriggerHeapSnapshot);
   SetMethod(
       context, target, "createHeapSnapshotStream", CreateHeapSnapshotStream);
+
+  constexpr int kHeapSnapshotCompress = HeapSnapshotWriter::kCompress;
+  constexpr int kHeapSnapshotBinary = HeapSnapshotWriter::kBinary;
+  NODE_DEFINE_CONSTANT(target, kHeapSnapshotCompress);
+  NODE_DEFINE_CONSTANT(target, kHeapSnapshotBinary);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
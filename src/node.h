@@ -227,6 +227,7 @@ class IsolateData;
 class Environment;
 class MultiIsolatePlatform;
 class InitializationResultImpl;
+struct SnapshotData;
 
 namespace ProcessFlags {
 // TODO(addaleax): Switch to uint32_t to match std::atomic<uint32_t>
@@ -496,17 +497,68 @@ NODE_EXTERN void SetIsolateUpForNode(v8::Isolate* isolate,
 // uncaught exception listener.
 NODE_EXTERN void SetIsolateUpForNode(v8::Isolate* isolate);
 
+// A snapshot of an initialized Node.js instance that new isolates and
+// Environments can be deserialized from, instead of being bootstrapped from
+// scratch. See CommonEnvironmentSetup::CreateForSnapshotting() and
+// CommonEnvironmentSetup::CreateFromSnapshot().
+class NODE_EXTERN EmbedderSnapshotData {
+ public:
+  struct DeleteSnapshotData {
+    void operator()(const EmbedderSnapshotData*) const;
+  };
+  using Pointer =
+      std::unique_ptr<const EmbedderSnapshotData, DeleteSnapshotData>;
+
+  // Returns the snapshot that is built into the Node.js binary, or an empty
+  // pointer if the binary was built without one.
+  static Pointer BuiltinSnapshotData();
+
+  // Reads a snapshot previously written with ToFile(). The FILE* handle is
+  // consumed but not closed, and can be closed right after this call.
+  // Returns an empty pointer if the snapshot was created by a different
+  // Node.js version or for a different platform or architecture.
+  static Pointer FromFile(FILE* in);
+
+  // Writes the snapshot to a file. The FILE* handle is not closed.
+  void ToFile(FILE* out) const;
+
+  // Returns whether isolates can be created from snapshots other than the
+  // built-in one. This is not the case if V8 was built with a read-only heap
+  // that is shared between isolates.
+  static bool CanUseCustomSnapshotPerIsolate();
+
+  EmbedderSnapshotData(const EmbedderSnapshotData&) = delete;
+  EmbedderSnapshotData& operator=(const EmbedderSnapshotData&) = delete;
+  EmbedderSnapshotData(EmbedderSnapshotData&&) = delete;
+  EmbedderSnapshotData& operator=(EmbedderSnapshotData&&) = delete;
+
+ protected:
+  EmbedderSnapshotData(const SnapshotData* impl, bool owns_impl);
+
+ private:
+  const SnapshotData* impl_;
+  bool owns_impl_;
+  friend struct SnapshotData;
+  friend class CommonEnvironmentSetup;
+};
+
 // Creates a new isolate with Node.js-specific settings.
 // This is a convenience method equivalent to using SetIsolateCreateParams(),
 // Isolate::Allocate(), MultiIsolatePlatform::RegisterIsolate(),
 // Isolate::Initialize(), and SetIsolateUpForNode().
-NODE_EXTERN v8::Isolate* NewIsolate(ArrayBufferAllocator* allocator,
-                                    struct uv_loop_s* event_loop,
-                                    MultiIsolatePlatform* platform = nullptr);
+// If `snapshot_data` is passed, the isolate is deserialized from it. It must
+// then also be passed to CreateIsolateData(), and the main context has to be
+// created by passing an empty context to CreateEnvironment().
+NODE_EXTERN v8::Isolate* NewIsolate(
+    ArrayBufferAllocator* allocator,
+    struct uv_loop_s* event_loop,
+    MultiIsolatePlatform* platform = nullptr,
+    const EmbedderSnapshotData* snapshot_data = nullptr);
 NODE_EXTERN v8::Isolate* NewIsolate(
     std::shared_ptr<ArrayBufferAllocator> allocator,
     struct uv_loop_s* event_loop,
-    MultiIsolatePlatform* platform);
+    MultiIsolatePlatform* platform,
+    const EmbedderSnapshotData* snapshot_data = nullptr);
 
 // Creates a new context with Node.js-specific tweaks.
 NODE_EXTERN v8::Local<v8::Context> NewContext(
@@ -521,11 +573,14 @@ NODE_EXTERN v8::Maybe<bool> InitializeContext(v8::Local<v8::Context> context);
 // If `platform` is passed, it will be used to register new Worker instances.
 // It can be `nullptr`, in which case creating new Workers inside of
 // Environments that use this `IsolateData` will not work.
+// `snapshot_data` must be the snapshot that the isolate was created from,
+// if any.
 NODE_EXTERN IsolateData* CreateIsolateData(
     v8::Isolate* isolate,
     struct uv_loop_s* loop,
     MultiIsolatePlatform* platform = nullptr,
-    ArrayBufferAllocator* allocator = nullptr);
+    ArrayBufferAllocator* allocator = nullptr,
+    const EmbedderSnapshotData* snapshot_data = nullptr);
 NODE_EXTERN void FreeIsolateData(IsolateData* isolate_data);
 
 struct ThreadId {
@@ -585,6 +640,11 @@ struct InspectorParentHandle {
 // TODO(addaleax): Maybe move per-Environment options parsing here.
 // Returns nullptr when the Environment cannot be created e.g. there are
 // pending JavaScript exceptions.
+// If `context` is empty, the Environment and its context are deserialized
+// from the snapshot that `isolate_data` was created with. In that case,
+// bootstrapping has already happened and LoadEnvironment() runs the main
+// function set by `v8.startupSnapshot.setDeserializeMainFunction()` when
+// no other entry point is passed to it.
 NODE_EXTERN Environment* CreateEnvironment(
     IsolateData* isolate_data,
     v8::Local<v8::Context> context,
@@ -751,6 +811,32 @@ class NODE_EXTERN CommonEnvironmentSetup {
       MultiIsolatePlatform* platform,
       std::vector<std::string>* errors,
       EnvironmentArgs&&... env_args);
+  // Like Create(), but deserializes the isolate and the Environment from
+  // `snapshot_data` instead of bootstrapping them. `snapshot_data` has to
+  // outlive the returned object.
+  template <typename... EnvironmentArgs>
+  static std::unique_ptr<CommonEnvironmentSetup> CreateFromSnapshot(
+      MultiIsolatePlatform* platform,
+      std::vector<std::string>* errors,
+      const EmbedderSnapshotData* snapshot_data,
+      EnvironmentArgs&&... env_args);
+
+  // Create an embedding setup that can be turned into a snapshot with
+  // CreateSnapshot() once the application has been initialized.
+  // In the Environment of such a setup,
+  // `v8.startupSnapshot.isBuildingSnapshot()` returns true, so that callbacks
+  // for serialization and the main function to run after deserialization can
+  // be registered from JavaScript.
+  static std::unique_ptr<CommonEnvironmentSetup> CreateForSnapshotting(
+      MultiIsolatePlatform* platform,
+      std::vector<std::string>* errors,
+      const std::vector<std::string>& args = {},
+      const std::vector<std::string>& exec_args = {});
+  // Serializes the isolate and the Environment of a setup created with
+  // CreateForSnapshotting(). Returns an empty pointer on failure, e.g. if
+  // there are still active handles or requests. This can only be called once
+  // and must not be called while the isolate is locked by the current thread.
+  EmbedderSnapshotData::Pointer CreateSnapshot();
 
   struct uv_loop_s* event_loop() const;
   std::shared_ptr<ArrayBufferAllocator> array_buffer_allocator() const;
@@ -765,12 +851,23 @@ class NODE_EXTERN CommonEnvironmentSetup {
   CommonEnvironmentSetup& operator=(CommonEnvironmentSetup&&) = delete;
 
  private:
+  enum Flags : uint32_t {
+    kNoFlags = 0,
+    kIsForSnapshotting = 1,
+  };
+
   struct Impl;
   Impl* impl_;
   CommonEnvironmentSetup(
       MultiIsolatePlatform*,
       std::vector<std::string>*,
       std::function<Environment*(const CommonEnvironmentSetup*)>);
+  CommonEnvironmentSetup(
+      MultiIsolatePlatform*,
+      std::vector<std::string>*,
+      const EmbedderSnapshotData*,
+      uint32_t flags,
+      std::function<Environment*(const CommonEnvironmentSetup*)>);
 };
 
 // Implementation for CommonEnvironmentSetup::Create
@@ -790,6 +887,26 @@ std::unique_ptr<CommonEnvironmentSetup> CommonEnvironmentSetup::Create(
   return ret;
 }
 
+// Implementation for CommonEnvironmentSetup::CreateFromSnapshot
+template <typename... EnvironmentArgs>
+std::unique_ptr<CommonEnvironmentSetup>
+CommonEnvironmentSetup::CreateFromSnapshot(
+    MultiIsolatePlatform* platform,
+    std::vector<std::string>* errors,
+    const EmbedderSnapshotData* snapshot_data,
+    EnvironmentArgs&&... env_args) {
+  auto ret = std::unique_ptr<CommonEnvironmentSetup>(new CommonEnvironmentSetup(
+      platform, errors, snapshot_data, Flags::kNoFlags,
+      [&](const CommonEnvironmentSetup* setup) -> Environment* {
+        // The context is empty at this point and will be deserialized.
+        return CreateEnvironment(
+            setup->isolate_data(), setup->context(),
+            std::forward<EnvironmentArgs>(env_args)...);
+      }));
+  if (!errors->empty()) ret.reset();
+  return ret;
+}
+
 /* Converts a unixtime to V8 Date */
 NODE_DEPRECATED("Use v8::Date::New() directly",
                 inline v8::Local<v8::Value> NODE_UNIXTIME_V8(double time) {
@@ -18,6 +18,8 @@
 #include <atomic>
 #include <cstring>
 #include <memory>
+#include <thread>
+#include <vector>
 
 node_napi_env__::node_napi_env__(v8::Local<v8::Context> context,
                                  const std::string& module_filename,
@@ -211,19 +213,23 @@ class ThreadSafeFunction : public node::AsyncResource {
                      node_napi_env env_,
                      void* finalize_data_,
                      napi_finalize finalize_cb_,
-                     napi_threadsafe_function_call_js call_js_cb_)
+                     napi_threadsafe_function_call_js call_js_cb_,
+                     node_api_threadsafe_function_call_js_batch batch_cb_)
       : AsyncResource(env_->isolate,
                       resource,
                       *v8::String::Utf8Value(env_->isolate, name)),
         thread_count(thread_count_),
         is_closing(false),
         dispatch_state(kDispatchIdle),
+        queue_size(0),
+        pending_pushes(0),
         context(context_),
         max_queue_size(max_queue_size_),
         env(env_),
         finalize_data(finalize_data_),
         finalize_cb(finalize_cb_),
         call_js_cb(call_js_cb_ == nullptr ? CallJs : call_js_cb_),
+        batch_cb(batch_cb_),
         handles_closing(false) {
     ref.Reset(env->isolate, func);
     node::AddEnvironmentCleanupHook(env->isolate, Cleanup, this);
@@ -238,28 +244,35 @@ class ThreadSafeFunction : public node::AsyncResource {
   // These methods can be called from any thread.
 
   napi_status Push(void* data, napi_threadsafe_function_call_mode mode) {
-    node::Mutex::ScopedLock lock(this->mutex);
-
-    while (queue.size() >= max_queue_size && max_queue_size > 0 &&
-           !is_closing) {
-      if (mode == napi_tsfn_nonblocking) {
+    if (max_queue_size > 0) {
+      if (!ReserveSlot(mode)) {
         return napi_queue_full;
       }
-      cond->Wait(lock);
+    } else {
+      queue_size.fetch_add(1, std::memory_order_relaxed);
     }
 
+    // The loop thread waits for `pending_pushes` to drop to zero after it has
+    // set `is_closing` and before it closes the async handle, so that no item
+    // is enqueued after the queue has been emptied for the last time.
+    pending_pushes.fetch_add(1);
     if (is_closing) {
+      pending_pushes.fetch_sub(1);
+      queue_size.fetch_sub(1, std::memory_order_relaxed);
+
+      node::Mutex::ScopedLock lock(this->mutex);
       if (thread_count == 0) {
         return napi_invalid_arg;
       } else {
         thread_count--;
         return napi_closing;
       }
-    } else {
-      queue.push(data);
-      Send();
-      return napi_ok;
     }
+
+    queue.Push(data);
+    Send();
+    pending_pushes.fetch_sub(1, std::memory_order_release);
+    return napi_ok;
   }
 
   napi_status Acquire() {
@@ -287,7 +300,7 @@ class ThreadSafeFunction : public node::AsyncResource {
       if (!is_closing) {
         is_closing = (mode == napi_tsfn_abort);
         if (is_closing && max_queue_size > 0) {
-          cond->Signal(lock);
+          cond->Broadcast(lock);
         }
         Send();
       }
@@ -297,8 +310,21 @@ class ThreadSafeFunction : public node::AsyncResource {
   }
 
   void EmptyQueueAndDelete() {
-    for (; !queue.empty(); queue.pop()) {
-      call_js_cb(nullptr, nullptr, context, queue.front());
+    void* data;
+    while (queue.Pop(&data)) {
+      if (batch_cb != nullptr) {
+        batch.push_back(data);
+        // Keep the documented maximum batch size for the final flush too.
+        if (batch.size() == kMaxBatchSize) {
+          batch_cb(nullptr, nullptr, context, batch.data(), batch.size());
+          batch.clear();
+        }
+      } else {
+        call_js_cb(nullptr, nullptr, context, data);
+      }
+    }
+    if (!batch.empty()) {
+      batch_cb(nullptr, nullptr, context, batch.data(), batch.size());
     }
     delete this;
   }
@@ -359,7 +385,7 @@ class ThreadSafeFunction : public node::AsyncResource {
     unsigned int iterations_left = kMaxIterationCount;
     while (has_more && --iterations_left != 0) {
       dispatch_state = kDispatchRunning;
-      has_more = DispatchOne();
+      has_more = batch_cb != nullptr ? DispatchBatch() : DispatchOne();
 
       // Send() was called while we were executing the JS function
       if (dispatch_state.exchange(kDispatchIdle) != kDispatchRunning) {
@@ -372,50 +398,59 @@ class ThreadSafeFunction : public node::AsyncResource {
     }
   }
 
-  bool DispatchOne() {
-    void* data = nullptr;
-    bool popped_value = false;
-    bool has_more = false;
-
-    {
+  // Moves up to `max_items` items from the queue into `batch`, and closes the
+  // thread-safe function if it has been drained and released by all threads.
+  // Returns whether more items are pending.
+  bool PopItems(size_t max_items) {
+    if (is_closing) {
       node::Mutex::ScopedLock lock(this->mutex);
-      if (is_closing) {
-        CloseHandlesAndMaybeDelete();
-      } else {
-        size_t size = queue.size();
-        if (size > 0) {
-          data = queue.front();
-          queue.pop();
-          popped_value = true;
-          if (size == max_queue_size && max_queue_size > 0) {
-            cond->Signal(lock);
-          }
-          size--;
-        }
+      CloseHandlesAndMaybeDelete();
+      return false;
+    }
 
-        if (size == 0) {
-          if (thread_count == 0) {
-            is_closing = true;
-            if (max_queue_size > 0) {
-              cond->Signal(lock);
-            }
-            CloseHandlesAndMaybeDelete();
-          }
-        } else {
-          has_more = true;
-        }
+    void* data;
+    while (batch.size() < max_items && queue.Pop(&data)) {
+      batch.push_back(data);
+    }
+
+    if (!batch.empty()) {
+      size_t size = queue_size.fetch_sub(batch.size());
+      if (size >= max_queue_size && max_queue_size > 0) {
+        node::Mutex::ScopedLock lock(this->mutex);
+        cond->Broadcast(lock);
+      }
+    }
+
+    // If nothing could be popped although the queue is not empty, a producer
+    // is in the middle of Push() and will call Send() once it is done.
+    if (queue_size.load() > 0) {
+      return !batch.empty();
+    }
+
+    // Producers only take the mutex to acquire or release the function, so
+    // the queue size must be re-checked under the lock before deciding that
+    // nothing else will ever be pushed.
+    node::Mutex::ScopedLock lock(this->mutex);
+    if (queue_size.load() == 0 && thread_count == 0) {
+      is_closing = true;
+      if (max_queue_size > 0) {
+        cond->Broadcast(lock);
       }
+      CloseHandlesAndMaybeDelete();
     }
+    return false;
+  }
+
+  bool DispatchOne() {
+    bool has_more = PopItems(1);
+
+    if (!batch.empty()) {
+      void* data = batch.front();
+      batch.clear();
 
-    if (popped_value) {
       v8::HandleScope scope(env->isolate);
       CallbackScope cb_scope(this);
-      napi_value js_callback = nullptr;
-      if (!ref.IsEmpty()) {
-        v8::Local<v8::Function> js_cb =
-            v8::Local<v8::Function>::New(env->isolate, ref);
-        js_callback = v8impl::JsValueFromV8LocalValue(js_cb);
-      }
+      napi_value js_callback = GetJsCallback();
       env->CallbackIntoModule<false>(
           [&](napi_env env) { call_js_cb(env, js_callback, context, data); });
     }
@@ -423,6 +458,31 @@ class ThreadSafeFunction : public node::AsyncResource {
     return has_more;
   }
 
+  bool DispatchBatch() {
+    bool has_more = PopItems(kMaxBatchSize);
+
+    if (!batch.empty()) {
+      v8::HandleScope scope(env->isolate);
+      CallbackScope cb_scope(this);
+      napi_value js_callback = GetJsCallback();
+      env->CallbackIntoModule<false>([&](napi_env env) {
+        batch_cb(env, js_callback, context, batch.data(), batch.size());
+      });
+      batch.clear();
+    }
+
+    return has_more;
+  }
+
+  napi_value GetJsCallback() {
+    if (ref.IsEmpty()) {
+      return nullptr;
+    }
+    v8::Local<v8::Function> js_cb =
+        v8::Local<v8::Function>::New(env->isolate, ref);
+    return v8impl::JsValueFromV8LocalValue(js_cb);
+  }
+
   void Finalize() {
     v8::HandleScope scope(env->isolate);
     if (finalize_cb) {
@@ -438,13 +498,19 @@ class ThreadSafeFunction : public node::AsyncResource {
       node::Mutex::ScopedLock lock(this->mutex);
       is_closing = true;
       if (max_queue_size > 0) {
-        cond->Signal(lock);
+        cond->Broadcast(lock);
       }
     }
     if (handles_closing) {
       return;
     }
     handles_closing = true;
+    // Producers that observed `is_closing == false` are about to finish
+    // enqueueing and signalling the async handle; this only ever spins for
+    // the duration of a single push.
+    while (pending_pushes.load() != 0) {
+      std::this_thread::yield();
+    }
     env->node_env()->CloseHandle(
         reinterpret_cast<uv_handle_t*>(&async),
         [](uv_handle_t* handle) -> void {
@@ -501,20 +567,99 @@ class ThreadSafeFunction : public node::AsyncResource {
   }
 
  private:
+  // Returns false if the queue is full and `mode` is non-blocking. Otherwise
+  // accounts for one more item in `queue_size`, which may briefly exceed
+  // `max_queue_size` when the function is closing.
+  bool ReserveSlot(napi_threadsafe_function_call_mode mode) {
+    size_t size = queue_size.load(std::memory_order_relaxed);
+    for (;;) {
+      while (size < max_queue_size) {
+        if (queue_size.compare_exchange_weak(size, size + 1)) {
+          return true;
+        }
+      }
+
+      if (is_closing) {
+        queue_size.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+
+      if (mode == napi_tsfn_nonblocking) {
+        return false;
+      }
+
+      node::Mutex::ScopedLock lock(this->mutex);
+      while ((size = queue_size.load()) >= max_queue_size && !is_closing) {
+        cond->Wait(lock);
+      }
+    }
+  }
+
+  // Unbounded multi-producer, single-consumer queue after Dmitry Vyukov's
+  // intrusive node-based design. Push() is wait-free and may be called from
+  // any thread, Pop() must only be called from the loop thread.
+  class Queue {
+   public:
+    Queue() : head_(new Node()), tail_(head_) {}
+
+    ~Queue() {
+      void* data;
+      while (Pop(&data)) {
+      }
+      delete head_;
+    }
+
+    void Push(void* data) {
+      Node* node = new Node();
+      node->data = data;
+      Node* prev = tail_.exchange(node, std::memory_order_acq_rel);
+      prev->next.store(node, std::memory_order_release);
+    }
+
+    // Returns false if the queue is empty, or if a concurrent Push() has not
+    // linked its node yet. In the latter case that Push() will signal the
+    // loop thread once it is done.
+    bool Pop(void** data) {
+      Node* next = head_->next.load(std::memory_order_acquire);
+      if (next == nullptr) {
+        return false;
+      }
+      *data = next->data;
+      delete head_;
+      head_ = next;
+      return true;
+    }
+
+   private:
+    struct Node {
+      std::atomic<Node*> next{nullptr};
+      void* data = nullptr;
+    };
+
+    Node* head_;
+    std::atomic<Node*> tail_;
+  };
+
   static const unsigned char kDispatchIdle = 0;
   static const unsigned char kDispatchRunning = 1 << 0;
   static const unsigned char kDispatchPending = 1 << 1;
 
   static const unsigned int kMaxIterationCount = 1000;
+  static const size_t kMaxBatchSize = 1024;
 
   // These are variables protected by the mutex.
   node::Mutex mutex;
   std::unique_ptr<node::ConditionVariable> cond;
-  std::queue<void*> queue;
-  uv_async_t async;
   size_t thread_count;
-  bool is_closing;
+
+  // These are variables that can be accessed from any thread without holding
+  // the mutex.
+  Queue queue;
+  uv_async_t async;
+  std::atomic_bool is_closing;
   std::atomic_uchar dispatch_state;
+  std::atomic_size_t queue_size;
+  std::atomic_size_t pending_pushes;
 
   // These are variables set once, upon creation, and then never again, which
   // means we don't need the mutex to read them.
@@ -527,6 +672,8 @@ class ThreadSafeFunction : public node::AsyncResource {
   void* finalize_data;
   napi_finalize finalize_cb;
   napi_threadsafe_function_call_js call_js_cb;
+  node_api_threadsafe_function_call_js_batch batch_cb;
+  std::vector<void*> batch;
   bool handles_closing;
 };
 
@@ -1308,18 +1455,22 @@ napi_status NAPI_CDECL napi_cancel_async_work(node_api_nogc_env env,
   return napi_clear_last_error(env);
 }
 
-napi_status NAPI_CDECL
-napi_create_threadsafe_function(napi_env env,
-                                napi_value func,
-                                napi_value async_resource,
-                                napi_value async_resource_name,
-                                size_t max_queue_size,
-                                size_t initial_thread_count,
-                                void* thread_finalize_data,
-                                napi_finalize thread_finalize_cb,
-                                void* context,
-                                napi_threadsafe_function_call_js call_js_cb,
-                                napi_threadsafe_function* result) {
+namespace v8impl {
+namespace {
+
+napi_status CreateThreadSafeFunction(
+    napi_env env,
+    napi_value func,
+    napi_value async_resource,
+    napi_value async_resource_name,
+    size_t max_queue_size,
+    size_t initial_thread_count,
+    void* thread_finalize_data,
+    napi_finalize thread_finalize_cb,
+    void* context,
+    napi_threadsafe_function_call_js call_js_cb,
+    node_api_threadsafe_function_call_js_batch batch_cb,
+    napi_threadsafe_function* result) {
   CHECK_ENV_NOT_IN_GC(env);
   CHECK_ARG(env, async_resource_name);
   RETURN_STATUS_IF_FALSE(env, initial_thread_count > 0, napi_invalid_arg);
@@ -1329,7 +1480,8 @@ napi_create_threadsafe_function(napi_env env,
 
   v8::Local<v8::Function> v8_func;
   if (func == nullptr) {
-    CHECK_ARG(env, call_js_cb);
+    RETURN_STATUS_IF_FALSE(
+        env, call_js_cb != nullptr || batch_cb != nullptr, napi_invalid_arg);
   } else {
     CHECK_TO_FUNCTION(env, v8_func, func);
   }
@@ -1356,7 +1508,8 @@ napi_create_threadsafe_function(napi_env env,
                                      reinterpret_cast<node_napi_env>(env),
                                      thread_finalize_data,
                                      thread_finalize_cb,
-                                     call_js_cb);
+                                     call_js_cb,
+                                     batch_cb);
 
   if (ts_fn == nullptr) {
     status = napi_generic_failure;
@@ -1371,6 +1524,63 @@ napi_create_threadsafe_function(napi_env env,
   return napi_set_last_error(env, status);
 }
 
+}  // end of anonymous namespace
+}  // end of namespace v8impl
+
+napi_status NAPI_CDECL
+napi_create_threadsafe_function(napi_env env,
+                                napi_value func,
+                                napi_value async_resource,
+                                napi_value async_resource_name,
+                                size_t max_queue_size,
+                                size_t initial_thread_count,
+                                void* thread_finalize_data,
+                                napi_finalize thread_finalize_cb,
+                                void* context,
+                                napi_threadsafe_function_call_js call_js_cb,
+                                napi_threadsafe_function* result) {
+  return v8impl::CreateThreadSafeFunction(env,
+                                          func,
+                                          async_resource,
+                                          async_resource_name,
+                                          max_queue_size,
+                                          initial_thread_count,
+                                          thread_finalize_data,
+                                          thread_finalize_cb,
+                                          context,
+                                          call_js_cb,
+                                          nullptr,
+                                          result);
+}
+
+napi_status NAPI_CDECL node_api_create_threadsafe_function_batch(
+    napi_env env,
+    napi_value func,
+    napi_value async_resource,
+    napi_value async_resource_name,
+    size_t max_queue_size,
+    size_t initial_thread_count,
+    void* thread_finalize_data,
+    napi_finalize thread_finalize_cb,
+    void* context,
+    node_api_threadsafe_function_call_js_batch call_js_cb,
+    napi_threadsafe_function* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, call_js_cb);
+  return v8impl::CreateThreadSafeFunction(env,
+                                          func,
+                                          async_resource,
+                                          async_resource_name,
+                                          max_queue_size,
+                                          initial_thread_count,
+                                          thread_finalize_data,
+                                          thread_finalize_cb,
+                                          context,
+                                          nullptr,
+                                          call_js_cb,
+                                          result);
+}
+
 napi_status NAPI_CDECL napi_get_threadsafe_function_context(
     napi_threadsafe_function func, void** result) {
   CHECK_NOT_NULL(func);
@@ -234,6 +234,22 @@ NAPI_EXTERN napi_status NAPI_CDECL napi_unref_threadsafe_function(
 NAPI_EXTERN napi_status NAPI_CDECL napi_ref_threadsafe_function(
     node_api_nogc_env env, napi_threadsafe_function func);
 
+#ifdef NAPI_EXPERIMENTAL
+#define NODE_API_EXPERIMENTAL_HAS_THREADSAFE_FUNCTION_BATCH
+NAPI_EXTERN napi_status NAPI_CDECL node_api_create_threadsafe_function_batch(
+    napi_env env,
+    napi_value func,
+    napi_value async_resource,
+    napi_value async_resource_name,
+    size_t max_queue_size,
+    size_t initial_thread_count,
+    void* thread_finalize_data,
+    napi_finalize thread_finalize_cb,
+    void* context,
+    node_api_threadsafe_function_call_js_batch call_js_cb,
+    napi_threadsafe_function* result);
+#endif  // NAPI_EXPERIMENTAL
+
 #endif  // NAPI_VERSION >= 4
 
 #if NAPI_VERSION >= 8
@@ -34,6 +34,14 @@ typedef void(NAPI_CDECL* napi_async_complete_callback)(napi_env env,
 #if NAPI_VERSION >= 4
 typedef void(NAPI_CDECL* napi_threadsafe_function_call_js)(
     napi_env env, napi_value js_callback, void* context, void* data);
+#ifdef NAPI_EXPERIMENTAL
+typedef void(NAPI_CDECL* node_api_threadsafe_function_call_js_batch)(
+    napi_env env,
+    napi_value js_callback,
+    void* context,
+    void** data,
+    size_t count);
+#endif  // NAPI_EXPERIMENTAL
 #endif  // NAPI_VERSION >= 4
 
 typedef struct {
@@ -3,12 +3,16 @@
 #include "base_object-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_bob-inl.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
-#include "threadpoolwork-inl.h"
 #include "v8.h"
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace node {
 
@@ -17,18 +21,17 @@ using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
 using v8::Context;
-using v8::EscapableHandleScope;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
+using v8::Int32;
 using v8::Isolate;
 using v8::Local;
-using v8::MaybeLocal;
 using v8::Number;
 using v8::Object;
 using v8::String;
-using v8::Uint32;
 using v8::Undefined;
 using v8::Value;
 
@@ -47,7 +50,7 @@ void Blob::Initialize(
   SetMethod(context, target, "storeDataObject", StoreDataObject);
   SetMethod(context, target, "getDataObject", GetDataObject);
   SetMethod(context, target, "revokeDataObject", RevokeDataObject);
-  FixedSizeBlobCopyJob::Initialize(realm->env(), target);
+  SetMethod(context, target, "createBlobFromFilePath", CreateBlobFromFilePath);
 }
 
 Local<FunctionTemplate> Blob::GetConstructorTemplate(Environment* env) {
@@ -60,7 +63,7 @@ Local<FunctionTemplate> Blob::GetConstructorTemplate(Environment* env) {
     tmpl->Inherit(BaseObject::GetConstructorTemplate(env));
     tmpl->SetClassName(
         FIXED_ONE_BYTE_STRING(env->isolate(), "Blob"));
-    SetProtoMethod(isolate, tmpl, "toArrayBuffer", ToArrayBuffer);
+    SetProtoMethod(isolate, tmpl, "getReader", GetReader);
     SetProtoMethod(isolate, tmpl, "slice", ToSlice);
     env->set_blob_constructor_template(tmpl);
   }
@@ -72,8 +75,7 @@ bool Blob::HasInstance(Environment* env, v8::Local<v8::Value> object) {
 }
 
 BaseObjectPtr<Blob> Blob::Create(Environment* env,
-                                 const std::vector<BlobEntry>& store,
-                                 size_t length) {
+                                 std::shared_ptr<DataQueue> data_queue) {
   HandleScope scope(env->isolate());
 
   Local<Function> ctor;
@@ -84,18 +86,18 @@ BaseObjectPtr<Blob> Blob::Create(Environment* env,
   if (!ctor->NewInstance(env->context()).ToLocal(&obj))
     return BaseObjectPtr<Blob>();
 
-  return MakeBaseObject<Blob>(env, obj, store, length);
+  return MakeBaseObject<Blob>(env, obj, std::move(data_queue));
 }
 
 void Blob::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(args[0]->IsArray());  // sources
-  CHECK(args[1]->IsUint32());  // length
+  CHECK(args[1]->IsNumber());  // length
 
-  std::vector<BlobEntry> entries;
+  std::vector<std::unique_ptr<DataQueue::Entry>> entries;
 
-  size_t length = args[1].As<Uint32>()->Value();
-  size_t len = 0;
+  uint64_t length = args[1].As<Number>()->Value();
+  uint64_t len = 0;
   Local<Array> ary = args[0].As<Array>();
   for (size_t n = 0; n < ary->Length(); n++) {
     Local<Value> entry;
@@ -105,113 +107,208 @@ void Blob::New(const FunctionCallbackInfo<Value>& args) {
     if (entry->IsArrayBufferView()) {
       Local<ArrayBufferView> view = entry.As<ArrayBufferView>();
       CHECK_EQ(view->ByteOffset(), 0);
-      std::shared_ptr<BackingStore> store = view->Buffer()->GetBackingStore();
-      size_t byte_length = view->ByteLength();
-      view->Buffer()->Detach();  // The Blob will own the backing store now.
-      entries.emplace_back(BlobEntry{std::move(store), byte_length, 0});
-      len += byte_length;
+      len += view->ByteLength();
+      // The Blob will own the backing store now.
+      entries.push_back(DataQueue::CreateInMemoryEntryFromView(view));
+      CHECK(entries.back());
     } else {
       Blob* blob;
       ASSIGN_OR_RETURN_UNWRAP(&blob, entry);
-      auto source = blob->entries();
-      entries.insert(entries.end(), source.begin(), source.end());
       len += blob->length();
+      entries.push_back(DataQueue::CreateDataQueueEntry(blob->data_queue()));
     }
   }
   CHECK_EQ(length, len);
 
-  BaseObjectPtr<Blob> blob = Create(env, entries, length);
+  std::shared_ptr<DataQueue> data_queue =
+      DataQueue::CreateIdempotent(std::move(entries));
+  CHECK(data_queue);
+  BaseObjectPtr<Blob> blob = Create(env, std::move(data_queue));
   if (blob)
     args.GetReturnValue().Set(blob->object());
 }
 
-void Blob::ToArrayBuffer(const FunctionCallbackInfo<Value>& args) {
+void Blob::GetReader(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Blob* blob;
   ASSIGN_OR_RETURN_UNWRAP(&blob, args.Holder());
-  Local<Value> ret;
-  if (blob->GetArrayBuffer(env).ToLocal(&ret))
-    args.GetReturnValue().Set(ret);
+  BaseObjectPtr<Blob::Reader> reader =
+      Blob::Reader::Create(env, BaseObjectPtr<Blob>(blob));
+  if (reader)
+    args.GetReturnValue().Set(reader->object());
 }
 
 void Blob::ToSlice(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Blob* blob;
   ASSIGN_OR_RETURN_UNWRAP(&blob, args.Holder());
-  CHECK(args[0]->IsUint32());
-  CHECK(args[1]->IsUint32());
-  size_t start = args[0].As<Uint32>()->Value();
-  size_t end = args[1].As<Uint32>()->Value();
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  uint64_t start = args[0].As<Number>()->Value();
+  uint64_t end = args[1].As<Number>()->Value();
   BaseObjectPtr<Blob> slice = blob->Slice(env, start, end);
   if (slice)
     args.GetReturnValue().Set(slice->object());
 }
 
 void Blob::MemoryInfo(MemoryTracker* tracker) const {
-  tracker->TrackFieldWithSize("store", length_);
-}
-
-MaybeLocal<Value> Blob::GetArrayBuffer(Environment* env) {
-  EscapableHandleScope scope(env->isolate());
-  size_t len = length();
-  std::shared_ptr<BackingStore> store =
-      ArrayBuffer::NewBackingStore(env->isolate(), len);
-  if (len > 0) {
-    unsigned char* dest = static_cast<unsigned char*>(store->Data());
-    size_t total = 0;
-    for (const auto& entry : entries()) {
-      unsigned char* src = static_cast<unsigned char*>(entry.store->Data());
-      src += entry.offset;
-      memcpy(dest, src, entry.length);
-      dest += entry.length;
-      total += entry.length;
-      CHECK_LE(total, len);
-    }
-  }
-
-  return scope.Escape(ArrayBuffer::New(env->isolate(), store));
+  tracker->TrackField("data_queue_", data_queue_);
 }
 
-BaseObjectPtr<Blob> Blob::Slice(Environment* env, size_t start, size_t end) {
+BaseObjectPtr<Blob> Blob::Slice(Environment* env,
+                                uint64_t start,
+                                uint64_t end) {
   CHECK_LE(start, length());
   CHECK_LE(end, length());
   CHECK_LE(start, end);
 
-  std::vector<BlobEntry> slices;
-  size_t total = end - start;
-  size_t remaining = total;
+  std::shared_ptr<DataQueue> slice = data_queue_->slice(start, end);
+  CHECK(slice);
+  return Create(env, std::move(slice));
+}
 
-  if (total == 0) return Create(env, slices, 0);
+Blob::Blob(Environment* env,
+           v8::Local<v8::Object> obj,
+           std::shared_ptr<DataQueue> data_queue)
+    : BaseObject(env, obj), data_queue_(std::move(data_queue)) {
+  CHECK(data_queue_->is_idempotent());
+  CHECK(data_queue_->size().has_value());
+  MakeWeak();
+}
 
-  for (const auto& entry : entries()) {
-    if (start + entry.offset > entry.store->ByteLength()) {
-      start -= entry.length;
-      continue;
-    }
+Blob::Reader::Reader(Environment* env,
+                     v8::Local<v8::Object> obj,
+                     BaseObjectPtr<Blob> strong_ptr)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_BLOBREADER),
+      inner_(strong_ptr->data_queue_->get_reader()),
+      strong_ptr_(std::move(strong_ptr)) {
+  CHECK(inner_);
+  MakeWeak();
+}
 
-    size_t offset = entry.offset + start;
-    size_t len = std::min(remaining, entry.store->ByteLength() - offset);
-    slices.emplace_back(BlobEntry{entry.store, len, offset});
+bool Blob::Reader::HasInstance(Environment* env, v8::Local<v8::Value> value) {
+  return GetConstructorTemplate(env)->HasInstance(value);
+}
 
-    remaining -= len;
-    start = 0;
+Local<FunctionTemplate> Blob::Reader::GetConstructorTemplate(Environment* env) {
+  Local<FunctionTemplate> tmpl = env->blob_reader_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = NewFunctionTemplate(isolate, nullptr);
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        AsyncWrap::kInternalFieldCount);
+    tmpl->Inherit(AsyncWrap::GetConstructorTemplate(env));
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "BlobReader"));
+    SetProtoMethod(isolate, tmpl, "pull", Pull);
+    env->set_blob_reader_constructor_template(tmpl);
+  }
+  return tmpl;
+}
 
-    if (remaining == 0)
-      break;
+BaseObjectPtr<Blob::Reader> Blob::Reader::Create(Environment* env,
+                                                 BaseObjectPtr<Blob> blob) {
+  Local<Object> obj;
+  if (!GetConstructorTemplate(env)->InstanceTemplate()
+          ->NewInstance(env->context()).ToLocal(&obj)) {
+    return BaseObjectPtr<Blob::Reader>();
   }
 
-  return Create(env, slices, total);
+  return MakeBaseObject<Blob::Reader>(env, obj, std::move(blob));
 }
 
-Blob::Blob(
-    Environment* env,
-    v8::Local<v8::Object> obj,
-    const std::vector<BlobEntry>& store,
-    size_t length)
-    : BaseObject(env, obj),
-      store_(store),
-      length_(length) {
-  MakeWeak();
+void Blob::Reader::Pull(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Blob::Reader* reader;
+  ASSIGN_OR_RETURN_UNWRAP(&reader, args.Holder());
+
+  CHECK(args[0]->IsFunction());
+  uint64_t max_length = std::numeric_limits<uint64_t>::max();
+  if (args[1]->IsNumber())
+    max_length = args[1].As<Number>()->Value();
+
+  // Collects the data that the DataQueue::Reader provides until it is
+  // delivered to the callback, copied into one ArrayBuffer.
+  struct Impl {
+    BaseObjectPtr<Blob::Reader> reader;
+    Global<Function> callback;
+    std::vector<DataQueue::Vec> vecs;
+    std::vector<bob::Done> dones;
+    uint64_t length = 0;
+    int status = bob::Status::STATUS_CONTINUE;
+    bool pulling = true;
+
+    void Deliver() {
+      Environment* env = reader->env();
+      Isolate* isolate = env->isolate();
+      HandleScope handle_scope(isolate);
+      Context::Scope context_scope(env->context());
+
+      if (status == bob::Status::STATUS_EOS)
+        status = bob::Status::STATUS_END;
+      if (status == bob::Status::STATUS_END || status < 0)
+        reader->eos_ = true;
+
+      Local<Value> argv[] = {
+        Int32::New(isolate, status),
+        Undefined(isolate),
+      };
+      if (length > 0) {
+        std::shared_ptr<BackingStore> store =
+            ArrayBuffer::NewBackingStore(isolate, length);
+        uint8_t* dest = static_cast<uint8_t*>(store->Data());
+        for (const DataQueue::Vec& vec : vecs) {
+          memcpy(dest, vec.base, vec.len);
+          dest += vec.len;
+        }
+        // The data has been copied, the source can release it.
+        for (bob::Done& done : dones)
+          std::move(done)(0);
+        argv[1] = ArrayBuffer::New(isolate, store);
+      }
+      reader->MakeCallback(
+          callback.Get(isolate), arraysize(argv), argv);
+    }
+  };
+
+  auto impl = std::make_shared<Impl>();
+  impl->reader = BaseObjectPtr<Blob::Reader>(reader);
+  impl->callback.Reset(env->isolate(), args[0].As<Function>());
+
+  if (reader->eos_) {
+    impl->status = bob::Status::STATUS_END;
+    impl->Deliver();
+    return;
+  }
+
+  auto next = [impl](int status,
+                     const DataQueue::Vec* vecs,
+                     size_t count,
+                     bob::Done done) {
+    for (size_t n = 0; n < count; n++) {
+      impl->vecs.push_back(vecs[n]);
+      impl->length += vecs[n].len;
+    }
+    if (count > 0)
+      impl->dones.push_back(std::move(done));
+    impl->status = status;
+    // Data that arrives asynchronously is delivered right away.
+    if (!impl->pulling)
+      impl->Deliver();
+  };
+
+  int status;
+  do {
+    status = reader->inner_->Pull(next, bob::Options::OPTIONS_NONE, nullptr, 0);
+  } while (status == bob::Status::STATUS_CONTINUE &&
+           impl->length < max_length);
+  impl->pulling = false;
+
+  if (status != bob::Status::STATUS_WAIT)
+    impl->Deliver();
+}
+
+void Blob::Reader::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("blob", strong_ptr_);
 }
 
 BaseObjectPtr<BaseObject>
@@ -223,7 +320,7 @@ Blob::BlobTransferData::Deserialize(
     THROW_ERR_MESSAGE_TARGET_CONTEXT_UNAVAILABLE(env);
     return {};
   }
-  return Blob::Create(env, store_, length_);
+  return Blob::Create(env, data_queue_);
 }
 
 BaseObject::TransferMode Blob::GetTransferMode() const {
@@ -231,7 +328,30 @@ BaseObject::TransferMode Blob::GetTransferMode() const {
 }
 
 std::unique_ptr<worker::TransferData> Blob::CloneForMessaging() const {
-  return std::make_unique<BlobTransferData>(store_, length_);
+  return std::make_unique<BlobTransferData>(data_queue_);
+}
+
+void Blob::CreateBlobFromFilePath(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString() || args[0]->IsUint8Array());  // path
+
+  std::vector<std::unique_ptr<DataQueue::Entry>> entries;
+  std::unique_ptr<DataQueue::Entry> entry =
+      DataQueue::CreateFdEntry(env, args[0]);
+  if (!entry) return;  // An exception has been thrown.
+  entries.push_back(std::move(entry));
+
+  std::shared_ptr<DataQueue> data_queue =
+      DataQueue::CreateIdempotent(std::move(entries));
+  CHECK(data_queue);
+  BaseObjectPtr<Blob> blob = Create(env, data_queue);
+  if (!blob) return;
+
+  Local<Value> ret[] = {
+    blob->object(),
+    Number::New(env->isolate(), static_cast<double>(blob->length())),
+  };
+  args.GetReturnValue().Set(Array::New(env->isolate(), ret, arraysize(ret)));
 }
 
 void Blob::StoreDataObject(const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -240,14 +360,14 @@ void Blob::StoreDataObject(const v8::FunctionCallbackInfo<v8::Value>& args) {
 
   CHECK(args[0]->IsString());  // ID key
   CHECK(Blob::HasInstance(env, args[1]));  // Blob
-  CHECK(args[2]->IsUint32());  // Length
+  CHECK(args[2]->IsNumber());  // Length
   CHECK(args[3]->IsString());  // Type
 
   Utf8Value key(env->isolate(), args[0]);
   Blob* blob;
   ASSIGN_OR_RETURN_UNWRAP(&blob, args[1]);
 
-  size_t length = args[2].As<Uint32>()->Value();
+  uint64_t length = args[2].As<Number>()->Value();
   Utf8Value type(env->isolate(), args[3]);
 
   binding_data->store_data_object(
@@ -291,7 +411,7 @@ void Blob::GetDataObject(const v8::FunctionCallbackInfo<v8::Value>& args) {
 
     Local<Value> values[] = {
       stored.blob->object(),
-      Uint32::NewFromUnsigned(env->isolate(), stored.length),
+      Number::New(env->isolate(), static_cast<double>(stored.length)),
       type
     };
 
@@ -303,114 +423,6 @@ void Blob::GetDataObject(const v8::FunctionCallbackInfo<v8::Value>& args) {
   }
 }
 
-FixedSizeBlobCopyJob::FixedSizeBlobCopyJob(Environment* env,
-                                           Local<Object> object,
-                                           Blob* blob,
-                                           FixedSizeBlobCopyJob::Mode mode)
-    : AsyncWrap(env, object, AsyncWrap::PROVIDER_FIXEDSIZEBLOBCOPY),
-      ThreadPoolWork(env, "blob"),
-      mode_(mode) {
-  if (mode == FixedSizeBlobCopyJob::Mode::SYNC) MakeWeak();
-  source_ = blob->entries();
-  length_ = blob->length();
-}
-
-void FixedSizeBlobCopyJob::AfterThreadPoolWork(int status) {
-  Environment* env = AsyncWrap::env();
-  CHECK_EQ(mode_, Mode::ASYNC);
-  CHECK(status == 0 || status == UV_ECANCELED);
-  std::unique_ptr<FixedSizeBlobCopyJob> ptr(this);
-  HandleScope handle_scope(env->isolate());
-  Context::Scope context_scope(env->context());
-  Local<Value> args[2];
-
-  if (status == UV_ECANCELED) {
-    args[0] = Number::New(env->isolate(), status),
-    args[1] = Undefined(env->isolate());
-  } else {
-    args[0] = Undefined(env->isolate());
-    args[1] = ArrayBuffer::New(env->isolate(), destination_);
-  }
-
-  ptr->MakeCallback(env->ondone_string(), arraysize(args), args);
-}
-
-void FixedSizeBlobCopyJob::DoThreadPoolWork() {
-  unsigned char* dest = static_cast<unsigned char*>(destination_->Data());
-  if (length_ > 0) {
-    size_t total = 0;
-    for (const auto& entry : source_) {
-      unsigned char* src = static_cast<unsigned char*>(entry.store->Data());
-      src += entry.offset;
-      memcpy(dest, src, entry.length);
-      dest += entry.length;
-      total += entry.length;
-      CHECK_LE(total, length_);
-    }
-  }
-}
-
-void FixedSizeBlobCopyJob::MemoryInfo(MemoryTracker* tracker) const {
-  tracker->TrackFieldWithSize("source", length_);
-  tracker->TrackFieldWithSize(
-      "destination",
-      destination_ ? destination_->ByteLength() : 0);
-}
-
-void FixedSizeBlobCopyJob::Initialize(Environment* env, Local<Object> target) {
-  Isolate* isolate = env->isolate();
-  v8::Local<v8::FunctionTemplate> job = NewFunctionTemplate(isolate, New);
-  job->Inherit(AsyncWrap::GetConstructorTemplate(env));
-  job->InstanceTemplate()->SetInternalFieldCount(
-      AsyncWrap::kInternalFieldCount);
-  SetProtoMethod(isolate, job, "run", Run);
-  SetConstructorFunction(env->context(), target, "FixedSizeBlobCopyJob", job);
-}
-
-void FixedSizeBlobCopyJob::New(const FunctionCallbackInfo<Value>& args) {
-  static constexpr size_t kMaxSyncLength = 4096;
-  static constexpr size_t kMaxEntryCount = 4;
-
-  Environment* env = Environment::GetCurrent(args);
-  CHECK(args.IsConstructCall());
-  CHECK(args[0]->IsObject());
-  CHECK(Blob::HasInstance(env, args[0]));
-
-  Blob* blob;
-  ASSIGN_OR_RETURN_UNWRAP(&blob, args[0]);
-
-  // This is a fairly arbitrary heuristic. We want to avoid deferring to
-  // the threadpool if the amount of data being copied is small and there
-  // aren't that many entries to copy.
-  FixedSizeBlobCopyJob::Mode mode =
-      (blob->length() < kMaxSyncLength &&
-       blob->entries().size() < kMaxEntryCount) ?
-          FixedSizeBlobCopyJob::Mode::SYNC :
-          FixedSizeBlobCopyJob::Mode::ASYNC;
-
-  new FixedSizeBlobCopyJob(env, args.This(), blob, mode);
-}
-
-void FixedSizeBlobCopyJob::Run(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  FixedSizeBlobCopyJob* job;
-  ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
-  job->destination_ =
-      ArrayBuffer::NewBackingStore(env->isolate(), job->length_);
-  if (job->mode() == FixedSizeBlobCopyJob::Mode::ASYNC)
-    return job->ScheduleWork();
-
-  job->DoThreadPoolWork();
-  args.GetReturnValue().Set(
-      ArrayBuffer::New(env->isolate(), job->destination_));
-}
-
-void FixedSizeBlobCopyJob::RegisterExternalReferences(
-    ExternalReferenceRegistry* registry) {
-  registry->Register(New);
-  registry->Register(Run);
-}
-
 void BlobBindingData::StoredDataObject::MemoryInfo(
     MemoryTracker* tracker) const {
   tracker->TrackField("blob", blob);
@@ -419,7 +431,7 @@ void BlobBindingData::StoredDataObject::MemoryInfo(
 
 BlobBindingData::StoredDataObject::StoredDataObject(
     const BaseObjectPtr<Blob>& blob_,
-    size_t length_,
+    uint64_t length_,
     const std::string& type_)
     : blob(blob_),
       length(length_),
@@ -485,13 +497,13 @@ InternalFieldInfoBase* BlobBindingData::Serialize(int index) {
 
 void Blob::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Blob::New);
-  registry->Register(Blob::ToArrayBuffer);
+  registry->Register(Blob::GetReader);
   registry->Register(Blob::ToSlice);
   registry->Register(Blob::StoreDataObject);
   registry->Register(Blob::GetDataObject);
   registry->Register(Blob::RevokeDataObject);
-
-  FixedSizeBlobCopyJob::RegisterExternalReferences(registry);
+  registry->Register(Blob::CreateBlobFromFilePath);
+  registry->Register(Blob::Reader::Pull);
 }
 
 }  // namespace node
@@ -5,6 +5,7 @@
 
 #include "async_wrap.h"
 #include "base_object.h"
+#include "dataqueue/queue.h"
 #include "env.h"
 #include "memory_tracker.h"
 #include "node_internals.h"
@@ -12,18 +13,13 @@
 #include "node_worker.h"
 #include "v8.h"
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace node {
 
-struct BlobEntry {
-  std::shared_ptr<v8::BackingStore> store;
-  size_t length;
-  size_t offset;
-};
-
 class Blob : public BaseObject {
  public:
   static void RegisterExternalReferences(
@@ -36,41 +32,64 @@ class Blob : public BaseObject {
       void* priv);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
-  static void ToArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetReader(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void ToSlice(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void StoreDataObject(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetDataObject(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RevokeDataObject(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CreateBlobFromFilePath(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
       Environment* env);
 
   static BaseObjectPtr<Blob> Create(Environment* env,
-                                    const std::vector<BlobEntry>& store,
-                                    size_t length);
+                                    std::shared_ptr<DataQueue> data_queue);
 
   static bool HasInstance(Environment* env, v8::Local<v8::Value> object);
 
-  const std::vector<BlobEntry>& entries() const { return store_; }
-
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(Blob)
   SET_SELF_SIZE(Blob)
 
-  // Copies the contents of the Blob into an ArrayBuffer.
-  v8::MaybeLocal<v8::Value> GetArrayBuffer(Environment* env);
+  BaseObjectPtr<Blob> Slice(Environment* env, uint64_t start, uint64_t end);
+
+  inline uint64_t length() const { return data_queue_->size().value(); }
+
+  // Reads the data of a Blob. The Blob is kept alive while it is read.
+  class Reader final : public AsyncWrap {
+   public:
+    static bool HasInstance(Environment* env, v8::Local<v8::Value> value);
+    static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+        Environment* env);
+    static BaseObjectPtr<Reader> Create(Environment* env,
+                                        BaseObjectPtr<Blob> blob);
+
+    // pull(callback[, maxLength]) calls callback(status, buffer) with the
+    // data that could be read, as one ArrayBuffer, or undefined if there was
+    // none. Data that is available synchronously is collected up to
+    // maxLength bytes. status is 1 if there is more data, 0 at the end, and
+    // a negative error code if reading failed.
+    static void Pull(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    Reader(Environment* env,
+           v8::Local<v8::Object> obj,
+           BaseObjectPtr<Blob> strong_ptr);
 
-  BaseObjectPtr<Blob> Slice(Environment* env, size_t start, size_t end);
+    void MemoryInfo(MemoryTracker* tracker) const override;
+    SET_MEMORY_INFO_NAME(Blob::Reader)
+    SET_SELF_SIZE(Reader)
 
-  inline size_t length() const { return length_; }
+   private:
+    std::shared_ptr<DataQueue::Reader> inner_;
+    BaseObjectPtr<Blob> strong_ptr_;
+    bool eos_ = false;
+  };
 
   class BlobTransferData : public worker::TransferData {
    public:
-    explicit BlobTransferData(
-        const std::vector<BlobEntry>& store,
-      size_t length)
-        : store_(store),
-          length_(length) {}
+    explicit BlobTransferData(std::shared_ptr<DataQueue> data_queue)
+        : data_queue_(std::move(data_queue)) {}
 
     BaseObjectPtr<BaseObject> Deserialize(
         Environment* env,
@@ -82,61 +101,20 @@ class Blob : public BaseObject {
     SET_NO_MEMORY_INFO()
 
    private:
-    std::vector<BlobEntry> store_;
-    size_t length_ = 0;
+    std::shared_ptr<DataQueue> data_queue_;
   };
 
   BaseObject::TransferMode GetTransferMode() const override;
   std::unique_ptr<worker::TransferData> CloneForMessaging() const override;
 
-  Blob(
-      Environment* env,
-      v8::Local<v8::Object> obj,
-      const std::vector<BlobEntry>& store,
-      size_t length);
-
- private:
-  std::vector<BlobEntry> store_;
-  size_t length_ = 0;
-};
+  Blob(Environment* env,
+       v8::Local<v8::Object> obj,
+       std::shared_ptr<DataQueue> data_queue);
 
-class FixedSizeBlobCopyJob : public AsyncWrap, public ThreadPoolWork {
- public:
-  enum class Mode {
-    SYNC,
-    ASYNC
-  };
-
-  static void RegisterExternalReferences(
-      ExternalReferenceRegistry* registry);
-  static void Initialize(Environment* env, v8::Local<v8::Object> target);
-  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
-  static void Run(const v8::FunctionCallbackInfo<v8::Value>& args);
-
-  bool IsNotIndicativeOfMemoryLeakAtExit() const override {
-    return true;
-  }
-
-  void DoThreadPoolWork() override;
-  void AfterThreadPoolWork(int status) override;
-
-  Mode mode() const { return mode_; }
-
-  void MemoryInfo(MemoryTracker* tracker) const override;
-  SET_MEMORY_INFO_NAME(FixedSizeBlobCopyJob)
-  SET_SELF_SIZE(FixedSizeBlobCopyJob)
+  const std::shared_ptr<DataQueue>& data_queue() const { return data_queue_; }
 
  private:
-  FixedSizeBlobCopyJob(
-    Environment* env,
-    v8::Local<v8::Object> object,
-    Blob* blob,
-    Mode mode = Mode::ASYNC);
-
-  Mode mode_;
-  std::vector<BlobEntry> source_;
-  std::shared_ptr<v8::BackingStore> destination_;
-  size_t length_ = 0;
+  std::shared_ptr<DataQueue> data_queue_;
 };
 
 class BlobBindingData : public SnapshotableObject {
@@ -155,14 +133,14 @@ class BlobBindingData : public SnapshotableObject {
 
   struct StoredDataObject : public MemoryRetainer {
     BaseObjectPtr<Blob> blob;
-    size_t length;
+    uint64_t length;
     std::string type;
 
     StoredDataObject() = default;
 
     StoredDataObject(
         const BaseObjectPtr<Blob>& blob_,
-        size_t length_,
+        uint64_t length_,
         const std::string& type_);
 
     void MemoryInfo(MemoryTracker* tracker) const override;
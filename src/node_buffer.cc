@@ -36,6 +36,7 @@
 
 #include <cstring>
 #include <climits>
+#include <limits>
 
 #define THROW_AND_RETURN_UNLESS_BUFFER(env, obj)                            \
   THROW_AND_RETURN_IF_NOT_BUFFER(env, obj, "argument")                      \
@@ -1131,6 +1132,48 @@ void IndexOfNumber(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// findRecordBoundaries(buffer, delimiter, offset, positions) stores the
+// positions of the delimiters found in `buffer` at or after `offset` in the
+// Uint32Array `positions`, and returns how many were found. A return value
+// equal to `positions.length` means that the search has to be continued after
+// the last of them. Delimiters do not overlap.
+void FindRecordBoundaries(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[2]->IsNumber());
+  CHECK(args[3]->IsUint32Array());
+
+  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[0]);
+  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[1]);
+  ArrayBufferViewContents<uint8_t> haystack(args[0]);
+  ArrayBufferViewContents<uint8_t> needle(args[1]);
+  CHECK_GT(needle.length(), 0);
+  CHECK_LE(haystack.length(), std::numeric_limits<uint32_t>::max());
+
+  Local<Uint32Array> positions_arr = args[3].As<Uint32Array>();
+  uint32_t* positions = reinterpret_cast<uint32_t*>(
+      static_cast<char*>(positions_arr->Buffer()->Data()) +
+      positions_arr->ByteOffset());
+  const size_t max_count = positions_arr->Length();
+
+  const size_t length = haystack.length();
+  size_t offset = static_cast<size_t>(args[2].As<Integer>()->Value());
+  size_t count = 0;
+  while (count < max_count && offset + needle.length() <= length) {
+    // For single byte delimiters this ends up in memchr().
+    const size_t pos = SearchString(haystack.data(),
+                                    length,
+                                    needle.data(),
+                                    needle.length(),
+                                    offset,
+                                    true);
+    if (pos == length) break;
+    positions[count++] = static_cast<uint32_t>(pos);
+    offset = pos + needle.length();
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(count));
+}
+
+
 void Swap16(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   THROW_AND_RETURN_UNLESS_BUFFER(env, args[0]);
@@ -1376,6 +1419,7 @@ void Initialize(Local<Object> target,
   SetMethodNoSideEffect(context, target, "indexOfBuffer", IndexOfBuffer);
   SetMethodNoSideEffect(context, target, "indexOfNumber", IndexOfNumber);
   SetMethodNoSideEffect(context, target, "indexOfString", IndexOfString);
+  SetMethod(context, target, "findRecordBoundaries", FindRecordBoundaries);
 
   SetMethod(context, target, "detachArrayBuffer", DetachArrayBuffer);
   SetMethod(context, target, "copyArrayBuffer", CopyArrayBuffer);
@@ -1437,6 +1481,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(IndexOfBuffer);
   registry->Register(IndexOfNumber);
   registry->Register(IndexOfString);
+  registry->Register(FindRecordBoundaries);
 
   registry->Register(Swap16);
   registry->Register(Swap32);
@@ -0,0 +1,544 @@
+#include "node_copy_tree.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+
+#include <sys/stat.h>  // S_IFMT and friends
+
+#include <utility>
+
+namespace node {
+namespace fs {
+
+using v8::Boolean;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Int32;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::Uint32;
+using v8::Undefined;
+using v8::Value;
+
+struct CopyTree::Entry {
+  enum State {
+    kStatSrc,
+    kStatDest,
+    kMkdir,
+    kScandir,
+    kUnlink,
+    kCopyFile,
+    kMakeWritable,
+    kStatTimes,
+    kUtime,
+    kChmod,
+  };
+
+  CopyTree* job;
+  // The directory this entry is in, nullptr for the root of the copy.
+  std::shared_ptr<Entry> parent;
+  std::string src;
+  std::string dest;
+  State state = kStatSrc;
+
+  uv_fs_t req;
+  // Keeps the entry alive while `req` is in flight.
+  std::shared_ptr<Entry> self;
+
+  uint64_t mode = 0;
+  uint64_t size = 0;
+  uint64_t dev = 0;
+  uint64_t ino = 0;
+  uv_timespec_t atime = {0, 0};
+  uv_timespec_t mtime = {0, 0};
+  bool dest_exists = false;
+  bool dest_is_directory = false;
+  bool dest_is_src = false;
+
+  // For directories: whether `dest` was created by this copy, in which case
+  // none of its children exist yet and its mode is set once they are copied.
+  bool created = false;
+  size_t pending = 0;
+  std::vector<std::string> names;
+};
+
+namespace {
+
+bool IsDirectory(uint64_t mode) {
+  return (mode & S_IFMT) == S_IFDIR;
+}
+
+double ToSeconds(const uv_timespec_t& ts) {
+  return static_cast<double>(ts.tv_sec) + ts.tv_nsec / 1e9;
+}
+
+}  // namespace
+
+CopyTree::CopyTree(Environment* env,
+                   Local<Object> wrap,
+                   std::string src,
+                   std::string dest,
+                   uint32_t flags,
+                   int copy_mode,
+                   uint32_t concurrency)
+    : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_FSCOPYTREE),
+      src_(std::move(src)),
+      dest_(std::move(dest)),
+      flags_(flags),
+      copy_mode_(copy_mode),
+      concurrency_(concurrency) {
+  // The job only keeps itself alive while it is running.
+  MakeWeak();
+}
+
+void CopyTree::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK_EQ(args.Length(), 5);
+
+  BufferValue src(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*src);
+  BufferValue dest(env->isolate(), args[1]);
+  CHECK_NOT_NULL(*dest);
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsInt32());
+  CHECK(args[4]->IsUint32());
+  const uint32_t concurrency = args[4].As<Uint32>()->Value();
+  CHECK_GT(concurrency, 0);
+
+  new CopyTree(env,
+               args.This(),
+               src.ToString(),
+               dest.ToString(),
+               args[2].As<Uint32>()->Value(),
+               args[3].As<Int32>()->Value(),
+               concurrency);
+}
+
+void CopyTree::Start(const FunctionCallbackInfo<Value>& args) {
+  CopyTree* job;
+  ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+  CHECK(!job->started_);
+  job->started_ = true;
+  job->ClearWeak();
+
+  auto root = std::make_shared<Entry>();
+  root->job = job;
+  root->src = job->src_;
+  root->dest = job->dest_;
+  job->queue_.push_back(std::move(root));
+  job->Pump();
+  job->MaybeDone();
+}
+
+void CopyTree::LinkDone(const FunctionCallbackInfo<Value>& args) {
+  CopyTree* job;
+  ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+  CHECK(args[0]->IsUint32());
+  auto it = job->links_.find(args[0].As<Uint32>()->Value());
+  CHECK_NE(it, job->links_.end());
+  std::shared_ptr<Entry> entry = std::move(it->second);
+  job->links_.erase(it);
+
+  if (args[1]->IsTrue()) {
+    job->EntryDone(entry, true);
+  } else {
+    job->Fail(kLinkFailed, nullptr, entry->src, entry->dest);
+  }
+  job->Pump();
+  job->MaybeDone();
+}
+
+void CopyTree::Pump() {
+  // Entries are taken from the back so that the walk is depth-first, which
+  // keeps the queue short and lets directories finish early.
+  while (status_ == kOk && in_flight_ < concurrency_ && !queue_.empty()) {
+    std::shared_ptr<Entry> entry = std::move(queue_.back());
+    queue_.pop_back();
+    Step(std::move(entry));
+  }
+}
+
+// Starts the request for the current state of `entry`.
+void CopyTree::Step(std::shared_ptr<Entry> entry) {
+  uv_loop_t* loop = env()->event_loop();
+  uv_fs_t* req = &entry->req;
+  const bool dereference = flags_ & kDereference;
+  const char* src = entry->src.c_str();
+  const char* dest = entry->dest.c_str();
+  const char* syscall = nullptr;
+  int err = 0;
+
+  switch (entry->state) {
+    case Entry::kStatSrc:
+    case Entry::kStatDest: {
+      const char* path = entry->state == Entry::kStatSrc ? src : dest;
+      syscall = dereference ? "stat" : "lstat";
+      err = dereference ? uv_fs_stat(loop, req, path, AfterRequest)
+                        : uv_fs_lstat(loop, req, path, AfterRequest);
+      break;
+    }
+    case Entry::kMkdir:
+      syscall = "mkdir";
+      err = uv_fs_mkdir(loop, req, dest, 0777, AfterRequest);
+      break;
+    case Entry::kScandir:
+      syscall = "scandir";
+      err = uv_fs_scandir(loop, req, src, 0, AfterRequest);
+      break;
+    case Entry::kUnlink:
+      syscall = "unlink";
+      err = uv_fs_unlink(loop, req, dest, AfterRequest);
+      break;
+    case Entry::kCopyFile:
+      syscall = "copyfile";
+      err = uv_fs_copyfile(loop, req, src, dest, copy_mode_, AfterRequest);
+      break;
+    case Entry::kMakeWritable:
+      syscall = "chmod";
+      err = uv_fs_chmod(
+          loop, req, dest, (entry->mode & 07777) | 0200, AfterRequest);
+      break;
+    case Entry::kStatTimes:
+      syscall = "stat";
+      err = uv_fs_stat(loop, req, src, AfterRequest);
+      break;
+    case Entry::kUtime:
+      syscall = "utime";
+      err = uv_fs_utime(loop,
+                        req,
+                        dest,
+                        ToSeconds(entry->atime),
+                        ToSeconds(entry->mtime),
+                        AfterRequest);
+      break;
+    case Entry::kChmod:
+      syscall = "chmod";
+      err = uv_fs_chmod(loop, req, dest, entry->mode & 07777, AfterRequest);
+      break;
+  }
+
+  if (err < 0) {
+    uv_fs_req_cleanup(req);
+    return Fail(err, syscall, entry->src, entry->dest);
+  }
+  Entry* raw = entry.get();
+  req->data = raw;
+  raw->self = std::move(entry);
+  in_flight_++;
+  env()->IncreaseWaitingRequestCounter();
+}
+
+void CopyTree::AfterRequest(uv_fs_t* req) {
+  std::shared_ptr<Entry> entry =
+      std::move(static_cast<Entry*>(req->data)->self);
+  CopyTree* job = entry->job;
+  Environment* env = job->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  env->DecreaseWaitingRequestCounter();
+  job->in_flight_--;
+
+  const int result = static_cast<int>(req->result);
+  if (result >= 0) {
+    switch (entry->state) {
+      case Entry::kStatSrc:
+        entry->mode = req->statbuf.st_mode;
+        entry->size = req->statbuf.st_size;
+        entry->dev = req->statbuf.st_dev;
+        entry->ino = req->statbuf.st_ino;
+        break;
+      case Entry::kStatDest:
+        entry->dest_exists = true;
+        entry->dest_is_directory = IsDirectory(req->statbuf.st_mode);
+        entry->dest_is_src = req->statbuf.st_ino != 0 &&
+                             req->statbuf.st_dev != 0 &&
+                             req->statbuf.st_ino == entry->ino &&
+                             req->statbuf.st_dev == entry->dev;
+        break;
+      case Entry::kStatTimes:
+        entry->atime = req->statbuf.st_atim;
+        entry->mtime = req->statbuf.st_mtim;
+        break;
+      case Entry::kScandir: {
+        uv_dirent_t ent;
+        while (uv_fs_scandir_next(req, &ent) != UV_EOF)
+          entry->names.emplace_back(ent.name);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  uv_fs_req_cleanup(req);
+
+  job->OnResult(std::move(entry), result);
+  job->Pump();
+  job->MaybeDone();
+}
+
+void CopyTree::OnResult(std::shared_ptr<Entry> entry, int result) {
+  if (status_ != kOk) return;
+
+  if (result < 0) {
+    if (entry->state == Entry::kStatDest && result == UV_ENOENT)
+      return Dispatch(std::move(entry));
+    const bool dereference = flags_ & kDereference;
+    switch (entry->state) {
+      case Entry::kStatSrc:
+        return Fail(result, dereference ? "stat" : "lstat", entry->src, "");
+      case Entry::kStatDest:
+        return Fail(result, dereference ? "stat" : "lstat", entry->dest, "");
+      case Entry::kMkdir:
+        return Fail(result, "mkdir", entry->dest, "");
+      case Entry::kScandir:
+        return Fail(result, "scandir", entry->src, "");
+      case Entry::kUnlink:
+        return Fail(result, "unlink", entry->dest, "");
+      case Entry::kCopyFile:
+        return Fail(result, "copyfile", entry->src, entry->dest);
+      case Entry::kStatTimes:
+        return Fail(result, "stat", entry->src, "");
+      case Entry::kUtime:
+        return Fail(result, "utime", entry->dest, "");
+      case Entry::kMakeWritable:
+      case Entry::kChmod:
+        return Fail(result, "chmod", entry->dest, "");
+    }
+    UNREACHABLE();
+  }
+
+  switch (entry->state) {
+    case Entry::kStatSrc:
+      // Nothing exists yet in a directory created by this copy.
+      if (entry->parent && entry->parent->created)
+        return Dispatch(std::move(entry));
+      entry->state = Entry::kStatDest;
+      return Step(std::move(entry));
+    case Entry::kStatDest:
+      if (entry->dest_is_src)
+        return Fail(kSame, nullptr, entry->src, entry->dest);
+      if (IsDirectory(entry->mode) && !entry->dest_is_directory)
+        return Fail(kDirToNonDir, nullptr, entry->src, entry->dest);
+      if (!IsDirectory(entry->mode) && entry->dest_is_directory)
+        return Fail(kNonDirToDir, nullptr, entry->src, entry->dest);
+      return Dispatch(std::move(entry));
+    case Entry::kMkdir:
+      entry->created = true;
+      entry->state = Entry::kScandir;
+      return Step(std::move(entry));
+    case Entry::kScandir: {
+      std::vector<std::string> names = std::move(entry->names);
+      if (names.empty()) return DirectoryDone(std::move(entry));
+      entry->pending = names.size();
+      for (std::string& name : names) {
+        auto child = std::make_shared<Entry>();
+        child->job = this;
+        child->parent = entry;
+        child->src = entry->src + kPathSeparator + name;
+        child->dest = entry->dest + kPathSeparator + name;
+        queue_.push_back(std::move(child));
+      }
+      return;
+    }
+    case Entry::kUnlink:
+      entry->state = Entry::kCopyFile;
+      return Step(std::move(entry));
+    case Entry::kCopyFile:
+      bytes_ += entry->size;
+      if (flags_ & kPreserveTimestamps) {
+        // Make sure the file is writable before setting the timestamps.
+        entry->state =
+            entry->mode & 0200 ? Entry::kStatTimes : Entry::kMakeWritable;
+        return Step(std::move(entry));
+      }
+#ifdef _WIN32
+      entry->state = Entry::kChmod;
+      return Step(std::move(entry));
+#else
+      // uv_fs_copyfile() already gave the copy the mode of the source.
+      return EntryDone(entry, true);
+#endif
+    case Entry::kMakeWritable:
+      // The atime of the first stat() cannot be trusted, reading the file
+      // has changed it.
+      entry->state = Entry::kStatTimes;
+      return Step(std::move(entry));
+    case Entry::kStatTimes:
+      entry->state = Entry::kUtime;
+      return Step(std::move(entry));
+    case Entry::kUtime:
+      entry->state = Entry::kChmod;
+      return Step(std::move(entry));
+    case Entry::kChmod:
+      return EntryDone(entry, true);
+  }
+  UNREACHABLE();
+}
+
+// Copies `entry` according to its type, once both paths have been stat'ed.
+void CopyTree::Dispatch(std::shared_ptr<Entry> entry) {
+  switch (entry->mode & S_IFMT) {
+    case S_IFDIR:
+      entry->state = entry->dest_exists ? Entry::kScandir : Entry::kMkdir;
+      return Step(std::move(entry));
+    case S_IFREG:
+    case S_IFCHR:
+#ifdef S_IFBLK
+    case S_IFBLK:
+#endif
+      if (!entry->dest_exists) {
+        entry->state = Entry::kCopyFile;
+        return Step(std::move(entry));
+      }
+      if (flags_ & kForce) {
+        entry->state = Entry::kUnlink;
+        return Step(std::move(entry));
+      }
+      if (flags_ & kErrorOnExist)
+        return Fail(kExists, nullptr, entry->src, entry->dest);
+      return EntryDone(entry, false);
+    case S_IFLNK: {
+      const uint32_t id = next_link_id_++;
+      Isolate* isolate = env()->isolate();
+      Local<Value> argv[] = {
+          Integer::NewFromUnsigned(isolate, id),
+          String::NewFromUtf8(isolate, entry->src.data(),
+                              v8::NewStringType::kNormal,
+                              entry->src.size()).ToLocalChecked(),
+          String::NewFromUtf8(isolate, entry->dest.data(),
+                              v8::NewStringType::kNormal,
+                              entry->dest.size()).ToLocalChecked(),
+          Boolean::New(isolate, entry->dest_exists),
+      };
+      links_.emplace(id, std::move(entry));
+      MakeCallback(env()->onlink_string(), arraysize(argv), argv);
+      return;
+    }
+#ifdef S_IFSOCK
+    case S_IFSOCK:
+      return Fail(kSocket, nullptr, entry->src, entry->dest);
+#endif
+#ifdef S_IFIFO
+    case S_IFIFO:
+      return Fail(kFifoPipe, nullptr, entry->src, entry->dest);
+#endif
+    default:
+      return Fail(kUnknownType, nullptr, entry->src, entry->dest);
+  }
+}
+
+void CopyTree::DirectoryDone(std::shared_ptr<Entry> entry) {
+  if (!entry->created) return EntryDone(entry, true);
+  // Set the mode only now, it might not allow writing to the directory.
+  entry->state = Entry::kChmod;
+  queue_.push_back(std::move(entry));
+}
+
+void CopyTree::EntryDone(const std::shared_ptr<Entry>& entry, bool copied) {
+  if (copied) {
+    entries_++;
+    ScheduleProgress();
+  }
+  const std::shared_ptr<Entry>& parent = entry->parent;
+  if (parent && --parent->pending == 0) DirectoryDone(parent);
+}
+
+// Records the first error and stops starting new requests. The job finishes
+// once the requests that are still in flight have completed.
+void CopyTree::Fail(int status,
+                    const char* syscall,
+                    const std::string& path,
+                    const std::string& dest) {
+  if (status_ != kOk) return;
+  status_ = status;
+  syscall_ = syscall;
+  error_path_ = path;
+  error_dest_ = dest;
+  queue_.clear();
+}
+
+void CopyTree::MaybeDone() {
+  if (done_ || !started_ || in_flight_ > 0 || !links_.empty()) return;
+  if (status_ == kOk && !queue_.empty()) return;
+  done_ = true;
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+  if (status_ == kOk) EmitProgress();
+
+  Local<Value> syscall = Undefined(isolate);
+  if (syscall_ != nullptr) syscall = OneByteString(isolate, syscall_);
+  Local<Value> argv[] = {
+      Integer::New(isolate, status_),
+      syscall,
+      String::NewFromUtf8(isolate, error_path_.data(),
+                          v8::NewStringType::kNormal,
+                          error_path_.size()).ToLocalChecked(),
+      String::NewFromUtf8(isolate, error_dest_.data(),
+                          v8::NewStringType::kNormal,
+                          error_dest_.size()).ToLocalChecked(),
+  };
+  MakeCallback(env()->ondone_string(), arraysize(argv), argv);
+  MakeWeak();
+}
+
+void CopyTree::ScheduleProgress() {
+  if (!(flags_ & kReportProgress) || progress_scheduled_) return;
+  progress_scheduled_ = true;
+  env()->SetImmediate([self = BaseObjectPtr<CopyTree>(this)](Environment* env) {
+    self->progress_scheduled_ = false;
+    if (self->done_) return;
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    self->EmitProgress();
+  });
+}
+
+void CopyTree::EmitProgress() {
+  if (!(flags_ & kReportProgress)) return;
+  if (entries_ == reported_entries_ && bytes_ == reported_bytes_) return;
+  reported_entries_ = entries_;
+  reported_bytes_ = bytes_;
+  Isolate* isolate = env()->isolate();
+  Local<Value> argv[] = {
+      Number::New(isolate, static_cast<double>(entries_)),
+      Number::New(isolate, static_cast<double>(bytes_)),
+  };
+  MakeCallback(env()->onprogress_string(), arraysize(argv), argv);
+}
+
+void CopyTree::Initialize(Environment* env, Local<Object> target) {
+  Isolate* isolate = env->isolate();
+  HandleScope scope(isolate);
+
+  Local<FunctionTemplate> t = NewFunctionTemplate(isolate, CopyTree::New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      CopyTree::kInternalFieldCount);
+  t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+
+  SetProtoMethod(isolate, t, "start", CopyTree::Start);
+  SetProtoMethod(isolate, t, "linkDone", CopyTree::LinkDone);
+
+  SetConstructorFunction(env->context(), target, "CopyTree", t);
+}
+
+void CopyTree::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(CopyTree::New);
+  registry->Register(CopyTree::Start);
+  registry->Register(CopyTree::LinkDone);
+}
+
+}  // namespace fs
+}  // namespace node
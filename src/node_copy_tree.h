@@ -0,0 +1,131 @@
+#ifndef SRC_NODE_COPY_TREE_H_
+#define SRC_NODE_COPY_TREE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+
+class Environment;
+class ExternalReferenceRegistry;
+
+namespace fs {
+
+// Copies a directory tree for the asynchronous fs.cp(). The tree is walked
+// from the event loop thread, and up to `concurrency` filesystem requests
+// (stat, mkdir, scandir, copyfile, ...) run on the threadpool at a time.
+// Directories are created and their children copied before the mode of a new
+// directory is set, the same order the JS implementation uses.
+//
+// Symbolic links are handed to JS through `onlink(id, src, dest, destExists)`
+// because resolving them needs the path module. JS calls `linkDone(id, ok)`
+// once the link is copied. Progress is reported through
+// `onprogress(entries, bytes)` at most once per event loop iteration, and
+// `ondone(status, syscall, path, dest)` is called once all requests have
+// finished. A negative status is a libuv error code, a positive one is one of
+// CopyTree::Error; for those `path` and `dest` are the entry that failed.
+class CopyTree final : public AsyncWrap {
+ public:
+  enum Flags : uint32_t {
+    kDereference = 1 << 0,
+    kErrorOnExist = 1 << 1,
+    kForce = 1 << 2,
+    kPreserveTimestamps = 1 << 3,
+    kReportProgress = 1 << 4,
+  };
+
+  enum Error : int {
+    kOk = 0,
+    kSame,
+    kDirToNonDir,
+    kNonDirToDir,
+    kExists,
+    kSocket,
+    kFifoPipe,
+    kUnknownType,
+    // Copying a symbolic link failed, JS has the error.
+    kLinkFailed,
+  };
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(CopyTree)
+  SET_SELF_SIZE(CopyTree)
+
+ private:
+  struct Entry;
+
+  CopyTree(Environment* env,
+           v8::Local<v8::Object> wrap,
+           std::string src,
+           std::string dest,
+           uint32_t flags,
+           int copy_mode,
+           uint32_t concurrency);
+
+  // new CopyTree(src, dest, flags, copyMode, concurrency)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // job.start()
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // job.linkDone(id, ok)
+  static void LinkDone(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static void AfterRequest(uv_fs_t* req);
+
+  void Pump();
+  void Step(std::shared_ptr<Entry> entry);
+  void OnResult(std::shared_ptr<Entry> entry, int result);
+  void Dispatch(std::shared_ptr<Entry> entry);
+  void DirectoryDone(std::shared_ptr<Entry> entry);
+  void EntryDone(const std::shared_ptr<Entry>& entry, bool copied);
+  void Fail(int status,
+            const char* syscall,
+            const std::string& path,
+            const std::string& dest);
+  void MaybeDone();
+  void ScheduleProgress();
+  void EmitProgress();
+
+  const std::string src_;
+  const std::string dest_;
+  const uint32_t flags_;
+  const int copy_mode_;
+  const uint32_t concurrency_;
+
+  // Entries that are ready for their next request.
+  std::vector<std::shared_ptr<Entry>> queue_;
+  // Symbolic links that are being copied by JS.
+  std::unordered_map<uint32_t, std::shared_ptr<Entry>> links_;
+  uint32_t next_link_id_ = 0;
+  uint32_t in_flight_ = 0;
+
+  bool started_ = false;
+  bool done_ = false;
+  int status_ = kOk;
+  const char* syscall_ = nullptr;
+  std::string error_path_;
+  std::string error_dest_;
+
+  uint64_t entries_ = 0;
+  uint64_t bytes_ = 0;
+  uint64_t reported_entries_ = 0;
+  uint64_t reported_bytes_ = 0;
+  bool progress_scheduled_ = false;
+};
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_COPY_TREE_H_
@@ -0,0 +1,309 @@
+#include "node_cpu_profiler.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "node_internals.h"
+#include "node_pprof.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace node {
+namespace v8_utils {
+
+using v8::CpuProfile;
+using v8::CpuProfileNode;
+using v8::CpuProfiler;
+using v8::CpuProfilingOptions;
+using v8::CpuProfilingResult;
+using v8::CpuProfilingStatus;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::ProfilerId;
+using v8::Uint32;
+using v8::Value;
+
+// The call tree of one finished V8 profile. Strings are interned, and
+// nodes[0] is the "(root)" node, which is its own parent.
+struct ContinuousCpuProfiler::Window {
+  struct Node {
+    uint32_t parent;
+    uint32_t name;
+    uint32_t url;
+    int line;
+    int column;
+    uint32_t hits;
+  };
+
+  std::vector<std::string> strings;
+  std::vector<Node> nodes;
+  int64_t start_ns;
+  int64_t end_ns;
+};
+
+namespace {
+
+std::shared_ptr<ContinuousCpuProfiler::Window> Flatten(
+    const CpuProfile* profile, int64_t start_ns, int64_t end_ns) {
+  using Window = ContinuousCpuProfiler::Window;
+  auto window = std::make_shared<Window>();
+  window->start_ns = start_ns;
+  window->end_ns = end_ns;
+
+  std::unordered_map<std::string, uint32_t> interned;
+  auto intern = [&](const char* str) {
+    auto it = interned.emplace(str, window->strings.size());
+    if (it.second) window->strings.emplace_back(str);
+    return it.first->second;
+  };
+
+  std::vector<std::pair<const CpuProfileNode*, uint32_t>> stack;
+  stack.emplace_back(profile->GetTopDownRoot(), 0);
+  while (!stack.empty()) {
+    const CpuProfileNode* node = stack.back().first;
+    uint32_t parent = stack.back().second;
+    stack.pop_back();
+
+    uint32_t index = static_cast<uint32_t>(window->nodes.size());
+    window->nodes.push_back({parent,
+                             intern(node->GetFunctionNameStr()),
+                             intern(node->GetScriptResourceNameStr()),
+                             node->GetLineNumber(),
+                             node->GetColumnNumber(),
+                             node->GetHitCount()});
+    for (int i = 0; i < node->GetChildrenCount(); i++)
+      stack.emplace_back(node->GetChild(i), index);
+  }
+  return window;
+}
+
+// Merges windows into one pprof profile. Every node with hits becomes a
+// sample whose stack is the path to the root, samples with the same stack
+// are merged. Samples taken while the thread was idle are left out.
+class PprofWriter {
+ public:
+  explicit PprofWriter(int64_t period_ns)
+      : builder_({{"samples", "count"}, {"cpu", "nanoseconds"}},
+                 {"cpu", "nanoseconds"},
+                 period_ns),
+        period_ns_(period_ns) {}
+
+  void Add(const ContinuousCpuProfiler::Window& window) {
+    if (start_ns_ == 0 || window.start_ns < start_ns_)
+      start_ns_ = window.start_ns;
+    end_ns_ = std::max(end_ns_, window.end_ns);
+
+    // Only the strings and functions of sampled stacks end up in the profile.
+    std::vector<int64_t> strings(window.strings.size(), -1);
+    auto string = [&](uint32_t index) {
+      if (strings[index] < 0)
+        strings[index] = builder_.Intern(window.strings[index]);
+      return strings[index];
+    };
+    std::vector<uint64_t> functions(window.nodes.size(), 0);
+    auto function = [&](size_t index) {
+      if (functions[index] == 0) {
+        const auto& node = window.nodes[index];
+        int64_t name = window.strings[node.name].empty()
+                           ? builder_.Intern("(anonymous)")
+                           : string(node.name);
+        functions[index] = builder_.Location(
+            name, string(node.url), node.line, node.column);
+      }
+      return functions[index];
+    };
+
+    std::vector<uint64_t> stack;
+    for (size_t i = 1; i < window.nodes.size(); i++) {
+      const auto& node = window.nodes[i];
+      if (node.hits == 0 || window.strings[node.name] == "(idle)") continue;
+      stack.clear();
+      for (size_t n = i; n != 0; n = window.nodes[n].parent)
+        stack.push_back(function(n));
+      const int64_t values[] = {node.hits, node.hits * period_ns_};
+      builder_.AddSample(stack, values);
+    }
+  }
+
+  std::string Finish() {
+    builder_.SetTime(start_ns_, end_ns_ - start_ns_);
+    return builder_.Finish();
+  }
+
+ private:
+  pprof::ProfileBuilder builder_;
+  const int64_t period_ns_;
+  int64_t start_ns_ = 0;
+  int64_t end_ns_ = 0;
+};
+
+}  // namespace
+
+class ContinuousCpuProfiler::EncodeJob final : public pprof::EncodeJob {
+ public:
+  EncodeJob(ContinuousCpuProfiler* profiler,
+            std::vector<std::shared_ptr<const Window>> windows,
+            bool compress,
+            std::string filename,
+            Local<Function> callback)
+      : pprof::EncodeJob(
+            profiler, "cpuprofile", compress, std::move(filename), callback),
+        period_ns_(profiler->sampling_interval_us_ * 1000LL),
+        windows_(std::move(windows)) {}
+
+ private:
+  std::string Encode() override {
+    PprofWriter writer(period_ns_);
+    for (const auto& window : windows_) writer.Add(*window);
+    windows_.clear();
+    return writer.Finish();
+  }
+
+  const int64_t period_ns_;
+  std::vector<std::shared_ptr<const Window>> windows_;
+};
+
+ContinuousCpuProfiler::ContinuousCpuProfiler(Environment* env,
+                                             Local<Object> wrap,
+                                             int sampling_interval_us,
+                                             uint32_t window_count)
+    : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_CPUPROFILER),
+      sampling_interval_us_(sampling_interval_us),
+      window_count_(window_count) {
+  MakeWeak();
+}
+
+ContinuousCpuProfiler::~ContinuousCpuProfiler() {
+  if (profiler_ == nullptr) return;
+  if (running_) {
+    CpuProfile* profile = profiler_->Stop(current_);
+    if (profile != nullptr) profile->Delete();
+  }
+  profiler_->Dispose();
+}
+
+bool ContinuousCpuProfiler::StartWindow() {
+  CpuProfilingResult result = profiler_->Start(CpuProfilingOptions(
+      v8::kLeafNodeLineNumbers, 0 /* max_samples */, sampling_interval_us_));
+  if (result.status != CpuProfilingStatus::kStarted) return false;
+  current_ = result.id;
+  window_start_ns_ = pprof::WallTimeNs();
+  return true;
+}
+
+// Ends the current window. When the profiler keeps running the next window is
+// started before the current one is stopped, so that no samples are lost.
+void ContinuousCpuProfiler::EndWindow() {
+  ProfilerId id = current_;
+  int64_t start_ns = window_start_ns_;
+  int64_t end_ns = pprof::WallTimeNs();
+  if (running_) running_ = StartWindow();
+
+  CpuProfile* profile = profiler_->Stop(id);
+  if (profile == nullptr) return;
+  windows_.push_back(Flatten(profile, start_ns, end_ns));
+  profile->Delete();
+  while (windows_.size() > window_count_) windows_.pop_front();
+}
+
+void ContinuousCpuProfiler::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsUint32());
+  new ContinuousCpuProfiler(env,
+                            args.This(),
+                            args[0].As<Uint32>()->Value(),
+                            args[1].As<Uint32>()->Value());
+}
+
+void ContinuousCpuProfiler::Start(const FunctionCallbackInfo<Value>& args) {
+  ContinuousCpuProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  if (self->running_) return args.GetReturnValue().Set(true);
+
+  if (self->profiler_ == nullptr) {
+    self->profiler_ = CpuProfiler::New(self->env()->isolate());
+    self->profiler_->SetSamplingInterval(self->sampling_interval_us_);
+  }
+  self->running_ = self->StartWindow();
+  args.GetReturnValue().Set(self->running_);
+}
+
+void ContinuousCpuProfiler::Rotate(const FunctionCallbackInfo<Value>& args) {
+  ContinuousCpuProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  if (self->running_) self->EndWindow();
+}
+
+void ContinuousCpuProfiler::Stop(const FunctionCallbackInfo<Value>& args) {
+  ContinuousCpuProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  if (!self->running_) return;
+  self->running_ = false;
+  self->EndWindow();
+}
+
+void ContinuousCpuProfiler::TakeProfile(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ContinuousCpuProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  CHECK(args[0]->IsBoolean());
+  CHECK(args[2]->IsFunction());
+  bool compress = args[0]->IsTrue();
+  std::string filename =
+      pprof::OutputFilename(env, args[1], "CPU", compress);
+
+  // Include everything up to now.
+  if (self->running_) self->EndWindow();
+
+  std::vector<std::shared_ptr<const Window>> windows(self->windows_.begin(),
+                                                      self->windows_.end());
+  auto job = new EncodeJob(self,
+                           std::move(windows),
+                           compress,
+                           std::move(filename),
+                           args[2].As<Function>());
+  job->ScheduleWork();
+}
+
+void ContinuousCpuProfiler::Initialize(Environment* env,
+                                       Local<Object> target) {
+  Isolate* isolate = env->isolate();
+
+  Local<FunctionTemplate> t =
+      NewFunctionTemplate(isolate, ContinuousCpuProfiler::New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      ContinuousCpuProfiler::kInternalFieldCount);
+  t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+
+  SetProtoMethod(isolate, t, "start", ContinuousCpuProfiler::Start);
+  SetProtoMethod(isolate, t, "rotate", ContinuousCpuProfiler::Rotate);
+  SetProtoMethod(isolate, t, "stop", ContinuousCpuProfiler::Stop);
+  SetProtoMethod(
+      isolate, t, "takeProfile", ContinuousCpuProfiler::TakeProfile);
+
+  SetConstructorFunction(
+      env->context(), target, "ContinuousCpuProfiler", t);
+}
+
+void ContinuousCpuProfiler::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(ContinuousCpuProfiler::New);
+  registry->Register(ContinuousCpuProfiler::Start);
+  registry->Register(ContinuousCpuProfiler::Rotate);
+  registry->Register(ContinuousCpuProfiler::Stop);
+  registry->Register(ContinuousCpuProfiler::TakeProfile);
+}
+
+}  // namespace v8_utils
+}  // namespace node
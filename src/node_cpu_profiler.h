@@ -0,0 +1,82 @@
+#ifndef SRC_NODE_CPU_PROFILER_H_
+#define SRC_NODE_CPU_PROFILER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "v8-profiler.h"
+#include "v8.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace node {
+
+class Environment;
+class ExternalReferenceRegistry;
+
+namespace v8_utils {
+
+// An always-on CPU profiler built on v8::CpuProfiler. Profiling is split into
+// windows: rotate() ends the current V8 profile and starts the next one, and
+// the call tree of the finished profile is copied into a compact Window. Only
+// the last `windowCount` windows are kept, so memory use stays bounded no
+// matter how long the profiler runs. V8 is asked to keep the aggregated tree
+// only, not every sample.
+//
+// takeProfile() merges the kept windows into a pprof profile. The encoding and
+// compression happen on the threadpool, as does writing the profile to a file
+// for writeProfile().
+class ContinuousCpuProfiler final : public AsyncWrap {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  struct Window;
+
+  ~ContinuousCpuProfiler() override;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(ContinuousCpuProfiler)
+  SET_SELF_SIZE(ContinuousCpuProfiler)
+
+ private:
+  class EncodeJob;
+
+  ContinuousCpuProfiler(Environment* env,
+                        v8::Local<v8::Object> wrap,
+                        int sampling_interval_us,
+                        uint32_t window_count);
+
+  // new ContinuousCpuProfiler(samplingIntervalUs, windowCount)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.start()
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.rotate()
+  static void Rotate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.stop()
+  static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.takeProfile(compress, filename | true | undefined, callback)
+  static void TakeProfile(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  bool StartWindow();
+  void EndWindow();
+
+  const int sampling_interval_us_;
+  const uint32_t window_count_;
+
+  v8::CpuProfiler* profiler_ = nullptr;
+  v8::ProfilerId current_ = 0;
+  bool running_ = false;
+  int64_t window_start_ns_ = 0;
+  std::deque<std::shared_ptr<const Window>> windows_;
+};
+
+}  // namespace v8_utils
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_CPU_PROFILER_H_
@@ -23,7 +23,9 @@
 #include "aliased_buffer-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_copy_tree.h"
 #include "node_external_reference.h"
+#include "node_file_tree.h"
 #include "node_process-inl.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
@@ -2740,6 +2742,8 @@ void Initialize(Local<Object> target,
       .Check();
 
   StatWatcher::Initialize(env, target);
+  CopyTree::Initialize(env, target);
+  FileTree::Initialize(env, target);
 
   // Create FunctionTemplate for FSReqCallback
   Local<FunctionTemplate> fst = NewFunctionTemplate(isolate, NewFSReqCallback);
@@ -2802,6 +2806,8 @@ BindingData* FSReqBase::binding_data() {
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Access);
   StatWatcher::RegisterExternalReferences(registry);
+  CopyTree::RegisterExternalReferences(registry);
+  FileTree::RegisterExternalReferences(registry);
 
   registry->Register(Close);
   registry->Register(Open);
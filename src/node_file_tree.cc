@@ -0,0 +1,614 @@
+#include "node_file_tree.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "node_file-inl.h"
+#include "node_internals.h"
+#include "string_bytes.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace node {
+namespace fs {
+
+#ifndef _WIN32
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::MaybeLocal;
+using v8::Object;
+using v8::String;
+using v8::Undefined;
+using v8::Value;
+
+namespace {
+
+constexpr int kOpenDirFlags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+// The number of directory descriptors RemoveTree() keeps open at once.
+constexpr size_t kMaxOpenDirs = 64;
+
+struct DirEntry {
+  std::string name;
+  uv_dirent_type_t type;
+};
+
+// The first failure of a walk. `err` is a libuv error code.
+struct TreeError {
+  int err = 0;
+  const char* syscall = nullptr;
+  std::string path;
+
+  bool Set(const char* failed_syscall, const std::string& failed_path) {
+    err = uv_translate_sys_error(errno);
+    syscall = failed_syscall;
+    path = failed_path;
+    return false;
+  }
+};
+
+struct DirList {
+  std::vector<std::string> names;
+  std::vector<uv_dirent_type_t> types;
+  std::vector<uint32_t> parents;
+  // Paths of the listed directories relative to the root, "" for the root.
+  std::vector<std::string> dirs;
+};
+
+uv_dirent_type_t TypeFromMode(mode_t mode) {
+  switch (mode & S_IFMT) {
+    case S_IFREG: return UV_DIRENT_FILE;
+    case S_IFDIR: return UV_DIRENT_DIR;
+    case S_IFLNK: return UV_DIRENT_LINK;
+    case S_IFIFO: return UV_DIRENT_FIFO;
+    case S_IFSOCK: return UV_DIRENT_SOCKET;
+    case S_IFCHR: return UV_DIRENT_CHAR;
+    case S_IFBLK: return UV_DIRENT_BLOCK;
+    default: return UV_DIRENT_UNKNOWN;
+  }
+}
+
+// Same mapping as libuv's uv__fs_get_dirent_type().
+uv_dirent_type_t TypeFromDirent(unsigned char d_type) {
+#ifdef DT_UNKNOWN
+  switch (d_type) {
+    case DT_REG: return UV_DIRENT_FILE;
+    case DT_DIR: return UV_DIRENT_DIR;
+    case DT_LNK: return UV_DIRENT_LINK;
+    case DT_FIFO: return UV_DIRENT_FIFO;
+    case DT_SOCK: return UV_DIRENT_SOCKET;
+    case DT_CHR: return UV_DIRENT_CHAR;
+    case DT_BLK: return UV_DIRENT_BLOCK;
+    default: return UV_DIRENT_UNKNOWN;
+  }
+#else
+  return UV_DIRENT_UNKNOWN;
+#endif
+}
+
+bool IsDots(const char* name) {
+  return name[0] == '.' &&
+         (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+// Reads all entries of the directory `fd` except "." and "..". Returns false
+// with errno set on failure.
+bool ReadEntries(int fd, std::vector<DirEntry>* entries) {
+#ifdef __linux__
+  // readdir(3) fills a 32 KiB buffer in glibc and a 4 KiB one in bionic and
+  // musl. A larger buffer reads wide directories with far fewer syscalls.
+  struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    uint16_t d_reclen;
+    uint8_t d_type;
+    char d_name[1];
+  };
+  static constexpr size_t kBufferSize = 64 * 1024;
+  std::unique_ptr<char[]> buffer(new char[kBufferSize]);
+
+  for (;;) {
+    long nread;  // NOLINT(runtime/int)
+    do {
+      nread = syscall(SYS_getdents64, fd, buffer.get(), kBufferSize);
+    } while (nread == -1 && errno == EINTR);
+    if (nread == -1) return false;
+    if (nread == 0) return true;
+
+    for (long pos = 0; pos < nread;) {  // NOLINT(runtime/int)
+      const LinuxDirent64* dent =
+          reinterpret_cast<const LinuxDirent64*>(buffer.get() + pos);
+      pos += dent->d_reclen;
+      if (IsDots(dent->d_name)) continue;
+      entries->push_back({dent->d_name, TypeFromDirent(dent->d_type)});
+    }
+  }
+#else
+  // fdopendir() takes ownership of the descriptor, the caller keeps `fd`.
+  int dir_fd = dup(fd);
+  if (dir_fd == -1) return false;
+  DIR* dir = fdopendir(dir_fd);
+  if (dir == nullptr) {
+    int saved_errno = errno;
+    close(dir_fd);
+    errno = saved_errno;
+    return false;
+  }
+
+  for (;;) {
+    errno = 0;
+    const struct dirent* dent = readdir(dir);
+    if (dent == nullptr) break;
+    if (IsDots(dent->d_name)) continue;
+#ifdef DT_UNKNOWN
+    entries->push_back({dent->d_name, TypeFromDirent(dent->d_type)});
+#else
+    entries->push_back({dent->d_name, UV_DIRENT_UNKNOWN});
+#endif
+  }
+
+  int saved_errno = errno;
+  closedir(dir);
+  errno = saved_errno;
+  return saved_errno == 0;
+#endif
+}
+
+std::string JoinPath(const std::string& dir, const std::string& name) {
+  if (dir.empty()) return name;
+  std::string path;
+  path.reserve(dir.size() + 1 + name.size());
+  path += dir;
+  path += '/';
+  path += name;
+  return path;
+}
+
+// Removes `path` and everything below it. Directories are walked depth-first
+// with one open descriptor for each of the kMaxOpenDirs deepest levels. The
+// descriptors of the levels above are closed, and reopened through ".." on
+// the way back up. Entries that disappear while the tree is being removed are
+// skipped.
+bool RemoveTree(const std::string& path, TreeError* error) {
+  struct Frame {
+    int fd;
+    std::string path;
+    std::string name;
+    std::vector<DirEntry> entries;
+    size_t next;
+    // Identifies the directory while `fd` is closed.
+    dev_t dev;
+    ino_t ino;
+  };
+  std::vector<Frame> stack;
+  auto close_all = [&]() {
+    for (const Frame& frame : stack) {
+      if (frame.fd != -1) close(frame.fd);
+    }
+  };
+
+  // Some systems let root unlink() directories, check the type first.
+  struct stat st;
+  if (lstat(path.c_str(), &st) == -1) {
+    return errno == ENOENT || error->Set("lstat", path);
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    return unlink(path.c_str()) == 0 || errno == ENOENT ||
+           error->Set("unlink", path);
+  }
+
+  int fd = open(path.c_str(), kOpenDirFlags | O_NOFOLLOW);
+  if (fd == -1) return errno == ENOENT || error->Set("scandir", path);
+  stack.push_back({fd, path, std::string(), {}, 0, 0, 0});
+  if (!ReadEntries(fd, &stack.back().entries)) {
+    error->Set("scandir", path);
+    close_all();
+    return false;
+  }
+
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+
+    if (frame.next == frame.entries.size()) {
+      if (stack.size() > 1 && stack[stack.size() - 2].fd == -1) {
+        Frame& parent = stack[stack.size() - 2];
+        int parent_fd = openat(frame.fd, "..", kOpenDirFlags);
+        if (parent_fd != -1 &&
+            (fstat(parent_fd, &st) == -1 || st.st_dev != parent.dev ||
+             st.st_ino != parent.ino)) {
+          // The tree was moved while it was being removed.
+          close(parent_fd);
+          parent_fd = -1;
+          errno = ENOENT;
+        }
+        if (parent_fd == -1) {
+          error->Set("scandir", parent.path);
+          close_all();
+          return false;
+        }
+        parent.fd = parent_fd;
+      }
+      close(frame.fd);
+      std::string dir_path = std::move(frame.path);
+      std::string dir_name = std::move(frame.name);
+      stack.pop_back();
+      int rc = stack.empty()
+                   ? rmdir(dir_path.c_str())
+                   : unlinkat(stack.back().fd, dir_name.c_str(), AT_REMOVEDIR);
+      if (rc == -1 && errno != ENOENT) {
+        error->Set("rmdir", dir_path);
+        close_all();
+        return false;
+      }
+      continue;
+    }
+
+    const DirEntry& entry = frame.entries[frame.next++];
+    const char* name = entry.name.c_str();
+    uv_dirent_type_t type = entry.type;
+    if (type == UV_DIRENT_UNKNOWN) {
+      if (fstatat(frame.fd, name, &st, AT_SYMLINK_NOFOLLOW) == -1) {
+        if (errno == ENOENT) continue;
+        error->Set("lstat", JoinPath(frame.path, entry.name));
+        close_all();
+        return false;
+      }
+      type = TypeFromMode(st.st_mode);
+    }
+
+    if (type != UV_DIRENT_DIR) {
+      if (unlinkat(frame.fd, name, 0) == -1 && errno != ENOENT) {
+        error->Set("unlink", JoinPath(frame.path, entry.name));
+        close_all();
+        return false;
+      }
+      continue;
+    }
+
+    std::string child_path = JoinPath(frame.path, entry.name);
+    int child_fd = openat(frame.fd, name, kOpenDirFlags | O_NOFOLLOW);
+    if (child_fd == -1) {
+      if (errno == ENOENT) continue;
+      error->Set("scandir", child_path);
+      close_all();
+      return false;
+    }
+    // `frame` and `entry` are invalid once the new frame has been pushed.
+    std::string child_name = entry.name;
+    stack.push_back(
+        {child_fd, std::move(child_path), std::move(child_name), {}, 0, 0, 0});
+    if (!ReadEntries(child_fd, &stack.back().entries)) {
+      error->Set("scandir", stack.back().path);
+      close_all();
+      return false;
+    }
+
+    if (stack.size() > kMaxOpenDirs) {
+      Frame& ancestor = stack[stack.size() - kMaxOpenDirs - 1];
+      if (fstat(ancestor.fd, &st) == -1) {
+        error->Set("scandir", ancestor.path);
+        close_all();
+        return false;
+      }
+      ancestor.dev = st.st_dev;
+      ancestor.ino = st.st_ino;
+      close(ancestor.fd);
+      ancestor.fd = -1;
+    }
+  }
+
+  return true;
+}
+
+// Lists everything below `path` breadth-first, in the order repeated
+// readdir() calls return it. Without `with_types` symbolic links to
+// directories are followed, with it only real directories are listed.
+bool ListTree(const std::string& path,
+              bool with_types,
+              DirList* list,
+              TreeError* error) {
+  std::vector<std::string>& dirs = list->dirs;
+  std::vector<DirEntry> entries;
+  struct stat st;
+
+  dirs.emplace_back();
+  for (size_t i = 0; i < dirs.size(); i++) {
+    // `dirs` grows while it is walked, copy the current element.
+    const std::string dir = dirs[i];
+    const std::string dir_path = dir.empty() ? path : JoinPath(path, dir);
+
+    int fd = open(dir_path.c_str(), kOpenDirFlags);
+    if (fd == -1) return error->Set("scandir", dir_path);
+    entries.clear();
+    if (!ReadEntries(fd, &entries)) {
+      error->Set("scandir", dir_path);
+      close(fd);
+      return false;
+    }
+    // uv_fs_scandir() sorts the entries the same way.
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const DirEntry& a, const DirEntry& b) {
+                return strcmp(a.name.c_str(), b.name.c_str()) < 0;
+              });
+
+    for (DirEntry& entry : entries) {
+      const char* name = entry.name.c_str();
+      bool is_dir = entry.type == UV_DIRENT_DIR;
+      if (with_types) {
+        if (entry.type == UV_DIRENT_UNKNOWN &&
+            fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+          entry.type = TypeFromMode(st.st_mode);
+          is_dir = entry.type == UV_DIRENT_DIR;
+        }
+      } else if (entry.type == UV_DIRENT_LINK ||
+                 entry.type == UV_DIRENT_UNKNOWN) {
+        is_dir = fstatat(fd, name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+      }
+
+      std::string relative = JoinPath(dir, entry.name);
+      if (with_types) {
+        list->names.push_back(std::move(entry.name));
+        list->types.push_back(entry.type);
+        list->parents.push_back(static_cast<uint32_t>(i));
+      } else {
+        list->names.push_back(relative);
+      }
+      if (is_dir) dirs.push_back(std::move(relative));
+    }
+
+    close(fd);
+  }
+
+  return true;
+}
+
+MaybeLocal<Value> ToJS(Environment* env,
+                       const DirList& list,
+                       bool with_types,
+                       enum encoding encoding,
+                       Local<Value>* error) {
+  Isolate* isolate = env->isolate();
+  std::vector<Local<Value>> names;
+  names.reserve(list.names.size());
+  for (const std::string& name : list.names) {
+    Local<Value> value;
+    if (!StringBytes::Encode(isolate, name.data(), name.size(), encoding, error)
+             .ToLocal(&value)) {
+      return MaybeLocal<Value>();
+    }
+    names.push_back(value);
+  }
+  Local<Array> names_array = Array::New(isolate, names.data(), names.size());
+  if (!with_types) return names_array;
+
+  std::vector<Local<Value>> types;
+  std::vector<Local<Value>> parents;
+  std::vector<Local<Value>> dirs;
+  types.reserve(list.types.size());
+  parents.reserve(list.parents.size());
+  dirs.reserve(list.dirs.size());
+  for (uv_dirent_type_t type : list.types)
+    types.push_back(Integer::New(isolate, type));
+  for (uint32_t parent : list.parents)
+    parents.push_back(Integer::NewFromUnsigned(isolate, parent));
+  for (const std::string& dir : list.dirs) {
+    dirs.push_back(String::NewFromUtf8(isolate,
+                                       dir.data(),
+                                       v8::NewStringType::kNormal,
+                                       static_cast<int>(dir.size()))
+                       .ToLocalChecked());
+  }
+
+  Local<Value> result[] = {
+    names_array,
+    Array::New(isolate, types.data(), types.size()),
+    Array::New(isolate, parents.data(), parents.size()),
+    Array::New(isolate, dirs.data(), dirs.size()),
+  };
+  return Array::New(isolate, result, arraysize(result));
+}
+
+void SetSyncError(Environment* env,
+                  Local<Value> ctx,
+                  const TreeError& error) {
+  Local<Context> context = env->context();
+  Isolate* isolate = env->isolate();
+  Local<Object> ctx_obj = ctx.As<Object>();
+  Local<String> path;
+  ctx_obj->Set(context,
+               env->errno_string(),
+               Integer::New(isolate, error.err)).Check();
+  ctx_obj->Set(context,
+               env->syscall_string(),
+               OneByteString(isolate, error.syscall)).Check();
+  if (String::NewFromUtf8(isolate, error.path.data(),
+                          v8::NewStringType::kNormal,
+                          static_cast<int>(error.path.size()))
+          .ToLocal(&path)) {
+    ctx_obj->Set(context, env->path_string(), path).Check();
+  }
+}
+
+// Runs one tree operation on the threadpool and settles its FSReqCallback or
+// FSReqPromise afterwards.
+class FileTreeWork final : public ThreadPoolWork {
+ public:
+  enum Operation { kRemove, kList };
+
+  FileTreeWork(Environment* env,
+               FSReqBase* req_wrap,
+               Operation operation,
+               std::string path,
+               bool with_types)
+      : ThreadPoolWork(env, "filetree"),
+        req_wrap_(req_wrap),
+        operation_(operation),
+        path_(std::move(path)),
+        with_types_(with_types) {}
+
+  void DoThreadPoolWork() override {
+    if (operation_ == kRemove)
+      RemoveTree(path_, &error_);
+    else
+      ListTree(path_, with_types_, &list_, &error_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<FileTreeWork> self(this);
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+
+    Environment* env = this->env();
+    if (!env->can_call_into_js()) return;
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    if (error_.err != 0) {
+      return req_wrap->Reject(UVException(isolate,
+                                          error_.err,
+                                          error_.syscall,
+                                          nullptr,
+                                          error_.path.c_str()));
+    }
+    if (operation_ == kRemove)
+      return req_wrap->Resolve(Undefined(isolate));
+
+    Local<Value> error;
+    Local<Value> result;
+    if (!ToJS(env, list_, with_types_, req_wrap->encoding(), &error)
+             .ToLocal(&result)) {
+      CHECK(!error.IsEmpty());
+      return req_wrap->Reject(error);
+    }
+    req_wrap->Resolve(result);
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  const Operation operation_;
+  const std::string path_;
+  const bool with_types_;
+  TreeError error_;
+  DirList list_;
+};
+
+static void RmTree(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 1);
+  if (req_wrap_async != nullptr) {  // rmTree(path, req)
+    req_wrap_async->Init("rm", nullptr, 0, UTF8);
+    auto work = new FileTreeWork(
+        env, req_wrap_async, FileTreeWork::kRemove, path.ToString(), false);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // rmTree(path, undefined, ctx)
+    CHECK_EQ(argc, 3);
+    env->PrintSyncTrace();
+    TreeError error;
+    if (!RemoveTree(path.ToString(), &error))
+      SetSyncError(env, args[2], error);
+  }
+}
+
+static void ReadDirRecursive(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+
+  bool with_types = args[2]->IsTrue();
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 3);
+  if (req_wrap_async != nullptr) {
+    // readdirRecursive(path, encoding, withTypes, req)
+    req_wrap_async->Init("scandir", nullptr, 0, encoding);
+    req_wrap_async->set_with_file_types(with_types);
+    auto work = new FileTreeWork(
+        env, req_wrap_async, FileTreeWork::kList, path.ToString(), with_types);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // readdirRecursive(path, encoding, withTypes, undefined, ctx)
+    CHECK_EQ(argc, 5);
+    env->PrintSyncTrace();
+    DirList list;
+    TreeError error;
+    if (!ListTree(path.ToString(), with_types, &list, &error))
+      return SetSyncError(env, args[4], error);
+
+    Local<Value> encode_error;
+    Local<Value> result;
+    if (!ToJS(env, list, with_types, encoding, &encode_error)
+             .ToLocal(&result)) {
+      CHECK(!encode_error.IsEmpty());
+      args[4].As<Object>()->Set(env->context(),
+                                env->error_string(),
+                                encode_error).Check();
+      return;
+    }
+    args.GetReturnValue().Set(result);
+  }
+}
+
+}  // namespace
+
+void FileTree::Initialize(Environment* env, Local<Object> target) {
+  Local<Context> context = env->context();
+  SetMethod(context, target, "rmTree", RmTree);
+  SetMethod(context, target, "readdirRecursive", ReadDirRecursive);
+}
+
+void FileTree::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(RmTree);
+  registry->Register(ReadDirRecursive);
+}
+
+#else  // _WIN32
+
+void FileTree::Initialize(Environment* env, v8::Local<v8::Object> target) {}
+
+void FileTree::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {}
+
+#endif  // _WIN32
+
+}  // namespace fs
+}  // namespace node
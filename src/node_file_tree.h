@@ -0,0 +1,42 @@
+#ifndef SRC_NODE_FILE_TREE_H_
+#define SRC_NODE_FILE_TREE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+class ExternalReferenceRegistry;
+
+namespace fs {
+
+// Operations on whole directory trees that return once, instead of one
+// request per entry. The asynchronous variants walk the tree on a single
+// threadpool thread, the synchronous ones on the calling thread. Directories
+// are opened once and their entries read in large batches, and entries are
+// removed relative to their parent's file descriptor with unlinkat().
+//
+//   rmTree(path, req | undefined, ctx)
+//     Removes `path` and, if it is a directory, everything below it. A
+//     missing `path` is not an error.
+//   readdirRecursive(path, encoding, withFileTypes, req | undefined, ctx)
+//     Lists all entries below `path` in breadth-first order, each directory's
+//     entries sorted by name. Returns the paths relative to `path`, or with
+//     `withFileTypes` an array of [names, types, parents, dirs], where
+//     `dirs[parents[i]]` is the relative path of the directory of entry `i`.
+//
+// Only available on POSIX systems, Windows uses the JS implementations.
+class FileTree {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+};
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_FILE_TREE_H_
@@ -0,0 +1,449 @@
+#include "node_heap_profiler.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "node_internals.h"
+#include "node_pprof.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+#include "v8-profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace node {
+namespace v8_utils {
+
+using v8::AllocationProfile;
+using v8::EmbedderGraph;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::HeapProfiler;
+using v8::Int32;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Uint32;
+using v8::Value;
+
+// The live memory at the time of an aggregation, by allocation stack.
+// Strings and frames are interned, stacks start at the leaf.
+struct ContinuousHeapProfiler::Table {
+  struct Frame {
+    uint32_t name;
+    uint32_t url;
+    int line;
+    int column;
+  };
+
+  struct Entry {
+    std::vector<uint32_t> stack;
+    uint64_t count;
+    uint64_t bytes;
+  };
+
+  std::vector<std::string> strings;
+  std::vector<Frame> frames;
+  std::vector<Entry> entries;
+  int64_t start_ns;
+  int64_t time_ns;
+};
+
+namespace {
+
+using Table = ContinuousHeapProfiler::Table;
+
+// Collects the stacks of a Table. Stacks with the same frames are merged, and
+// Finish() only keeps the `max_stacks` largest ones. All the others are
+// merged into a single "(other)" stack so the totals stay correct.
+class TableBuilder {
+ public:
+  uint32_t Frame(const std::string& name,
+                 const std::string& url,
+                 int line,
+                 int column) {
+    auto it = frame_index_.emplace(FrameKey(name, url, line, column),
+                                   frames_.size());
+    if (it.second) frames_.push_back(&it.first->first);
+    return it.first->second;
+  }
+
+  void Add(const std::vector<uint32_t>& stack,
+           uint64_t count,
+           uint64_t bytes) {
+    std::string key(reinterpret_cast<const char*>(stack.data()),
+                    stack.size() * sizeof(stack[0]));
+    auto it = entry_index_.emplace(std::move(key), entries_.size());
+    if (it.second) entries_.push_back({stack, 0, 0});
+    entries_[it.first->second].count += count;
+    entries_[it.first->second].bytes += bytes;
+  }
+
+  std::shared_ptr<const Table> Finish(size_t max_stacks,
+                                      int64_t start_ns,
+                                      int64_t time_ns) {
+    if (entries_.size() > max_stacks) {
+      size_t keep = max_stacks - 1;
+      std::nth_element(entries_.begin(),
+                       entries_.begin() + keep,
+                       entries_.end(),
+                       [](const Table::Entry& a, const Table::Entry& b) {
+                         return a.bytes > b.bytes;
+                       });
+      Table::Entry other{{Frame("(other)", "", 0, 0)}, 0, 0};
+      for (size_t i = keep; i < entries_.size(); i++) {
+        other.count += entries_[i].count;
+        other.bytes += entries_[i].bytes;
+      }
+      entries_.resize(keep);
+      entries_.push_back(std::move(other));
+    }
+
+    // Only copy the frames and strings that the kept stacks use.
+    auto table = std::make_shared<Table>();
+    table->start_ns = start_ns;
+    table->time_ns = time_ns;
+    std::unordered_map<std::string, uint32_t> strings;
+    auto intern = [&](const std::string& str) {
+      auto it = strings.emplace(str, table->strings.size());
+      if (it.second) table->strings.push_back(str);
+      return it.first->second;
+    };
+    std::vector<int64_t> frames(frames_.size(), -1);
+    for (Table::Entry& entry : entries_) {
+      for (uint32_t& frame : entry.stack) {
+        if (frames[frame] < 0) {
+          const FrameKey& key = *frames_[frame];
+          frames[frame] = table->frames.size();
+          table->frames.push_back({intern(std::get<0>(key)),
+                                   intern(std::get<1>(key)),
+                                   std::get<2>(key),
+                                   std::get<3>(key)});
+        }
+        frame = static_cast<uint32_t>(frames[frame]);
+      }
+    }
+    table->entries = std::move(entries_);
+    return table;
+  }
+
+ private:
+  using FrameKey = std::tuple<std::string, std::string, int, int>;
+
+  std::map<FrameKey, uint32_t> frame_index_;
+  std::vector<const FrameKey*> frames_;
+  std::unordered_map<std::string, size_t> entry_index_;
+  std::vector<Table::Entry> entries_;
+};
+
+void AddAllocationProfile(Isolate* isolate,
+                          AllocationProfile* profile,
+                          TableBuilder* builder) {
+  auto frame = [&](const AllocationProfile::Node* node) {
+    Utf8Value name(isolate, node->name);
+    Utf8Value url(isolate, node->script_name);
+    return builder->Frame(name.length() == 0 ? "(anonymous)" : *name,
+                          *url,
+                          node->line_number,
+                          node->column_number);
+  };
+
+  auto add = [&](const AllocationProfile::Node* node,
+                 const std::vector<uint32_t>& stack) {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    for (const AllocationProfile::Allocation& allocation : node->allocations) {
+      count += allocation.count;
+      bytes += static_cast<uint64_t>(allocation.size) * allocation.count;
+    }
+    builder->Add(stack, count, bytes);
+  };
+
+  // The "(root)" node is only part of the stacks of allocations that have no
+  // other frame.
+  const AllocationProfile::Node* root = profile->GetRootNode();
+  if (!root->allocations.empty()) add(root, {frame(root)});
+
+  // `path` goes from the root to the current node.
+  std::vector<uint32_t> path;
+  std::vector<uint32_t> stack;
+  std::vector<std::pair<const AllocationProfile::Node*, size_t>> pending;
+  for (const AllocationProfile::Node* child : root->children)
+    pending.emplace_back(child, 0);
+  while (!pending.empty()) {
+    const AllocationProfile::Node* node = pending.back().first;
+    size_t depth = pending.back().second;
+    pending.pop_back();
+
+    path.resize(depth);
+    path.push_back(frame(node));
+    if (!node->allocations.empty()) {
+      stack.assign(path.rbegin(), path.rend());
+      add(node, stack);
+    }
+    for (const AllocationProfile::Node* child : node->children)
+      pending.emplace_back(child, depth + 1);
+  }
+}
+
+// Receives the MemoryTracker graph of an Environment. Only the native nodes
+// are kept; the JS objects they wrap or reference are already accounted for
+// by V8. The first edge that reaches a node comes from the node that tracked
+// it, so following those edges gives the path through which it is owned.
+class NativeGraph : public EmbedderGraph {
+ public:
+  Node* V8Node(const Local<Value>& value) override { return &js_node_; }
+
+  Node* AddNode(std::unique_ptr<Node> node) override {
+    Node* n = node.get();
+    owners_.emplace(n, nullptr);
+    nodes_.push_back(std::move(node));
+    return n;
+  }
+
+  void AddEdge(Node* from, Node* to, const char* name = nullptr) override {
+    if (from == &js_node_ || from == to) return;
+    auto it = owners_.find(to);
+    if (it != owners_.end() && it->second == nullptr) it->second = from;
+  }
+
+  void AddTo(TableBuilder* builder, size_t max_depth) {
+    std::unordered_map<Node*, uint32_t> frames;
+    auto frame = [&](Node* node) {
+      auto it = frames.find(node);
+      if (it != frames.end()) return it->second;
+      std::string name = node->Name();
+      if (node->NamePrefix() != nullptr)
+        name = std::string(node->NamePrefix()) + " " + name;
+      uint32_t index = builder->Frame(name, "(native)", 0, 0);
+      frames.emplace(node, index);
+      return index;
+    };
+
+    std::vector<uint32_t> stack;
+    for (const std::unique_ptr<Node>& node : nodes_) {
+      size_t size = node->SizeInBytes();
+      if (size == 0) continue;
+      stack.clear();
+      for (Node* n = node.get(); n != nullptr && stack.size() < max_depth;
+           n = owners_[n]) {
+        stack.push_back(frame(n));
+      }
+      builder->Add(stack, 1, size);
+    }
+  }
+
+ private:
+  class JSNode : public Node {
+   public:
+    const char* Name() override { return "<JS Node>"; }
+    size_t SizeInBytes() override { return 0; }
+    bool IsEmbedderNode() override { return false; }
+  };
+
+  JSNode js_node_;
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::unordered_map<Node*, Node*> owners_;
+};
+
+std::string EncodeTable(const Table* table, int64_t period) {
+  pprof::ProfileBuilder builder({{"objects", "count"}, {"space", "bytes"}},
+                                {"space", "bytes"},
+                                period);
+  if (table == nullptr) return builder.Finish();
+
+  std::vector<int64_t> strings(table->strings.size(), -1);
+  auto string = [&](uint32_t index) {
+    if (strings[index] < 0)
+      strings[index] = builder.Intern(table->strings[index]);
+    return strings[index];
+  };
+  std::vector<uint64_t> locations(table->frames.size(), 0);
+  std::vector<uint64_t> stack;
+  for (const Table::Entry& entry : table->entries) {
+    stack.clear();
+    for (uint32_t index : entry.stack) {
+      if (locations[index] == 0) {
+        const Table::Frame& frame = table->frames[index];
+        locations[index] = builder.Location(
+            string(frame.name), string(frame.url), frame.line, frame.column);
+      }
+      stack.push_back(locations[index]);
+    }
+    const int64_t values[] = {static_cast<int64_t>(entry.count),
+                              static_cast<int64_t>(entry.bytes)};
+    builder.AddSample(stack, values);
+  }
+  builder.SetTime(table->time_ns, table->time_ns - table->start_ns);
+  return builder.Finish();
+}
+
+}  // namespace
+
+class ContinuousHeapProfiler::EncodeJob final : public pprof::EncodeJob {
+ public:
+  EncodeJob(ContinuousHeapProfiler* profiler,
+            std::shared_ptr<const Table> table,
+            bool compress,
+            std::string filename,
+            Local<Function> callback)
+      : pprof::EncodeJob(
+            profiler, "heapprofile", compress, std::move(filename), callback),
+        sampling_interval_(profiler->sampling_interval_),
+        table_(std::move(table)) {}
+
+ private:
+  std::string Encode() override {
+    std::string data = EncodeTable(table_.get(), sampling_interval_);
+    table_.reset();
+    return data;
+  }
+
+  const uint64_t sampling_interval_;
+  std::shared_ptr<const Table> table_;
+};
+
+ContinuousHeapProfiler::ContinuousHeapProfiler(Environment* env,
+                                               Local<Object> wrap,
+                                               uint64_t sampling_interval,
+                                               int stack_depth,
+                                               uint32_t max_stacks,
+                                               bool include_native)
+    : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_HEAPPROFILER),
+      sampling_interval_(sampling_interval),
+      stack_depth_(stack_depth),
+      max_stacks_(max_stacks),
+      include_native_(include_native) {
+  MakeWeak();
+}
+
+ContinuousHeapProfiler::~ContinuousHeapProfiler() {
+  if (running_) env()->isolate()->GetHeapProfiler()->StopSamplingHeapProfiler();
+}
+
+void ContinuousHeapProfiler::UpdateTable() {
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  std::unique_ptr<AllocationProfile> profile(
+      isolate->GetHeapProfiler()->GetAllocationProfile());
+  if (!profile) return;
+
+  TableBuilder builder;
+  AddAllocationProfile(isolate, profile.get(), &builder);
+  profile.reset();
+  if (include_native_) {
+    NativeGraph graph;
+    Environment::BuildEmbedderGraph(isolate, &graph, env());
+    graph.AddTo(&builder, static_cast<size_t>(stack_depth_));
+  }
+  table_ = builder.Finish(max_stacks_, start_ns_, pprof::WallTimeNs());
+}
+
+void ContinuousHeapProfiler::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsInt32());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsBoolean());
+  new ContinuousHeapProfiler(env,
+                             args.This(),
+                             args[0].As<Number>()->Value(),
+                             args[1].As<Int32>()->Value(),
+                             args[2].As<Uint32>()->Value(),
+                             args[3]->IsTrue());
+}
+
+void ContinuousHeapProfiler::Start(const FunctionCallbackInfo<Value>& args) {
+  ContinuousHeapProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  if (self->running_) return args.GetReturnValue().Set(true);
+
+  HeapProfiler* profiler = self->env()->isolate()->GetHeapProfiler();
+  self->running_ = profiler->StartSamplingHeapProfiler(
+      self->sampling_interval_, self->stack_depth_);
+  if (self->running_) {
+    self->start_ns_ = pprof::WallTimeNs();
+    self->table_.reset();
+  }
+  args.GetReturnValue().Set(self->running_);
+}
+
+void ContinuousHeapProfiler::Aggregate(
+    const FunctionCallbackInfo<Value>& args) {
+  ContinuousHeapProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  if (self->running_) self->UpdateTable();
+}
+
+// The last table is kept, so that the profile can still be taken after the
+// profiler has been stopped.
+void ContinuousHeapProfiler::Stop(const FunctionCallbackInfo<Value>& args) {
+  ContinuousHeapProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  if (!self->running_) return;
+  self->UpdateTable();
+  self->env()->isolate()->GetHeapProfiler()->StopSamplingHeapProfiler();
+  self->running_ = false;
+}
+
+void ContinuousHeapProfiler::TakeProfile(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ContinuousHeapProfiler* self;
+  ASSIGN_OR_RETURN_UNWRAP(&self, args.Holder());
+  CHECK(args[0]->IsBoolean());
+  CHECK(args[2]->IsFunction());
+  bool compress = args[0]->IsTrue();
+  std::string filename =
+      pprof::OutputFilename(env, args[1], "Heap", compress);
+
+  // Include everything up to now.
+  if (self->running_) self->UpdateTable();
+
+  auto job = new EncodeJob(self,
+                           self->table_,
+                           compress,
+                           std::move(filename),
+                           args[2].As<Function>());
+  job->ScheduleWork();
+}
+
+void ContinuousHeapProfiler::Initialize(Environment* env,
+                                        Local<Object> target) {
+  Isolate* isolate = env->isolate();
+
+  Local<FunctionTemplate> t =
+      NewFunctionTemplate(isolate, ContinuousHeapProfiler::New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      ContinuousHeapProfiler::kInternalFieldCount);
+  t->Inherit(AsyncWrap::GetConstructorTemplate(env));
+
+  SetProtoMethod(isolate, t, "start", ContinuousHeapProfiler::Start);
+  SetProtoMethod(isolate, t, "aggregate", ContinuousHeapProfiler::Aggregate);
+  SetProtoMethod(isolate, t, "stop", ContinuousHeapProfiler::Stop);
+  SetProtoMethod(
+      isolate, t, "takeProfile", ContinuousHeapProfiler::TakeProfile);
+
+  SetConstructorFunction(
+      env->context(), target, "ContinuousHeapProfiler", t);
+}
+
+void ContinuousHeapProfiler::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(ContinuousHeapProfiler::New);
+  registry->Register(ContinuousHeapProfiler::Start);
+  registry->Register(ContinuousHeapProfiler::Aggregate);
+  registry->Register(ContinuousHeapProfiler::Stop);
+  registry->Register(ContinuousHeapProfiler::TakeProfile);
+}
+
+}  // namespace v8_utils
+}  // namespace node
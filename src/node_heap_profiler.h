@@ -0,0 +1,85 @@
+#ifndef SRC_NODE_HEAP_PROFILER_H_
+#define SRC_NODE_HEAP_PROFILER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "v8.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace node {
+
+class Environment;
+class ExternalReferenceRegistry;
+
+namespace v8_utils {
+
+// An always-on heap profiler built on V8's sampling heap profiler. V8 samples
+// allocations roughly every `samplingInterval` bytes and forgets the samples
+// of objects that have been collected, so its profile only describes live
+// memory. aggregate() folds that profile into a compact Table of allocation
+// stacks, keeping the `maxStacks` largest ones and merging the rest, so the
+// memory held by the profiler does not grow with the number of call sites.
+//
+// When `includeNative` is set, the sizes reported by the MemoryRetainers that
+// are reachable from the Environment are added to the table as well. Their
+// stack is the ownership path in the MemoryTracker graph.
+//
+// takeProfile() encodes the last table as a pprof profile on the threadpool,
+// and optionally writes it to a file there.
+class ContinuousHeapProfiler final : public AsyncWrap {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  struct Table;
+
+  ~ContinuousHeapProfiler() override;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(ContinuousHeapProfiler)
+  SET_SELF_SIZE(ContinuousHeapProfiler)
+
+ private:
+  class EncodeJob;
+
+  ContinuousHeapProfiler(Environment* env,
+                         v8::Local<v8::Object> wrap,
+                         uint64_t sampling_interval,
+                         int stack_depth,
+                         uint32_t max_stacks,
+                         bool include_native);
+
+  // new ContinuousHeapProfiler(samplingInterval, stackDepth, maxStacks,
+  //                            includeNative)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.start()
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.aggregate()
+  static void Aggregate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.stop()
+  static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // profiler.takeProfile(compress, filename | true | undefined, callback)
+  static void TakeProfile(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void UpdateTable();
+
+  const uint64_t sampling_interval_;
+  const int stack_depth_;
+  const uint32_t max_stacks_;
+  const bool include_native_;
+
+  bool running_ = false;
+  int64_t start_ns_ = 0;
+  std::shared_ptr<const Table> table_;
+};
+
+}  // namespace v8_utils
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_HEAP_PROFILER_H_
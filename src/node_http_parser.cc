@@ -25,6 +25,7 @@
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "histogram-inl.h"
 #include "memory_tracker-inl.h"
 #include "stream_base-inl.h"
 #include "v8.h"
@@ -32,6 +33,7 @@
 
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <deque>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -195,6 +197,12 @@ struct ParserComparator {
   bool operator()(const Parser* lhs, const Parser* rhs) const;
 };
 
+// Latencies from 1us to 1h are recorded with 2 significant digits, which
+// keeps each histogram at a few tens of kilobytes.
+const Histogram::Options kTimingOptions {
+  1000, int64_t{3600} * 1000 * 1000 * 1000, 2
+};
+
 class ConnectionsList : public BaseObject {
  public:
     static void New(const FunctionCallbackInfo<Value>& args);
@@ -207,6 +215,25 @@ class ConnectionsList : public BaseObject {
 
     static void Expired(const FunctionCallbackInfo<Value>& args);
 
+    // Returns copies of the timing histograms, ordered by Timing, and
+    // resets them if args[0] is true.
+    static void Timings(const FunctionCallbackInfo<Value>& args);
+
+    // Time from the start of a request to the end of its headers, to the
+    // end of its body, and to the end of its response, in nanoseconds.
+    enum Timing {
+      kTimingHeaders,
+      kTimingBody,
+      kTimingResponse,
+      kTimingCount
+    };
+
+    bool records_timings() const { return !timings_.empty(); }
+
+    void RecordTiming(Timing timing, uint64_t start) {
+      timings_[timing]->Record(uv_hrtime() - start);
+    }
+
     void Push(Parser* parser) {
       all_connections_.insert(parser);
     }
@@ -223,18 +250,27 @@ class ConnectionsList : public BaseObject {
       active_connections_.erase(parser);
     }
 
-    SET_NO_MEMORY_INFO()
+    void MemoryInfo(MemoryTracker* tracker) const override {
+      for (const HistogramImpl& timing : timings_)
+        tracker->TrackField("timing", timing.histogram());
+    }
+
     SET_MEMORY_INFO_NAME(ConnectionsList)
     SET_SELF_SIZE(ConnectionsList)
 
  private:
-    ConnectionsList(Environment* env, Local<Object> object)
+    ConnectionsList(Environment* env, Local<Object> object, bool timings)
       : BaseObject(env, object) {
         MakeWeak();
+        if (timings) {
+          for (int i = 0; i < kTimingCount; i++)
+            timings_.emplace_back(kTimingOptions);
+        }
       }
 
     std::set<Parser*, ParserComparator> all_connections_;
     std::set<Parser*, ParserComparator> active_connections_;
+    std::vector<HistogramImpl> timings_;
 };
 
 class Parser : public AsyncWrap, public StreamListener {
@@ -271,6 +307,10 @@ class Parser : public AsyncWrap, public StreamListener {
     if (connectionsList_ != nullptr) {
       connectionsList_->Push(this);
       connectionsList_->PushActive(this);
+      // Responses are sent in the order of the requests, even when they
+      // are pipelined.
+      if (connectionsList_->records_timings())
+        response_starts_.push_back(last_message_start_);
     }
 
     Local<Value> cb = object()->Get(env()->context(), kOnMessageBegin)
@@ -363,6 +403,11 @@ class Parser : public AsyncWrap, public StreamListener {
     headers_completed_ = true;
     header_nread_ = 0;
 
+    if (connectionsList_ != nullptr && connectionsList_->records_timings()) {
+      connectionsList_->RecordTiming(ConnectionsList::kTimingHeaders,
+                                     last_message_start_);
+    }
+
     // Arguments for the on-headers-complete javascript callback. This
     // list needs to be kept in sync with the actual argument list for
     // `parserOnHeadersComplete` in lib/_http_common.js.
@@ -485,6 +530,10 @@ class Parser : public AsyncWrap, public StreamListener {
     if (connectionsList_ != nullptr) {
       connectionsList_->Pop(this);
       connectionsList_->PopActive(this);
+      if (connectionsList_->records_timings()) {
+        connectionsList_->RecordTiming(ConnectionsList::kTimingBody,
+                                       last_message_start_);
+      }
     }
 
     last_message_start_ = 0;
@@ -579,6 +628,21 @@ class Parser : public AsyncWrap, public StreamListener {
     }
   }
 
+  // Called by the server when the response to the oldest request that is
+  // still waiting for one has been sent.
+  static void FinishResponse(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+
+    if (parser->response_starts_.empty()) return;
+    if (parser->connectionsList_ != nullptr &&
+        parser->connectionsList_->records_timings()) {
+      parser->connectionsList_->RecordTiming(
+          ConnectionsList::kTimingResponse, parser->response_starts_.front());
+    }
+    parser->response_starts_.pop_front();
+  }
+
   void Save() {
     url_.Save();
     status_message_.Save();
@@ -663,6 +727,7 @@ class Parser : public AsyncWrap, public StreamListener {
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
     parser->Init(type, max_http_header_size, lenient_flags);
+    parser->response_starts_.clear();
 
     if (connectionsList != nullptr) {
       parser->connectionsList_ = connectionsList;
@@ -1006,6 +1071,8 @@ class Parser : public AsyncWrap, public StreamListener {
   uint64_t max_http_header_size_;
   uint64_t last_message_start_;
   ConnectionsList* connectionsList_;
+  // Start times of the requests whose response has not been sent yet.
+  std::deque<uint64_t> response_starts_;
 
   BaseObjectPtr<BindingData> binding_data_;
 
@@ -1048,7 +1115,29 @@ void ConnectionsList::New(const FunctionCallbackInfo<Value>& args) {
   Local<Context> context = args.GetIsolate()->GetCurrentContext();
   Environment* env = Environment::GetCurrent(context);
 
-  new ConnectionsList(env, args.This());
+  new ConnectionsList(env, args.This(), args[0]->IsTrue());
+}
+
+void ConnectionsList::Timings(const FunctionCallbackInfo<Value>& args) {
+  ConnectionsList* list;
+
+  ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+
+  if (!list->records_timings()) return;
+
+  Environment* env = list->env();
+  Local<Value> result[kTimingCount];
+  for (int i = 0; i < kTimingCount; i++) {
+    Histogram* timing = list->timings_[i].histogram().get();
+    BaseObjectPtr<HistogramBase> snapshot =
+        HistogramBase::Create(env, kTimingOptions);
+    if (!snapshot) return;
+    (*snapshot)->Add(*timing);
+    if (args[0]->IsTrue()) timing->Reset();
+    result[i] = snapshot->object();
+  }
+
+  args.GetReturnValue().Set(Array::New(env->isolate(), result, kTimingCount));
 }
 
 void ConnectionsList::All(const FunctionCallbackInfo<Value>& args) {
@@ -1249,6 +1338,7 @@ void InitializeHttpParser(Local<Object> target,
   SetProtoMethod(isolate, t, "close", Parser::Close);
   SetProtoMethod(isolate, t, "free", Parser::Free);
   SetProtoMethod(isolate, t, "remove", Parser::Remove);
+  SetProtoMethod(isolate, t, "finishResponse", Parser::FinishResponse);
   SetProtoMethod(isolate, t, "execute", Parser::Execute);
   SetProtoMethod(isolate, t, "finish", Parser::Finish);
   SetProtoMethod(isolate, t, "initialize", Parser::Initialize);
@@ -1270,6 +1360,7 @@ void InitializeHttpParser(Local<Object> target,
   SetProtoMethod(isolate, c, "idle", ConnectionsList::Idle);
   SetProtoMethod(isolate, c, "active", ConnectionsList::Active);
   SetProtoMethod(isolate, c, "expired", ConnectionsList::Expired);
+  SetProtoMethod(isolate, c, "timings", ConnectionsList::Timings);
   SetConstructorFunction(context, target, "ConnectionsList", c);
 }
 
@@ -120,7 +120,9 @@ class NodeArrayBufferAllocator : public ArrayBufferAllocator {
     return total_mem_usage_.load(std::memory_order_relaxed);
   }
 
- private:
+ protected:
+  bool should_zero_fill() const;
+
   uint32_t zero_fill_field_ = 1;  // Boolean but exposed as uint32 to JS land.
   std::atomic<size_t> total_mem_usage_ {0};
 
@@ -146,6 +148,16 @@ class DebuggingArrayBufferAllocator final : public NodeArrayBufferAllocator {
   std::unordered_map<void*, size_t> allocations_;
 };
 
+// Serves small allocations from the process-wide ArrayBufferPool instead of
+// the system allocator. Enabled by --pool-arraybuffer-allocations.
+class PoolingArrayBufferAllocator final : public NodeArrayBufferAllocator {
+ public:
+  void* Allocate(size_t size) override;
+  void* AllocateUninitialized(size_t size) override;
+  void Free(void* data, size_t size) override;
+  void* Reallocate(void* data, size_t old_size, size_t size) override;
+};
+
 namespace Buffer {
 v8::MaybeLocal<v8::Object> Copy(Environment* env, const char* data, size_t len);
 v8::MaybeLocal<v8::Object> New(Environment* env, size_t size);
@@ -202,7 +214,8 @@ v8::MaybeLocal<v8::Value> InternalMakeCallback(
     const v8::Local<v8::Function> callback,
     int argc,
     v8::Local<v8::Value> argv[],
-    async_context asyncContext);
+    async_context asyncContext,
+    v8::Local<v8::Value> context_frame = v8::Local<v8::Value>());
 
 v8::MaybeLocal<v8::Value> MakeSyncCallback(v8::Isolate* isolate,
                                            v8::Local<v8::Object> recv,
@@ -222,10 +235,14 @@ class InternalCallbackScope {
     // compatibility issues, but it shouldn't.)
     kSkipTaskQueues = 2
   };
+  // If |context_frame| is not empty, it is made the current async context
+  // frame for the lifetime of the scope.
   InternalCallbackScope(Environment* env,
                         v8::Local<v8::Object> object,
                         const async_context& asyncContext,
-                        int flags = kNoFlags);
+                        int flags = kNoFlags,
+                        v8::Local<v8::Value> context_frame =
+                            v8::Local<v8::Value>());
   // Utility that can be used by AsyncWrap classes.
   explicit InternalCallbackScope(AsyncWrap* async_wrap, int flags = 0);
   ~InternalCallbackScope();
@@ -238,6 +255,7 @@ class InternalCallbackScope {
   Environment* env_;
   async_context async_context_;
   v8::Local<v8::Object> object_;
+  v8::Global<v8::Value> prior_context_frame_;
   bool skip_hooks_;
   bool skip_task_queues_;
   bool failed_ = false;
@@ -279,6 +297,10 @@ class ThreadPoolWork {
   Environment* env_;
   uv_work_t work_req_;
   const char* type_;
+  // Timestamps for the event loop phase monitors, 0 while none is enabled.
+  uint64_t queued_at_ = 0;
+  uint64_t started_at_ = 0;
+  uint64_t finished_at_ = 0;
 };
 
 #define TRACING_CATEGORY_NODE "node"
@@ -385,7 +407,10 @@ class DiagnosticFilename {
 };
 
 namespace heap {
-v8::Maybe<void> WriteSnapshot(Environment* env, const char* filename);
+// `flags` is a combination of HeapSnapshotWriter::Flags.
+v8::Maybe<void> WriteSnapshot(Environment* env,
+                              const char* filename,
+                              int flags);
 }
 
 namespace heap {
@@ -1,8 +1,5 @@
 #include "node_main_instance.h"
 #include <memory>
-#if HAVE_OPENSSL
-#include "crypto/crypto_util.h"
-#endif  // HAVE_OPENSSL
 #include "debug_utils-inl.h"
 #include "node_builtins.h"
 #include "node_external_reference.h"
@@ -86,7 +83,7 @@ NodeMainInstance::NodeMainInstance(const SnapshotData* snapshot_data,
       event_loop,
       platform,
       array_buffer_allocator_.get(),
-      snapshot_data == nullptr ? nullptr : &(snapshot_data->isolate_data_info));
+      snapshot_data);
 
   isolate_data_->max_young_gen_size =
       isolate_params_->constraints.max_young_generation_size_in_bytes();
@@ -163,42 +160,16 @@ NodeMainInstance::CreateMainEnvironment(int* exit_code) {
     isolate_->GetHeapProfiler()->StartTrackingHeapObjects(true);
   }
 
-  Local<Context> context;
   DeleteFnPtr<Environment, FreeEnvironment> env;
 
   if (snapshot_data_ != nullptr) {
-    env.reset(new Environment(isolate_data_.get(),
-                              isolate_,
-                              args_,
-                              exec_args_,
-                              &(snapshot_data_->env_info),
-                              EnvironmentFlags::kDefaultFlags,
-                              {}));
-#ifdef NODE_V8_SHARED_RO_HEAP
-    // TODO(addaleax): Do this as part of creating the Environment
-    // once we store the SnapshotData* itself on IsolateData.
-    env->builtin_loader()->RefreshCodeCache(snapshot_data_->code_cache);
-#endif
-    context = Context::FromSnapshot(isolate_,
-                                    SnapshotData::kNodeMainContextIndex,
-                                    {DeserializeNodeInternalFields, env.get()})
-                  .ToLocalChecked();
-
-    CHECK(!context.IsEmpty());
-    Context::Scope context_scope(context);
-
-    CHECK(InitializeContextRuntime(context).IsJust());
-    SetIsolateErrorHandlers(isolate_, {});
-    env->InitializeMainContext(context, &(snapshot_data_->env_info));
-#if HAVE_INSPECTOR
-    env->InitializeInspector({});
-#endif
-
-#if HAVE_OPENSSL
-    crypto::InitCryptoOnce(isolate_);
-#endif  // HAVE_OPENSSL
+    // An empty context makes CreateEnvironment() deserialize the main
+    // context from the snapshot that the IsolateData was created with.
+    env.reset(CreateEnvironment(
+        isolate_data_.get(), Local<Context>(), args_, exec_args_));
+    CHECK_NOT_NULL(env);
   } else {
-    context = NewContext(isolate_);
+    Local<Context> context = NewContext(isolate_);
     CHECK(!context.IsEmpty());
     Context::Scope context_scope(context);
     env.reset(
@@ -377,6 +377,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             &EnvironmentOptions::enable_source_maps,
             kAllowedInEnvvar);
   AddOption("--experimental-abortcontroller", "", NoOp{}, kAllowedInEnvvar);
+  AddOption("--experimental-async-context-frame",
+            "Use a promise-hook-free implementation of AsyncLocalStorage "
+            "based on V8's continuation-preserved embedder data",
+            &EnvironmentOptions::experimental_async_context_frame,
+            kAllowedInEnvvar);
   AddOption("--experimental-fetch",
             "experimental Fetch API",
             &EnvironmentOptions::experimental_fetch,
@@ -445,6 +450,16 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "Generate heap snapshot on specified signal",
             &EnvironmentOptions::heap_snapshot_signal,
             kAllowedInEnvvar);
+  AddOption("--cpu-prof-signal",
+            "Keep a CPU profile of the last minute and write it to disk in "
+            "pprof format on specified signal",
+            &EnvironmentOptions::cpu_profile_signal,
+            kAllowedInEnvvar);
+  AddOption("--heapsnapshot-compress",
+            "Compress heap snapshots generated by --heapsnapshot-signal and "
+            "--heapsnapshot-near-heap-limit with gzip",
+            &EnvironmentOptions::heap_snapshot_compress,
+            kAllowedInEnvvar);
   AddOption("--heapsnapshot-near-heap-limit",
             "Generate heap snapshots whenever V8 is approaching "
             "the heap limit. No more than the specified number of "
@@ -805,6 +820,11 @@ PerIsolateOptionsParser::PerIsolateOptionsParser(
             "",
             &PerIsolateOptions::experimental_shadow_realm,
             kAllowedInEnvvar);
+  AddOption("--build-snapshot",
+            "Generate a snapshot blob when the process exits."
+            " Currently only supported in the node_mksnapshot binary.",
+            &PerIsolateOptions::build_snapshot,
+            kDisallowedInEnvvar);
   AddOption("--harmony-shadow-realm", "", V8Option{});
   Implies("--experimental-shadow-realm", "--harmony-shadow-realm");
   Implies("--harmony-shadow-realm", "--experimental-shadow-realm");
@@ -843,15 +863,15 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "", /* undocumented, only for debugging */
             &PerProcessOptions::debug_arraybuffer_allocations,
             kAllowedInEnvvar);
+  AddOption("--pool-arraybuffer-allocations",
+            "serve small ArrayBuffer and Buffer allocations from a "
+            "process-wide pool of size-class free lists",
+            &PerProcessOptions::pool_arraybuffer_allocations,
+            kAllowedInEnvvar);
   AddOption("--disable-proto",
             "disable Object.prototype.__proto__",
             &PerProcessOptions::disable_proto,
             kAllowedInEnvvar);
-  AddOption("--build-snapshot",
-            "Generate a snapshot blob when the process exits."
-            " Currently only supported in the node_mksnapshot binary.",
-            &PerProcessOptions::build_snapshot,
-            kDisallowedInEnvvar);
   AddOption("--node-snapshot",
             "",  // It's a debug-only option.
             &PerProcessOptions::node_snapshot,
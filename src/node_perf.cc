@@ -9,18 +9,25 @@
 #include "node_process-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 namespace node {
 namespace performance {
 
+using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::Context;
 using v8::DontDelete;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::GCCallbackFlags;
 using v8::GCType;
+using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
@@ -108,7 +115,64 @@ void MarkMilestone(const FunctionCallbackInfo<Value>& args) {
 void SetupPerformanceObservers(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(args[0]->IsFunction());
+  CHECK(args[1]->IsFunction());
   env->set_performance_entry_callback(args[0].As<Function>());
+  env->set_performance_entry_batch_callback(args[1].As<Function>());
+}
+
+double* PerformanceEntryBuffer::Push() {
+  if (ring_.empty())
+    ring_.resize(kCapacity * NODE_PERFORMANCE_ENTRY_FIELD_COUNT);
+  if (write_ - read_ == kCapacity) {
+    const double* oldest = Entry(read_++);
+    spilled_.insert(
+        spilled_.end(), oldest, oldest + NODE_PERFORMANCE_ENTRY_FIELD_COUNT);
+  }
+  return Entry(write_++);
+}
+
+void PerformanceEntryBuffer::Take(double* out, size_t count) {
+  CHECK_LE(count, size());
+  size_t spilled = std::min(count * NODE_PERFORMANCE_ENTRY_FIELD_COUNT,
+                            spilled_.size());
+  if (spilled > 0) {
+    memcpy(out, spilled_.data(), spilled * sizeof(double));
+    spilled_.erase(spilled_.begin(), spilled_.begin() + spilled);
+    out += spilled;
+    count -= spilled / NODE_PERFORMANCE_ENTRY_FIELD_COUNT;
+  }
+  for (; count > 0; count--) {
+    memcpy(out,
+           Entry(read_++),
+           NODE_PERFORMANCE_ENTRY_FIELD_COUNT * sizeof(double));
+    out += NODE_PERFORMANCE_ENTRY_FIELD_COUNT;
+  }
+}
+
+void FlushPerformanceEntries(Environment* env) {
+  PerformanceEntryBuffer* buffer = &env->performance_state()->entry_buffer;
+  buffer->flush_scheduled = false;
+  size_t count = buffer->size();
+  if (count == 0) return;
+
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+  // A GC while the batch is created adds entries to the buffer, and schedules
+  // another flush for them.
+  size_t length = count * NODE_PERFORMANCE_ENTRY_FIELD_COUNT;
+  std::unique_ptr<BackingStore> store =
+      ArrayBuffer::NewBackingStore(isolate, length * sizeof(double));
+  buffer->Take(static_cast<double*>(store->Data()), count);
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(store));
+  Local<Value> entries = Float64Array::New(ab, 0, length);
+
+  if (env->performance_entry_batch_callback().IsEmpty()) return;
+  MakeSyncCallback(isolate,
+                   env->context()->Global(),
+                   env->performance_entry_batch_callback(),
+                   1,
+                   &entries);
 }
 
 // Marks the start of a GC cycle
@@ -174,17 +238,15 @@ void MarkGarbageCollectionEnd(
   double duration =
       (PERFORMANCE_NOW() / 1e6) - (state->performance_last_gc_start_mark / 1e6);
 
-  std::unique_ptr<GCPerformanceEntry> entry =
-      std::make_unique<GCPerformanceEntry>(
-          "gc",
-          start_time,
-          duration,
-          GCPerformanceEntry::Details(static_cast<PerformanceGCKind>(type),
-                                      static_cast<PerformanceGCFlags>(flags)));
-
-  env->SetImmediate([entry = std::move(entry)](Environment* env) {
-    entry->Notify(env);
-  }, CallbackFlags::kUnrefed);
+  GCPerformanceEntry entry(
+      "gc",
+      start_time,
+      duration,
+      GCPerformanceEntry::Details(static_cast<PerformanceGCKind>(type),
+                                  static_cast<PerformanceGCFlags>(flags)));
+  // Creating JS objects is not allowed here, and the entries of frequent
+  // GCs are delivered in batches.
+  entry.Enqueue(env);
 }
 
 void GarbageCollectionCleanupHook(void* data) {
@@ -257,6 +319,195 @@ void CreateELDHistogram(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(histogram->object());
 }
 
+void LoopPhaseTracker::AddMonitor(EventLoopPhaseMonitor* monitor) {
+  if (monitors_.empty()) {
+    // Phases that started while no monitor was enabled are not measured.
+    phase_ = NODE_PERFORMANCE_LOOP_PHASE_INVALID;
+    outer_phase_ = NODE_PERFORMANCE_LOOP_PHASE_INVALID;
+  }
+  monitors_.push_back(monitor);
+}
+
+void LoopPhaseTracker::RemoveMonitor(EventLoopPhaseMonitor* monitor) {
+  monitors_.erase(std::remove(monitors_.begin(), monitors_.end(), monitor),
+                  monitors_.end());
+}
+
+void LoopPhaseTracker::Record(PerformanceLoopPhase phase, uint64_t duration) {
+  for (EventLoopPhaseMonitor* monitor : monitors_)
+    monitor->RecordPhase(phase, duration);
+}
+
+void LoopPhaseTracker::EnterPhase(PerformanceLoopPhase phase) {
+  outer_phase_ = phase_;
+  phase_ = phase;
+  phase_start_ = PERFORMANCE_NOW();
+}
+
+void LoopPhaseTracker::LeavePhase(PerformanceLoopPhase phase) {
+  if (phase_ != phase) return;
+  uint64_t now = PERFORMANCE_NOW();
+  Record(phase, now - phase_start_);
+  if (phase == NODE_PERFORMANCE_LOOP_PHASE_CHECK) {
+    phase_ = NODE_PERFORMANCE_LOOP_PHASE_CLOSE;
+    close_start_ = now;
+    close_excluded_ = 0;
+    return;
+  }
+  phase_ = outer_phase_;
+  // Timers run between the close phase of an iteration and the poll phase
+  // of the next one.
+  if (phase_ == NODE_PERFORMANCE_LOOP_PHASE_CLOSE)
+    close_excluded_ += now - phase_start_;
+}
+
+void LoopPhaseTracker::BeforePoll(uv_loop_t* loop) {
+  uint64_t now = PERFORMANCE_NOW();
+  if (phase_ == NODE_PERFORMANCE_LOOP_PHASE_CLOSE)
+    Record(phase_, now - close_start_ - close_excluded_);
+  phase_ = NODE_PERFORMANCE_LOOP_PHASE_POLL;
+  phase_start_ = now;
+  poll_idle_start_ = uv_metrics_idle_time(loop);
+}
+
+void LoopPhaseTracker::AfterPoll(uv_loop_t* loop) {
+  if (phase_ != NODE_PERFORMANCE_LOOP_PHASE_POLL) return;
+  uint64_t duration = PERFORMANCE_NOW() - phase_start_;
+  uint64_t idle = uv_metrics_idle_time(loop) - poll_idle_start_;
+  Record(phase_, duration - std::min(idle, duration));
+  phase_ = NODE_PERFORMANCE_LOOP_PHASE_INVALID;
+}
+
+void LoopPhaseTracker::CountCallback() {
+  if (phase_ == NODE_PERFORMANCE_LOOP_PHASE_INVALID) return;
+  for (EventLoopPhaseMonitor* monitor : monitors_)
+    monitor->CountCallback(phase_);
+}
+
+void LoopPhaseTracker::RecordThreadPoolWork(uint64_t wait, uint64_t run) {
+  for (EventLoopPhaseMonitor* monitor : monitors_)
+    monitor->RecordThreadPoolWork(wait, run);
+}
+
+EventLoopPhaseMonitor::EventLoopPhaseMonitor(Environment* env,
+                                             Local<Object> wrap)
+    : BaseObject(env, wrap) {
+  MakeWeak();
+  for (std::shared_ptr<Histogram>& histogram : histograms_)
+    histogram = std::make_shared<Histogram>(Histogram::Options {});
+}
+
+EventLoopPhaseMonitor::~EventLoopPhaseMonitor() {
+  if (enabled_) env()->performance_state()->loop_phases.RemoveMonitor(this);
+}
+
+void EventLoopPhaseMonitor::RecordPhase(PerformanceLoopPhase phase,
+                                        uint64_t duration) {
+  histograms_[phase]->Record(duration);
+}
+
+void EventLoopPhaseMonitor::RecordThreadPoolWork(uint64_t wait,
+                                                 uint64_t run) {
+  histograms_[kThreadPoolWait]->Record(wait);
+  histograms_[kThreadPoolRun]->Record(run);
+}
+
+void EventLoopPhaseMonitor::MemoryInfo(MemoryTracker* tracker) const {
+  for (const std::shared_ptr<Histogram>& histogram : histograms_)
+    tracker->TrackField("histogram", histogram);
+}
+
+void EventLoopPhaseMonitor::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  new EventLoopPhaseMonitor(env, args.This());
+}
+
+void EventLoopPhaseMonitor::Start(const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  if (monitor->enabled_) return;
+  monitor->enabled_ = true;
+  monitor->env()->performance_state()->loop_phases.AddMonitor(monitor);
+}
+
+void EventLoopPhaseMonitor::Stop(const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  if (!monitor->enabled_) return;
+  monitor->enabled_ = false;
+  monitor->env()->performance_state()->loop_phases.RemoveMonitor(monitor);
+}
+
+void EventLoopPhaseMonitor::GetHistograms(
+    const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  Environment* env = monitor->env();
+  Local<Value> histograms[kHistogramCount];
+  for (size_t i = 0; i < kHistogramCount; i++) {
+    BaseObjectPtr<HistogramBase> histogram =
+        HistogramBase::Create(env, monitor->histograms_[i]);
+    if (!histogram) return;
+    histograms[i] = histogram->object();
+  }
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), histograms, arraysize(histograms)));
+}
+
+void EventLoopPhaseMonitor::GetCallbackCounts(
+    const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  Isolate* isolate = monitor->env()->isolate();
+  Local<Value> counts[NODE_PERFORMANCE_LOOP_PHASE_INVALID];
+  for (size_t i = 0; i < arraysize(counts); i++)
+    counts[i] = Number::New(isolate, monitor->callbacks_[i]);
+  args.GetReturnValue().Set(Array::New(isolate, counts, arraysize(counts)));
+}
+
+void EventLoopPhaseMonitor::ResetCallbackCounts(
+    const FunctionCallbackInfo<Value>& args) {
+  EventLoopPhaseMonitor* monitor;
+  ASSIGN_OR_RETURN_UNWRAP(&monitor, args.Holder());
+  std::fill(std::begin(monitor->callbacks_), std::end(monitor->callbacks_), 0);
+}
+
+void EventLoopPhaseMonitor::Initialize(Environment* env,
+                                       Local<Object> target) {
+  Isolate* isolate = env->isolate();
+
+  Local<FunctionTemplate> t =
+      NewFunctionTemplate(isolate, EventLoopPhaseMonitor::New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      EventLoopPhaseMonitor::kInternalFieldCount);
+
+  SetProtoMethod(isolate, t, "start", EventLoopPhaseMonitor::Start);
+  SetProtoMethod(isolate, t, "stop", EventLoopPhaseMonitor::Stop);
+  SetProtoMethod(
+      isolate, t, "getHistograms", EventLoopPhaseMonitor::GetHistograms);
+  SetProtoMethod(isolate,
+                 t,
+                 "getCallbackCounts",
+                 EventLoopPhaseMonitor::GetCallbackCounts);
+  SetProtoMethod(isolate,
+                 t,
+                 "resetCallbackCounts",
+                 EventLoopPhaseMonitor::ResetCallbackCounts);
+
+  SetConstructorFunction(env->context(), target, "EventLoopPhaseMonitor", t);
+}
+
+void EventLoopPhaseMonitor::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(EventLoopPhaseMonitor::New);
+  registry->Register(EventLoopPhaseMonitor::Start);
+  registry->Register(EventLoopPhaseMonitor::Stop);
+  registry->Register(EventLoopPhaseMonitor::GetHistograms);
+  registry->Register(EventLoopPhaseMonitor::GetCallbackCounts);
+  registry->Register(EventLoopPhaseMonitor::ResetCallbackCounts);
+}
+
 void GetTimeOrigin(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(Number::New(args.GetIsolate(), timeOrigin / 1e6));
 }
@@ -312,6 +563,7 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "getTimeOriginTimestamp", GetTimeOriginTimeStamp);
   SetMethod(context, target, "createELDHistogram", CreateELDHistogram);
   SetMethod(context, target, "markBootstrapComplete", MarkBootstrapComplete);
+  EventLoopPhaseMonitor::Initialize(env, target);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -345,6 +597,18 @@ void Initialize(Local<Object> target,
   NODE_PERFORMANCE_MILESTONES(V)
 #undef V
 
+#define V(name, _)                                                            \
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_LOOP_PHASE_##name);
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_ENTRY_FIELD_TYPE);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants,
+                              NODE_PERFORMANCE_ENTRY_FIELD_START_TIME);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_ENTRY_FIELD_DURATION);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_ENTRY_FIELD_DETAILS);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_ENTRY_FIELD_COUNT);
+
   PropertyAttribute attr =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
 
@@ -369,6 +633,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(MarkBootstrapComplete);
   HistogramBase::RegisterExternalReferences(registry);
   IntervalHistogram::RegisterExternalReferences(registry);
+  EventLoopPhaseMonitor::RegisterExternalReferences(registry);
 }
 }  // namespace performance
 }  // namespace node
@@ -86,6 +86,9 @@ enum PerformanceGCFlags {
     v8::GCCallbackFlags::kGCCallbackScheduleIdleGarbageCollection
 };
 
+// Delivers the entries of the PerformanceEntryBuffer of `env` to JS.
+void FlushPerformanceEntries(Environment* env);
+
 template <typename Traits>
 struct PerformanceEntry {
   using Details = typename Traits::Details;
@@ -140,6 +143,26 @@ struct PerformanceEntry {
         arraysize(argv),
         argv);
   }
+
+  // Like Notify(), but without creating any JS object. The entry is packed
+  // into the PerformanceEntryBuffer of the Environment by Traits::Pack(), and
+  // the buffer is delivered to the observers on the next turn of the event
+  // loop. The name of a packed entry is the name of its type.
+  void Enqueue(Environment* env) {
+    DCHECK_EQ(name, GetPerformanceEntryTypeName(Traits::kType));
+    PerformanceEntryBuffer* buffer = &env->performance_state()->entry_buffer;
+    double* fields = buffer->Push();
+    fields[NODE_PERFORMANCE_ENTRY_FIELD_TYPE] = Traits::kType;
+    fields[NODE_PERFORMANCE_ENTRY_FIELD_START_TIME] = start_time;
+    fields[NODE_PERFORMANCE_ENTRY_FIELD_DURATION] = duration;
+    Traits::Pack(*this, fields + NODE_PERFORMANCE_ENTRY_FIELD_DETAILS);
+    if (!buffer->flush_scheduled) {
+      buffer->flush_scheduled = true;
+      env->SetImmediate(
+          [](Environment* env) { FlushPerformanceEntries(env); },
+          CallbackFlags::kUnrefed);
+    }
+  }
 };
 
 struct GCPerformanceEntryTraits {
@@ -156,10 +179,69 @@ struct GCPerformanceEntryTraits {
   static v8::MaybeLocal<v8::Object> GetDetails(
       Environment* env,
       const PerformanceEntry<GCPerformanceEntryTraits>& entry);
+
+  static void Pack(const PerformanceEntry<GCPerformanceEntryTraits>& entry,
+                   double* details) {
+    details[0] = entry.details.kind;
+    details[1] = entry.details.flags;
+  }
 };
 
 using GCPerformanceEntry = PerformanceEntry<GCPerformanceEntryTraits>;
 
+inline const char* GetPerformanceLoopPhaseName(PerformanceLoopPhase phase) {
+  switch (phase) {
+#define V(name, label) case NODE_PERFORMANCE_LOOP_PHASE_##name: return label;
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+    default:
+      UNREACHABLE();
+  }
+}
+
+// Histograms of the duration of each event loop phase and of the time
+// ThreadPoolWork spends queued and running, in nanoseconds, plus the number
+// of callbacks into JS per phase. Fed by the LoopPhaseTracker of the
+// Environment while enabled.
+class EventLoopPhaseMonitor final : public BaseObject {
+ public:
+  enum HistogramIndex {
+    kThreadPoolWait = NODE_PERFORMANCE_LOOP_PHASE_INVALID,
+    kThreadPoolRun,
+    kHistogramCount
+  };
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  EventLoopPhaseMonitor(Environment* env, v8::Local<v8::Object> wrap);
+  ~EventLoopPhaseMonitor() override;
+
+  void RecordPhase(PerformanceLoopPhase phase, uint64_t duration);
+  void CountCallback(PerformanceLoopPhase phase) { callbacks_[phase]++; }
+  void RecordThreadPoolWork(uint64_t wait, uint64_t run);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(EventLoopPhaseMonitor)
+  SET_SELF_SIZE(EventLoopPhaseMonitor)
+
+ private:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Returns the histograms, ordered by HistogramIndex.
+  static void GetHistograms(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Returns the callback counts, ordered by PerformanceLoopPhase.
+  static void GetCallbackCounts(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ResetCallbackCounts(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  bool enabled_ = false;
+  std::shared_ptr<Histogram> histograms_[kHistogramCount];
+  double callbacks_[NODE_PERFORMANCE_LOOP_PHASE_INVALID] = {};
+};
+
 }  // namespace performance
 }  // namespace node
 
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace node {
 namespace performance {
@@ -38,6 +39,15 @@ extern uint64_t performance_v8_start;
   V(NET, "net")                                                               \
   V(DNS, "dns")
 
+// The phases of the event loop that are measured by an
+// EventLoopPhaseMonitor. `close` also covers the callbacks libuv deferred to
+// the next iteration and runs between the check and the timers phases.
+#define NODE_PERFORMANCE_LOOP_PHASES(V)                                       \
+  V(TIMERS, "timers")                                                         \
+  V(POLL, "poll")                                                             \
+  V(CHECK, "check")                                                           \
+  V(CLOSE, "close")
+
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
   NODE_PERFORMANCE_MILESTONES(V)
@@ -52,6 +62,118 @@ enum PerformanceEntryType {
   NODE_PERFORMANCE_ENTRY_TYPE_INVALID
 };
 
+enum PerformanceLoopPhase {
+#define V(name, _) NODE_PERFORMANCE_LOOP_PHASE_##name,
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+  NODE_PERFORMANCE_LOOP_PHASE_INVALID
+};
+
+// The layout of an entry in a PerformanceEntryBuffer, in doubles.
+enum PerformanceEntryField {
+  NODE_PERFORMANCE_ENTRY_FIELD_TYPE,
+  NODE_PERFORMANCE_ENTRY_FIELD_START_TIME,
+  NODE_PERFORMANCE_ENTRY_FIELD_DURATION,
+  NODE_PERFORMANCE_ENTRY_FIELD_DETAILS,
+  NODE_PERFORMANCE_ENTRY_FIELD_COUNT = NODE_PERFORMANCE_ENTRY_FIELD_DETAILS + 2
+};
+
+// Performance entries created by native code that have not been delivered
+// to the observers yet, packed into a ring buffer of doubles. Entries are
+// delivered to JS in batches, as a Float64Array, by one callback per turn of
+// the event loop. Both sides run on the thread of the Environment, so no
+// locking is needed. When the ring is full the oldest entries are moved to a
+// growable overflow area, so entries are never dropped.
+class PerformanceEntryBuffer {
+ public:
+  static constexpr size_t kCapacity = 256;
+
+  // Returns the NODE_PERFORMANCE_ENTRY_FIELD_COUNT values of a new entry.
+  double* Push();
+  // Copies the `count` oldest entries to `out` and removes them.
+  void Take(double* out, size_t count);
+
+  size_t size() const {
+    return spilled_.size() / NODE_PERFORMANCE_ENTRY_FIELD_COUNT +
+           static_cast<size_t>(write_ - read_);
+  }
+
+  bool flush_scheduled = false;
+
+ private:
+  double* Entry(uint64_t index) {
+    return ring_.data() +
+           (index % kCapacity) * NODE_PERFORMANCE_ENTRY_FIELD_COUNT;
+  }
+
+  std::vector<double> ring_;
+  uint64_t read_ = 0;
+  uint64_t write_ = 0;
+  std::vector<double> spilled_;
+};
+
+class EventLoopPhaseMonitor;
+
+// Follows the event loop through its phases on behalf of the
+// EventLoopPhaseMonitors that are enabled, and forwards the duration of each
+// phase, the callbacks into JS and the ThreadPoolWork timings to them. The
+// Environment calls the hooks from the handles it registers with libuv, so
+// libuv itself is not instrumented:
+//
+// - timers and check are the time spent in RunTimers() and CheckImmediate().
+// - poll runs from the prepare to the check handle of the Environment, minus
+//   the time libuv spent blocked waiting for events.
+// - close runs from the end of the check phase to the next poll phase, minus
+//   the time spent in timers.
+//
+// All hooks run on the thread of the Environment. They do nothing but check
+// enabled() while no monitor is enabled.
+class LoopPhaseTracker {
+ public:
+  bool enabled() const { return !monitors_.empty(); }
+
+  void AddMonitor(EventLoopPhaseMonitor* monitor);
+  void RemoveMonitor(EventLoopPhaseMonitor* monitor);
+
+  void EnterPhase(PerformanceLoopPhase phase);
+  void LeavePhase(PerformanceLoopPhase phase);
+  void BeforePoll(uv_loop_t* loop);
+  void AfterPoll(uv_loop_t* loop);
+  // Counts a call from the event loop into JS in the current phase.
+  void CountCallback();
+  void RecordThreadPoolWork(uint64_t wait, uint64_t run);
+
+ private:
+  void Record(PerformanceLoopPhase phase, uint64_t duration);
+
+  std::vector<EventLoopPhaseMonitor*> monitors_;
+  PerformanceLoopPhase phase_ = NODE_PERFORMANCE_LOOP_PHASE_INVALID;
+  PerformanceLoopPhase outer_phase_ = NODE_PERFORMANCE_LOOP_PHASE_INVALID;
+  uint64_t phase_start_ = 0;
+  uint64_t close_start_ = 0;
+  uint64_t close_excluded_ = 0;
+  uint64_t poll_idle_start_ = 0;
+};
+
+// Measures a timers or check phase, if a monitor is enabled when it starts.
+class LoopPhaseScope {
+ public:
+  LoopPhaseScope(LoopPhaseTracker* tracker, PerformanceLoopPhase phase)
+      : tracker_(tracker->enabled() ? tracker : nullptr), phase_(phase) {
+    if (tracker_ != nullptr) tracker_->EnterPhase(phase_);
+  }
+  ~LoopPhaseScope() {
+    if (tracker_ != nullptr) tracker_->LeavePhase(phase_);
+  }
+
+  LoopPhaseScope(const LoopPhaseScope&) = delete;
+  LoopPhaseScope& operator=(const LoopPhaseScope&) = delete;
+
+ private:
+  LoopPhaseTracker* tracker_;
+  PerformanceLoopPhase phase_;
+};
+
 class PerformanceState {
  public:
   struct SerializeInfo {
@@ -73,6 +195,9 @@ class PerformanceState {
   uint64_t performance_last_gc_start_mark = 0;
   uint16_t current_gc_type = 0;
 
+  PerformanceEntryBuffer entry_buffer;
+  LoopPhaseTracker loop_phases;
+
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
 
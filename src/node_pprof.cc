@@ -0,0 +1,242 @@
+#include "node_pprof.h"
+#include "async_wrap-inl.h"
+#include "base_object-inl.h"
+#include "diagnosticfilename-inl.h"
+#include "env-inl.h"
+#include "node_buffer.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cstring>
+#include <utility>
+
+namespace node {
+namespace pprof {
+
+using v8::Context;
+using v8::Function;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::String;
+using v8::Undefined;
+using v8::Value;
+
+namespace {
+
+// Minimal protobuf encoding for the profile.proto messages.
+void AppendVarint(std::string* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendInt(std::string* out, uint32_t field, int64_t value) {
+  AppendVarint(out, field << 3);
+  AppendVarint(out, static_cast<uint64_t>(value));
+}
+
+void AppendBytes(std::string* out, uint32_t field, const std::string& bytes) {
+  AppendVarint(out, (field << 3) | 2);
+  AppendVarint(out, bytes.size());
+  out->append(bytes);
+}
+
+}  // namespace
+
+ProfileBuilder::ProfileBuilder(std::vector<ValueType> sample_types,
+                               ValueType period_type,
+                               int64_t period)
+    : sample_types_(std::move(sample_types)),
+      period_type_(period_type),
+      period_(period) {
+  // The first entry of the string table must be the empty string.
+  Intern("");
+}
+
+int64_t ProfileBuilder::Intern(const std::string& str) {
+  auto it = string_index_.emplace(str, strings_.size());
+  if (it.second) strings_.push_back(str);
+  return it.first->second;
+}
+
+uint64_t ProfileBuilder::Location(int64_t name,
+                                  int64_t filename,
+                                  int line,
+                                  int column) {
+  // Ids start at 1, 0 is reserved.
+  auto it = functions_.emplace(FunctionKey(name, filename, line, column),
+                               functions_.size() + 1);
+  return it.first->second;
+}
+
+void ProfileBuilder::AddSample(const std::vector<uint64_t>& stack,
+                               const int64_t* values) {
+  std::string key(reinterpret_cast<const char*>(stack.data()),
+                  stack.size() * sizeof(stack[0]));
+  auto it = sample_index_.emplace(std::move(key), samples_.size());
+  if (it.second) {
+    samples_.push_back({stack, std::vector<int64_t>(sample_types_.size())});
+  }
+  std::vector<int64_t>& sample_values = samples_[it.first->second].values;
+  for (size_t i = 0; i < sample_values.size(); i++)
+    sample_values[i] += values[i];
+}
+
+void ProfileBuilder::SetTime(int64_t time_ns, int64_t duration_ns) {
+  time_ns_ = time_ns;
+  duration_ns_ = duration_ns;
+}
+
+std::string ProfileBuilder::Finish() {
+  std::string out;
+  std::string message;
+  std::string packed;
+
+  auto value_type = [&](const ValueType& type) {
+    std::string value;
+    AppendInt(&value, 1, Intern(type.type));
+    AppendInt(&value, 2, Intern(type.unit));
+    return value;
+  };
+  // sample_type
+  for (const ValueType& type : sample_types_)
+    AppendBytes(&out, 1, value_type(type));
+
+  // sample
+  for (const Sample& sample : samples_) {
+    message.clear();
+    packed.clear();
+    for (uint64_t location : sample.stack) AppendVarint(&packed, location);
+    AppendBytes(&message, 1, packed);
+    packed.clear();
+    for (int64_t value : sample.values)
+      AppendVarint(&packed, static_cast<uint64_t>(value));
+    AppendBytes(&message, 2, packed);
+    AppendBytes(&out, 2, message);
+  }
+
+  // location and function
+  for (const auto& entry : functions_) {
+    int64_t name = std::get<0>(entry.first);
+    int64_t filename = std::get<1>(entry.first);
+    int line = std::get<2>(entry.first);
+    uint64_t id = entry.second;
+
+    std::string line_message;
+    AppendInt(&line_message, 1, id);
+    AppendInt(&line_message, 2, line);
+    message.clear();
+    AppendInt(&message, 1, id);
+    AppendBytes(&message, 4, line_message);
+    AppendBytes(&out, 4, message);
+
+    message.clear();
+    AppendInt(&message, 1, id);
+    AppendInt(&message, 2, name);
+    AppendInt(&message, 3, name);
+    AppendInt(&message, 4, filename);
+    AppendInt(&message, 5, line);
+    AppendBytes(&out, 5, message);
+  }
+
+  std::string period_type = value_type(period_type_);
+  // string_table
+  for (const std::string& str : strings_) AppendBytes(&out, 6, str);
+  // time_nanos, duration_nanos, period_type, period
+  AppendInt(&out, 9, time_ns_);
+  AppendInt(&out, 10, duration_ns_);
+  AppendBytes(&out, 11, period_type);
+  AppendInt(&out, 12, period_);
+  return out;
+}
+
+std::string Gzip(const std::string& data) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  // 16 + MAX_WBITS selects the gzip format.
+  CHECK_EQ(deflateInit2(&stream,
+                        Z_DEFAULT_COMPRESSION,
+                        Z_DEFLATED,
+                        16 + MAX_WBITS,
+                        8,
+                        Z_DEFAULT_STRATEGY),
+           Z_OK);
+  std::string out(deflateBound(&stream, data.size()), '\0');
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  stream.avail_out = out.size();
+  CHECK_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+int64_t WallTimeNs() {
+  uv_timeval64_t tv;
+  if (uv_gettimeofday(&tv) != 0) return 0;
+  return tv.tv_sec * 1000000000LL + tv.tv_usec * 1000LL;
+}
+
+std::string OutputFilename(Environment* env,
+                           Local<Value> filename,
+                           const char* prefix,
+                           bool compress) {
+  if (filename->IsTrue()) {
+    DiagnosticFilename name(env, prefix, compress ? "pb.gz" : "pb");
+    return *name;
+  }
+  if (filename->IsUndefined()) return std::string();
+  BufferValue path(env->isolate(), filename);
+  CHECK_NOT_NULL(*path);
+  return path.ToString();
+}
+
+EncodeJob::EncodeJob(AsyncWrap* wrap,
+                     const char* type,
+                     bool compress,
+                     std::string filename,
+                     Local<Function> callback)
+    : ThreadPoolWork(wrap->env(), type),
+      wrap_(wrap),
+      compress_(compress),
+      filename_(std::move(filename)),
+      callback_(wrap->env()->isolate(), callback) {}
+
+void EncodeJob::DoThreadPoolWork() {
+  data_ = Encode();
+  if (compress_) data_ = Gzip(data_);
+  if (!filename_.empty()) {
+    err_ = WriteFileSync(filename_.c_str(),
+                         uv_buf_init(&data_[0], data_.size()));
+  }
+}
+
+void EncodeJob::AfterThreadPoolWork(int status) {
+  std::unique_ptr<EncodeJob> self(this);
+  Environment* env = wrap_->env();
+  if (!env->can_call_into_js()) return;
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  Local<Value> argv[] = {Undefined(isolate), Undefined(isolate)};
+  if (!filename_.empty()) {
+    if (err_ < 0) argv[0] = Integer::New(isolate, err_);
+    if (!String::NewFromUtf8(isolate, filename_.c_str()).ToLocal(&argv[1]))
+      return;
+  } else if (!Buffer::Copy(env, data_.data(), data_.size())
+                  .ToLocal(&argv[1])) {
+    return;
+  }
+  wrap_->MakeCallback(callback_.Get(isolate), arraysize(argv), argv);
+}
+
+}  // namespace pprof
+}  // namespace node
@@ -0,0 +1,113 @@
+#ifndef SRC_NODE_PPROF_H_
+#define SRC_NODE_PPROF_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "base_object.h"
+#include "node_internals.h"
+#include "v8.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+namespace pprof {
+
+struct ValueType {
+  const char* type;
+  const char* unit;
+};
+
+// Builds a Profile message of the pprof format (profile.proto). Strings and
+// functions are interned, there is one location per function, and samples
+// with the same stack are merged by adding up their values. Does not touch
+// V8, so it can be used off the main thread.
+class ProfileBuilder {
+ public:
+  ProfileBuilder(std::vector<ValueType> sample_types,
+                 ValueType period_type,
+                 int64_t period);
+
+  ProfileBuilder(const ProfileBuilder&) = delete;
+  ProfileBuilder& operator=(const ProfileBuilder&) = delete;
+
+  int64_t Intern(const std::string& str);
+  // Returns the id of the location of a function.
+  uint64_t Location(int64_t name, int64_t filename, int line, int column);
+  // `stack` starts at the leaf, `values` has one entry per sample type.
+  void AddSample(const std::vector<uint64_t>& stack, const int64_t* values);
+  void SetTime(int64_t time_ns, int64_t duration_ns);
+
+  std::string Finish();
+
+ private:
+  struct Sample {
+    std::vector<uint64_t> stack;
+    std::vector<int64_t> values;
+  };
+  using FunctionKey = std::tuple<int64_t, int64_t, int, int>;
+
+  const std::vector<ValueType> sample_types_;
+  const ValueType period_type_;
+  const int64_t period_;
+  int64_t time_ns_ = 0;
+  int64_t duration_ns_ = 0;
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, int64_t> string_index_;
+  std::map<FunctionKey, uint64_t> functions_;
+  std::vector<Sample> samples_;
+  std::unordered_map<std::string, size_t> sample_index_;
+};
+
+// Compresses `data` in the gzip format, as pprof files usually are.
+std::string Gzip(const std::string& data);
+
+// The wall clock time in nanoseconds since the epoch, as pprof expects it.
+int64_t WallTimeNs();
+
+// The file that a profile is written to, from the `filename` argument of
+// takeProfile(): a path, `true` for a generated name, or undefined for none,
+// in which case the returned string is empty.
+std::string OutputFilename(Environment* env,
+                           v8::Local<v8::Value> filename,
+                           const char* prefix,
+                           bool compress);
+
+// Encodes a profile on the threadpool, compresses it and writes it to a file
+// there if asked to. `callback` is then called on `wrap` with (err, filename)
+// if a file was written, and with (undefined, buffer) otherwise.
+class EncodeJob : public ThreadPoolWork {
+ public:
+  EncodeJob(AsyncWrap* wrap,
+            const char* type,
+            bool compress,
+            std::string filename,
+            v8::Local<v8::Function> callback);
+
+  void DoThreadPoolWork() final;
+  void AfterThreadPoolWork(int status) final;
+
+ protected:
+  // Called on the threadpool, returns the uncompressed profile.
+  virtual std::string Encode() = 0;
+
+ private:
+  BaseObjectPtr<AsyncWrap> wrap_;
+  const bool compress_;
+  const std::string filename_;
+  v8::Global<v8::Function> callback_;
+  std::string data_;
+  int err_ = 0;
+};
+
+}  // namespace pprof
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_PPROF_H_
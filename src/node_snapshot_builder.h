@@ -10,7 +10,9 @@
 
 namespace node {
 
+class Environment;
 class ExternalReferenceRegistry;
+class IsolateData;
 struct SnapshotData;
 
 class NODE_EXTERN_PRIVATE SnapshotBuilder {
@@ -24,15 +26,24 @@ class NODE_EXTERN_PRIVATE SnapshotBuilder {
                       const std::vector<std::string> args,
                       const std::vector<std::string> exec_args);
 
+  // Serialize an Environment that has been bootstrapped in an isolate owned
+  // by |creator| into out. Used both by Generate() and by embedders through
+  // CommonEnvironmentSetup::CreateSnapshot().
+  static int CreateSnapshot(SnapshotData* out,
+                            v8::SnapshotCreator* creator,
+                            IsolateData* isolate_data,
+                            Environment* env,
+                            /* SnapshotMetadata::Type */ uint8_t snapshot_type);
+
   // If nullptr is returned, the binary is not built with embedded
   // snapshot.
   static const SnapshotData* GetEmbeddedSnapshotData();
   static void InitializeIsolateParams(const SnapshotData* data,
                                       v8::Isolate::CreateParams* params);
 
- private:
   static const std::vector<intptr_t>& CollectExternalReferences();
 
+ private:
   static std::unique_ptr<ExternalReferenceRegistry> registry_;
 };
 }  // namespace node
@@ -22,6 +22,7 @@
 #include "node_util.h"
 #include "node_v8.h"
 #include "node_v8_platform-inl.h"
+#include "timers.h"
 
 #if HAVE_INSPECTOR
 #include "inspector/worker_inspector.h"  // ParentInspectorHandle
@@ -1131,7 +1132,7 @@ int SnapshotBuilder::Generate(SnapshotData* out,
 
   // It's only possible to be kDefault in node_mksnapshot.
   SnapshotMetadata::Type snapshot_type =
-      per_process::cli_options->build_snapshot
+      per_process::cli_options->per_isolate->build_snapshot
           ? SnapshotMetadata::Type::kFullyCustomized
           : SnapshotMetadata::Type::kDefault;
 
@@ -1146,31 +1147,6 @@ int SnapshotBuilder::Generate(SnapshotData* out,
       }
     });
 
-    // The default context with only things created by V8.
-    Local<Context> default_context = Context::New(isolate);
-
-    // The context used by the vm module.
-    Local<Context> vm_context;
-    {
-      Local<ObjectTemplate> global_template =
-          main_instance->isolate_data()->contextify_global_template();
-      CHECK(!global_template.IsEmpty());
-      if (!contextify::ContextifyContext::CreateV8Context(
-               isolate, global_template, nullptr, nullptr)
-               .ToLocal(&vm_context)) {
-        return SNAPSHOT_ERROR;
-      }
-    }
-
-    // The Node.js-specific context with primodials, can be used by workers
-    // TODO(joyeecheung): investigate if this can be used by vm contexts
-    // without breaking compatibility.
-    Local<Context> base_context = NewContext(isolate);
-    if (base_context.IsEmpty()) {
-      return BOOTSTRAP_ERROR;
-    }
-    ResetContextSettingsBeforeSnapshot(base_context);
-
     Local<Context> main_context = NewContext(isolate);
     if (main_context.IsEmpty()) {
       return BOOTSTRAP_ERROR;
@@ -1218,6 +1194,61 @@ int SnapshotBuilder::Generate(SnapshotData* out,
           return exit_code;
         }
       }
+    }
+  }
+
+  return CreateSnapshot(out,
+                        &creator,
+                        main_instance->isolate_data(),
+                        env,
+                        static_cast<uint8_t>(snapshot_type));
+}
+
+int SnapshotBuilder::CreateSnapshot(SnapshotData* out,
+                                    SnapshotCreator* creator,
+                                    IsolateData* isolate_data,
+                                    Environment* env,
+                                    uint8_t snapshot_type) {
+  Isolate* isolate = env->isolate();
+  {
+    HandleScope scope(isolate);
+    TryCatch bootstrapCatch(isolate);
+
+    auto print_Exception = OnScopeLeave([&]() {
+      if (bootstrapCatch.HasCaught()) {
+        PrintCaughtException(
+            isolate, isolate->GetCurrentContext(), bootstrapCatch);
+      }
+    });
+
+    // The default context with only things created by V8.
+    Local<Context> default_context = Context::New(isolate);
+
+    // The context used by the vm module.
+    Local<Context> vm_context;
+    {
+      Local<ObjectTemplate> global_template =
+          isolate_data->contextify_global_template();
+      CHECK(!global_template.IsEmpty());
+      if (!contextify::ContextifyContext::CreateV8Context(
+               isolate, global_template, nullptr, nullptr)
+               .ToLocal(&vm_context)) {
+        return SNAPSHOT_ERROR;
+      }
+    }
+
+    // The Node.js-specific context with primodials, can be used by workers
+    // TODO(joyeecheung): investigate if this can be used by vm contexts
+    // without breaking compatibility.
+    Local<Context> base_context = NewContext(isolate);
+    if (base_context.IsEmpty()) {
+      return BOOTSTRAP_ERROR;
+    }
+    ResetContextSettingsBeforeSnapshot(base_context);
+
+    Local<Context> main_context = env->context();
+    {
+      Context::Scope context_scope(main_context);
 
       if (per_process::enabled_debug_list.enabled(DebugCategory::MKSNAPSHOT)) {
         env->ForEachRealm([](Realm* realm) { realm->PrintInfoForSnapshot(); });
@@ -1225,9 +1256,8 @@ int SnapshotBuilder::Generate(SnapshotData* out,
       }
 
       // Serialize the native states
-      out->isolate_data_info =
-          main_instance->isolate_data()->Serialize(&creator);
-      out->env_info = env->Serialize(&creator);
+      out->isolate_data_info = isolate_data->Serialize(creator);
+      out->env_info = env->Serialize(creator);
 
 #ifdef NODE_USE_NODE_CODE_CACHE
       // Regenerate all the code cache.
@@ -1250,19 +1280,19 @@ int SnapshotBuilder::Generate(SnapshotData* out,
     // Global handles to the contexts can't be disposed before the
     // blob is created. So initialize all the contexts before adding them.
     // TODO(joyeecheung): figure out how to remove this restriction.
-    creator.SetDefaultContext(default_context);
-    size_t index = creator.AddContext(vm_context);
+    creator->SetDefaultContext(default_context);
+    size_t index = creator->AddContext(vm_context);
     CHECK_EQ(index, SnapshotData::kNodeVMContextIndex);
-    index = creator.AddContext(base_context);
+    index = creator->AddContext(base_context);
     CHECK_EQ(index, SnapshotData::kNodeBaseContextIndex);
-    index = creator.AddContext(main_context,
-                               {SerializeNodeContextInternalFields, env});
+    index = creator->AddContext(main_context,
+                                {SerializeNodeContextInternalFields, env});
     CHECK_EQ(index, SnapshotData::kNodeMainContextIndex);
   }
 
   // Must be out of HandleScope
   out->v8_snapshot_blob_data =
-      creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kKeep);
+      creator->CreateBlob(SnapshotCreator::FunctionCodeHandling::kKeep);
 
   // We must be able to rehash the blob when we restore it or otherwise
   // the hash seed would be fixed by V8, introducing a vulnerability.
@@ -1270,11 +1300,12 @@ int SnapshotBuilder::Generate(SnapshotData* out,
     return SNAPSHOT_ERROR;
   }
 
-  out->metadata = SnapshotMetadata{snapshot_type,
-                                   per_process::metadata.versions.node,
-                                   per_process::metadata.arch,
-                                   per_process::metadata.platform,
-                                   v8::ScriptCompiler::CachedDataVersionTag()};
+  out->metadata =
+      SnapshotMetadata{static_cast<SnapshotMetadata::Type>(snapshot_type),
+                       per_process::metadata.versions.node,
+                       per_process::metadata.arch,
+                       per_process::metadata.platform,
+                       v8::ScriptCompiler::CachedDataVersionTag()};
 
   // We cannot resurrect the handles from the snapshot, so make sure that
   // no handles are left open in the environment after the blob is created
@@ -25,7 +25,9 @@
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
 #include "node.h"
+#include "node_cpu_profiler.h"
 #include "node_external_reference.h"
+#include "node_heap_profiler.h"
 #include "util-inl.h"
 #include "v8.h"
 
@@ -462,6 +464,9 @@ void Initialize(Local<Object> target,
   SetProtoMethod(env->isolate(), t, "start", GCProfiler::Start);
   SetProtoMethod(env->isolate(), t, "stop", GCProfiler::Stop);
   SetConstructorFunction(context, target, "GCProfiler", t);
+
+  ContinuousCpuProfiler::Initialize(env, target);
+  ContinuousHeapProfiler::Initialize(env, target);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -474,6 +479,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GCProfiler::New);
   registry->Register(GCProfiler::Start);
   registry->Register(GCProfiler::Stop);
+  ContinuousCpuProfiler::RegisterExternalReferences(registry);
+  ContinuousHeapProfiler::RegisterExternalReferences(registry);
 }
 
 }  // namespace v8_utils
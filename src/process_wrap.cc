@@ -24,13 +24,25 @@
 #include "stream_wrap.h"
 #include "util-inl.h"
 
+#include <atomic>
 #include <climits>
 #include <cstdlib>
 #include <cstring>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
 namespace node {
 
 using v8::Array;
+using v8::BackingStore;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -41,7 +53,9 @@ using v8::Isolate;
 using v8::Local;
 using v8::Number;
 using v8::Object;
+using v8::SharedArrayBuffer;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace {
@@ -64,6 +78,9 @@ class ProcessWrap : public HandleWrap {
     SetProtoMethod(isolate, constructor, "kill", Kill);
 
     SetConstructorFunction(context, target, "Process", constructor);
+
+    SetMethod(context, target, "createSharedMemory", CreateSharedMemory);
+    SetMethod(context, target, "mapSharedMemory", MapSharedMemory);
   }
 
   SET_NO_MEMORY_INFO()
@@ -306,6 +323,76 @@ class ProcessWrap : public HandleWrap {
     args.GetReturnValue().Set(err);
   }
 
+  // Creates an anonymous shared memory object of args[0] bytes, used as the
+  // transport of IPC channels with `ipcTransport: 'shared-memory'`. Returns
+  // a file descriptor or a negative libuv error code.
+  static void CreateSharedMemory(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args[0]->IsUint32());
+#ifdef _WIN32
+    args.GetReturnValue().Set(UV_ENOSYS);
+#else
+    const size_t size = args[0].As<Uint32>()->Value();
+    int fd = -1;
+#if defined(__linux__) && defined(SYS_memfd_create)
+    fd = static_cast<int>(
+        syscall(SYS_memfd_create, "node-ipc", 1 /* MFD_CLOEXEC */));
+#endif
+#ifndef __ANDROID__
+    if (fd == -1) {
+      static std::atomic<unsigned int> counter{0};
+      char name[64];
+      snprintf(name,
+               sizeof(name),
+               "/node-ipc-%d-%u",
+               uv_os_getpid(),
+               counter++);
+      fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+      if (fd != -1) shm_unlink(name);
+    }
+#endif
+    if (fd == -1)
+      return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+    if (ftruncate(fd, size) != 0) {
+      const int err = uv_translate_sys_error(errno);
+      ::close(fd);
+      return args.GetReturnValue().Set(err);
+    }
+    args.GetReturnValue().Set(fd);
+#endif
+  }
+
+  // Maps the whole shared memory object behind the file descriptor args[0]
+  // into a SharedArrayBuffer. Returns a negative libuv error code on failure.
+  // The file descriptor can be closed afterwards.
+  static void MapSharedMemory(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args[0]->IsInt32());
+#ifdef _WIN32
+    args.GetReturnValue().Set(UV_ENOSYS);
+#else
+    Environment* env = Environment::GetCurrent(args);
+    const int fd = args[0].As<Int32>()->Value();
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+      return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+    const size_t size = static_cast<size_t>(st.st_size);
+    if (size == 0) return args.GetReturnValue().Set(UV_EINVAL);
+    void* data =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+      return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+
+    std::unique_ptr<BackingStore> store = SharedArrayBuffer::NewBackingStore(
+        data,
+        size,
+        [](void* data, size_t length, void* deleter_data) {
+          munmap(data, length);
+        },
+        nullptr);
+    args.GetReturnValue().Set(
+        SharedArrayBuffer::New(env->isolate(), std::move(store)));
+#endif
+  }
+
   static void OnExit(uv_process_t* handle,
                      int64_t exit_status,
                      int term_signal) {
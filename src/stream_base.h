@@ -298,6 +298,9 @@ class StreamResource {
   uint64_t bytes_written_ = 0;
 
   friend class StreamListener;
+  // Counts the bytes it moves with splice(2), which bypasses EmitRead() and
+  // Write().
+  friend class StreamPipe;
 };
 
 
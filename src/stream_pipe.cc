@@ -1,8 +1,14 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
+#include "stream_wrap.h"
 #include "node_buffer.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 
 using v8::BackingStore;
@@ -11,6 +17,7 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Integer;
 using v8::Isolate;
 using v8::Just;
 using v8::Local;
@@ -36,6 +43,7 @@ StreamPipe::StreamPipe(StreamBase* source,
 
 StreamPipe::~StreamPipe() {
   Unpipe(true);
+  CloseSplicePipe();
 }
 
 StreamBase* StreamPipe::source() {
@@ -61,6 +69,7 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
   source()->RemoveStreamListener(&readable_listener_);
   if (pending_writes_ == 0)
     sink()->RemoveStreamListener(&writable_listener_);
+  CloseSplicePipe();
 
   if (is_in_deletion) return;
 
@@ -76,8 +85,11 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
     Local<Value> onunpipe;
     if (!object->Get(env->context(), env->onunpipe_string()).ToLocal(&onunpipe))
       return;
+    Local<Value> argv[] = { Integer::New(env->isolate(), splice_error_) };
     if (onunpipe->IsFunction() &&
-        MakeCallback(onunpipe.As<Function>(), 0, nullptr).IsEmpty()) {
+        MakeCallback(onunpipe.As<Function>(),
+                     splice_error_ != 0 ? arraysize(argv) : 0,
+                     argv).IsEmpty()) {
       return;
     }
 
@@ -107,6 +119,10 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
 
 uv_buf_t StreamPipe::ReadableListener::OnStreamAlloc(size_t suggested_size) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::readable_listener_, this);
+  // An empty buffer makes libuv report UV_ENOBUFS instead of reading, which
+  // tells us that the source is readable without consuming any data.
+  if (pipe->uses_splice())
+    return uv_buf_init(nullptr, 0);
   size_t size = std::min(suggested_size, pipe->wanted_data_);
   CHECK_GT(size, 0);
   return pipe->env()->allocate_managed_buffer(size);
@@ -115,6 +131,10 @@ uv_buf_t StreamPipe::ReadableListener::OnStreamAlloc(size_t suggested_size) {
 void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
                                                 const uv_buf_t& buf_) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::readable_listener_, this);
+  if (nread == UV_ENOBUFS && pipe->uses_splice()) {
+    pipe->SpliceData();
+    return;
+  }
   std::unique_ptr<BackingStore> bs = pipe->env()->release_managed_buffer(buf_);
   if (nread < 0) {
     // EOF or error; stop reading and pass the error to the previous listener
@@ -154,6 +174,139 @@ void StreamPipe::ProcessData(size_t nread,
   }
 }
 
+void StreamPipe::MaybeEnableSplice(Local<Object> source_obj,
+                                   Local<Object> sink_obj) {
+#ifdef __linux__
+  Local<FunctionTemplate> sw = env()->libuv_stream_wrap_ctor_template();
+  if (sw.IsEmpty() || !sw->HasInstance(source_obj) ||
+      !sw->HasInstance(sink_obj)) {
+    return;
+  }
+
+  LibuvStreamWrap* source = Unwrap<LibuvStreamWrap>(source_obj);
+  LibuvStreamWrap* sink = Unwrap<LibuvStreamWrap>(sink_obj);
+  if (source == nullptr || sink == nullptr ||
+      source->stream() == nullptr || sink->stream() == nullptr ||
+      source->is_named_pipe_ipc() || sink->is_named_pipe_ipc()) {
+    return;
+  }
+
+  uv_os_fd_t source_fd;
+  uv_os_fd_t sink_fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(source->stream()),
+                &source_fd) != 0 ||
+      uv_fileno(reinterpret_cast<uv_handle_t*>(sink->stream()),
+                &sink_fd) != 0) {
+    return;
+  }
+
+  int fds[2];
+  if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0)
+    return;
+
+  splice_fds_[0] = fds[0];
+  splice_fds_[1] = fds[1];
+  splice_source_fd_ = source_fd;
+  splice_sink_fd_ = sink_fd;
+  splice_sink_stream_ = sink->stream();
+#endif  // __linux__
+}
+
+void StreamPipe::CloseSplicePipe() {
+#ifdef __linux__
+  for (int& fd : splice_fds_) {
+    if (fd != -1) {
+      close(fd);
+      fd = -1;
+    }
+  }
+  splice_pending_ = 0;
+#endif  // __linux__
+}
+
+void StreamPipe::SpliceData() {
+#ifdef __linux__
+  // The kernel pipe holds at most this much, so move data in chunks of that
+  // size, and yield to the event loop after a few of them.
+  static constexpr size_t kSpliceChunkSize = 64 * 1024;
+  static constexpr size_t kSpliceBudget = 16 * kSpliceChunkSize;
+
+  for (size_t moved = 0; moved < kSpliceBudget;) {
+    CHECK_EQ(splice_pending_, 0);
+    ssize_t n;
+    do {
+      n = splice(splice_source_fd_, nullptr, splice_fds_[1], nullptr,
+                 kSpliceChunkSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    } while (n == -1 && errno == EINTR);
+
+    if (n == 0) {
+      readable_listener_.OnStreamRead(UV_EOF, uv_buf_init(nullptr, 0));
+      return;
+    }
+    if (n < 0) {
+      if (errno == EAGAIN)
+        return;
+      readable_listener_.OnStreamRead(-errno, uv_buf_init(nullptr, 0));
+      return;
+    }
+
+    moved += n;
+    source()->bytes_read_ += n;
+    splice_pending_ = n;
+    if (!FlushSplicePipe())
+      return;
+  }
+#endif  // __linux__
+}
+
+bool StreamPipe::FlushSplicePipe() {
+#ifdef __linux__
+  while (splice_pending_ > 0) {
+    // Data that was queued on the sink by other means has to go first.
+    if (uv_stream_get_write_queue_size(splice_sink_stream_) > 0) {
+      WriteSplicePipe();
+      return false;
+    }
+
+    ssize_t n;
+    do {
+      n = splice(splice_fds_[0], nullptr, splice_sink_fd_, nullptr,
+                 splice_pending_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    } while (n == -1 && errno == EINTR);
+
+    if (n < 0) {
+      if (errno == EAGAIN) {
+        // The sink is full. Hand what is left to a regular write, which
+        // stops reading until it is done and so applies backpressure.
+        WriteSplicePipe();
+      } else {
+        splice_error_ = -errno;
+        is_eof_ = true;
+        Unpipe();
+      }
+      return false;
+    }
+
+    splice_pending_ -= n;
+    sink()->bytes_written_ += n;
+  }
+#endif  // __linux__
+  return true;
+}
+
+void StreamPipe::WriteSplicePipe() {
+#ifdef __linux__
+  uv_buf_t buf = env()->allocate_managed_buffer(splice_pending_);
+  ssize_t n;
+  do {
+    n = read(splice_fds_[0], buf.base, buf.len);
+  } while (n == -1 && errno == EINTR);
+  CHECK_EQ(n, static_cast<ssize_t>(splice_pending_));
+  splice_pending_ = 0;
+  ProcessData(n, env()->release_managed_buffer(buf));
+#endif  // __linux__
+}
+
 void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
                                                       int status) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
@@ -279,7 +432,10 @@ void StreamPipe::New(const FunctionCallbackInfo<Value>& args) {
   StreamBase* source = StreamBase::FromObject(args[0].As<Object>());
   StreamBase* sink = StreamBase::FromObject(args[1].As<Object>());
 
-  if (StreamPipe::New(source, sink, args.This()).IsNothing()) return;
+  StreamPipe* pipe;
+  if (!StreamPipe::New(source, sink, args.This()).To(&pipe)) return;
+  if (args[2]->IsTrue())
+    pipe->MaybeEnableSplice(args[0].As<Object>(), args[1].As<Object>());
 }
 
 void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
@@ -307,6 +463,12 @@ void StreamPipe::PendingWrites(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(pipe->pending_writes_);
 }
 
+void StreamPipe::UsesSplice(const FunctionCallbackInfo<Value>& args) {
+  StreamPipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  args.GetReturnValue().Set(pipe->uses_splice());
+}
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -322,6 +484,7 @@ void InitializeStreamPipe(Local<Object> target,
   SetProtoMethod(isolate, pipe, "start", StreamPipe::Start);
   SetProtoMethod(isolate, pipe, "isClosed", StreamPipe::IsClosed);
   SetProtoMethod(isolate, pipe, "pendingWrites", StreamPipe::PendingWrites);
+  SetProtoMethod(isolate, pipe, "usesSplice", StreamPipe::UsesSplice);
   pipe->Inherit(AsyncWrap::GetConstructorTemplate(env));
   pipe->InstanceTemplate()->SetInternalFieldCount(
       StreamPipe::kInternalFieldCount);
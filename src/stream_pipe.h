@@ -21,6 +21,7 @@ class StreamPipe : public AsyncWrap {
   static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void IsClosed(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void PendingWrites(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void UsesSplice(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(StreamPipe)
@@ -32,6 +33,31 @@ class StreamPipe : public AsyncWrap {
   inline StreamBase* source();
   inline StreamBase* sink();
 
+  // When both ends are TCP or pipe handles, data can be moved between them
+  // with splice(2) through a kernel pipe instead of being read into memory
+  // and written out again. This is only available on Linux.
+  void MaybeEnableSplice(v8::Local<v8::Object> source_obj,
+                         v8::Local<v8::Object> sink_obj);
+  inline bool uses_splice() const { return splice_fds_[0] != -1; }
+  void CloseSplicePipe();
+  // Called when the source is readable. Moves data to the sink until either
+  // side would block.
+  void SpliceData();
+  // Moves the data in the kernel pipe to the sink. Returns false if that
+  // could not be done without blocking, in which case the data has been
+  // handed to a regular, queued write.
+  bool FlushSplicePipe();
+  void WriteSplicePipe();
+
+  int splice_fds_[2] = { -1, -1 };
+  int splice_source_fd_ = -1;
+  int splice_sink_fd_ = -1;
+  uv_stream_t* splice_sink_stream_ = nullptr;
+  // Number of bytes currently held in the kernel pipe.
+  size_t splice_pending_ = 0;
+  // A write error that occurred while splicing, reported to onunpipe.
+  int splice_error_ = 0;
+
   int pending_writes_ = 0;
   bool is_reading_ = false;
   bool is_eof_ = false;
@@ -63,6 +63,17 @@ void IsConstructCallCallback(const FunctionCallbackInfo<Value>& args) {
   StreamReq::ResetObject(args.This());
 }
 
+void GetReadBufferAllocations(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(
+      static_cast<double>(env->read_buffer_allocations()));
+}
+
+void GetReadBufferCopies(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(static_cast<double>(env->read_buffer_copies()));
+}
+
 void LibuvStreamWrap::Initialize(Local<Object> target,
                                  Local<Value> unused,
                                  Local<Context> context,
@@ -104,6 +115,9 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kArrayBufferOffset);
   NODE_DEFINE_CONSTANT(target, kBytesWritten);
   NODE_DEFINE_CONSTANT(target, kLastWriteWasAsync);
+  SetMethod(context, target, "getReadBufferAllocations",
+            GetReadBufferAllocations);
+  SetMethod(context, target, "getReadBufferCopies", GetReadBufferCopies);
   target
       ->Set(context,
             FIXED_ONE_BYTE_STRING(isolate, "streamBaseState"),
@@ -116,6 +130,8 @@ void LibuvStreamWrap::RegisterExternalReferences(
   registry->Register(IsConstructCallCallback);
   registry->Register(GetWriteQueueSize);
   registry->Register(SetBlocking);
+  registry->Register(GetReadBufferAllocations);
+  registry->Register(GetReadBufferCopies);
   StreamBase::RegisterExternalReferences(registry);
 }
 
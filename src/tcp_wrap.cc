@@ -34,6 +34,11 @@
 
 #include <cstdlib>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 
 namespace node {
 
@@ -123,6 +128,7 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, REUSEPORT);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -251,7 +257,7 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
+  if (!args[2]->IsUndefined() &&
       !args[2]->Uint32Value(env->context()).To(&flags)) {
     return;
   }
@@ -259,6 +265,11 @@ void TCPWrap::Bind(
   T addr;
   int err = uv_ip_addr(*ip_address, port, &addr);
 
+  if (err == 0 && (flags & REUSEPORT)) {
+    flags &= ~REUSEPORT;
+    err = wrap->EnableReusePort(family);
+  }
+
   if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
@@ -267,6 +278,43 @@ void TCPWrap::Bind(
   args.GetReturnValue().Set(err);
 }
 
+int TCPWrap::EnableReusePort(int family) {
+  // Other platforms either lack SO_REUSEPORT or do not balance connections
+  // across the sockets that share a port.
+#if defined(__linux__) && defined(SO_REUSEPORT)
+  // libuv creates the socket lazily in uv_tcp_bind(), which is too late to
+  // set the option, so create it here unless the handle already has one.
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd);
+  bool opened = false;
+  if (err == UV_EBADF) {
+    fd = socket(family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) return uv_translate_sys_error(errno);
+    opened = true;
+  } else if (err != 0) {
+    return err;
+  }
+
+  const int on = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) == -1) {
+    err = uv_translate_sys_error(errno);
+    if (opened) ::close(fd);
+    return err;
+  }
+
+  if (opened) {
+    err = uv_tcp_open(&handle_, fd);
+    if (err != 0) {
+      ::close(fd);
+      return err;
+    }
+  }
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
 void TCPWrap::Bind(const FunctionCallbackInfo<Value>& args) {
   Bind<sockaddr_in>(args, AF_INET, uv_ip4_addr);
 }
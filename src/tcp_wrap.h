@@ -39,6 +39,14 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
     SERVER
   };
 
+  // REUSEPORT sets SO_REUSEPORT on the socket before binding it, so that
+  // several listening sockets, possibly owned by different processes, can
+  // share an address and have the kernel balance incoming connections across
+  // them. It is not a libuv flag and is stripped before calling uv_tcp_bind().
+  enum BindFlags : unsigned int {
+    REUSEPORT = 1 << 16
+  };
+
   static v8::MaybeLocal<v8::Object> Instantiate(Environment* env,
                                                 AsyncWrap* parent,
                                                 SocketType type);
@@ -88,6 +96,7 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
       const v8::FunctionCallbackInfo<v8::Value>& args,
       int family,
       std::function<int(const char* ip_address, int port, T* addr)> uv_ip_addr);
+  int EnableReusePort(int family);
   static void Reset(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Reset(v8::Local<v8::Value> close_callback = v8::Local<v8::Value>());
 
@@ -24,6 +24,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "env-inl.h"
 #include "node_internals.h"
 #include "tracing/trace_event.h"
 #include "util-inl.h"
@@ -32,6 +33,9 @@ namespace node {
 
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
+  queued_at_ = env_->performance_state()->loop_phases.enabled() ?
+      uv_hrtime() : 0;
+  started_at_ = 0;
   TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
       TRACING_CATEGORY_NODE2(threadpoolwork, async), type_, this);
   int status = uv_queue_work(
@@ -41,13 +45,20 @@ void ThreadPoolWork::ScheduleWork() {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         TRACE_EVENT_BEGIN0(TRACING_CATEGORY_NODE2(threadpoolwork, sync),
                            self->type_);
+        if (self->queued_at_ != 0) self->started_at_ = uv_hrtime();
         self->DoThreadPoolWork();
+        if (self->queued_at_ != 0) self->finished_at_ = uv_hrtime();
         TRACE_EVENT_END0(TRACING_CATEGORY_NODE2(threadpoolwork, sync),
                          self->type_);
       },
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         self->env_->DecreaseWaitingRequestCounter();
+        if (self->started_at_ != 0) {
+          self->env_->performance_state()->loop_phases.RecordThreadPoolWork(
+              self->started_at_ - self->queued_at_,
+              self->finished_at_ - self->started_at_);
+        }
         TRACE_EVENT_NESTABLE_ASYNC_END1(
             TRACING_CATEGORY_NODE2(threadpoolwork, async),
             self->type_,
@@ -1,3 +1,5 @@
+#include "timers.h"
+#include "base_object-inl.h"
 #include "env-inl.h"
 #include "node_external_reference.h"
 #include "util-inl.h"
@@ -6,15 +8,19 @@
 #include <cstdint>
 
 namespace node {
-namespace {
+namespace timers {
 
+using v8::CFunction;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::Local;
+using v8::Number;
 using v8::Object;
 using v8::Value;
 
+namespace {
+
 void SetupTimers(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsFunction());
   CHECK(args[1]->IsFunction());
@@ -24,11 +30,6 @@ void SetupTimers(const FunctionCallbackInfo<Value>& args) {
   env->set_timers_callback_function(args[1].As<Function>());
 }
 
-void GetLibuvNow(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  args.GetReturnValue().Set(env->GetNow());
-}
-
 void ScheduleTimer(const FunctionCallbackInfo<Value>& args) {
   auto env = Environment::GetCurrent(args);
   env->ScheduleTimer(args[0]->IntegerValue(env->context()).FromJust());
@@ -42,13 +43,81 @@ void ToggleImmediateRef(const FunctionCallbackInfo<Value>& args) {
   Environment::GetCurrent(args)->ToggleImmediateRef(args[0]->IsTrue());
 }
 
+}  // anonymous namespace
+
+BindingData::BindingData(Realm* realm, Local<Object> object)
+    : SnapshotableObject(realm, object, type_int) {}
+
+CFunction BindingData::fast_get_libuv_now_(CFunction::Make(FastGetLibuvNow));
+
+void BindingData::AddMethods() {
+  SetFastMethod(env()->context(),
+                object(),
+                "getLibuvNow",
+                SlowGetLibuvNow,
+                &fast_get_libuv_now_);
+}
+
+void BindingData::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(SlowGetLibuvNow);
+  registry->Register(FastGetLibuvNow);
+  registry->Register(fast_get_libuv_now_.GetTypeInfo());
+}
+
+BindingData* BindingData::FromV8Value(Local<Value> value) {
+  Local<Object> v8_object = value.As<Object>();
+  return static_cast<BindingData*>(
+      v8_object->GetAlignedPointerFromInternalField(BaseObject::kSlot));
+}
+
+double BindingData::GetLibuvNowImpl(BindingData* receiver) {
+  return static_cast<double>(receiver->env()->GetNowUint64());
+}
+
+void BindingData::SlowGetLibuvNow(const FunctionCallbackInfo<Value>& args) {
+  double now = GetLibuvNowImpl(FromJSObject<BindingData>(args.Holder()));
+  args.GetReturnValue().Set(Number::New(args.GetIsolate(), now));
+}
+
+bool BindingData::PrepareForSerialization(Local<Context> context,
+                                          v8::SnapshotCreator* creator) {
+  // Return true because we need to maintain the reference to the binding from
+  // JS land.
+  return true;
+}
+
+InternalFieldInfoBase* BindingData::Serialize(int index) {
+  DCHECK_EQ(index, BaseObject::kEmbedderType);
+  InternalFieldInfo* info =
+      InternalFieldInfoBase::New<InternalFieldInfo>(type());
+  return info;
+}
+
+void BindingData::Deserialize(Local<Context> context,
+                              Local<Object> holder,
+                              int index,
+                              InternalFieldInfoBase* info) {
+  DCHECK_EQ(index, BaseObject::kEmbedderType);
+  v8::HandleScope scope(context->GetIsolate());
+  Realm* realm = Realm::GetCurrent(context);
+  BindingData* binding = realm->AddBindingData<BindingData>(context, holder);
+  CHECK_NOT_NULL(binding);
+}
+
+namespace {
+
 void Initialize(Local<Object> target,
-                       Local<Value> unused,
-                       Local<Context> context,
-                       void* priv) {
-  Environment* env = Environment::GetCurrent(context);
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Realm* realm = Realm::GetCurrent(context);
+  Environment* env = realm->env();
+  BindingData* const binding_data =
+      realm->AddBindingData<BindingData>(context, target);
+  if (binding_data == nullptr) return;
+  binding_data->AddMethods();
 
-  SetMethod(context, target, "getLibuvNow", GetLibuvNow);
   SetMethod(context, target, "setupTimers", SetupTimers);
   SetMethod(context, target, "scheduleTimer", ScheduleTimer);
   SetMethod(context, target, "toggleTimerRef", ToggleTimerRef);
@@ -66,16 +135,20 @@ void Initialize(Local<Object> target,
             env->timeout_info().GetJSArray())
       .Check();
 }
-}  // anonymous namespace
-void RegisterTimerExternalReferences(ExternalReferenceRegistry* registry) {
-  registry->Register(GetLibuvNow);
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  BindingData::RegisterExternalReferences(registry);
+
   registry->Register(SetupTimers);
   registry->Register(ScheduleTimer);
   registry->Register(ToggleTimerRef);
   registry->Register(ToggleImmediateRef);
 }
 
+}  // anonymous namespace
+}  // namespace timers
 }  // namespace node
 
-NODE_BINDING_CONTEXT_AWARE_INTERNAL(timers, node::Initialize)
-NODE_BINDING_EXTERNAL_REFERENCE(timers, node::RegisterTimerExternalReferences)
+NODE_BINDING_CONTEXT_AWARE_INTERNAL(timers, node::timers::Initialize)
+NODE_BINDING_EXTERNAL_REFERENCE(timers,
+                                node::timers::RegisterExternalReferences)
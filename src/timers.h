@@ -0,0 +1,54 @@
+#ifndef SRC_TIMERS_H_
+#define SRC_TIMERS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include "node_snapshotable.h"
+#include "v8-fast-api-calls.h"
+#include "v8.h"
+
+namespace node {
+
+class ExternalReferenceRegistry;
+class Realm;
+
+namespace timers {
+class BindingData : public SnapshotableObject {
+ public:
+  BindingData(Realm* realm, v8::Local<v8::Object> object);
+
+  using InternalFieldInfo = InternalFieldInfoBase;
+
+  SERIALIZABLE_OBJECT_METHODS()
+  SET_BINDING_ID(timers_binding_data)
+
+  SET_NO_MEMORY_INFO()
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+
+  void AddMethods();
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  static BindingData* FromV8Value(v8::Local<v8::Value> receiver);
+
+  // Every re-armed timer, including the idle timeout of every socket that
+  // reads or writes, asks for the loop time, so this is a fast API call.
+  static double GetLibuvNowImpl(BindingData* receiver);
+  static double FastGetLibuvNow(v8::Local<v8::Value> receiver) {
+    return GetLibuvNowImpl(FromV8Value(receiver));
+  }
+  static void SlowGetLibuvNow(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+ private:
+  // This needs to be static so that its address is available to register as
+  // an external reference in the snapshot at environment creation time.
+  static v8::CFunction fast_get_libuv_now_;
+};
+
+}  // namespace timers
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_TIMERS_H_
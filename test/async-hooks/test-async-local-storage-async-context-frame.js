@@ -0,0 +1,104 @@
+'use strict';
+// Flags: --experimental-async-context-frame
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { AsyncLocalStorage, AsyncResource } = require('async_hooks');
+
+const als = new AsyncLocalStorage();
+const other = new AsyncLocalStorage();
+
+// The store is propagated through promises, timers, immediates, ticks,
+// microtasks, native callbacks and async resources.
+als.run('outer', common.mustCall(async () => {
+  assert.strictEqual(als.getStore(), 'outer');
+  assert.strictEqual(other.getStore(), undefined);
+
+  await null;
+  assert.strictEqual(als.getStore(), 'outer');
+
+  await new Promise((resolve) => setTimeout(resolve, 1));
+  assert.strictEqual(als.getStore(), 'outer');
+
+  setTimeout(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'outer');
+  }), 1);
+  const interval = setInterval(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'outer');
+    clearInterval(interval);
+  }), 1);
+  setImmediate(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'outer');
+  }));
+  process.nextTick(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'outer');
+  }));
+  queueMicrotask(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'outer');
+  }));
+  fs.stat(__filename, common.mustSucceed(() => {
+    assert.strictEqual(als.getStore(), 'outer');
+  }));
+
+  const resource = new AsyncResource('test');
+  const bound = AsyncLocalStorage.bind(() => als.getStore());
+  const snapshot = AsyncLocalStorage.snapshot();
+  als.run('inner', common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'inner');
+    resource.runInAsyncScope(() => {
+      assert.strictEqual(als.getStore(), 'outer');
+    });
+    assert.strictEqual(bound(), 'outer');
+    assert.strictEqual(snapshot(() => als.getStore()), 'outer');
+    assert.strictEqual(als.getStore(), 'inner');
+  }));
+  assert.strictEqual(als.getStore(), 'outer');
+
+  // Stores of different instances are independent of each other.
+  other.run('other', common.mustCall(async () => {
+    await null;
+    assert.strictEqual(als.getStore(), 'outer');
+    assert.strictEqual(other.getStore(), 'other');
+    als.exit(common.mustCall(() => {
+      assert.strictEqual(als.getStore(), undefined);
+      assert.strictEqual(other.getStore(), 'other');
+    }));
+    assert.strictEqual(als.getStore(), 'outer');
+  }));
+}));
+
+assert.strictEqual(als.getStore(), undefined);
+
+// A store entered by a promise reaction stays with that reaction's
+// continuations and does not leak into unrelated ones.
+{
+  const store = {};
+  Promise.resolve().then(common.mustCall(async () => {
+    als.enterWith(store);
+    await null;
+    assert.strictEqual(als.getStore(), store);
+  }));
+  Promise.resolve().then(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), undefined);
+  }));
+}
+
+// An error thrown from run() restores the previous store.
+assert.throws(() => {
+  als.run('error', () => {
+    throw new Error('boom');
+  });
+}, /boom/);
+assert.strictEqual(als.getStore(), undefined);
+
+// disable() drops the store until run() or enterWith() are called again.
+als.run('disabled', common.mustCall(() => {
+  process.nextTick(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), undefined);
+  }));
+  als.disable();
+  assert.strictEqual(als.getStore(), undefined);
+  als.run('enabled', common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'enabled');
+  }));
+}));
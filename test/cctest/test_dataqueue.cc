@@ -0,0 +1,153 @@
+#include "dataqueue/queue.h"
+#include "gtest/gtest.h"
+#include "node_bob-inl.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using node::DataQueue;
+using v8::ArrayBuffer;
+using v8::BackingStore;
+
+namespace {
+
+std::shared_ptr<BackingStore> CreateStore(const char* data) {
+  size_t length = strlen(data);
+  return ArrayBuffer::NewBackingStore(
+      const_cast<char*>(data), length, [](void*, size_t, void*) {}, nullptr);
+}
+
+std::unique_ptr<DataQueue::Entry> CreateEntry(const char* data) {
+  std::shared_ptr<BackingStore> store = CreateStore(data);
+  size_t length = store->ByteLength();
+  return DataQueue::CreateInMemoryEntryFromBackingStore(
+      std::move(store), 0, length);
+}
+
+// Pulls from the reader until it stops returning STATUS_CONTINUE, appending
+// the data to `out`. Returns the last status.
+int ReadAll(const std::shared_ptr<DataQueue::Reader>& reader,
+            std::string* out) {
+  int status;
+  do {
+    status = reader->Pull(
+        [&](int status,
+            const DataQueue::Vec* vecs,
+            size_t count,
+            node::bob::Done done) {
+          for (size_t n = 0; n < count; n++) {
+            out->append(reinterpret_cast<const char*>(vecs[n].base),
+                        vecs[n].len);
+          }
+        },
+        node::bob::OPTIONS_SYNC,
+        nullptr,
+        0);
+  } while (status == node::bob::STATUS_CONTINUE);
+  return status;
+}
+
+std::string Read(const std::shared_ptr<DataQueue>& data_queue) {
+  std::string out;
+  CHECK_EQ(ReadAll(data_queue->get_reader(), &out), node::bob::STATUS_END);
+  return out;
+}
+
+}  // namespace
+
+TEST(DataQueue, InMemoryEntry) {
+  std::unique_ptr<DataQueue::Entry> entry = CreateEntry("hello world");
+  CHECK(entry->is_idempotent());
+  CHECK_EQ(entry->size().value(), 11);
+
+  std::unique_ptr<DataQueue::Entry> slice = entry->slice(6);
+  CHECK_EQ(slice->size().value(), 5);
+  CHECK_EQ(entry->slice(3, 100)->size().value(), 8);
+  CHECK_EQ(entry->slice(20)->size().value(), 0);
+  CHECK_EQ(entry->slice(5, 2)->size().value(), 0);
+
+  std::vector<std::unique_ptr<DataQueue::Entry>> list;
+  list.push_back(std::move(slice));
+  std::shared_ptr<DataQueue> data_queue =
+      DataQueue::CreateIdempotent(std::move(list));
+  CHECK_EQ(Read(data_queue), "world");
+
+  // Reading past the end reports STATUS_EOS.
+  std::shared_ptr<DataQueue::Reader> reader = data_queue->get_reader();
+  std::string out;
+  CHECK_EQ(ReadAll(reader, &out), node::bob::STATUS_END);
+  CHECK_EQ(ReadAll(reader, &out), node::bob::STATUS_EOS);
+  CHECK_EQ(out, "world");
+}
+
+TEST(DataQueue, IdempotentDataQueue) {
+  std::vector<std::unique_ptr<DataQueue::Entry>> list;
+  list.push_back(CreateEntry("hello "));
+  list.push_back(CreateEntry(""));
+  list.push_back(CreateEntry("world"));
+  std::shared_ptr<DataQueue> data_queue =
+      DataQueue::CreateIdempotent(std::move(list));
+
+  CHECK(data_queue->is_idempotent());
+  CHECK_EQ(data_queue->size().value(), 11);
+  CHECK(!data_queue->append(CreateEntry("!")).has_value());
+
+  // Every reader reads the same data.
+  CHECK_EQ(Read(data_queue), "hello world");
+  CHECK_EQ(Read(data_queue), "hello world");
+
+  // Slices can span entries, and be sliced again.
+  std::shared_ptr<DataQueue> slice = data_queue->slice(3, 8);
+  CHECK_EQ(slice->size().value(), 5);
+  CHECK_EQ(Read(slice), "lo wo");
+  CHECK_EQ(Read(slice->slice(1, 4)), "o w");
+  CHECK_EQ(Read(data_queue->slice(6)), "world");
+  CHECK_EQ(Read(data_queue->slice(11)), "");
+
+  // Queues can be nested.
+  std::vector<std::unique_ptr<DataQueue::Entry>> outer;
+  outer.push_back(DataQueue::CreateDataQueueEntry(slice));
+  outer.push_back(CreateEntry("!"));
+  std::shared_ptr<DataQueue> nested =
+      DataQueue::CreateIdempotent(std::move(outer));
+  CHECK_EQ(nested->size().value(), 6);
+  CHECK_EQ(Read(nested), "lo wo!");
+  CHECK_EQ(Read(nested->slice(2)), " wo!");
+}
+
+TEST(DataQueue, NonIdempotentDataQueue) {
+  std::shared_ptr<DataQueue> data_queue = DataQueue::Create();
+  CHECK(!data_queue->is_idempotent());
+  CHECK(!data_queue->is_capped());
+  CHECK_EQ(data_queue->size().value(), 0);
+  CHECK_NULL(data_queue->slice(0));
+
+  CHECK(data_queue->append(CreateEntry("hello ")).value());
+  CHECK_EQ(data_queue->size().value(), 6);
+
+  // Only one reader is allowed, and it blocks once it runs out of data
+  // until the queue is capped.
+  std::shared_ptr<DataQueue::Reader> reader = data_queue->get_reader();
+  CHECK(reader);
+  CHECK_NULL(data_queue->get_reader());
+
+  std::string out;
+  CHECK_EQ(ReadAll(reader, &out), node::bob::STATUS_BLOCK);
+  CHECK_EQ(out, "hello ");
+
+  CHECK(data_queue->append(CreateEntry("world")).value());
+  data_queue->cap(12);
+  CHECK(data_queue->is_capped());
+  CHECK_EQ(data_queue->maybeCapRemaining().value(), 1);
+  CHECK(!data_queue->append(CreateEntry("!!")).value());
+  CHECK_EQ(ReadAll(reader, &out), node::bob::STATUS_BLOCK);
+  CHECK(data_queue->append(CreateEntry("!")).value());
+  CHECK_EQ(data_queue->maybeCapRemaining().value(), 0);
+
+  CHECK_EQ(ReadAll(reader, &out), node::bob::STATUS_END);
+  CHECK_EQ(out, "hello world!");
+}
@@ -57,9 +57,51 @@ int RunNodeInstance(MultiIsolatePlatform* platform,
                     const std::vector<std::string>& exec_args) {
   int exit_code = 0;
 
+  // Format of the arguments of this binary:
+  // Building snapshot:
+  // embedtest js_code_to_eval arg1 arg2... \
+  //           --embedder-snapshot-blob blob-path \
+  //           --embedder-snapshot-create
+  // Running snapshot:
+  // embedtest --embedder-snapshot-blob blob-path arg1 arg2...
+  // No snapshot:
+  // embedtest arg1 arg2...
+  node::EmbedderSnapshotData::Pointer snapshot;
+
+  bool is_building_snapshot = false;
+  std::string snapshot_blob_path;
+  for (size_t i = 0; i < args.size(); ++i) {
+    const std::string& arg = args[i];
+    if (arg == "--embedder-snapshot-create") {
+      is_building_snapshot = true;
+    } else if (arg == "--embedder-snapshot-blob") {
+      assert(i + 1 < args.size());
+      snapshot_blob_path = args[i + 1];
+      i++;
+    }
+  }
+
+  if (!snapshot_blob_path.empty() && !is_building_snapshot) {
+    FILE* fp = fopen(snapshot_blob_path.c_str(), "rb");
+    assert(fp != nullptr);
+    snapshot = node::EmbedderSnapshotData::FromFile(fp);
+    fclose(fp);
+    if (!snapshot) {
+      fprintf(stderr, "%s: Cannot load snapshot from %s\n",
+              args[0].c_str(), snapshot_blob_path.c_str());
+      return 1;
+    }
+  }
+
   std::vector<std::string> errors;
   std::unique_ptr<CommonEnvironmentSetup> setup =
-      CommonEnvironmentSetup::Create(platform, &errors, args, exec_args);
+      snapshot ? CommonEnvironmentSetup::CreateFromSnapshot(
+                     platform, &errors, snapshot.get(), args, exec_args)
+      : is_building_snapshot
+          ? CommonEnvironmentSetup::CreateForSnapshotting(
+                platform, &errors, args, exec_args)
+          : CommonEnvironmentSetup::Create(
+                platform, &errors, args, exec_args);
   if (!setup) {
     for (const std::string& err : errors)
       fprintf(stderr, "%s: %s\n", args[0].c_str(), err.c_str());
@@ -75,21 +117,41 @@ int RunNodeInstance(MultiIsolatePlatform* platform,
     HandleScope handle_scope(isolate);
     Context::Scope context_scope(setup->context());
 
-    MaybeLocal<Value> loadenv_ret = node::LoadEnvironment(
-        env,
-        "const publicRequire ="
-        "  require('module').createRequire(process.cwd() + '/');"
-        "globalThis.require = publicRequire;"
-        "globalThis.embedVars = { nön_ascıı: '🏳️‍🌈' };"
-        "require('vm').runInThisContext(process.argv[1]);");
+    MaybeLocal<Value> loadenv_ret;
+    if (snapshot) {
+      // Runs the function passed to
+      // v8.startupSnapshot.setDeserializeMainFunction().
+      loadenv_ret = node::LoadEnvironment(env, node::StartExecutionCallback{});
+    } else {
+      loadenv_ret = node::LoadEnvironment(
+          env,
+          // Snapshots do not support userland require()s (yet).
+          "if (!require('v8').startupSnapshot.isBuildingSnapshot()) {"
+          "  const publicRequire ="
+          "    require('module').createRequire(process.cwd() + '/');"
+          "  globalThis.require = publicRequire;"
+          "} else globalThis.require = require;"
+          "globalThis.embedVars = { nön_ascıı: '🏳️‍🌈' };"
+          "require('vm').runInThisContext(process.argv[1]);");
+    }
 
     if (loadenv_ret.IsEmpty())  // There has been a JS exception.
       return 1;
 
     exit_code = node::SpinEventLoop(env).FromMaybe(1);
+  }
 
-    node::Stop(env);
+  if (!snapshot_blob_path.empty() && is_building_snapshot) {
+    snapshot = setup->CreateSnapshot();
+    assert(snapshot);
+
+    FILE* fp = fopen(snapshot_blob_path.c_str(), "wb");
+    assert(fp != nullptr);
+    snapshot->ToFile(fp);
+    fclose(fp);
   }
 
+  node::Stop(env);
+
   return exit_code;
 }
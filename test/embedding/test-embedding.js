@@ -41,3 +41,31 @@ const fixturePath = JSON.stringify(fixtures.path('exit.js'));
 assert.strictEqual(
   child_process.spawnSync(binary, [`require(${fixturePath})`, 92]).status,
   92);
+
+// Basic snapshot support
+{
+  const tmpdir = require('../common/tmpdir');
+  tmpdir.refresh();
+  const snapshotBlob = path.join(tmpdir.path, 'embedder-snapshot.blob');
+  const buildSnapshotArgs = [
+    `eval(require("fs").readFileSync(${JSON.stringify(fixtures.path('snapshot', 'echo-args.js'))}, "utf8"))`,
+    'arg1', 'arg2',
+    '--embedder-snapshot-blob', snapshotBlob, '--embedder-snapshot-create',
+  ];
+  const runEmbeddedSnapshotArgs = [
+    '--embedder-snapshot-blob', snapshotBlob, 'arg3', 'arg4',
+  ];
+
+  assert.strictEqual(child_process.spawnSync(binary, [
+    '--', ...buildSnapshotArgs,
+  ], {
+    cwd: tmpdir.path,
+  }).status, 0);
+  const spawnResult = child_process.spawnSync(binary, [
+    '--', ...runEmbeddedSnapshotArgs,
+  ]);
+  assert.deepStrictEqual(JSON.parse(spawnResult.stdout), {
+    originalArgv: [binary, ...buildSnapshotArgs],
+    currentArgv: [binary, ...runEmbeddedSnapshotArgs],
+  });
+}
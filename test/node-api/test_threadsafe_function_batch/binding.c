@@ -0,0 +1,253 @@
+// For the purpose of this test we use libuv's threading library. When deciding
+// on a threading library for a new project it bears remembering that in the
+// future libuv may introduce API changes which may render it non-ABI-stable,
+// which, in turn, may affect the ABI stability of the project despite its use
+// of N-API.
+#include <uv.h>
+#include <node_api.h>
+#include "../../js-native-api/common.h"
+
+#define MAX_THREADS 16
+#define ITEMS_PER_THREAD 10000
+
+typedef struct {
+  napi_threadsafe_function ts_fn;
+  napi_ref js_finalize_cb;
+  uv_thread_t threads[MAX_THREADS];
+  uint32_t thread_count;
+} batch_test;
+
+static batch_test test_info;
+
+// Items that were still queued when a thread-safe function was aborted, and
+// the largest batch they were flushed in.
+static size_t final_items;
+static size_t final_max_batch;
+
+// Thread data to transmit to JS
+static int ints[MAX_THREADS][ITEMS_PER_THREAD];
+
+static void producer_thread(void* data) {
+  int* items = data;
+  int index;
+
+  for (index = 0; index < ITEMS_PER_THREAD; index++) {
+    if (napi_call_threadsafe_function(test_info.ts_fn,
+                                      &items[index],
+                                      napi_tsfn_blocking) != napi_ok) {
+      napi_fatal_error("producer_thread", NAPI_AUTO_LENGTH,
+          "napi_call_threadsafe_function failed", NAPI_AUTO_LENGTH);
+    }
+  }
+
+  if (napi_release_threadsafe_function(test_info.ts_fn,
+                                       napi_tsfn_release) != napi_ok) {
+    napi_fatal_error("producer_thread", NAPI_AUTO_LENGTH,
+        "napi_release_threadsafe_function failed", NAPI_AUTO_LENGTH);
+  }
+}
+
+// Getting the data into JS, one array per batch
+static void call_js_batch(napi_env env,
+                          napi_value cb,
+                          void* context,
+                          void** data,
+                          size_t count) {
+  napi_value argv, undefined, value;
+  size_t index;
+
+  if (env == NULL) {
+    final_items += count;
+    if (count > final_max_batch) {
+      final_max_batch = count;
+    }
+    return;
+  }
+
+  if (cb == NULL) {
+    return;
+  }
+
+  NODE_API_ASSERT_RETURN_VOID(env, count > 0, "Batch is not empty");
+  NODE_API_ASSERT_RETURN_VOID(env, context == &test_info,
+      "Thread-safe function context is as expected");
+  NODE_API_CALL_RETURN_VOID(env, napi_create_array_with_length(env, count,
+      &argv));
+  for (index = 0; index < count; index++) {
+    NODE_API_CALL_RETURN_VOID(env, napi_create_int32(env, *(int*)data[index],
+        &value));
+    NODE_API_CALL_RETURN_VOID(env, napi_set_element(env, argv, index, value));
+  }
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(env, napi_call_function(env, undefined, cb, 1,
+      &argv, NULL));
+}
+
+// Join the threads and inform JS that we're done.
+static void join_the_threads(napi_env env, void* data, void* hint) {
+  batch_test* info = data;
+  napi_value js_cb, undefined;
+  uint32_t index;
+
+  for (index = 0; index < info->thread_count; index++) {
+    uv_thread_join(&info->threads[index]);
+  }
+
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_get_reference_value(env, info->js_finalize_cb, &js_cb));
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_call_function(env, undefined, js_cb, 0, NULL, NULL));
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_delete_reference(env, info->js_finalize_cb));
+}
+
+// StartThreads(callback, threadCount, maxQueueSize, onFinalize)
+static napi_value StartThreads(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4];
+  napi_value async_name;
+  uint32_t max_queue_size;
+  uint32_t index;
+
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_ASSERT(env, test_info.ts_fn == NULL,
+      "Existing thread-safe function");
+  NODE_API_CALL(env,
+      napi_get_value_uint32(env, argv[1], &test_info.thread_count));
+  NODE_API_ASSERT(env, test_info.thread_count > 0 &&
+      test_info.thread_count <= MAX_THREADS, "Thread count is in range");
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[2], &max_queue_size));
+  NODE_API_CALL(env,
+      napi_create_reference(env, argv[3], 1, &test_info.js_finalize_cb));
+  NODE_API_CALL(env, napi_create_string_utf8(env,
+      "N-API Batched Thread-safe Function Test", NAPI_AUTO_LENGTH,
+      &async_name));
+  NODE_API_CALL(env, node_api_create_threadsafe_function_batch(env,
+      argv[0],
+      NULL,
+      async_name,
+      max_queue_size,
+      test_info.thread_count,
+      &test_info,
+      join_the_threads,
+      &test_info,
+      call_js_batch,
+      &test_info.ts_fn));
+
+  for (index = 0; index < test_info.thread_count; index++) {
+    NODE_API_ASSERT(env, uv_thread_create(&test_info.threads[index],
+        producer_thread, ints[index]) == 0, "Thread creation");
+  }
+
+  return NULL;
+}
+
+static void call_finalize_cb(napi_env env, void* data, void* hint) {
+  napi_ref js_finalize_cb = data;
+  napi_value js_cb, undefined;
+
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_get_reference_value(env, js_finalize_cb, &js_cb));
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_call_function(env, undefined, js_cb, 0, NULL, NULL));
+  NODE_API_CALL_RETURN_VOID(env, napi_delete_reference(env, js_finalize_cb));
+}
+
+// QueueAndAbort(callback, count, onFinalize) queues `count` items from the
+// main thread and aborts the function before any of them is delivered.
+static napi_value QueueAndAbort(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_value async_name;
+  napi_threadsafe_function ts_fn;
+  napi_ref js_finalize_cb;
+  uint32_t count;
+  uint32_t index;
+
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[1], &count));
+  NODE_API_ASSERT(env, count <= ITEMS_PER_THREAD, "Count is in range");
+  NODE_API_CALL(env, napi_create_reference(env, argv[2], 1, &js_finalize_cb));
+  NODE_API_CALL(env, napi_create_string_utf8(env,
+      "N-API Aborted Batched Thread-safe Function Test", NAPI_AUTO_LENGTH,
+      &async_name));
+  NODE_API_CALL(env, node_api_create_threadsafe_function_batch(env,
+      argv[0],
+      NULL,
+      async_name,
+      0,
+      1,
+      js_finalize_cb,
+      call_finalize_cb,
+      &test_info,
+      call_js_batch,
+      &ts_fn));
+
+  final_items = 0;
+  final_max_batch = 0;
+  for (index = 0; index < count; index++) {
+    NODE_API_CALL(env, napi_call_threadsafe_function(ts_fn,
+                                                     &ints[0][index],
+                                                     napi_tsfn_nonblocking));
+  }
+  NODE_API_CALL(env, napi_release_threadsafe_function(ts_fn,
+                                                      napi_tsfn_abort));
+
+  return NULL;
+}
+
+// GetFinalFlush() returns [items, maxBatch] for the last aborted function.
+static napi_value GetFinalFlush(napi_env env, napi_callback_info info) {
+  napi_value result, value;
+
+  NODE_API_CALL(env, napi_create_array_with_length(env, 2, &result));
+  NODE_API_CALL(env, napi_create_uint32(env, final_items, &value));
+  NODE_API_CALL(env, napi_set_element(env, result, 0, value));
+  NODE_API_CALL(env, napi_create_uint32(env, final_max_batch, &value));
+  NODE_API_CALL(env, napi_set_element(env, result, 1, value));
+
+  return result;
+}
+
+static napi_value Reset(napi_env env, napi_callback_info info) {
+  test_info.ts_fn = NULL;
+  return NULL;
+}
+
+// Module init
+static napi_value Init(napi_env env, napi_value exports) {
+  size_t thread, index;
+  for (thread = 0; thread < MAX_THREADS; thread++) {
+    for (index = 0; index < ITEMS_PER_THREAD; index++) {
+      ints[thread][index] = thread * ITEMS_PER_THREAD + index;
+    }
+  }
+  napi_value js_items_per_thread;
+  NODE_API_CALL(env, napi_create_uint32(env, ITEMS_PER_THREAD,
+      &js_items_per_thread));
+
+  napi_property_descriptor properties[] = {
+    {
+      "ITEMS_PER_THREAD",
+      NULL,
+      NULL,
+      NULL,
+      NULL,
+      js_items_per_thread,
+      napi_enumerable,
+      NULL
+    },
+    DECLARE_NODE_API_PROPERTY("StartThreads", StartThreads),
+    DECLARE_NODE_API_PROPERTY("Reset", Reset),
+    DECLARE_NODE_API_PROPERTY("QueueAndAbort", QueueAndAbort),
+    DECLARE_NODE_API_PROPERTY("GetFinalFlush", GetFinalFlush),
+  };
+
+  NODE_API_CALL(env, napi_define_properties(env, exports,
+    sizeof(properties)/sizeof(properties[0]), properties));
+
+  return exports;
+}
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
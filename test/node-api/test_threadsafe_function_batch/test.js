@@ -0,0 +1,57 @@
+'use strict';
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/binding`);
+
+// Each producer thread `t` queues the integers
+// [t * ITEMS_PER_THREAD, (t + 1) * ITEMS_PER_THREAD) in ascending order. The
+// batched callback must receive every one of them exactly once, in batches of
+// at most 1024 items, and items from one thread must stay in order.
+function testBatches(threadCount, maxQueueSize) {
+  return new Promise((resolve) => {
+    const received = [];
+    const lastSeen = new Array(threadCount).fill(-1);
+    binding.StartThreads(common.mustCallAtLeast((batch) => {
+      assert(Array.isArray(batch));
+      assert(batch.length >= 1 && batch.length <= 1024);
+      for (const value of batch) {
+        const thread = Math.floor(value / binding.ITEMS_PER_THREAD);
+        assert(value > lastSeen[thread]);
+        lastSeen[thread] = value;
+        received.push(value);
+      }
+    }), threadCount, maxQueueSize, common.mustCall(() => {
+      binding.Reset();
+      assert.strictEqual(received.length,
+                         threadCount * binding.ITEMS_PER_THREAD);
+      assert.strictEqual(new Set(received).size, received.length);
+      resolve();
+    }));
+  });
+}
+
+// Items that are still queued when the function is aborted are handed to the
+// batched callback without an environment, in batches of at most 1024 items
+// as well.
+function testAbort(count) {
+  return new Promise((resolve) => {
+    binding.QueueAndAbort(common.mustNotCall(), count, common.mustCall(() => {
+      // The queue is emptied right after the finalizer has run.
+      setImmediate(() => {
+        const [items, maxBatch] = binding.GetFinalFlush();
+        assert.strictEqual(items, count);
+        assert(maxBatch >= 1 && maxBatch <= 1024);
+        resolve();
+      });
+    }));
+  });
+}
+
+testBatches(1, 0)
+  .then(() => testBatches(4, 0))
+  .then(() => testBatches(16, 0))
+  .then(() => testBatches(4, 2))
+  .then(() => testBatches(16, 64))
+  .then(() => testAbort(5000))
+  .then(common.mustCall());
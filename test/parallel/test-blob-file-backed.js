@@ -0,0 +1,120 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { Blob } = require('buffer');
+const {
+  openAsBlob,
+  promises: { writeFile },
+  readFileSync,
+  statSync,
+  unlinkSync,
+  utimesSync,
+  writeFileSync,
+} = require('fs');
+const path = require('path');
+const { text } = require('stream/consumers');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const testfile = path.join(tmpdir.path, 'test-file-backed-blob.txt');
+const testfile2 = path.join(tmpdir.path, 'test-file-backed-blob2.txt');
+const testfile3 = path.join(tmpdir.path, 'test-file-backed-blob3.txt');
+writeFileSync(testfile, readFileSync(__filename, 'utf8'));
+writeFileSync(testfile2, 'a'.repeat(1000) + 'b'.repeat(200000));
+writeFileSync(testfile3, '');
+
+(async () => {
+  const blob = await openAsBlob(testfile, { type: 'Text/Plain' });
+  const data = readFileSync(testfile, 'utf8');
+
+  assert.ok(blob instanceof Blob);
+  assert.strictEqual(blob.size, statSync(testfile).size);
+  assert.strictEqual(blob.type, 'text/plain');
+  assert.strictEqual(await blob.text(), data);
+  assert.strictEqual(await text(blob.stream()), data);
+
+  // A file-backed Blob can be read any number of times, also concurrently.
+  assert.deepStrictEqual(
+    await Promise.all([blob.text(), blob.text()]), [data, data]);
+
+  const slice = blob.slice(10, 20);
+  assert.strictEqual(slice.size, 10);
+  assert.strictEqual(await slice.text(), data.slice(10, 20));
+  assert.strictEqual(await slice.slice(-5).text(), data.slice(15, 20));
+
+  // File-backed Blobs can be combined with in-memory data.
+  const combined = new Blob(['<', blob.slice(0, 5), '>']);
+  assert.strictEqual(await combined.text(), `<${data.slice(0, 5)}>`);
+
+  // A Blob can be cloned, the clone reads the same file.
+  assert.strictEqual(await structuredClone(slice).text(), data.slice(10, 20));
+})().then(common.mustCall());
+
+(async () => {
+  // Files larger than one read are read in chunks.
+  const blob = await openAsBlob(testfile2);
+  const data = readFileSync(testfile2);
+  assert.strictEqual(blob.size, 201000);
+  assert.deepStrictEqual(Buffer.from(await blob.arrayBuffer()), data);
+
+  const chunks = [];
+  for await (const chunk of blob.stream()) {
+    assert.ok(chunk.byteLength <= 65536);
+    chunks.push(chunk);
+  }
+  assert.ok(chunks.length > 1);
+  assert.deepStrictEqual(Buffer.concat(chunks), data);
+
+  const slice = blob.slice(990, 70000);
+  assert.deepStrictEqual(Buffer.from(await slice.arrayBuffer()),
+                         data.subarray(990, 70000));
+})().then(common.mustCall());
+
+(async () => {
+  const blob = await openAsBlob(testfile3);
+  assert.strictEqual(blob.size, 0);
+  assert.strictEqual(await blob.text(), '');
+  const reader = blob.stream().getReader();
+  assert.ok((await reader.read()).done);
+})().then(common.mustCall());
+
+(async () => {
+  // Reading fails once the file has been modified.
+  const file = path.join(tmpdir.path, 'test-file-backed-blob-modified.txt');
+  writeFileSync(file, 'abc');
+  const blob = await openAsBlob(file);
+  assert.strictEqual(await blob.text(), 'abc');
+
+  await writeFile(file, 'abcdef');
+  await assert.rejects(blob.text(), { name: 'NotReadableError' });
+  await assert.rejects(text(blob.stream()), { name: 'NotReadableError' });
+
+  // Also if the size stays the same.
+  const blob2 = await openAsBlob(file);
+  const future = new Date(Date.now() + 10000);
+  utimesSync(file, future, future);
+  await assert.rejects(blob2.arrayBuffer(), { name: 'NotReadableError' });
+
+  // Or removed. The file is only opened once the blob is read.
+  const blob3 = await openAsBlob(file);
+  unlinkSync(file);
+  await assert.rejects(blob3.text(), { name: 'NotReadableError' });
+})().then(common.mustCall());
+
+(async () => {
+  await assert.rejects(openAsBlob(path.join(tmpdir.path, 'missing')), {
+    code: 'ENOENT',
+    syscall: 'stat',
+  });
+  await assert.rejects(openAsBlob(tmpdir.path), { code: 'EISDIR' });
+
+  assert.throws(() => openAsBlob(1), { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => openAsBlob(testfile, null), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => openAsBlob(testfile, { type: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+})().then(common.mustCall());
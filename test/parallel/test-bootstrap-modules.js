@@ -9,6 +9,7 @@ const common = require('../common');
 const assert = require('assert');
 
 const expectedModules = new Set([
+  'Internal Binding async_context_frame',
   'Internal Binding async_wrap',
   'Internal Binding buffer',
   'Internal Binding builtins',
@@ -38,6 +39,7 @@ const expectedModules = new Set([
   'NativeModule events',
   'NativeModule fs',
   'NativeModule internal/assert',
+  'NativeModule internal/async_context_frame',
   'NativeModule internal/async_hooks',
   'NativeModule internal/buffer',
   'NativeModule internal/console/constructor',
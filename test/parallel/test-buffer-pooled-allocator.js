@@ -0,0 +1,52 @@
+'use strict';
+// Flags: --pool-arraybuffer-allocations --expose-gc
+
+// With --pool-arraybuffer-allocations, memory of dropped buffers is handed out
+// again. Make sure that memory which must be zero-filled still is, and that
+// buffers created and freed on different threads do not share memory.
+
+require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+const sizes = [1, 63, 64, 65, 4096, 8192, 65535, 65536, 65537, 1024 * 1024];
+
+function isZeroFilled(buf) {
+  for (const n of buf)
+    if (n > 0) return false;
+  return true;
+}
+
+for (let i = 0; i < 20; i++) {
+  for (const size of sizes) {
+    Buffer.allocUnsafeSlow(size).fill(0xff);
+    new Uint8Array(new ArrayBuffer(size)).fill(0xff);
+  }
+  globalThis.gc();
+
+  for (const size of sizes) {
+    assert(isZeroFilled(Buffer.alloc(size)));
+    assert(isZeroFilled(new Uint8Array(new ArrayBuffer(size))));
+  }
+}
+
+// Buffers that are alive at the same time must not overlap, including ones
+// transferred from a worker and freed on the main thread.
+const worker = new Worker(`
+  const { parentPort } = require('worker_threads');
+  const buffers = [];
+  for (let i = 0; i < 100; i++)
+    buffers.push(new Uint8Array(new ArrayBuffer(100 + i)).fill(i));
+  parentPort.postMessage(buffers, buffers.map((b) => b.buffer));
+`, { eval: true });
+
+worker.once('message', (buffers) => {
+  const local = [];
+  for (let i = 0; i < 100; i++)
+    local.push(new Uint8Array(new ArrayBuffer(100 + i)).fill(255 - i));
+  for (let i = 0; i < 100; i++) {
+    assert.strictEqual(buffers[i].length, 100 + i);
+    assert(buffers[i].every((n) => n === i));
+    assert(local[i].every((n) => n === 255 - i));
+  }
+});
@@ -0,0 +1,88 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const child_process = require('child_process');
+const net = require('net');
+const { inspect } = require('util');
+
+// Messages sent with `ipcTransport: 'shared-memory'` arrive complete and in
+// order in both directions, including the ones that have to take the pipe
+// because they carry a handle or do not fit into the ring buffers.
+
+const kMessages = 10000;
+
+if (process.argv[2] === 'child') {
+  let expected = 0;
+  process.on('message', (message, handle) => {
+    if (message === 'done') {
+      for (let i = 0; i < kMessages; i++)
+        process.send({ seq: i, padding: 'x'.repeat(i % 100) });
+      process.send('done');
+      return;
+    }
+    assert.strictEqual(message.seq, expected++);
+    if (handle !== undefined) {
+      assert(handle instanceof net.Server);
+      handle.close();
+    }
+  });
+  return;
+}
+
+for (const value of [null, 42, 'memory']) {
+  assert.throws(() => {
+    child_process.fork(__filename, ['child'], { ipcTransport: value });
+  }, {
+    code: 'ERR_INVALID_ARG_VALUE',
+    message: "The property 'options.ipcTransport' " +
+      "must be one of: undefined, 'pipe', 'shared-memory'. " +
+      `Received ${inspect(value)}`
+  });
+}
+
+if (common.isWindows) {
+  assert.throws(() => {
+    child_process.fork(__filename, ['child'], {
+      ipcTransport: 'shared-memory',
+    });
+  }, { code: 'ERR_FEATURE_UNAVAILABLE_ON_PLATFORM' });
+  return;
+}
+
+for (const serialization of ['json', 'advanced']) {
+  const child = child_process.fork(__filename, ['child'], {
+    serialization,
+    ipcTransport: 'shared-memory',
+  });
+
+  const server = net.createServer();
+  server.listen(0, common.mustCall(() => {
+    for (let i = 0; i < kMessages; i++) {
+      if (i === kMessages / 2) {
+        child.send({ seq: i }, server);
+      } else if (i % 1000 === 0) {
+        // Larger than the ring buffers.
+        child.send({ seq: i, padding: 'x'.repeat(1024 * 1024) });
+      } else {
+        child.send({ seq: i });
+      }
+    }
+    child.send('done');
+  }));
+
+  let expected = 0;
+  child.on('message', common.mustCall((message) => {
+    if (message === 'done') {
+      assert.strictEqual(expected, kMessages);
+      server.close();
+      child.disconnect();
+      return;
+    }
+    assert.strictEqual(message.seq, expected++);
+    assert.strictEqual(message.padding, 'x'.repeat(message.seq % 100));
+  }, kMessages + 1));
+
+  child.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+  }));
+}
@@ -0,0 +1,57 @@
+'use strict';
+const common = require('../common');
+
+// With cluster.SCHED_REUSEPORT every worker listens on a socket of its own
+// and the kernel spreads the connections across them.
+
+if (!common.isLinux)
+  common.skip('SO_REUSEPORT load balancing is only supported on Linux');
+
+const assert = require('assert');
+const cluster = require('cluster');
+const net = require('net');
+
+cluster.schedulingPolicy = cluster.SCHED_REUSEPORT;
+
+const kWorkers = 2;
+const kConnections = 64;
+
+if (cluster.isPrimary) {
+  const ports = [];
+  const seen = new Set();
+  let pending = kConnections;
+
+  function connect(port) {
+    const socket = net.connect(port, common.localhostIPv4);
+    let data = '';
+    socket.setEncoding('utf8');
+    socket.on('data', (chunk) => data += chunk);
+    socket.on('end', common.mustCall(() => {
+      seen.add(data);
+      if (--pending === 0) {
+        assert.strictEqual(seen.size, kWorkers);
+        cluster.disconnect();
+      }
+    }));
+  }
+
+  for (let i = 0; i < kWorkers; i++) {
+    cluster.fork().on('listening', common.mustCall((address) => {
+      ports.push(address.port);
+      if (ports.length < kWorkers)
+        return;
+      // listen(0) resolves to the same port in every worker.
+      assert.strictEqual(new Set(ports).size, 1);
+      for (let i = 0; i < kConnections; i++)
+        connect(ports[0]);
+    }));
+  }
+} else {
+  const server = net.createServer((socket) => {
+    socket.end(`${cluster.worker.id}`);
+  });
+  server.listen(0, common.localhostIPv4, common.mustCall(() => {
+    // The handle is a real TCP handle rather than a round-robin stand-in.
+    assert.strictEqual(server._handle.constructor.name, 'TCP');
+  }));
+}
@@ -0,0 +1,91 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const inputs = [
+  Buffer.alloc(0),
+  Buffer.from('abc'),
+  Buffer.alloc(4096, 'x'),
+  new Uint8Array(65536).fill(7),
+  new DataView(new ArrayBuffer(17)),
+  new ArrayBuffer(33),
+  Buffer.from('hello world').subarray(6),
+];
+
+function expected(algorithm, encoding, outputLength) {
+  return inputs.map((input) => {
+    const data = input instanceof ArrayBuffer ? new Uint8Array(input) : input;
+    return crypto.createHash(algorithm, { outputLength })
+      .update(data).digest(encoding);
+  });
+}
+
+for (const algorithm of ['sha1', 'sha256', 'sha512', 'md5']) {
+  const digests = crypto.hashManySync(algorithm, inputs);
+  assert.strictEqual(digests.length, inputs.length);
+  for (const digest of digests)
+    assert(Buffer.isBuffer(digest));
+  assert.deepStrictEqual(digests, expected(algorithm, 'buffer'));
+
+  assert.deepStrictEqual(
+    crypto.hashManySync(algorithm, inputs, { outputEncoding: 'hex' }),
+    expected(algorithm, 'hex'));
+
+  for (const concurrency of [1, 2, 3, 16]) {
+    crypto.hashMany(algorithm, inputs, {
+      concurrency,
+      outputEncoding: 'base64',
+    }, common.mustSucceed((digests) => {
+      assert.deepStrictEqual(digests, expected(algorithm, 'base64'));
+    }));
+  }
+}
+
+// XOF output lengths.
+assert.deepStrictEqual(
+  crypto.hashManySync('shake256', inputs, { outputLength: 100 }),
+  expected('shake256', 'buffer', 100));
+assert.deepStrictEqual(
+  crypto.hashManySync('shake128', inputs, { outputLength: 0 }),
+  expected('shake128', 'buffer', 0));
+
+// Empty input lists.
+assert.deepStrictEqual(crypto.hashManySync('sha256', []), []);
+crypto.hashMany('sha256', [], common.mustSucceed((digests) => {
+  assert.deepStrictEqual(digests, []);
+}));
+
+// The async job copies its inputs, later modifications are not observed.
+{
+  const data = [Buffer.from('abc'), Buffer.from('def')];
+  const want = data.map((d) => crypto.createHash('sha256').update(d).digest());
+  crypto.hashMany('sha256', data, common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, want);
+  }));
+  data[0].fill(0);
+}
+
+assert.throws(() => crypto.hashManySync('sha256', 'abc'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => crypto.hashManySync('sha256', [Buffer.alloc(1), 'abc']), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /The "data\[1\]" argument/,
+});
+assert.throws(() => crypto.hashManySync('no-such-hash', [Buffer.alloc(1)]), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST',
+});
+assert.throws(() => crypto.hashManySync('sha256', [], { outputLength: 16 }), {
+  code: 'ERR_CRYPTO_INVALID_DIGEST',
+});
+assert.throws(() => crypto.hashMany('sha256', [], { concurrency: 0 },
+                                    common.mustNotCall()), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => crypto.hashMany('sha256', []), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
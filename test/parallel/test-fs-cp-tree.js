@@ -0,0 +1,204 @@
+'use strict';
+
+// Tests fs.cp() of directories, which are copied natively unless a filter is
+// given.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+let dirc = 0;
+function nextdir() {
+  return path.join(tmpdir.path, `dir${++dirc}`);
+}
+
+// Creates `dirs` directories holding `files` files each, and returns the
+// number of entries and bytes in the tree.
+function makeTree(root, dirs, files) {
+  fs.mkdirSync(root);
+  let entries = 1;
+  let bytes = 0;
+  for (let d = 0; d < dirs; d++) {
+    const dir = path.join(root, `d${d}`, 'nested');
+    fs.mkdirSync(dir, { recursive: true });
+    entries += 2;
+    for (let f = 0; f < files; f++) {
+      const data = `${d}:${f}`.repeat(f + 1);
+      fs.writeFileSync(path.join(dir, `f${f}.txt`), data);
+      entries++;
+      bytes += data.length;
+    }
+  }
+  return { entries, bytes };
+}
+
+function assertTreeEqual(src, dest) {
+  const srcStat = fs.lstatSync(src);
+  const destStat = fs.lstatSync(dest);
+  assert.strictEqual(destStat.mode, srcStat.mode);
+  if (srcStat.isDirectory()) {
+    const names = fs.readdirSync(src).sort();
+    assert.deepStrictEqual(fs.readdirSync(dest).sort(), names);
+    for (const name of names)
+      assertTreeEqual(path.join(src, name), path.join(dest, name));
+  } else if (srcStat.isSymbolicLink()) {
+    assert.strictEqual(fs.readlinkSync(dest), fs.readlinkSync(src));
+  } else {
+    assert.deepStrictEqual(fs.readFileSync(dest), fs.readFileSync(src));
+  }
+}
+
+// Many files in nested directories are copied, and progress is reported.
+{
+  const src = nextdir();
+  const dest = nextdir();
+  const { entries, bytes } = makeTree(src, 5, 40);
+  let last = { entries: 0, bytes: 0 };
+  fs.cp(src, dest, {
+    recursive: true,
+    onProgress: common.mustCallAtLeast((progress) => {
+      assert.ok(progress.entries >= last.entries);
+      assert.ok(progress.bytes >= last.bytes);
+      last = progress;
+    }),
+  }, common.mustSucceed(() => {
+    assert.deepStrictEqual(last, { entries, bytes });
+    assertTreeEqual(src, dest);
+  }));
+}
+
+// Symbolic links are copied, relative ones are resolved unless
+// verbatimSymlinks is set.
+(async () => {
+  const src = nextdir();
+  fs.mkdirSync(path.join(src, 'a', 'b'), { recursive: true });
+  fs.writeFileSync(path.join(src, 'a', 'b', 'file'), 'hello');
+  fs.symlinkSync(path.join('b', 'file'), path.join(src, 'a', 'link'));
+
+  const dest = nextdir();
+  await fs.promises.cp(src, dest, { recursive: true });
+  assert.strictEqual(fs.readlinkSync(path.join(dest, 'a', 'link')),
+                     path.join(src, 'a', 'b', 'file'));
+  assert.strictEqual(fs.readFileSync(path.join(dest, 'a', 'link'), 'utf8'),
+                     'hello');
+
+  const verbatim = nextdir();
+  await fs.promises.cp(src, verbatim, {
+    recursive: true,
+    verbatimSymlinks: true,
+  });
+  assertTreeEqual(src, verbatim);
+
+  // Copying again replaces the links.
+  await fs.promises.cp(src, verbatim, { recursive: true });
+  assert.strictEqual(fs.readlinkSync(path.join(verbatim, 'a', 'link')),
+                     path.join(src, 'a', 'b', 'file'));
+})().then(common.mustCall());
+
+// The mode of a new directory is set once its contents have been copied,
+// and timestamps of read-only files are preserved.
+if (!common.isWindows && !common.isIBMi) {
+  const src = nextdir();
+  fs.mkdirSync(path.join(src, 'readonly'), { recursive: true });
+  const file = path.join(src, 'readonly', 'file');
+  fs.writeFileSync(file, 'hello');
+  fs.chmodSync(file, 0o444);
+  fs.utimesSync(file, new Date(2000, 0, 1), new Date(2001, 0, 1));
+  fs.chmodSync(path.join(src, 'readonly'), 0o555);
+
+  const dest = nextdir();
+  fs.cp(src, dest, {
+    recursive: true,
+    preserveTimestamps: true,
+  }, common.mustSucceed(() => {
+    assertTreeEqual(src, dest);
+    const copy = fs.statSync(path.join(dest, 'readonly', 'file'));
+    assert.strictEqual(copy.mtime.getTime(), new Date(2001, 0, 1).getTime());
+    fs.chmodSync(path.join(src, 'readonly'), 0o755);
+    fs.chmodSync(path.join(dest, 'readonly'), 0o755);
+  }));
+}
+
+// Existing files are left alone unless force is set.
+(async () => {
+  const src = nextdir();
+  makeTree(src, 1, 2);
+  const dest = nextdir();
+  fs.mkdirSync(path.join(dest, 'd0', 'nested'), { recursive: true });
+  const existing = path.join(dest, 'd0', 'nested', 'f0.txt');
+  fs.writeFileSync(existing, 'existing');
+
+  await fs.promises.cp(src, dest, { recursive: true, force: false });
+  assert.strictEqual(fs.readFileSync(existing, 'utf8'), 'existing');
+
+  await assert.rejects(fs.promises.cp(src, dest, {
+    recursive: true,
+    force: false,
+    errorOnExist: true,
+  }), { code: 'ERR_FS_CP_EEXIST' });
+
+  await fs.promises.cp(src, dest, { recursive: true });
+  assertTreeEqual(src, dest);
+})().then(common.mustCall());
+
+// Type mismatches inside the tree are reported.
+(async () => {
+  const src = nextdir();
+  makeTree(src, 1, 1);
+  const dest = nextdir();
+  fs.mkdirSync(path.join(dest, 'd0'), { recursive: true });
+  fs.writeFileSync(path.join(dest, 'd0', 'nested'), '');
+  await assert.rejects(fs.promises.cp(src, dest, { recursive: true }), {
+    code: 'ERR_FS_CP_DIR_TO_NON_DIR',
+    path: path.join(dest, 'd0', 'nested'),
+  });
+
+  const dest2 = nextdir();
+  fs.mkdirSync(path.join(dest2, 'd0', 'nested', 'f0.txt'), {
+    recursive: true,
+  });
+  await assert.rejects(fs.promises.cp(src, dest2, { recursive: true }), {
+    code: 'ERR_FS_CP_NON_DIR_TO_DIR',
+    path: path.join(dest2, 'd0', 'nested', 'f0.txt'),
+  });
+})().then(common.mustCall());
+
+// Filesystem errors carry the failing syscall and path.
+if (!common.isWindows && !common.isIBMi && process.getuid() !== 0) {
+  const src = nextdir();
+  makeTree(src, 1, 1);
+  const unreadable = path.join(src, 'd0', 'nested');
+  fs.chmodSync(unreadable, 0o000);
+  fs.cp(src, nextdir(), { recursive: true }, common.mustCall((err) => {
+    fs.chmodSync(unreadable, 0o755);
+    assert.strictEqual(err.code, 'EACCES');
+    assert.strictEqual(err.syscall, 'scandir');
+    assert.strictEqual(err.path, unreadable);
+  }));
+}
+
+// The filter is still applied, and progress reported, when one is given.
+(async () => {
+  const src = nextdir();
+  makeTree(src, 2, 3);
+  const dest = nextdir();
+  let entries = 0;
+  await fs.promises.cp(src, dest, {
+    recursive: true,
+    filter: (source) => !source.endsWith('d1'),
+    onProgress: common.mustCallAtLeast((progress) => {
+      entries = progress.entries;
+    }),
+  });
+  assert.deepStrictEqual(fs.readdirSync(dest), ['d0']);
+  // The root, d0, d0/nested and its three files.
+  assert.strictEqual(entries, 6);
+})().then(common.mustCall());
+
+assert.throws(() => fs.cp('a', 'b', { onProgress: 1 }, common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
@@ -0,0 +1,197 @@
+'use strict';
+// Removing and listing wide and deep directory trees, which is done with a
+// single native call on POSIX systems.
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+tmpdir.refresh();
+
+let count = 0;
+const nextDirPath = () => path.join(tmpdir.path, `tree-${count++}`);
+
+// The first entries of the tree below, in the order readdir() lists them.
+const expected = [
+  'deep', 'link', 'wide',
+  'deep/d',
+  'wide/f-0', 'wide/f-1', 'wide/f-10', 'wide/f-100', 'wide/f-1000',
+];
+
+const outside = path.join(tmpdir.path, 'outside');
+fs.mkdirSync(outside);
+fs.writeFileSync(path.join(outside, 'keep'), 'keep');
+
+function makeTree(dir) {
+  fs.mkdirSync(dir);
+  // More entries than fit in one read of the directory.
+  fs.mkdirSync(path.join(dir, 'wide'));
+  for (let i = 0; i < 3000; i++) {
+    fs.writeFileSync(path.join(dir, 'wide', `f-${i}`), '');
+  }
+  let deep = path.join(dir, 'deep');
+  for (let i = 0; i < 100; i++) {
+    deep = path.join(deep, 'd');
+  }
+  fs.mkdirSync(deep, { recursive: true });
+  fs.writeFileSync(path.join(deep, 'file'), '');
+  // Symbolic links are removed, not followed.
+  fs.symlinkSync(outside, path.join(dir, 'link'), 'dir');
+  return dir;
+}
+
+function checkRemoved(dir) {
+  assert(!fs.existsSync(dir));
+  assert.strictEqual(fs.readFileSync(path.join(outside, 'keep'), 'utf8'),
+                     'keep');
+}
+
+{
+  const dir = makeTree(nextDirPath());
+  fs.rmSync(dir, { recursive: true });
+  checkRemoved(dir);
+}
+
+{
+  const dir = makeTree(nextDirPath());
+  fs.rm(dir, { recursive: true }, common.mustSucceed(() => {
+    checkRemoved(dir);
+  }));
+}
+
+(async () => {
+  const dir = makeTree(nextDirPath());
+  await fs.promises.rm(dir, { recursive: true });
+  checkRemoved(dir);
+})().then(common.mustCall());
+
+{
+  const dir = makeTree(nextDirPath());
+  const link = path.join(dir, 'link');
+
+  // Without `withFileTypes` symbolic links to directories are listed too.
+  const names = fs.readdirSync(dir, { recursive: true });
+  assert.strictEqual(names.length, 3000 + 101 + 3 + 1);
+  assert.deepStrictEqual(names.slice(0, expected.length + 1),
+                         [...expected.slice(0, 4), 'link/keep',
+                          ...expected.slice(4)].map(path.normalize));
+  assert(names.includes(path.normalize('deep/d/d/d')));
+  assert(names.includes(path.normalize('link/keep')));
+
+  if (!common.isWindows) {
+    const buffers =
+      fs.readdirSync(dir, { recursive: true, encoding: 'buffer' });
+    assert.deepStrictEqual(buffers, names.map((name) => Buffer.from(name)));
+  }
+
+  fs.readdir(dir, { recursive: true }, common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, names);
+  }));
+  fs.promises.readdir(dir, { recursive: true }).then(common.mustCall((result) => {
+    assert.deepStrictEqual(result.sort(), [...names].sort());
+  }));
+
+  // With it they are not.
+  const dirents = fs.readdirSync(dir, { recursive: true, withFileTypes: true });
+  assert.strictEqual(dirents.length, 3000 + 101 + 3);
+  assert.deepStrictEqual(
+    dirents.slice(0, expected.length)
+           .map((dirent) => path.join(dirent.parentPath, dirent.name)),
+    expected.map((name) => path.join(dir, name)));
+  const linkDirent = dirents.find((dirent) => dirent.name === 'link');
+  assert(linkDirent.isSymbolicLink());
+  assert.strictEqual(linkDirent.parentPath, dir);
+  const fileDirent = dirents.find((dirent) => dirent.name === 'file');
+  assert(fileDirent.isFile());
+  assert.strictEqual(path.relative(dir, fileDirent.parentPath),
+                     path.join('deep', ...new Array(100).fill('d')));
+
+  const types = (dirent) => [dirent.parentPath, dirent.name,
+                             dirent.isDirectory()];
+  fs.readdir(dir, { recursive: true, withFileTypes: true },
+             common.mustSucceed((result) => {
+               assert.deepStrictEqual(result.map(types), dirents.map(types));
+             }));
+  fs.promises.readdir(dir, { recursive: true, withFileTypes: true })
+    .then(common.mustCall((result) => {
+      assert.strictEqual(result.length, dirents.length);
+      assert(result.every((dirent) => dirent instanceof fs.Dirent));
+    }));
+
+  assert(fs.existsSync(link));
+}
+
+if (!common.isWindows) {
+  // Trees deeper than the number of descriptors that can be open at once.
+  const dir = nextDirPath();
+  let deep = dir;
+  for (let i = 0; i < 500; i++) {
+    deep = path.join(deep, 'd');
+  }
+  fs.mkdirSync(deep, { recursive: true });
+  fs.writeFileSync(path.join(deep, 'file'), '');
+
+  const script = 'require("fs").rmSync(process.argv[1], { recursive: true })';
+  const { status, stderr } = spawnSync('/bin/sh', [
+    '-c', `ulimit -n 128 && exec "$0" -e '${script}' "$1"`,
+    process.execPath, dir,
+  ], { encoding: 'utf8' });
+  assert.strictEqual(status, 0, stderr);
+  assert(!fs.existsSync(dir));
+}
+
+{
+  // Errors are reported for the path that failed.
+  const missing = path.join(tmpdir.path, 'missing');
+  assert.throws(() => fs.readdirSync(missing, { recursive: true }), {
+    code: 'ENOENT',
+    syscall: 'scandir',
+    path: missing,
+  });
+  if (!common.isWindows) {
+    fs.readdir(missing, { recursive: true }, common.mustCall((err) => {
+      assert.strictEqual(err.code, 'ENOENT');
+      assert.strictEqual(err.path, missing);
+    }));
+  }
+  assert.rejects(fs.promises.readdir(missing, { recursive: true }), {
+    code: 'ENOENT',
+    path: missing,
+  }).then(common.mustCall());
+}
+
+if (!common.isWindows && process.getuid() !== 0) {
+  const dir = nextDirPath();
+  const readonly = path.join(dir, 'a', 'readonly');
+  const file = path.join(readonly, 'file');
+  fs.mkdirSync(readonly, { recursive: true });
+  fs.writeFileSync(file, '');
+  fs.chmodSync(readonly, 0o555);
+
+  try {
+    assert.throws(() => fs.rmSync(dir, { recursive: true }), {
+      code: 'EACCES',
+      syscall: 'unlink',
+      path: file,
+    });
+    assert(fs.existsSync(file));
+  } finally {
+    fs.chmodSync(readonly, 0o755);
+  }
+
+  fs.chmodSync(readonly, 0o111);
+  try {
+    assert.throws(() => fs.readdirSync(dir, { recursive: true }), {
+      code: 'EACCES',
+      syscall: 'scandir',
+      path: readonly,
+    });
+  } finally {
+    fs.chmodSync(readonly, 0o755);
+  }
+
+  fs.rmSync(dir, { recursive: true });
+  assert(!fs.existsSync(dir));
+}
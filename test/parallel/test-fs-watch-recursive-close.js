@@ -0,0 +1,48 @@
+'use strict';
+
+const common = require('../common');
+
+if (!common.isOSX && !common.isWindows && !common.isLinux)
+  common.skip('recursive fs.watch() is not supported on this platform');
+
+// Closing a recursive watcher emits 'close' once and stops the events. On
+// Linux, where it is backed by an inotify descriptor, the descriptor is
+// released.
+
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'root');
+fs.mkdirSync(path.join(root, 'a', 'b'), { recursive: true });
+
+function openFds() {
+  return common.isLinux ? fs.readdirSync('/proc/self/fd').length : 0;
+}
+
+const before = openFds();
+const watcher = fs.watch(root, { recursive: true });
+watcher.on('change', common.mustNotCall());
+watcher.on('close', common.mustCall(() => {
+  // The handle is closed by the event loop after 'close' is emitted.
+  setImmediate(() => setImmediate(common.mustCall(() => {
+    assert.strictEqual(openFds(), before);
+    closeFromListener();
+  })));
+}));
+watcher.close();
+// Closing again is a no-op.
+watcher.close();
+fs.writeFileSync(path.join(root, 'a', 'b', 'file.txt'), '');
+
+function closeFromListener() {
+  const watcher = fs.watch(root, { recursive: true });
+  watcher.on('change', common.mustCallAtLeast(() => watcher.close(), 1));
+  watcher.on('close', common.mustCall());
+  setTimeout(() => {
+    fs.writeFileSync(path.join(root, 'a', 'other.txt'), '');
+  }, common.platformTimeout(100));
+}
@@ -0,0 +1,43 @@
+// Flags: --expose-gc
+'use strict';
+
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('recursive watchers are native handles of their own on Linux');
+
+// Test that recursive watchers do not leave a handle behind once they have
+// been closed, so that neither the handles nor the watchers they refer to
+// stay alive after many watch/close cycles.
+
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'root');
+fs.mkdirSync(path.join(root, 'a'), { recursive: true });
+
+const kCycles = 100;
+const handles = [];
+const watchers = [];
+
+let closed = 0;
+for (let i = 0; i < kCycles; i++) {
+  const watcher = fs.watch(root, { recursive: true });
+  handles.push(new WeakRef(watcher._handle));
+  watchers.push(new WeakRef(watcher));
+  watcher.on('close', common.mustCall(() => {
+    if (++closed === kCycles)
+      setImmediate(check);
+  }));
+  watcher.close();
+}
+
+function check() {
+  const alive = (refs) => refs.filter((ref) => ref.deref() !== undefined);
+  common.gcUntil('recursive watchers are collected', () => {
+    return alive(handles).length === 0 && alive(watchers).length === 0;
+  }).then(common.mustCall());
+}
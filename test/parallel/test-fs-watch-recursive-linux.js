@@ -0,0 +1,103 @@
+'use strict';
+
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('tests the inotify based recursive watcher');
+
+// Directories that are created in or moved into the watched tree are watched
+// as well, including their contents, and moved out ones are not any longer.
+
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'root');
+const outside = path.join(tmpdir.path, 'outside');
+fs.mkdirSync(path.join(root, 'existing'), { recursive: true });
+fs.mkdirSync(path.join(outside, 'moved', 'deep'), { recursive: true });
+fs.writeFileSync(path.join(outside, 'moved', 'deep', 'before.txt'), '');
+
+const steps = [
+  // A file in a directory that existed before watching started.
+  [path.join('existing', 'a.txt'), () => {
+    fs.writeFileSync(path.join(root, 'existing', 'a.txt'), 'a');
+  }],
+  // A file in a nested directory that is created afterwards.
+  [path.join('new', 'nested', 'b.txt'), () => {
+    fs.mkdirSync(path.join(root, 'new', 'nested'), { recursive: true });
+    fs.writeFileSync(path.join(root, 'new', 'nested', 'b.txt'), 'b');
+  }],
+  // The contents of a directory that is moved into the tree are reported,
+  // and changes below it are seen.
+  [path.join('moved', 'deep', 'before.txt'), () => {
+    fs.renameSync(path.join(outside, 'moved'), path.join(root, 'moved'));
+  }],
+  [path.join('moved', 'deep', 'after.txt'), () => {
+    fs.writeFileSync(path.join(root, 'moved', 'deep', 'after.txt'), '');
+  }],
+  // After moving it out again, it is not watched any longer.
+  ['last.txt', () => {
+    fs.renameSync(path.join(root, 'moved'), path.join(outside, 'moved'));
+    fs.writeFileSync(path.join(outside, 'moved', 'deep', 'ignored.txt'), '');
+    fs.writeFileSync(path.join(root, 'last.txt'), '');
+  }],
+];
+
+const watcher = fs.watch(root, { recursive: true });
+const seen = new Set();
+let step = 0;
+
+watcher.on('change', common.mustCallAtLeast((eventType, filename) => {
+  assert.ok(eventType === 'change' || eventType === 'rename');
+  assert.strictEqual(typeof filename, 'string');
+  assert.ok(!filename.includes('ignored.txt'));
+  seen.add(filename);
+  while (step < steps.length && seen.has(steps[step][0])) {
+    if (++step === steps.length) {
+      // Give stray events from the moved out directory a chance to show up.
+      setTimeout(() => watcher.close(), common.platformTimeout(100));
+      return;
+    }
+    steps[step][1]();
+  }
+}));
+
+steps[0][1]();
+
+// The promise API reports all events of a batch.
+(async () => {
+  const dir = path.join(tmpdir.path, 'promises');
+  fs.mkdirSync(dir);
+  const events = fs.promises.watch(dir, { recursive: true });
+  const next = events.next();
+  fs.mkdirSync(path.join(dir, 'x', 'y', 'z'), { recursive: true });
+  const expected = new Set(['x', path.join('x', 'y'), path.join('x', 'y', 'z')]);
+  let result = await next;
+  while (expected.size > 0) {
+    expected.delete(result.value.filename);
+    if (expected.size > 0)
+      result = await events.next();
+  }
+  await events.return();
+})().then(common.mustCall());
+
+if (process.getuid() !== 0) {
+  // Directories that cannot be read are left out, the rest of the tree is
+  // still watched. Other failures to add a watch, such as hitting the
+  // fs.inotify.max_user_watches limit, are reported as errors instead.
+  const dir = path.join(tmpdir.path, 'unreadable');
+  const locked = path.join(dir, 'locked');
+  fs.mkdirSync(locked, { recursive: true });
+  fs.chmodSync(locked, 0o000);
+  try {
+    const watcher = fs.watch(dir, { recursive: true });
+    watcher.on('error', common.mustNotCall());
+    watcher.close();
+  } finally {
+    fs.chmodSync(locked, 0o755);
+  }
+}
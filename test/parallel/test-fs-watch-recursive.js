@@ -18,7 +18,7 @@ const testsubdir = fs.mkdtempSync(testDir + path.sep);
 const relativePathOne = path.join(path.basename(testsubdir), filenameOne);
 const filepathOne = path.join(testsubdir, filenameOne);
 
-if (!common.isOSX && !common.isWindows) {
+if (!common.isOSX && !common.isWindows && !common.isLinux) {
   assert.throws(() => { fs.watch(testDir, { recursive: true }); },
                 { code: 'ERR_FEATURE_UNAVAILABLE_ON_PLATFORM' });
   return;
@@ -0,0 +1,77 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+{
+  const server = http.createServer();
+  assert.strictEqual(server.recordTimings, false);
+  assert.strictEqual(server.getTimings(), undefined);
+
+  for (const recordTimings of [1, 'true', null]) {
+    assert.throws(() => http.createServer({ recordTimings }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  assert.throws(() => server.getTimings({ reset: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+{
+  // Timings can be read before the server listens.
+  const server = http.createServer({ recordTimings: true });
+  const { headers, body, response } = server.getTimings();
+  assert.strictEqual(headers.count, 0);
+  assert.strictEqual(body.count, 0);
+  assert.strictEqual(response.count, 0);
+}
+
+const kDelay = 20;
+
+const server = http.createServer({ recordTimings: true }, (req, res) => {
+  req.resume();
+  req.on('end', () => setTimeout(() => res.end('ok'), kDelay));
+});
+
+server.listen(0, common.mustCall(async () => {
+  const { port } = server.address();
+  const agent = new http.Agent({ keepAlive: true, maxSockets: 1 });
+
+  for (let i = 0; i < 3; i++) {
+    await new Promise((resolve) => {
+      const req = http.request({ port, agent, method: 'POST' }, (res) => {
+        res.resume();
+        res.on('end', resolve);
+      });
+      req.end('body');
+    });
+  }
+  agent.destroy();
+
+  const snapshot = server.getTimings();
+  for (const name of ['headers', 'body', 'response'])
+    assert.strictEqual(snapshot[name].count, 3, name);
+  assert(snapshot.response.min >= (kDelay - 5) * 1e6);
+
+  // Two pipelined requests on the same connection.
+  const socket = net.connect(port, common.mustCall(() => {
+    socket.write('GET / HTTP/1.1\r\nHost: localhost\r\n\r\n' +
+                 'GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n');
+  }));
+  socket.resume();
+  socket.on('end', common.mustCall(() => {
+    // The snapshot is a copy.
+    assert.strictEqual(snapshot.response.count, 3);
+
+    const { headers, body, response } = server.getTimings({ reset: true });
+    assert.strictEqual(headers.count, 5);
+    assert.strictEqual(body.count, 5);
+    assert.strictEqual(response.count, 5);
+
+    assert.strictEqual(server.getTimings().response.count, 0);
+    server.close();
+  }));
+}));
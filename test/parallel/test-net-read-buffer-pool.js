@@ -0,0 +1,78 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+// Test that small reads reuse the same read buffer, and that the data handed
+// to JS is still correct and sits in an ArrayBuffer of its own, which holds
+// nothing but the data of that read.
+
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const {
+  getReadBufferAllocations,
+  getReadBufferCopies,
+} = internalBinding('stream_wrap');
+
+const kRounds = 200;
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.on('data', (data) => socket.write(data));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port);
+  const allocations = getReadBufferAllocations();
+  const copies = getReadBufferCopies();
+  const chunks = [];
+  let round = 0;
+
+  socket.on('data', (data) => {
+    chunks.push(data);
+    assert.strictEqual(data.toString(), `message ${round}`);
+    assert.strictEqual(data.byteOffset, 0);
+    assert.strictEqual(data.buffer.byteLength, data.length);
+    if (++round < kRounds) {
+      socket.write(`message ${round}`);
+      return;
+    }
+
+    // Both the client and the server read kRounds times, which must have
+    // needed far fewer buffers.
+    const used = getReadBufferAllocations() - allocations;
+    assert(used < kRounds / 10, `${used} allocations for ${kRounds * 2} reads`);
+    // The data of each of those reads was copied out of the read buffer.
+    assert(getReadBufferCopies() - copies >= kRounds);
+
+    // Reads that were delivered earlier are not overwritten by later ones.
+    for (let i = 0; i < kRounds; i++)
+      assert.strictEqual(chunks[i].toString(), `message ${i}`);
+
+    socket.end();
+    server.close();
+  });
+  socket.write('message 0');
+}));
+
+{
+  // Large reads take the read buffer over, without exposing more than the
+  // data they hold either.
+  const payload = Buffer.alloc(4 * 1024 * 1024, 'x');
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.end(payload);
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port);
+    const chunks = [];
+    socket.on('data', (data) => {
+      assert.strictEqual(data.byteOffset, 0);
+      assert.strictEqual(data.buffer.byteLength, data.length);
+      chunks.push(data);
+    });
+    socket.on('end', common.mustCall(() => {
+      assert(Buffer.concat(chunks).equals(payload));
+      server.close();
+    }));
+  }));
+}
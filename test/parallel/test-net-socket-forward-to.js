@@ -0,0 +1,111 @@
+'use strict';
+const common = require('../common');
+
+// Test that socket.forwardTo() forwards data in both directions of a proxy,
+// including data that was already read before forwarding started, and ends
+// the destination when the source ends. Data written to the destination from
+// JS before forwarding started goes first, and the forwarded bytes are
+// counted in bytesRead and bytesWritten.
+
+const assert = require('assert');
+const net = require('net');
+
+assert.throws(() => new net.Socket().forwardTo({}), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => new net.Socket().forwardTo(new net.Socket(), 'cb'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+function makeData(size, seed) {
+  const data = Buffer.allocUnsafe(size);
+  for (let i = 0; i < size; i++)
+    data[i] = (i * seed) & 0xff;
+  return data;
+}
+
+const request = makeData(4 * 1024 * 1024, 7);
+const response = makeData(4 * 1024 * 1024, 13);
+
+function collect(socket, expected) {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert(Buffer.concat(chunks).equals(expected));
+  }));
+}
+
+const server = net.createServer(common.mustCall((socket) => {
+  collect(socket, request);
+  socket.end(response);
+}));
+
+// Each direction of the proxy ends on its own.
+const proxy = net.createServer({ allowHalfOpen: true }, common.mustCall((client) => {
+  // Read the first chunk in JS before handing the socket over.
+  client.once('data', common.mustCall((first) => {
+    client.pause();
+    client.unshift(first);
+
+    const upstream = net.connect({
+      port: server.address().port,
+      allowHalfOpen: true,
+    });
+    client.forwardTo(upstream, common.mustCall((err) => {
+      assert.strictEqual(err, null);
+      assert.strictEqual(client.bytesRead, request.length);
+      assert.strictEqual(upstream.bytesWritten, request.length);
+    }));
+    upstream.forwardTo(client, common.mustCall((err) => {
+      assert.strictEqual(err, null);
+      assert.strictEqual(upstream.bytesRead, response.length);
+      assert.strictEqual(client.bytesWritten, response.length);
+    }));
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  proxy.listen(0, common.mustCall(() => {
+    const client = net.connect(proxy.address().port, common.mustCall(() => {
+      client.end(request);
+    }));
+    collect(client, response);
+    client.on('close', common.mustCall(() => {
+      proxy.close();
+      server.close();
+    }));
+  }));
+}));
+
+{
+  // Writes that are queued or corked on the destination are not overtaken.
+  const header = makeData(1024 * 1024, 3);
+  const body = makeData(1024 * 1024, 5);
+
+  const source = net.createServer(common.mustCall((socket) => {
+    socket.end(body);
+  }));
+  const sink = net.createServer(common.mustCall((socket) => {
+    collect(socket, Buffer.concat([header, header, body]));
+    socket.on('end', common.mustCall(() => {
+      source.close();
+      sink.close();
+    }));
+  }));
+
+  source.listen(0, common.mustCall(() => {
+    sink.listen(0, common.mustCall(() => {
+      const from = net.connect(source.address().port);
+      const to = net.connect(sink.address().port);
+      // Queued while connecting.
+      to.write(header);
+      to.cork();
+      to.write(header);
+      from.forwardTo(to, common.mustCall((err) => {
+        assert.strictEqual(err, null);
+        assert.strictEqual(from.bytesRead, body.length);
+        assert.strictEqual(to.bytesWritten, 2 * header.length + body.length);
+      }));
+    }));
+  }));
+}
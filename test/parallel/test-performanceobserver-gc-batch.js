@@ -0,0 +1,64 @@
+// Flags: --expose-gc --no-warnings
+'use strict';
+
+// Verifies that the entries of many GCs that happen during one turn of the
+// event loop are delivered together, in order, and without losing any, even
+// when there are more of them than the native buffer holds.
+
+const common = require('../common');
+const assert = require('assert');
+const {
+  PerformanceObserver,
+  constants: { NODE_PERFORMANCE_GC_MINOR },
+} = require('perf_hooks');
+
+const kGCCount = 1000;
+
+function checkEntries(entries) {
+  const minor = entries.filter((entry) => {
+    return entry.detail.kind === NODE_PERFORMANCE_GC_MINOR;
+  });
+  assert(minor.length >= kGCCount, `${minor.length} minor GCs`);
+  for (let i = 0; i < entries.length; i++) {
+    const entry = entries[i];
+    assert.strictEqual(entry.name, 'gc');
+    assert.strictEqual(entry.entryType, 'gc');
+    assert.strictEqual(typeof entry.startTime, 'number');
+    assert.strictEqual(typeof entry.duration, 'number');
+    assert.strictEqual(entry.kind, entry.detail.kind);
+    assert.strictEqual(entry.flags, entry.detail.flags);
+    if (i > 0)
+      assert(entry.startTime >= entries[i - 1].startTime);
+  }
+}
+
+let first;
+const obs = new PerformanceObserver(common.mustCall((list, observer) => {
+  const entries = list.getEntries();
+  checkEntries(entries);
+  assert.deepStrictEqual(list.getEntriesByType('gc'), entries);
+  assert.deepStrictEqual(list.getEntriesByName('gc', 'gc'), entries);
+  first = entries;
+  observer.disconnect();
+}));
+obs.observe({ type: 'gc' });
+
+// A second observer receives the same entries, and takeRecords() returns the
+// entries that have not been dispatched yet.
+const obs2 = new PerformanceObserver(common.mustNotCall());
+obs2.observe({ entryTypes: ['gc'] });
+
+for (let i = 0; i < kGCCount; i++)
+  global.gc({ type: 'minor' });
+
+let records;
+setImmediate(common.mustCall(() => {
+  records = obs2.takeRecords();
+  obs2.disconnect();
+  checkEntries(records.sort((a, b) => a.startTime - b.startTime));
+}));
+
+process.on('exit', () => {
+  // The entry objects are shared by the observers.
+  assert(records.includes(first[0]));
+});
@@ -0,0 +1,89 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Readable } = require('stream');
+const { splitRecords } = require('readline');
+
+async function collect(chunks, options) {
+  const records = [];
+  for await (const batch of splitRecords(chunks, options)) {
+    assert(Array.isArray(batch));
+    assert.notStrictEqual(batch.length, 0);
+    for (const record of batch) {
+      assert(Buffer.isBuffer(record));
+      records.push(record.toString());
+    }
+  }
+  return records;
+}
+
+function chunked(string, sizes) {
+  const buffer = Buffer.from(string);
+  const chunks = [];
+  for (let i = 0, j = 0; i < buffer.length; j++) {
+    const size = sizes[j % sizes.length];
+    chunks.push(buffer.subarray(i, i + size));
+    i += size;
+  }
+  return chunks;
+}
+
+(async () => {
+  // Records within a chunk are views of it, and are yielded together.
+  const chunk = Buffer.from('a\nbc\n');
+  const batches = [];
+  for await (const batch of splitRecords([chunk]))
+    batches.push(batch);
+  assert.strictEqual(batches.length, 1);
+  const records = batches[0];
+  assert.deepStrictEqual(records.map(String), ['a', 'bc']);
+  assert.strictEqual(records[1].buffer, chunk.buffer);
+  assert.strictEqual(records[1].byteOffset, chunk.byteOffset + 2);
+
+  // Empty records are kept, a trailing delimiter does not add one.
+  assert.deepStrictEqual(await collect(['\n\na\n']), ['', '', 'a']);
+  assert.deepStrictEqual(await collect(['a\nb']), ['a', 'b']);
+  assert.deepStrictEqual(await collect([]), []);
+  assert.deepStrictEqual(await collect(['\r\n'], { delimiter: '\n' }), ['\r']);
+
+  // Records and delimiters spanning chunks, for every way of cutting the
+  // input into chunks of one to four bytes.
+  const input = 'x\r\n\r\nyy\r\nzzz\r\n\n\rw';
+  for (const delimiter of ['\n', '\r\n', '\r\n\r\n']) {
+    const expected = input.split(delimiter);
+    for (let a = 1; a <= 4; a++) {
+      for (let b = 1; b <= 4; b++) {
+        assert.deepStrictEqual(
+          await collect(chunked(input, [a, b]), { delimiter }), expected);
+        assert.deepStrictEqual(
+          await collect(chunked(input, [a, b]),
+                        { delimiter: Buffer.from(delimiter) }),
+          expected);
+      }
+    }
+  }
+
+  // More records in a chunk than are looked up in one go.
+  const lines = [];
+  for (let i = 0; i < 5000; i++)
+    lines.push(JSON.stringify({ i }));
+  const ndjson = lines.join('\n') + '\n';
+  assert.deepStrictEqual(await collect([ndjson]), lines);
+  assert.deepStrictEqual(
+    await collect(Readable.from(chunked(ndjson, [4096, 10]))), lines);
+
+  // String chunks, e.g. from a stream with an encoding set.
+  const stream = Readable.from(['ä\nö', 'ü\n'], { objectMode: false });
+  stream.setEncoding('utf8');
+  assert.deepStrictEqual(await collect(stream), ['ä', 'öü']);
+
+  for (const delimiter of [1, null, {}]) {
+    await assert.rejects(collect(['a'], { delimiter }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  await assert.rejects(collect(['a'], { delimiter: '' }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  await assert.rejects(collect([1]), { code: 'ERR_INVALID_ARG_TYPE' });
+})().then(common.mustCall());
@@ -4,7 +4,7 @@
 require('../common');
 const assert = require('assert');
 const { internalBinding } = require('internal/test/binding');
-const { getLibuvNow } = internalBinding('timers');
+const binding = internalBinding('timers');
 
 // Return value of getLibuvNow() should easily fit in a SMI after start-up.
-assert(getLibuvNow() < 0x3ffffff);
+assert(binding.getLibuvNow() < 0x3ffffff);
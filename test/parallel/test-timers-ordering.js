@@ -25,7 +25,7 @@
 require('../common');
 const assert = require('assert');
 const { internalBinding } = require('internal/test/binding');
-const { getLibuvNow } = internalBinding('timers');
+const binding = internalBinding('timers');
 
 const N = 30;
 
@@ -39,7 +39,7 @@ function f(i) {
     last_i = i;
 
     // Check that this iteration is fired at least 1ms later than the previous
-    const now = getLibuvNow();
+    const now = binding.getLibuvNow();
     assert(now >= last_ts + 1,
            `current ts ${now} < prev ts ${last_ts} + 1`);
     last_ts = now;
@@ -0,0 +1,66 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Test that large transfers in both directions at once arrive intact, with
+// writes of varying sizes that make the encrypted buffers of the TLS layer
+// grow, wrap around and shrink again.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+const kTotal = 8 * 1024 * 1024;
+
+function send(socket, data) {
+  let offset = 0;
+  let size = 1;
+  function write() {
+    while (offset < data.length) {
+      const end = Math.min(offset + size, data.length);
+      // Alternate between tiny writes and writes spanning many TLS records.
+      size = size > 1024 * 1024 ? 1 : size * 7 + 3;
+      const ok = socket.write(data.subarray(offset, end));
+      offset = end;
+      if (!ok) {
+        socket.once('drain', write);
+        return;
+      }
+    }
+    socket.end();
+  }
+  write();
+}
+
+function receive(socket, expected) {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert(Buffer.concat(chunks).equals(expected));
+  }));
+}
+
+const fromClient = crypto.randomBytes(kTotal);
+const fromServer = crypto.randomBytes(kTotal);
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+}, common.mustCall((socket) => {
+  receive(socket, fromClient);
+  send(socket, fromServer);
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+  }, common.mustCall(() => {
+    send(socket, fromClient);
+  }));
+  receive(socket, fromServer);
+  socket.on('close', () => server.close());
+}));
@@ -0,0 +1,101 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+if (common.isWindows)
+  common.skip('no mkfifo on Windows');
+
+// Test that a connection that is destroyed while its offloaded private key
+// operation is still running fails its handshake cleanly, with both RSA and
+// ECDSA keys, and that the server keeps working afterwards. A single
+// threadpool thread is kept busy opening a FIFO, so that the operations stay
+// queued until the connection is gone.
+
+process.env.UV_THREADPOOL_SIZE = '1';
+
+const assert = require('assert');
+const child_process = require('child_process');
+const fixtures = require('../common/fixtures');
+const fs = require('fs');
+const path = require('path');
+const tls = require('tls');
+const { internalBinding } = require('internal/test/binding');
+const { getOffloadedPrivateKeyOperations } = internalBinding('crypto');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+if (!tls.createSecureContext().context.enablePrivateKeyOffload())
+  common.skip('OpenSSL cannot run async jobs on this platform');
+
+const fifo = path.join(tmpdir.path, 'fifo');
+const mkfifo = child_process.spawnSync('mkfifo', [fifo]);
+if (mkfifo.error && mkfifo.error.code === 'ENOENT')
+  common.skip('missing mkfifo');
+
+const cases = [
+  // RSA signature, RSA decryption and ECDSA signature.
+  { maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-AES128-GCM-SHA256' },
+  { maxVersion: 'TLSv1.2', ciphers: 'AES128-GCM-SHA256' },
+  { maxVersion: 'TLSv1.2', ciphers: 'ECDHE-ECDSA-AES128-GCM-SHA256' },
+];
+
+const server = tls.createServer({
+  key: [
+    fixtures.readKey('agent1-key.pem'),
+    fixtures.readKey('ec10-key.pem'),
+  ],
+  cert: [
+    fixtures.readKey('agent1-cert.pem'),
+    fixtures.readKey('ec10-cert.pem'),
+  ],
+  ciphers: 'ALL',
+  offloadPrivateKey: true,
+}, (socket) => {
+  assert.strictEqual(getOffloadedPrivateKeyOperations(socket._handle), 1);
+  socket.end();
+});
+
+server.listen(0, common.localhostIPv4, common.mustCall(() => {
+  runCase(0);
+}));
+
+function connect(options, callback) {
+  return tls.connect({
+    ...options,
+    host: common.localhostIPv4,
+    port: server.address().port,
+    rejectUnauthorized: false,
+  }, callback);
+}
+
+function runCase(index) {
+  if (index === cases.length) {
+    server.close();
+    return;
+  }
+  const options = cases[index];
+
+  // Occupy the only threadpool thread until a writer opens the FIFO.
+  fs.open(fifo, 'r', common.mustSucceed((fd) => {
+    fs.closeSync(fd);
+    // The aborted operation has finished, and the server still works.
+    const socket = connect(options, common.mustCall(() => {
+      assert.strictEqual(socket.getCipher().name, options.ciphers);
+      socket.resume();
+      socket.on('end', common.mustCall(() => runCase(index + 1)));
+    }));
+  }));
+
+  // The client goes away right after sending its ClientHello, while the
+  // server's private key operation is queued behind the FIFO.
+  server.once('tlsClientError', common.mustCall((err, socket) => {
+    assert.strictEqual(err.code, 'ECONNRESET');
+    fs.closeSync(fs.openSync(fifo, 'w'));
+  }));
+  const client = connect(options, common.mustNotCall());
+  client.on('error', () => {});
+  client.once('connect', () => client.destroy());
+}
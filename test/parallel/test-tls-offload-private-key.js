@@ -0,0 +1,132 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Test that handshakes complete, with both RSA and ECDSA keys and with each
+// kind of private key operation, when the server offloads its private key
+// operations to the threadpool, and that the operation of each handshake
+// actually ran there.
+
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+const { internalBinding } = require('internal/test/binding');
+const { getOffloadedPrivateKeyOperations } = internalBinding('crypto');
+
+assert.throws(() => tls.createSecureContext({ offloadPrivateKey: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /options\.offloadPrivateKey/,
+});
+
+// Where OpenSSL cannot run async jobs, the option has no effect.
+const kOffloadedOperations =
+  tls.createSecureContext().context.enablePrivateKeyOffload() ? 1 : 0;
+
+const kConnections = 8;
+
+const cases = [
+  // TLSv1.2 ECDHE signatures.
+  {
+    maxVersion: 'TLSv1.2',
+    ciphers: 'ECDHE-RSA-AES128-GCM-SHA256',
+    cn: 'agent1',
+  },
+  {
+    maxVersion: 'TLSv1.2',
+    ciphers: 'ECDHE-ECDSA-AES128-GCM-SHA256',
+    cn: 'agent10.example.com',
+  },
+  // TLSv1.2 RSA key exchange, which decrypts instead of signing.
+  {
+    maxVersion: 'TLSv1.2',
+    ciphers: 'AES128-GCM-SHA256',
+    cn: 'agent1',
+  },
+  // TLSv1.3 CertificateVerify signatures.
+  {
+    minVersion: 'TLSv1.3',
+    sigalgs: 'rsa_pss_rsae_sha256',
+    cn: 'agent1',
+  },
+  {
+    minVersion: 'TLSv1.3',
+    sigalgs: 'ecdsa_secp256r1_sha256',
+    cn: 'agent10.example.com',
+  },
+];
+
+const server = tls.createServer({
+  key: [
+    fixtures.readKey('agent1-key.pem'),
+    fixtures.readKey('ec10-key.pem'),
+  ],
+  cert: [
+    fixtures.readKey('agent1-cert.pem'),
+    fixtures.readKey('ec10-cert.pem'),
+  ],
+  ciphers: 'ALL',
+  offloadPrivateKey: true,
+}, (socket) => {
+  assert.strictEqual(getOffloadedPrivateKeyOperations(socket._handle),
+                     kOffloadedOperations);
+  socket.pipe(socket);
+});
+
+server.listen(0, common.mustCall(() => {
+  runCase(0);
+}));
+
+function runCase(index) {
+  if (index === cases.length) {
+    server.close();
+    return;
+  }
+
+  const { cn, ...options } = cases[index];
+  let pending = kConnections;
+  for (let i = 0; i < kConnections; i++) {
+    const socket = tls.connect({
+      ...options,
+      port: server.address().port,
+      rejectUnauthorized: false,
+    }, common.mustCall(() => {
+      assert.strictEqual(socket.getPeerCertificate().subject.CN, cn);
+      if (options.ciphers)
+        assert.strictEqual(socket.getCipher().name, options.ciphers);
+      else
+        assert.strictEqual(socket.getProtocol(), 'TLSv1.3');
+      socket.end(`hello ${i}`);
+    }));
+
+    let received = '';
+    socket.setEncoding('utf8');
+    socket.on('data', (chunk) => received += chunk);
+    socket.on('end', common.mustCall(() => {
+      assert.strictEqual(received, `hello ${i}`);
+      if (--pending === 0)
+        runCase(index + 1);
+    }));
+  }
+}
+
+{
+  // Without the option, the operations run on the event loop thread.
+  const server = tls.createServer({
+    key: fixtures.readKey('agent1-key.pem'),
+    cert: fixtures.readKey('agent1-cert.pem'),
+  }, common.mustCall((socket) => {
+    assert.strictEqual(getOffloadedPrivateKeyOperations(socket._handle), 0);
+    socket.end();
+    server.close();
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const socket = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+    }, common.mustCall(() => socket.resume()));
+  }));
+}
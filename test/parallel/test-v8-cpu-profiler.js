@@ -0,0 +1,161 @@
+'use strict';
+
+// Tests the continuous CPU profiler and its pprof output.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const { CpuProfiler } = require('v8');
+
+tmpdir.refresh();
+
+// Returns the fields of a protobuf message as [number, value] pairs, where
+// value is a number for varints and a Buffer for length-delimited fields.
+function decode(buffer) {
+  const fields = [];
+  let offset = 0;
+  function varint() {
+    let value = 0;
+    let shift = 0;
+    let byte;
+    do {
+      byte = buffer[offset++];
+      value += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+  while (offset < buffer.length) {
+    const key = varint();
+    const number = Math.floor(key / 8);
+    switch (key & 7) {
+      case 0:
+        fields.push([number, varint()]);
+        break;
+      case 2: {
+        const length = varint();
+        fields.push([number, buffer.subarray(offset, offset + length)]);
+        offset += length;
+        break;
+      }
+      default:
+        assert.fail(`unexpected wire type ${key & 7}`);
+    }
+  }
+  assert.strictEqual(offset, buffer.length);
+  return fields;
+}
+
+function checkProfile(profile) {
+  const fields = decode(profile);
+  const strings = fields.filter(([n]) => n === 6).map(([, s]) => `${s}`);
+  assert.strictEqual(strings[0], '');
+  // Two sample types: samples/count and cpu/nanoseconds.
+  assert.strictEqual(fields.filter(([n]) => n === 1).length, 2);
+  assert(strings.includes('samples'));
+  assert(strings.includes('nanoseconds'));
+  assert(!strings.includes('(idle)'));
+  return { fields, strings };
+}
+
+function spin(ms) {
+  const end = Date.now() + ms;
+  let x = 0;
+  while (Date.now() < end) x += Math.sqrt(x + 1);
+  return x;
+}
+
+{
+  for (const options of [null, 1, 'a']) {
+    assert.throws(() => new CpuProfiler(options), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  for (const name of ['samplingInterval', 'windowDuration', 'windowCount']) {
+    assert.throws(() => new CpuProfiler({ [name]: 0 }), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+    assert.throws(() => new CpuProfiler({ [name]: 1.5 }), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+    assert.throws(() => new CpuProfiler({ [name]: '1' }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  const profiler = new CpuProfiler();
+  assert.throws(() => profiler.takeProfile({ compress: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => profiler.writeProfile(1), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+(async () => {
+  const profiler = new CpuProfiler({
+    samplingInterval: 100,
+    windowDuration: 20,
+    windowCount: 1000,
+  });
+
+  // Nothing has been profiled yet.
+  checkProfile(await profiler.takeProfile({ compress: false }));
+
+  profiler.start();
+  profiler.start();
+  spin(200);
+  await new Promise((resolve) => setTimeout(resolve, 50));
+  spin(200);
+
+  const compressed = await profiler.takeProfile();
+  const { fields, strings } = checkProfile(zlib.gunzipSync(compressed));
+  assert(strings.includes('spin'));
+  assert(strings.includes(__filename));
+  assert(fields.some(([n]) => n === 2));  // sample
+  const period = fields.find(([n]) => n === 12);  // period
+  assert.strictEqual(period[1], 100 * 1000);
+
+  profiler.stop();
+  profiler.stop();
+
+  // The profile taken after stopping still has the samples.
+  const uncompressed = await profiler.takeProfile({ compress: false });
+  assert(checkProfile(uncompressed).strings.includes('spin'));
+
+  const filename = path.join(tmpdir.path, 'cpu.pb.gz');
+  assert.strictEqual(await profiler.writeProfile(filename), filename);
+  assert(checkProfile(zlib.gunzipSync(fs.readFileSync(filename)))
+    .strings.includes('spin'));
+
+  await assert.rejects(
+    profiler.writeProfile(path.join(tmpdir.path, 'missing', 'cpu.pb.gz')),
+    { code: 'ENOENT', syscall: 'open' });
+
+  // Only the last windows are kept.
+  const short = new CpuProfiler({ windowDuration: 1, windowCount: 1 });
+  short.start();
+  spin(100);
+  await new Promise((resolve) => setTimeout(resolve, 100));
+  const profile = checkProfile(await short.takeProfile({ compress: false }));
+  assert(!profile.strings.includes('spin'));
+  short.stop();
+})().then(common.mustCall());
+
+if (!common.isWindows && common.isMainThread) {
+  const { spawnSync } = require('child_process');
+  const cwd = path.join(tmpdir.path, 'signal');
+  fs.mkdirSync(cwd);
+  const child = spawnSync(process.execPath, [
+    '--cpu-prof-signal=SIGUSR2',
+    '-e',
+    'process.kill(process.pid, "SIGUSR2"); setTimeout(() => {}, 1000);',
+  ], { cwd });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  const files = fs.readdirSync(cwd);
+  assert.strictEqual(files.length, 1);
+  assert.match(files[0], /^CPU\..*\.pb\.gz$/);
+  checkProfile(zlib.gunzipSync(fs.readFileSync(path.join(cwd, files[0]))));
+}
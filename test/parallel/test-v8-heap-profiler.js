@@ -0,0 +1,168 @@
+'use strict';
+
+// Tests the continuous heap profiler and its pprof output.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const { HeapProfiler } = require('v8');
+
+tmpdir.refresh();
+
+// Returns the fields of a protobuf message as [number, value] pairs, where
+// value is a number for varints and a Buffer for length-delimited fields.
+function decode(buffer) {
+  const fields = [];
+  let offset = 0;
+  function varint() {
+    let value = 0;
+    let shift = 0;
+    let byte;
+    do {
+      byte = buffer[offset++];
+      value += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+  while (offset < buffer.length) {
+    const key = varint();
+    const number = Math.floor(key / 8);
+    switch (key & 7) {
+      case 0:
+        fields.push([number, varint()]);
+        break;
+      case 2: {
+        const length = varint();
+        fields.push([number, buffer.subarray(offset, offset + length)]);
+        offset += length;
+        break;
+      }
+      default:
+        assert.fail(`unexpected wire type ${key & 7}`);
+    }
+  }
+  assert.strictEqual(offset, buffer.length);
+  return fields;
+}
+
+function checkProfile(profile) {
+  const fields = decode(profile);
+  const strings = fields.filter(([n]) => n === 6).map(([, s]) => `${s}`);
+  assert.strictEqual(strings[0], '');
+  // Two sample types: objects/count and space/bytes.
+  assert.strictEqual(fields.filter(([n]) => n === 1).length, 2);
+  assert(strings.includes('objects'));
+  assert(strings.includes('space'));
+  assert(strings.includes('bytes'));
+  const samples = fields.filter(([n]) => n === 2).map(([, s]) => decode(s));
+  return { fields, strings, samples };
+}
+
+const retained = [];
+function leakHeapProfilerMarkers() {
+  for (let i = 0; i < 5000; i++)
+    retained.push(new Array(64).fill(i));
+}
+
+{
+  for (const options of [null, 1, 'a']) {
+    assert.throws(() => new HeapProfiler(options), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  for (const name of ['samplingInterval', 'stackDepth', 'maxStacks',
+                      'aggregateInterval']) {
+    assert.throws(() => new HeapProfiler({ [name]: 0 }), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+    assert.throws(() => new HeapProfiler({ [name]: '1' }), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  assert.throws(() => new HeapProfiler({ native: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  const profiler = new HeapProfiler();
+  assert.throws(() => profiler.takeProfile({ compress: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => profiler.writeProfile(1), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+(async () => {
+  const profiler = new HeapProfiler({
+    samplingInterval: 256,
+    aggregateInterval: 10,
+  });
+
+  // Nothing has been profiled yet.
+  assert.strictEqual(
+    checkProfile(await profiler.takeProfile({ compress: false }))
+      .samples.length,
+    0);
+
+  profiler.start();
+  profiler.start();
+
+  // Only one sampling heap profiler can run at a time.
+  assert.throws(() => new HeapProfiler().start(), {
+    code: 'ERR_OPERATION_FAILED',
+  });
+
+  leakHeapProfilerMarkers();
+  await new Promise((resolve) => setTimeout(resolve, 50));
+
+  const compressed = await profiler.takeProfile();
+  const { fields, strings, samples } =
+    checkProfile(zlib.gunzipSync(compressed));
+  assert(strings.includes('leakHeapProfilerMarkers'));
+  assert(strings.includes(__filename));
+  // Native memory, owned by the Environment.
+  assert(strings.includes('(native)'));
+  assert(strings.includes('Node / Environment'));
+  assert(samples.length > 0);
+  for (const sample of samples) {
+    // location_id and value are packed.
+    assert(sample.find(([n]) => n === 1)[1].length > 0);
+    assert(sample.find(([n]) => n === 2)[1].length > 0);
+  }
+  const period = fields.find(([n]) => n === 12);  // period
+  assert.strictEqual(period[1], 256);
+
+  profiler.stop();
+  profiler.stop();
+
+  // The profile taken after stopping still has the samples.
+  const uncompressed = await profiler.takeProfile({ compress: false });
+  assert(checkProfile(uncompressed).strings
+    .includes('leakHeapProfilerMarkers'));
+
+  const filename = path.join(tmpdir.path, 'heap.pb.gz');
+  assert.strictEqual(await profiler.writeProfile(filename), filename);
+  assert(checkProfile(zlib.gunzipSync(fs.readFileSync(filename)))
+    .strings.includes('leakHeapProfilerMarkers'));
+
+  await assert.rejects(
+    profiler.writeProfile(path.join(tmpdir.path, 'missing', 'heap.pb.gz')),
+    { code: 'ENOENT', syscall: 'open' });
+
+  // The number of stacks is bounded, the others are merged.
+  const bounded = new HeapProfiler({
+    samplingInterval: 256,
+    maxStacks: 1,
+    native: false,
+  });
+  bounded.start();
+  leakHeapProfilerMarkers();
+  const profile = checkProfile(await bounded.takeProfile({ compress: false }));
+  bounded.stop();
+  assert.strictEqual(profile.samples.length, 1);
+  assert(profile.strings.includes('(other)'));
+  assert(!profile.strings.includes('(native)'));
+})().then(common.mustCall());
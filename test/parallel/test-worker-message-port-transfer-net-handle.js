@@ -0,0 +1,80 @@
+'use strict';
+const common = require('../common');
+
+// Sockets and listening servers can be moved to another thread with
+// socket.detachHandle()/server.detachHandle() and postMessage().
+
+if (common.isWindows)
+  common.skip('network handles cannot be transferred on Windows');
+
+const assert = require('assert');
+const net = require('net');
+const { Worker } = require('worker_threads');
+
+const workerSource = `
+  const net = require('net');
+  const { parentPort } = require('worker_threads');
+  parentPort.on('message', ({ kind, handle }) => {
+    if (kind === 'socket') {
+      new net.Socket({ handle }).end('hello from worker');
+    } else {
+      const server = net.createServer((socket) => {
+        socket.end('served by worker');
+        server.close();
+      });
+      server.listen(handle, () => parentPort.postMessage('listening'));
+    }
+  });
+`;
+
+function readAll(socket, cb) {
+  let data = '';
+  socket.setEncoding('utf8');
+  socket.on('data', (chunk) => data += chunk);
+  socket.on('end', common.mustCall(() => cb(data)));
+}
+
+{
+  // An accepted connection.
+  const worker = new Worker(workerSource, { eval: true });
+  const onconnection = common.mustCall((socket) => {
+    const handle = socket.detachHandle();
+    assert.strictEqual(socket._handle, null);
+    assert.throws(() => socket.detachHandle(), { code: 'ERR_SOCKET_CLOSED' });
+
+    // The handle has to be in the transfer list.
+    assert.throws(() => worker.postMessage({ kind: 'socket', handle }), {
+      code: 'ERR_MISSING_TRANSFERABLE_IN_TRANSFER_LIST',
+    });
+    worker.postMessage({ kind: 'socket', handle }, [handle]);
+    server.close();
+  });
+  const server = net.createServer({ pauseOnConnect: true }, onconnection);
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    readAll(client, (data) => {
+      assert.strictEqual(data, 'hello from worker');
+      worker.terminate();
+    });
+  }));
+}
+
+{
+  // A listening server.
+  const worker = new Worker(workerSource, { eval: true });
+  const server = net.createServer(common.mustNotCall());
+  server.on('close', common.mustCall());
+  server.listen(0, common.mustCall(() => {
+    const { port } = server.address();
+    const handle = server.detachHandle();
+    assert.strictEqual(server.listening, false);
+    worker.postMessage({ kind: 'server', handle }, [handle]);
+    worker.once('message', common.mustCall(() => {
+      readAll(net.connect(port), (data) => {
+        assert.strictEqual(data, 'served by worker');
+        worker.terminate();
+      });
+    }));
+  }));
+}
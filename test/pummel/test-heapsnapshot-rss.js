@@ -0,0 +1,81 @@
+'use strict';
+
+// Measures how much memory writing a heap snapshot of a 1 GB heap takes on
+// top of taking the snapshot. Most of the memory needed for a snapshot is the
+// graph V8 builds, which is proportional to the number of objects. Writing
+// the snapshot streams it to the file, so it must only need a bounded amount
+// of memory, independent of the size of the heap or of the output.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const os = require('os');
+
+if (!common.isLinux)
+  common.skip('Peak RSS is only reset on Linux');
+
+if (!common.enoughTestMem || os.totalmem() < 4 * 1024 ** 3)
+  common.skip('Insufficient memory for snapshot test');
+
+const kHeapSize = 1024 ** 3;
+const kMaxWriteOverhead = 128 * 1024 * 1024;
+
+// Fills the heap with `kHeapSize` bytes, mostly in large arrays of doubles
+// plus many small objects. The peak RSS is reset before the snapshot is taken
+// so that only the memory used for the snapshot is measured.
+const script = `
+  const fs = require('fs');
+  const v8 = require('v8');
+  const retained = globalThis.retained = [];
+  for (let size = 0; size < ${kHeapSize};) {
+    retained.push(new Array(1024 * 1024).fill(0.5));
+    size += 8 * 1024 * 1024;
+  }
+  for (let i = 0; i < 1e5; i++)
+    retained.push({ i, name: 'object-' + i });
+  globalThis.gc();
+
+  const { heapUsed, rss } = process.memoryUsage();
+  fs.writeFileSync('/proc/self/clear_refs', '5');
+  const options = JSON.parse(process.argv[1]);
+  let size = 0;
+  if (options === null) {
+    globalThis.snapshot = v8.getHeapSnapshot();
+  } else {
+    size = fs.statSync(v8.writeHeapSnapshot('snapshot', options)).size;
+  }
+  const status = fs.readFileSync('/proc/self/status', 'latin1');
+  const peak = Number(/VmHWM:\\s+(\\d+) kB/.exec(status)[1]) * 1024;
+  console.log(JSON.stringify({ heapUsed, size, overhead: peak - rss }));
+`;
+
+function run(options) {
+  tmpdir.refresh();
+  const child = spawnSync(process.execPath, [
+    '--expose-gc',
+    '--max-old-space-size=4096',
+    '-e', script,
+    JSON.stringify(options),
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  const result = JSON.parse(child.stdout);
+  assert(result.heapUsed >= kHeapSize);
+  console.log(`${JSON.stringify(options)}: ${JSON.stringify(result)}`);
+  return result;
+}
+
+// Only taking the snapshot, without writing it.
+const baseline = run(null).overhead;
+
+for (const options of [
+  {},
+  { compress: true },
+  { format: 'binary' },
+  { format: 'binary', compress: true },
+]) {
+  const { overhead } = run(options);
+  assert(overhead - baseline < kMaxWriteOverhead,
+         `Writing a snapshot with ${JSON.stringify(options)} used ` +
+         `${overhead - baseline} bytes on top of taking it`);
+}
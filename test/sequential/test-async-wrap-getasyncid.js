@@ -65,7 +65,7 @@ const path = require('path');
     delete providers.ELDHISTOGRAM;
     delete providers.SIGINTWATCHDOG;
     delete providers.WORKERHEAPSNAPSHOT;
-    delete providers.FIXEDSIZEBLOBCOPY;
+    delete providers.BLOBREADER;
     delete providers.RANDOMPRIMEREQUEST;
     delete providers.CHECKPRIMEREQUEST;
     delete providers.QUIC_LOGSTREAM;
@@ -173,6 +173,9 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
 
   const StatWatcher = binding.StatWatcher;
   testInitialized(new StatWatcher(), 'StatWatcher');
+
+  const CopyTree = binding.CopyTree;
+  testInitialized(new CopyTree('src', 'dest', 0, 0, 1), 'CopyTree');
 }
 
 
@@ -333,6 +336,17 @@ if (process.features.inspector && common.isMainThread) {
   v8.getHeapSnapshot().destroy();
 }
 
+{
+  const { ContinuousCpuProfiler } = internalBinding('v8');
+  testInitialized(new ContinuousCpuProfiler(1000, 1), 'ContinuousCpuProfiler');
+}
+
+{
+  const { ContinuousHeapProfiler } = internalBinding('v8');
+  testInitialized(new ContinuousHeapProfiler(512 * 1024, 16, 4096, true),
+                  'ContinuousHeapProfiler');
+}
+
 // DIRHANDLE
 {
   const dirBinding = internalBinding('fs_dir');
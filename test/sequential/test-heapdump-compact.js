@@ -0,0 +1,134 @@
+'use strict';
+
+// Tests compressed heap snapshots and the binary heap snapshot format.
+
+const common = require('../common');
+
+if (!common.isMainThread)
+  common.skip('process.chdir is not available in Workers');
+
+const { writeHeapSnapshot } = require('v8');
+const assert = require('assert');
+const fs = require('fs');
+const zlib = require('zlib');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+process.chdir(tmpdir.path);
+
+// Decodes a snapshot in the binary format into the object JSON.parse()
+// returns for the JSON format.
+function decodeBinarySnapshot(buffer) {
+  assert.strictEqual(buffer.toString('latin1', 0, 8), 'NODEHEAP');
+  assert.strictEqual(buffer[8], 1);
+  let offset = 9;
+  function varint() {
+    let value = 0;
+    let shift = 0;
+    let byte;
+    do {
+      byte = buffer[offset++];
+      value += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+
+  function utf8(length) {
+    offset += length;
+    return buffer.toString('utf8', offset - length, offset);
+  }
+  const snapshot = {};
+  for (let length; (length = varint()) !== 0;) {
+    const name = utf8(length);
+    const kind = buffer[offset++];
+    if (kind === 0) {
+      snapshot[name] = JSON.parse(utf8(varint()));
+      continue;
+    }
+    assert(kind === 1 || kind === 2);
+    const values = snapshot[name] = [];
+    for (let value; (value = varint()) !== 0;) {
+      if (kind === 1) {
+        value -= 1;
+        values.push(value % 2 ? -(value + 1) / 2 : value / 2);
+      } else {
+        values.push(utf8(value - 1));
+      }
+    }
+  }
+  assert.strictEqual(offset, buffer.length);
+  return snapshot;
+}
+
+function checkSnapshot(snapshot) {
+  const { meta, node_count, edge_count } = snapshot.snapshot;
+  assert.strictEqual(snapshot.nodes.length,
+                     node_count * meta.node_fields.length);
+  assert.strictEqual(snapshot.edges.length,
+                     edge_count * meta.edge_fields.length);
+  assert(snapshot.strings.includes(marker.name));
+  assert(snapshot.strings.includes(marker.text));
+}
+
+class HeapdumpCompactMarker {
+  constructor() {
+    this.text = 'line\n"quoted"\tü€';
+  }
+}
+const marker = new HeapdumpCompactMarker();
+marker.name = HeapdumpCompactMarker.name;
+
+{
+  const filename = writeHeapSnapshot('plain.heapsnapshot', {});
+  checkSnapshot(JSON.parse(fs.readFileSync(filename, 'utf8')));
+}
+
+{
+  const filename = writeHeapSnapshot(undefined, { compress: true });
+  assert.match(filename, /^Heap\..*\.heapsnapshot\.gz$/);
+  checkSnapshot(JSON.parse(zlib.gunzipSync(fs.readFileSync(filename))));
+}
+
+{
+  const filename = writeHeapSnapshot(undefined, { format: 'binary' });
+  assert.match(filename, /^Heap\..*\.heapsnapshot\.bin$/);
+  const binary = fs.readFileSync(filename);
+  const snapshot = decodeBinarySnapshot(binary);
+  checkSnapshot(snapshot);
+
+  const json = fs.readFileSync(writeHeapSnapshot('json.heapsnapshot'));
+  assert(binary.length < json.length);
+}
+
+{
+  const filename = writeHeapSnapshot('snapshot.bin.gz', {
+    compress: true,
+    format: 'binary',
+  });
+  assert.strictEqual(filename, 'snapshot.bin.gz');
+  checkSnapshot(decodeBinarySnapshot(zlib.gunzipSync(
+    fs.readFileSync(filename))));
+}
+
+for (const options of [null, 1, 'binary']) {
+  assert.throws(() => writeHeapSnapshot(undefined, options), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+assert.throws(() => writeHeapSnapshot(undefined, { compress: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => writeHeapSnapshot(undefined, { format: 'xml' }), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+
+if (common.isLinux && fs.existsSync('/dev/full')) {
+  // Write errors stop the serialization and are reported.
+  for (const compress of [false, true]) {
+    assert.throws(() => writeHeapSnapshot('/dev/full', { compress }), {
+      code: 'ENOSPC',
+      syscall: 'write',
+    });
+  }
+}
@@ -0,0 +1,87 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const { monitorEventLoopPhases } = require('perf_hooks');
+const { sleep } = require('internal/util');
+const zlib = require('zlib');
+
+const kPhases = ['timers', 'poll', 'check', 'close'];
+
+{
+  const monitor = monitorEventLoopPhases();
+  assert(monitor.enable());
+  assert(!monitor.enable());
+  assert(monitor.disable());
+  assert(!monitor.disable());
+  assert.deepStrictEqual(Object.keys(monitor.phases), kPhases);
+  assert.deepStrictEqual(Object.keys(monitor.callbacks), kPhases);
+  assert.deepStrictEqual(Object.keys(monitor.threadpool), ['wait', 'run']);
+
+  for (const name of ['enable', 'disable', 'reset']) {
+    assert.throws(() => monitor[name].call({}), {
+      code: 'ERR_INVALID_THIS',
+    });
+  }
+}
+
+{
+  const monitor = monitorEventLoopPhases();
+  const idle = monitorEventLoopPhases();
+  monitor.enable();
+
+  // Blocks the event loop for a while in each phase.
+  setTimeout(common.mustCall(() => {
+    sleep(20);
+    setImmediate(common.mustCall(() => {
+      sleep(20);
+      fs.readFile(__filename, common.mustSucceed(() => {
+        sleep(20);
+        zlib.deflate(Buffer.alloc(1024), common.mustSucceed(() => {
+          const server = net.createServer().listen(0, common.mustCall(() => {
+            server.close(common.mustCall(() => setImmediate(check)));
+          }));
+        }));
+      }));
+    }));
+  }), 1);
+
+  function check() {
+    monitor.disable();
+
+    for (const phase of kPhases) {
+      assert(monitor.phases[phase].count > 0, phase);
+      assert(monitor.callbacks[phase] > 0, phase);
+    }
+    for (const phase of ['timers', 'poll', 'check'])
+      assert(monitor.phases[phase].max >= 20e6, phase);
+    assert(monitor.threadpool.wait.count > 0);
+    assert(monitor.threadpool.run.count > 0);
+
+    // A monitor that was never enabled records nothing.
+    for (const phase of kPhases) {
+      assert.strictEqual(idle.phases[phase].count, 0);
+      assert.strictEqual(idle.callbacks[phase], 0);
+    }
+    assert.strictEqual(idle.threadpool.wait.count, 0);
+
+    // Nothing is recorded after disable().
+    const counts = monitor.callbacks;
+    const polls = monitor.phases.poll.count;
+    setImmediate(common.mustCall(() => {
+      assert.deepStrictEqual(monitor.callbacks, counts);
+      assert.strictEqual(monitor.phases.poll.count, polls);
+
+      monitor.reset();
+      for (const phase of kPhases) {
+        assert.strictEqual(monitor.phases[phase].count, 0);
+        assert.strictEqual(monitor.callbacks[phase], 0);
+      }
+      assert.strictEqual(monitor.threadpool.wait.count, 0);
+      assert.strictEqual(monitor.threadpool.run.count, 0);
+    }));
+  }
+}
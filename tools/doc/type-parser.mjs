@@ -175,6 +175,7 @@ const customTypesMap = {
 
   'os.constants.dlopen': 'os.html#dlopen-constants',
 
+  'EventLoopPhaseMonitor': 'perf_hooks.html#class-eventloopphasemonitor',
   'Histogram': 'perf_hooks.html#class-histogram',
   'IntervalHistogram':
      'perf_hooks.html#class-intervalhistogram-extends-histogram',
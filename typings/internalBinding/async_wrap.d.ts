@@ -12,63 +12,66 @@ declare namespace InternalAsyncWrapBinding {
 
   interface Providers {
     NONE: 0;
-    DIRHANDLE: 1;
-    DNSCHANNEL: 2;
-    ELDHISTOGRAM: 3;
-    FILEHANDLE: 4;
-    FILEHANDLECLOSEREQ: 5;
-    FIXEDSIZEBLOBCOPY: 6;
-    FSEVENTWRAP: 7;
-    FSREQCALLBACK: 8;
-    FSREQPROMISE: 9;
-    GETADDRINFOREQWRAP: 10;
-    GETNAMEINFOREQWRAP: 11;
-    HEAPSNAPSHOT: 12;
-    HTTP2SESSION: 13;
-    HTTP2STREAM: 14;
-    HTTP2PING: 15;
-    HTTP2SETTINGS: 16;
-    HTTPINCOMINGMESSAGE: 17;
-    HTTPCLIENTREQUEST: 18;
-    JSSTREAM: 19;
-    JSUDPWRAP: 20;
-    MESSAGEPORT: 21;
-    PIPECONNECTWRAP: 22;
-    PIPESERVERWRAP: 23;
-    PIPEWRAP: 24;
-    PROCESSWRAP: 25;
-    PROMISE: 26;
-    QUERYWRAP: 27;
-    SHUTDOWNWRAP: 28;
-    SIGNALWRAP: 29;
-    STATWATCHER: 30;
-    STREAMPIPE: 31;
-    TCPCONNECTWRAP: 32;
-    TCPSERVERWRAP: 33;
-    TCPWRAP: 34;
-    TTYWRAP: 35;
-    UDPSENDWRAP: 36;
-    UDPWRAP: 37;
-    SIGINTWATCHDOG: 38;
-    WORKER: 39;
-    WORKERHEAPSNAPSHOT: 40;
-    WRITEWRAP: 41;
-    ZLIB: 42;
-    CHECKPRIMEREQUEST: 43;
-    PBKDF2REQUEST: 44;
-    KEYPAIRGENREQUEST: 45;
-    KEYGENREQUEST: 46;
-    KEYEXPORTREQUEST: 47;
-    CIPHERREQUEST: 48;
-    DERIVEBITSREQUEST: 49;
-    HASHREQUEST: 50;
-    RANDOMBYTESREQUEST: 51;
-    RANDOMPRIMEREQUEST: 52;
-    SCRYPTREQUEST: 53;
-    SIGNREQUEST: 54;
-    TLSWRAP: 55;
-    VERIFYREQUEST: 56;
-    INSPECTORJSBINDING: 57;
+    CPUPROFILER: 1;
+    DIRHANDLE: 2;
+    DNSCHANNEL: 3;
+    ELDHISTOGRAM: 4;
+    FILEHANDLE: 5;
+    FILEHANDLECLOSEREQ: 6;
+    BLOBREADER: 7;
+    FSCOPYTREE: 8;
+    FSEVENTWRAP: 9;
+    FSREQCALLBACK: 10;
+    FSREQPROMISE: 11;
+    GETADDRINFOREQWRAP: 12;
+    GETNAMEINFOREQWRAP: 13;
+    HEAPPROFILER: 14;
+    HEAPSNAPSHOT: 15;
+    HTTP2SESSION: 16;
+    HTTP2STREAM: 17;
+    HTTP2PING: 18;
+    HTTP2SETTINGS: 19;
+    HTTPINCOMINGMESSAGE: 20;
+    HTTPCLIENTREQUEST: 21;
+    JSSTREAM: 22;
+    JSUDPWRAP: 23;
+    MESSAGEPORT: 24;
+    PIPECONNECTWRAP: 25;
+    PIPESERVERWRAP: 26;
+    PIPEWRAP: 27;
+    PROCESSWRAP: 28;
+    PROMISE: 29;
+    QUERYWRAP: 30;
+    SHUTDOWNWRAP: 31;
+    SIGNALWRAP: 32;
+    STATWATCHER: 33;
+    STREAMPIPE: 34;
+    TCPCONNECTWRAP: 35;
+    TCPSERVERWRAP: 36;
+    TCPWRAP: 37;
+    TTYWRAP: 38;
+    UDPSENDWRAP: 39;
+    UDPWRAP: 40;
+    SIGINTWATCHDOG: 41;
+    WORKER: 42;
+    WORKERHEAPSNAPSHOT: 43;
+    WRITEWRAP: 44;
+    ZLIB: 45;
+    CHECKPRIMEREQUEST: 46;
+    PBKDF2REQUEST: 47;
+    KEYPAIRGENREQUEST: 48;
+    KEYGENREQUEST: 49;
+    KEYEXPORTREQUEST: 50;
+    CIPHERREQUEST: 51;
+    DERIVEBITSREQUEST: 52;
+    HASHREQUEST: 53;
+    RANDOMBYTESREQUEST: 54;
+    RANDOMPRIMEREQUEST: 55;
+    SCRYPTREQUEST: 56;
+    SIGNREQUEST: 57;
+    TLSWRAP: 58;
+    VERIFYREQUEST: 59;
+    INSPECTORJSBINDING: 60;
   }
 }
 
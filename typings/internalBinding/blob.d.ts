@@ -1,18 +1,17 @@
 declare namespace InternalBlobBinding {
   interface BlobHandle {
+    getReader(): BlobReader;
     slice(start: number, end: number): BlobHandle;
   }
 
-  class FixedSizeBlobCopyJob {
-    constructor(handle: BlobHandle);
-    run(): ArrayBuffer | undefined;
-    ondone: (err: unknown, res?: ArrayBuffer) => void;
+  interface BlobReader {
+    pull(callback: (status: number, buffer?: ArrayBuffer) => void, maxLength?: number): void;
   }
 }
 
 declare function InternalBinding(binding: 'blob'): {
   createBlob(sources: Array<Uint8Array | InternalBlobBinding.BlobHandle>, length: number): InternalBlobBinding.BlobHandle;
-  FixedSizeBlobCopyJob: typeof InternalBlobBinding.FixedSizeBlobCopyJob;
+  createBlobFromFilePath(path: string | Uint8Array): [handle: InternalBlobBinding.BlobHandle, length: number];
   getDataObject(id: string): [handle: InternalBlobBinding.BlobHandle | undefined, length: number, type: string] | undefined;
   storeDataObject(id: string, handle: InternalBlobBinding.BlobHandle, size: number, type: string): void;
   revokeDataObject(id: string): void;